@@ -0,0 +1,122 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkAlignedImageBufferAllocator_h
+#define itkAlignedImageBufferAllocator_h
+
+#include "itkImageBufferAllocator.h"
+#include "itkObjectFactory.h"
+
+#include <atomic>
+
+namespace itk
+{
+
+/** \class AlignedImageBufferAllocator
+ * \brief Image buffer allocator providing aligned buffers, backed by huge pages.
+ *
+ * The buffers are aligned on GetAlignment() bytes, 64 by default, which is
+ * the size of a cache line and of an AVX-512 register. Vectorized code can
+ * query the alignment of the buffer of an image with
+ * ImportImageContainer::GetBufferAlignment().
+ *
+ * On Linux, the kernel is advised to back the buffers of at least
+ * GetHugePageMinimumBufferSize() bytes with transparent huge pages
+ * (madvise(MADV_HUGEPAGE)). This reduces the TLB misses of random accesses
+ * to large images, as done by interpolators in resampling and warping
+ * filters. It has no effect if transparent huge pages are disabled, or on
+ * the other platforms.
+ *
+ * The settings may be changed at any time. They apply to the subsequent
+ * allocations.
+ *
+ * To use it for all the images:
+   \code
+   itk::ImageBufferAllocator::SetGlobalDefaultAllocator(itk::AlignedImageBufferAllocator::New());
+   \endcode
+ *
+ * \ingroup ImageObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT AlignedImageBufferAllocator : public ImageBufferAllocator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(AlignedImageBufferAllocator);
+
+  /** Standard class type aliases. */
+  using Self = AlignedImageBufferAllocator;
+  using Superclass = ImageBufferAllocator;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(AlignedImageBufferAllocator);
+
+  void *
+  Allocate(SizeValueType numberOfBytes) override;
+
+  void
+  Deallocate(void * buffer, SizeValueType numberOfBytes) override;
+
+  /** Set/Get the alignment of the buffers, in bytes. It must be a power of
+   * two, at most 4096. Lower values than the alignment guaranteed by
+   * operator new are raised to it. The default is 64. */
+  /** @ITKStartGrouping */
+  void
+  SetAlignment(SizeValueType alignment);
+  SizeValueType
+  GetAlignment() const override;
+  /** @ITKEndGrouping */
+
+  /** Set/Get whether large buffers are backed by huge pages. The default is true. */
+  /** @ITKStartGrouping */
+  void
+  SetUseHugePages(bool useHugePages);
+  bool
+  GetUseHugePages() const;
+  itkBooleanMacro(UseHugePages);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the size of the smallest buffer backed by huge pages. The
+   * default is 2 MiB, the size of a huge page on x86-64. */
+  /** @ITKStartGrouping */
+  void
+  SetHugePageMinimumBufferSize(SizeValueType numberOfBytes);
+  SizeValueType
+  GetHugePageMinimumBufferSize() const;
+  /** @ITKEndGrouping */
+
+protected:
+  AlignedImageBufferAllocator() = default;
+  ~AlignedImageBufferAllocator() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** The settings are atomic, as Allocate() may be called concurrently. */
+  std::atomic<SizeValueType> m_Alignment{ 64 };
+  std::atomic<bool>          m_UseHugePages{ true };
+  std::atomic<SizeValueType> m_HugePageMinimumBufferSize{ SizeValueType{ 2 } << 20 };
+};
+
+} // end namespace itk
+
+#endif
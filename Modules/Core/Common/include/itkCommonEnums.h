@@ -143,6 +143,25 @@ public:
     OrderNotApplicable
   };
 
+  /**
+   * \ingroup ITKCommon
+   * Enums used to specify whether, and how, a file is memory mapped instead
+   * of read, when its pixels are stored as they are laid out in memory.
+   */
+  enum class IOMemoryMapping : uint8_t
+  {
+    /** The file is read into a newly allocated buffer. */
+    Off,
+    /** The pages of the file are mapped read-only: writing to the buffer
+     * crashes the process. In-place filters do not reuse such a buffer, but
+     * any other writer does, so only request it when the buffer is never
+     * written to, and prefer CopyOnWrite otherwise. */
+    ReadOnly,
+    /** The pages of the file are mapped privately: a page is copied when first
+     * written to, and the file is never modified. */
+    CopyOnWrite
+  };
+
   /**
    * \ingroup ITKCommon
    * Enums used to specify cell type */
@@ -170,6 +189,7 @@ using IOComponentEnum = CommonEnums::IOComponent;
 using IOFileEnum = CommonEnums::IOFile;
 using IOFileModeEnum = CommonEnums::IOFileMode;
 using IOByteOrderEnum = CommonEnums::IOByteOrder;
+using IOMemoryMappingEnum = CommonEnums::IOMemoryMapping;
 using CellGeometryEnum = CommonEnums::CellGeometry;
 
 #if !defined(ITK_LEGACY_REMOVE)
@@ -193,6 +213,8 @@ extern ITKCommon_EXPORT std::ostream &
                         operator<<(std::ostream & out, IOFileModeEnum value);
 extern ITKCommon_EXPORT std::ostream &
                         operator<<(std::ostream & out, IOByteOrderEnum value);
+extern ITKCommon_EXPORT std::ostream &
+                        operator<<(std::ostream & out, IOMemoryMappingEnum value);
 extern ITKCommon_EXPORT std::ostream &
                         operator<<(std::ostream & out, CellGeometryEnum value);
 
@@ -297,6 +319,32 @@ public:
 extern ITKCommon_EXPORT std::ostream &
                         operator<<(std::ostream & out, const ObjectFactoryEnums::InsertionPosition value);
 
+/** \class ImportImageContainerEnums
+ * \ingroup ITKCommon
+ */
+class ImportImageContainerEnums
+{
+public:
+  /** \ingroup ITKCommon
+   * Placement of the pages of the pixel buffers allocated by
+   * ImportImageContainer, see ImportImageContainerCommon.
+   */
+  enum class AllocationPolicy : uint8_t
+  {
+    /** Pages are placed by the operating system when first accessed,
+     * typically by the thread which initializes the buffer. */
+    Default,
+    /** Pages are first accessed in parallel, in contiguous chunks, so that
+     * each one is placed close to the thread which later processes it. */
+    ParallelFirstTouch,
+    /** Pages are interleaved among all the allowed NUMA nodes (Linux only,
+     * same as ParallelFirstTouch elsewhere). */
+    NUMAInterleave
+  };
+};
+extern ITKCommon_EXPORT std::ostream &
+                        operator<<(std::ostream & out, const ImportImageContainerEnums::AllocationPolicy value);
+
 } // namespace itk
 
 #endif // itkCommonEnums_h
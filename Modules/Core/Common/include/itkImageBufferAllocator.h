@@ -0,0 +1,106 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferAllocator_h
+#define itkImageBufferAllocator_h
+
+#include "itkObject.h"
+#include "itkSingletonMacro.h"
+
+namespace itk
+{
+
+struct ImageBufferAllocatorGlobals;
+
+/** \class ImageBufferAllocator
+ * \brief Abstract base class of the allocators of pixel buffers.
+ *
+ * An ImageBufferAllocator provides the raw memory of the buffers allocated
+ * by ImportImageContainer, for trivial element types. It can be set on a
+ * single container (see ImportImageContainer::SetBufferAllocator), or
+ * globally with SetGlobalDefaultAllocator(). When no allocator is set, the
+ * buffers are allocated with new[] and released with delete[].
+ *
+ * A buffer is always released through the allocator which provided it,
+ * with the size it was requested with. Consequently, the application must
+ * not take over (and delete[]) the buffer of a container allocated through
+ * an allocator.
+ *
+ * Implementations must be thread-safe.
+ *
+ * \sa PooledImageBufferAllocator
+ * \ingroup ImageObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageBufferAllocator : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageBufferAllocator);
+
+  /** Standard class type aliases. */
+  using Self = ImageBufferAllocator;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ImageBufferAllocator);
+
+  /** Returns a buffer of at least numberOfBytes bytes, aligned on
+   * GetAlignment() bytes. Its content is undefined: it may be memory which
+   * has never been accessed, or a buffer released earlier. Throws a
+   * MemoryAllocationError on failure. */
+  virtual void *
+  Allocate(SizeValueType numberOfBytes) = 0;
+
+  /** Releases a buffer returned by Allocate(numberOfBytes). */
+  virtual void
+  Deallocate(void * buffer, SizeValueType numberOfBytes) = 0;
+
+  /** Alignment, in bytes, of the buffers returned by Allocate(). The default
+   * implementation returns the alignment guaranteed by operator new. */
+  virtual SizeValueType
+  GetAlignment() const;
+
+  /** Whether writing to a buffer returned by this allocator is not allowed,
+   * as for read-only memory mappings. In-place filters then allocate their
+   * output instead of reusing the buffer of their input. The default
+   * implementation returns false. */
+  virtual bool
+  IsBufferReadOnly(const void * buffer) const;
+
+  /** Set/Get the allocator used by the containers which have none set. The
+   * default is nullptr, meaning that new[] and delete[] are used. */
+  /** @ITKStartGrouping */
+  static void
+  SetGlobalDefaultAllocator(ImageBufferAllocator * allocator);
+  static Pointer
+  GetGlobalDefaultAllocator();
+  /** @ITKEndGrouping */
+
+protected:
+  ImageBufferAllocator() = default;
+  ~ImageBufferAllocator() override = default;
+
+private:
+  itkGetGlobalDeclarationMacro(ImageBufferAllocatorGlobals, PimplGlobals);
+  static ImageBufferAllocatorGlobals * m_PimplGlobals;
+};
+
+} // end namespace itk
+
+#endif
@@ -18,6 +18,8 @@
 #ifndef itkImportImageContainer_h
 #define itkImportImageContainer_h
 
+#include "itkImageBufferAllocator.h"
+#include "itkImportImageContainerCommon.h"
 #include "itkObject.h"
 #include "itkObjectFactory.h"
 #include <utility>
@@ -36,6 +38,11 @@ namespace itk
  *
  * \tparam TElement The element type stored in the container.
  *
+ * The pages of the buffers it allocates are placed according to the global
+ * allocation policy, see ImportImageContainerCommon. The buffers of trivial
+ * elements are obtained from the buffer allocator of the container if set, or
+ * else from the global default allocator, see ImageBufferAllocator.
+ *
  * \ingroup ImageObjects
  * \ingroup IOFilters
  * \ingroup ITKCommon
@@ -79,6 +86,12 @@ public:
   void
   SetImportPointer(TElement * ptr, TElementIdentifier num, bool LetContainerManageMemory = false);
 
+  /** Set the pointer from which the image data is imported, letting this
+   * class manage the memory: "ptr" must have been provided by "allocator",
+   * for "num" pixels, and is released by it when it is no longer used. */
+  void
+  SetImportPointer(TElement * ptr, TElementIdentifier num, ImageBufferAllocator * allocator);
+
   /** Index operator. This version can be an lvalue. */
   TElement &
   operator[](const ElementIdentifier id)
@@ -160,6 +173,35 @@ public:
   itkGetConstMacro(ContainerManageMemory, bool);
   itkBooleanMacro(ContainerManageMemory);
   /** @ITKEndGrouping */
+
+  /** Set/Get the allocator of the buffers subsequently allocated by this
+   * container. If nullptr (the default), ImageBufferAllocator::GetGlobalDefaultAllocator()
+   * is used. The current buffer is still released through the allocator
+   * which provided it. */
+  /** @ITKStartGrouping */
+  itkSetObjectMacro(BufferAllocator, ImageBufferAllocator);
+  itkGetModifiableObjectMacro(BufferAllocator, ImageBufferAllocator);
+  /** @ITKEndGrouping */
+
+  /** Alignment, in bytes, guaranteed for the current buffer: the alignment
+   * the buffer allocator which provided it had when allocating it, or else
+   * alignof(TElement). Later changes of the allocator settings do not affect it.
+   * Vectorized code may use aligned loads and stores accordingly.
+   * \sa AlignedImageBufferAllocator */
+  SizeValueType
+  GetBufferAlignment() const;
+
+  /** Allocator which provided the current buffer, or nullptr if it was
+   * allocated with new[] or imported without an allocator. */
+  itkGetConstObjectMacro(ImportPointerAllocator, ImageBufferAllocator);
+
+  /** Whether the current buffer must not be written to, as reported by the
+   * allocator which provided it. \sa ImageBufferAllocator::IsBufferReadOnly() */
+  bool
+  IsBufferReadOnly() const
+  {
+    return m_ImportPointerAllocator && m_ImportPointerAllocator->IsBufferReadOnly(m_ImportPointer);
+  }
 protected:
   ImportImageContainer() = default;
   ~ImportImageContainer() override;
@@ -172,7 +214,10 @@ protected:
 
   /**
    * Allocates elements of the array.  If UseValueInitialization is true, then
-   * POD types will be zero-initialized.
+   * POD types will be zero-initialized. Large buffers of trivial elements are
+   * first accessed according to ImportImageContainerCommon::GetGlobalAllocationPolicy().
+   * The container only calls it when no ImageBufferAllocator provides the
+   * buffer, see SetBufferAllocator().
    */
   virtual TElement *
   AllocateElements(ElementIdentifier size, bool UseValueInitialization = false) const;
@@ -204,6 +249,7 @@ protected:
   SetImportPointer(TElement * ptr)
   {
     m_ImportPointer = ptr;
+    m_BufferAlignment = alignof(TElement);
   }
 
 private:
@@ -211,6 +257,34 @@ private:
   TElementIdentifier m_Size{};
   TElementIdentifier m_Capacity{};
   bool               m_ContainerManageMemory{ true };
+
+  ImageBufferAllocator::Pointer m_BufferAllocator{};
+
+  /** Allocator which provided m_ImportPointer, or nullptr if it was
+   * allocated with new[]. */
+  ImageBufferAllocator::Pointer m_ImportPointerAllocator{};
+
+  /** Alignment of m_ImportPointer, as returned by GetBufferAlignment(). */
+  SizeValueType m_BufferAlignment{ alignof(TElement) };
+
+  /** A buffer, with the allocator which provided it, or nullptr if it was
+   * allocated with new[], and the alignment it is guaranteed to have. */
+  struct AllocatedBuffer
+  {
+    TElement *                    Pointer;
+    ImageBufferAllocator::Pointer Allocator;
+    SizeValueType                 Alignment;
+  };
+
+  /** Allocates a buffer of size elements with the buffer allocator, when
+   * there is one for TElement, or else with AllocateElements(). */
+  AllocatedBuffer
+  AllocateBuffer(ElementIdentifier size, bool UseValueInitialization) const;
+
+  /** Alignment of buffer, which its allocator provides aligned on at least
+   * allocatorAlignment bytes when the settings are not changed concurrently. */
+  static SizeValueType
+  GetAlignmentOfBuffer(const TElement * buffer, SizeValueType allocatorAlignment);
 };
 } // end namespace itk
 
@@ -29,6 +29,10 @@
 #define itkImportImageContainer_hxx
 
 #include <algorithm> // For copy_n.
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
 
 namespace itk
 {
@@ -53,13 +57,15 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   {
     if (size > m_Capacity)
     {
-      TElement * temp = this->AllocateElements(size, UseValueInitialization);
+      AllocatedBuffer temp = this->AllocateBuffer(size, UseValueInitialization);
       // only copy the portion of the data used in the old buffer
-      std::copy_n(m_ImportPointer, m_Size, temp);
+      std::copy_n(m_ImportPointer, m_Size, temp.Pointer);
 
       DeallocateManagedMemory();
 
-      m_ImportPointer = temp;
+      m_ImportPointer = temp.Pointer;
+      m_ImportPointerAllocator = std::move(temp.Allocator);
+      m_BufferAlignment = temp.Alignment;
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -73,7 +79,10 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   }
   else
   {
-    m_ImportPointer = this->AllocateElements(size, UseValueInitialization);
+    AllocatedBuffer buffer = this->AllocateBuffer(size, UseValueInitialization);
+    m_ImportPointer = buffer.Pointer;
+    m_ImportPointerAllocator = std::move(buffer.Allocator);
+    m_BufferAlignment = buffer.Alignment;
     m_Capacity = size;
     m_Size = size;
     m_ContainerManageMemory = true;
@@ -94,12 +103,14 @@ ImportImageContainer<TElementIdentifier, TElement>::Squeeze()
     if (m_Size < m_Capacity)
     {
       const TElementIdentifier size = m_Size;
-      TElement *               temp = this->AllocateElements(size, false);
-      std::copy_n(m_ImportPointer, m_Size, temp);
+      AllocatedBuffer temp = this->AllocateBuffer(size, false);
+      std::copy_n(m_ImportPointer, m_Size, temp.Pointer);
 
       DeallocateManagedMemory();
 
-      m_ImportPointer = temp;
+      m_ImportPointer = temp.Pointer;
+      m_ImportPointerAllocator = std::move(temp.Allocator);
+      m_BufferAlignment = temp.Alignment;
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -150,6 +161,59 @@ ImportImageContainer<TElementIdentifier, TElement>::SetImportPointer(TElement *
   this->Modified();
 }
 
+template <typename TElementIdentifier, typename TElement>
+void
+ImportImageContainer<TElementIdentifier, TElement>::SetImportPointer(TElement *             ptr,
+                                                                     TElementIdentifier     num,
+                                                                     ImageBufferAllocator * allocator)
+{
+  DeallocateManagedMemory();
+  m_ImportPointer = ptr;
+  m_ImportPointerAllocator = allocator;
+  m_BufferAlignment = allocator ? GetAlignmentOfBuffer(ptr, allocator->GetAlignment()) : alignof(TElement);
+  m_ContainerManageMemory = true;
+  m_Capacity = num;
+  m_Size = num;
+
+  this->Modified();
+}
+
+template <typename TElementIdentifier, typename TElement>
+auto
+ImportImageContainer<TElementIdentifier, TElement>::AllocateBuffer(ElementIdentifier size,
+                                                                   bool UseValueInitialization) const -> AllocatedBuffer
+{
+  // Buffers of trivial elements are obtained from the buffer allocator, if any
+  ImageBufferAllocator::Pointer allocator{};
+  if constexpr (std::is_trivial_v<TElement>)
+  {
+    allocator = m_BufferAllocator ? m_BufferAllocator : ImageBufferAllocator::GetGlobalDefaultAllocator();
+  }
+  const SizeValueType allocatorAlignment = allocator ? allocator->GetAlignment() : 0;
+  if (alignof(TElement) > allocatorAlignment)
+  {
+    return { this->AllocateElements(size, UseValueInitialization), nullptr, alignof(TElement) };
+  }
+
+  // The pages of a large buffer are not accessed by its allocation, so that
+  // they can be placed according to the allocation policy
+  const SizeValueType numberOfBytes = static_cast<SizeValueType>(size) * sizeof(TElement);
+  const bool          placeBuffer = ImportImageContainerCommon::IsGlobalAllocationPolicyApplicable(numberOfBytes);
+
+  // Throws a MemoryAllocationError on failure
+  auto * const data = static_cast<TElement *>(allocator->Allocate(numberOfBytes));
+  if (UseValueInitialization && !placeBuffer)
+  {
+    // The buffer may have been released earlier, with another content
+    std::memset(static_cast<void *>(data), 0, numberOfBytes);
+  }
+  if (placeBuffer)
+  {
+    ImportImageContainerCommon::PlaceBuffer(data, numberOfBytes, UseValueInitialization);
+  }
+  return { data, std::move(allocator), GetAlignmentOfBuffer(data, allocatorAlignment) };
+}
+
 template <typename TElementIdentifier, typename TElement>
 TElement *
 ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIdentifier size,
@@ -157,9 +221,15 @@ ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIden
 {
   TElement * data = nullptr;
 
+  // The pages of a buffer of trivial elements are not accessed by its
+  // allocation, so that they can be placed according to the allocation policy
+  const SizeValueType numberOfBytes = static_cast<SizeValueType>(size) * sizeof(TElement);
+  const bool          placeBuffer =
+    std::is_trivial_v<TElement> && ImportImageContainerCommon::IsGlobalAllocationPolicyApplicable(numberOfBytes);
+
   try
   {
-    if (UseValueInitialization)
+    if (UseValueInitialization && !placeBuffer)
     {
       data = new TElement[size]();
     }
@@ -178,6 +248,10 @@ ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIden
     // of memory.  Do not use the exception macro.
     throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
   }
+  if (placeBuffer)
+  {
+    ImportImageContainerCommon::PlaceBuffer(data, numberOfBytes, UseValueInitialization);
+  }
   return data;
 }
 
@@ -188,13 +262,45 @@ ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
   // Encapsulate all image memory deallocation here
   if (m_ContainerManageMemory)
   {
-    delete[] m_ImportPointer;
+    if (m_ImportPointerAllocator)
+    {
+      m_ImportPointerAllocator->Deallocate(m_ImportPointer, static_cast<SizeValueType>(m_Capacity) * sizeof(TElement));
+    }
+    else
+    {
+      delete[] m_ImportPointer;
+    }
   }
+  m_ImportPointerAllocator = nullptr;
+  m_BufferAlignment = alignof(TElement);
   m_ImportPointer = nullptr;
   m_Capacity = 0;
   m_Size = 0;
 }
 
+template <typename TElementIdentifier, typename TElement>
+SizeValueType
+ImportImageContainer<TElementIdentifier, TElement>::GetBufferAlignment() const
+{
+  return m_BufferAlignment;
+}
+
+template <typename TElementIdentifier, typename TElement>
+SizeValueType
+ImportImageContainer<TElementIdentifier, TElement>::GetAlignmentOfBuffer(const TElement * buffer,
+                                                                         SizeValueType    allocatorAlignment)
+{
+  // The settings of the allocator may have been changed between the query of
+  // its alignment and the allocation: only report what the address ensures
+  const auto    address = reinterpret_cast<std::uintptr_t>(buffer);
+  SizeValueType alignment = std::max<SizeValueType>(allocatorAlignment, alignof(TElement));
+  while (alignment > alignof(TElement) && address % alignment != 0)
+  {
+    alignment /= 2;
+  }
+  return alignment;
+}
+
 template <typename TElementIdentifier, typename TElement>
 void
 ImportImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream & os, Indent indent) const
@@ -205,6 +311,8 @@ ImportImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream & os,
   os << indent << "Container manages memory: " << (m_ContainerManageMemory ? "true" : "false") << std::endl;
   os << indent << "Size: " << m_Size << std::endl;
   os << indent << "Capacity: " << m_Capacity << std::endl;
+  os << indent << "BufferAlignment: " << this->GetBufferAlignment() << std::endl;
+  itkPrintSelfObjectMacro(BufferAllocator);
 }
 } // end namespace itk
 
@@ -0,0 +1,95 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImportImageContainerCommon_h
+#define itkImportImageContainerCommon_h
+
+#include "ITKCommonExport.h"
+#include "itkCommonEnums.h"
+#include "itkIntTypes.h"
+#include "itkSingletonMacro.h"
+
+namespace itk
+{
+
+struct ImportImageContainerCommonGlobals;
+
+/** \class ImportImageContainerCommon
+ * \brief Settings and helpers common to all the ImportImageContainer templates
+ *
+ * This class holds the global allocation policy of the pixel buffers. By
+ * default, the pages of a buffer are placed on the NUMA node of the thread
+ * which first accesses them, typically the one which allocates (and maybe
+ * zero-initializes) the buffer. On multi-socket systems, the threads which
+ * then process the image read most of it across the interconnect.
+ *
+ * With the ParallelFirstTouch policy, a freshly allocated buffer is first
+ * accessed by the work units of a multi-threader, each one in a contiguous
+ * chunk. The chunks follow the linear layout of the buffer, like the regions
+ * ImageRegionSplitterSlowDimension gives to the work units of a filter, so
+ * that the pages end up close to the threads which process them. The
+ * NUMAInterleave policy spreads the pages evenly among the NUMA nodes
+ * instead, for buffers which are accessed from all the threads.
+ *
+ * The policy only applies to buffers of trivial element types, whose size is
+ * at least GetGlobalAllocationPolicyMinimumBufferSize() bytes.
+ *
+ * \ingroup ITKCommon
+ */
+struct ITKCommon_EXPORT ImportImageContainerCommon
+{
+  using AllocationPolicyEnum = ImportImageContainerEnums::AllocationPolicy;
+
+  /** Set/Get the policy used to place the pages of the buffers allocated by
+   * ImportImageContainer. The default is AllocationPolicyEnum::Default. */
+  /** @ITKStartGrouping */
+  static void
+  SetGlobalAllocationPolicy(AllocationPolicyEnum policy);
+  static AllocationPolicyEnum
+  GetGlobalAllocationPolicy();
+  /** @ITKEndGrouping */
+
+  /** Set/Get the size, in bytes, of the smallest buffer to which the
+   * allocation policy applies. Smaller buffers are not worth the cost of
+   * dispatching work units. The default is 1 MiB. */
+  /** @ITKStartGrouping */
+  static void
+  SetGlobalAllocationPolicyMinimumBufferSize(SizeValueType numberOfBytes);
+  static SizeValueType
+  GetGlobalAllocationPolicyMinimumBufferSize();
+  /** @ITKEndGrouping */
+
+  /** Returns whether the global allocation policy applies to a buffer of the
+   * specified size. */
+  static bool
+  IsGlobalAllocationPolicyApplicable(SizeValueType numberOfBytes);
+
+  /** Places the pages of a freshly allocated buffer, which must not have
+   * been accessed yet, according to the global allocation policy. The whole
+   * buffer is zero-filled if zeroFill is true, otherwise a single byte is
+   * written per page. */
+  static void
+  PlaceBuffer(void * buffer, SizeValueType numberOfBytes, bool zeroFill);
+
+private:
+  itkGetGlobalDeclarationMacro(ImportImageContainerCommonGlobals, PimplGlobals);
+  static ImportImageContainerCommonGlobals * m_PimplGlobals;
+};
+
+} // end namespace itk
+
+#endif
@@ -75,7 +75,9 @@ InPlaceImageFilter<TInputImage, TOutputImage>::InternalAllocateOutputs()
   {
     rMatch = false;
   }
-  if (inputPtr != nullptr && this->GetInPlace() && this->CanRunInPlace() && rMatch)
+  // A read-only buffer, as memory mapped by ImageFileReader, cannot be reused
+  if (inputPtr != nullptr && this->GetInPlace() && this->CanRunInPlace() && rMatch &&
+      !inputPtr->GetPixelContainer()->IsBufferReadOnly())
   {
     // Graft this first input to the output.  Later, we'll need to
     // remove the input's hold on the bulk data.
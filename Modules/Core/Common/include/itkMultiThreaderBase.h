@@ -64,7 +64,8 @@ public:
     First = Platform,
     Pool,
     TBB,
-    Last = TBB,
+    WorkStealing,
+    Last = WorkStealing,
     Unknown = -1
   };
 
@@ -168,6 +169,7 @@ public:
   static constexpr ThreaderEnum First = ThreaderEnum::First;
   static constexpr ThreaderEnum Pool = ThreaderEnum::Pool;
   static constexpr ThreaderEnum TBB = ThreaderEnum::TBB;
+  static constexpr ThreaderEnum WorkStealing = ThreaderEnum::WorkStealing;
   static constexpr ThreaderEnum Last = ThreaderEnum::Last;
   static constexpr ThreaderEnum Unknown = ThreaderEnum::Unknown;
 #endif
@@ -188,6 +190,8 @@ public:
         return "Pool";
       case ThreaderEnum::TBB:
         return "TBB";
+      case ThreaderEnum::WorkStealing:
+        return "WorkStealing";
       case ThreaderEnum::Unknown:
       default:
         return "Unknown";
@@ -431,6 +435,48 @@ ITK_GCC_PRAGMA_DIAG_POP()
                          ThreadingFunctorType funcP,
                          ProcessObject *      filter);
 
+  /** Scheduling context of the calling thread: the number of nested work
+   * units it is currently executing. Zero when called from outside of any
+   * parallel section, one from within a work unit of an outermost parallel
+   * section (e.g. from DynamicThreadedGenerateData), two or more when a
+   * filter is updated from within a work unit of another filter. */
+  static ThreadIdType
+  GetWorkUnitNestingLevel();
+
+  /** Approximate number of threads of the process which are currently
+   * executing work units, over all the multi-threader instances. */
+  static ThreadIdType
+  GetGlobalNumberOfBusyThreads();
+
+  /** Number of work units a parallel section started by the calling thread
+   * should use, given that numberOfWorkUnits were requested. For an
+   * outermost section, numberOfWorkUnits is returned unchanged. For a nested
+   * section, it is limited to the number of idle threads (as estimated by
+   * GetGlobalDefaultNumberOfThreads() - GetGlobalNumberOfBusyThreads()) plus
+   * the calling thread itself, so that inner pipelines started from within
+   * worker threads do not oversubscribe the cores. A result of 1 means that
+   * the nested section should run inline on the calling thread. */
+  static ThreadIdType
+  GetNumberOfWorkUnitsForCallingThread(ThreadIdType numberOfWorkUnits);
+
+  /** \class WorkUnitScope
+   * \brief Marks the execution of a work unit by the calling thread.
+   *
+   * Multi-threader implementations create one around each work unit they
+   * execute (including the one executed by the thread which starts the
+   * parallel section), which maintains GetWorkUnitNestingLevel() and
+   * GetGlobalNumberOfBusyThreads(). Code running its own threads can use it
+   * too, so that the parallel sections it nests are scheduled accordingly.
+   * \ingroup ITKCommon */
+  class ITKCommon_EXPORT WorkUnitScope
+  {
+  public:
+    ITK_DISALLOW_COPY_AND_MOVE(WorkUnitScope);
+
+    WorkUnitScope();
+    ~WorkUnitScope();
+  };
+
 protected:
   MultiThreaderBase();
   ~MultiThreaderBase() override;
@@ -0,0 +1,166 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPooledImageBufferAllocator_h
+#define itkPooledImageBufferAllocator_h
+
+#include "itkAlignedImageBufferAllocator.h"
+#include "itkObjectFactory.h"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace itk
+{
+
+/** \class PooledImageBufferAllocator
+ * \brief Image buffer allocator which keeps the released buffers for reuse.
+ *
+ * When a pipeline is updated again, each of its images typically releases
+ * its buffer and then allocates one of the same size. For large buffers,
+ * the system allocator maps fresh pages each time, which are then faulted
+ * in and zeroed again by the kernel. This allocator instead keeps the large
+ * buffers it releases, and hands them out again for requests of the same
+ * size class.
+ *
+ * Requests are rounded up to size classes, eight per power of two, so that
+ * at most 12.5% of a buffer is wasted. At most GetMaximumNumberOfCachedBytes()
+ * bytes are kept: beyond, the least recently released buffers are freed.
+ * Buffers smaller than GetMinimumPooledBufferSize() are neither rounded nor
+ * kept, as the system allocator already handles them efficiently.
+ *
+ * The buffers are aligned, and backed by huge pages, as set in the
+ * superclass. A kept buffer is only reused if it is aligned as currently set.
+ *
+ * To use it for all the images:
+   \code
+   itk::ImageBufferAllocator::SetGlobalDefaultAllocator(itk::PooledImageBufferAllocator::New());
+   \endcode
+ *
+ * \ingroup ImageObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PooledImageBufferAllocator : public AlignedImageBufferAllocator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PooledImageBufferAllocator);
+
+  /** Standard class type aliases. */
+  using Self = PooledImageBufferAllocator;
+  using Superclass = AlignedImageBufferAllocator;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(PooledImageBufferAllocator);
+
+  void *
+  Allocate(SizeValueType numberOfBytes) override;
+
+  void
+  Deallocate(void * buffer, SizeValueType numberOfBytes) override;
+
+  /** Set/Get the maximum number of bytes kept in released buffers.
+   * Lowering it frees the least recently released buffers in excess.
+   * The default is 1 GiB. */
+  /** @ITKStartGrouping */
+  void
+  SetMaximumNumberOfCachedBytes(SizeValueType numberOfBytes);
+  SizeValueType
+  GetMaximumNumberOfCachedBytes() const;
+  /** @ITKEndGrouping */
+
+  /** Set/Get the size of the smallest buffer which is kept for reuse.
+   * It may be changed while buffers are allocated: these are still
+   * released with the size they were allocated with. The default is 1 MiB. */
+  /** @ITKStartGrouping */
+  void
+  SetMinimumPooledBufferSize(SizeValueType numberOfBytes);
+  SizeValueType
+  GetMinimumPooledBufferSize() const;
+  /** @ITKEndGrouping */
+
+  /** Number of bytes, and of buffers, currently kept for reuse. */
+  /** @ITKStartGrouping */
+  SizeValueType
+  GetNumberOfCachedBytes() const;
+  SizeValueType
+  GetNumberOfCachedBuffers() const;
+  /** @ITKEndGrouping */
+
+  /** Number of allocations served with a released buffer, since creation. */
+  SizeValueType
+  GetNumberOfReusedBuffers() const;
+
+  /** Frees all the buffers kept for reuse. */
+  void
+  ReleaseCachedBuffers();
+
+  /** Size class of a request of numberOfBytes bytes, which is the actual
+   * size of the buffers allocated for it. */
+  SizeValueType
+  GetBufferSize(SizeValueType numberOfBytes) const;
+
+protected:
+  PooledImageBufferAllocator() = default;
+  ~PooledImageBufferAllocator() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  struct CachedBuffer
+  {
+    void *        Buffer;
+    SizeValueType Size;
+  };
+
+  /** Removes the least recently released buffers until at most
+   * numberOfBytes bytes are kept, and returns them, to be freed once
+   * m_Mutex is unlocked. Must be called with m_Mutex locked. */
+  std::list<CachedBuffer>
+  TrimCache(SizeValueType numberOfBytes);
+
+  void
+  FreeBuffers(const std::list<CachedBuffer> & buffers);
+
+  static SizeValueType
+  ComputeBufferSize(SizeValueType numberOfBytes, SizeValueType minimumPooledBufferSize);
+
+  mutable std::mutex m_Mutex;
+
+  /** Settings, guarded by m_Mutex. */
+  SizeValueType m_MaximumNumberOfCachedBytes{ SizeValueType{ 1 } << 30 };
+  SizeValueType m_MinimumPooledBufferSize{ SizeValueType{ 1 } << 20 };
+
+  /** Released buffers, the most recently released first. */
+  std::list<CachedBuffer> m_CachedBuffers; // guarded by m_Mutex
+  SizeValueType           m_NumberOfCachedBytes{ 0 };
+  SizeValueType           m_NumberOfReusedBuffers{ 0 };
+
+  /** Actual size of the outstanding buffers which may be pooled on release,
+   * as the settings may have changed since they were allocated. */
+  std::unordered_map<void *, SizeValueType> m_AllocatedBufferSizes; // guarded by m_Mutex
+};
+
+} // end namespace itk
+
+#endif
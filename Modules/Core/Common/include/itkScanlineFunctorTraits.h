@@ -0,0 +1,106 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkScanlineFunctorTraits_h
+#define itkScanlineFunctorTraits_h
+
+#include "itkDefaultPixelAccessor.h"
+#include "itkIntTypes.h"
+
+#include <type_traits>
+
+namespace itk::Functor
+{
+/** Tells whether the pixels of a line of an image of type TImage are stored
+ * one after the other in its buffer, and are read and written without
+ * conversion, so that the line can be accessed as a plain array of
+ * TImage::PixelType. This is the case of itk::Image, but not of image
+ * adaptors or of itk::VectorImage.
+ *
+ * \ingroup ITKCommon
+ */
+template <typename TImage>
+constexpr bool HasContiguousScanlines_v =
+  std::is_same_v<typename TImage::AccessorType, DefaultPixelAccessor<typename TImage::PixelType>>;
+
+/** Tells whether a functor processes whole scanlines, in addition to single
+ * pixels. Such a functor provides an overload of the form
+ *
+ * \code
+ *   void operator()(const TInputPixel1 * input1, ..., TOutputPixel * output, SizeValueType numberOfPixels) const;
+ * \endcode
+ *
+ * which computes output[i] from input1[i], ... for i in [0, numberOfPixels),
+ * exactly as the pixel overload would. The arrays do not partially overlap,
+ * but the output may be one of the inputs when a filter runs in place.
+ * Writing this overload as a plain loop over the arrays lets the compiler
+ * vectorize it, which it rarely does for a loop over image iterators.
+ *
+ * The functor filters call this overload once per line when all their
+ * images satisfy HasContiguousScanlines_v, and the pixel overload otherwise.
+ *
+ * \ingroup ITKCommon
+ */
+template <typename TFunctor, typename TOutputPixel, typename... TInputPixels>
+constexpr bool IsScanlineFunctor_v =
+  std::is_invocable_v<const TFunctor &, const TInputPixels *..., TOutputPixel *, SizeValueType>;
+
+/** Computes output[i] = functor(inputs[i]...) for i in [0, numberOfPixels),
+ * which is what the scanline overload of most functors does.
+ *
+ * \ingroup ITKCommon
+ */
+template <typename TFunctor, typename TOutputPixel, typename... TInputPixels>
+inline void
+ApplyToScanline(const TFunctor &      functor,
+                TOutputPixel *        output,
+                SizeValueType         numberOfPixels,
+                const TInputPixels *... inputs)
+{
+  for (SizeValueType i = 0; i < numberOfPixels; ++i)
+  {
+    output[i] = static_cast<TOutputPixel>(functor(inputs[i]...));
+  }
+}
+
+/** \class ScanlineFunctor
+ * \brief Base class giving a pixel functor its scanline overload.
+ *
+ * A functor TFunctor computing a TOutputPixel from TInputPixels... derives
+ * from ScanlineFunctor<TFunctor, TOutputPixel, TInputPixels...> to process
+ * whole scanlines with its pixel overload (see IsScanlineFunctor_v). As its
+ * own operator() hides the one of this class, it also declares
+ *
+ * \code
+ *   using ScanlineFunctor<TFunctor, TOutputPixel, TInputPixels...>::operator();
+ * \endcode
+ *
+ * \ingroup ITKCommon
+ */
+template <typename TFunctor, typename TOutputPixel, typename... TInputPixels>
+class ScanlineFunctor
+{
+public:
+  void
+  operator()(const TInputPixels *... inputs, TOutputPixel * output, SizeValueType numberOfPixels) const
+  {
+    ApplyToScanline(static_cast<const TFunctor &>(*this), output, numberOfPixels, inputs...);
+  }
+};
+} // namespace itk::Functor
+
+#endif
@@ -36,6 +36,11 @@ namespace itk
  * UnaryFunctorImageFilter (like the CastImageFilter) can be used
  * to promote a 2D image to a 3D image, etc.
  *
+ * When the functor also processes whole scanlines (see
+ * Functor::IsScanlineFunctor_v) and both images store their lines
+ * contiguously, the functor is called once per line of the output region
+ * rather than once per pixel.
+ *
  * \sa UnaryGeneratorImageFilter
  * \sa BinaryFunctorImageFilter TernaryFunctorImageFilter
  *
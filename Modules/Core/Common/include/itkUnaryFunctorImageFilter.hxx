@@ -19,6 +19,7 @@
 #define itkUnaryFunctorImageFilter_hxx
 
 #include "itkImageScanlineIterator.h"
+#include "itkScanlineFunctorTraits.h"
 #include "itkTotalProgressReporter.h"
 
 namespace itk
@@ -89,17 +90,33 @@ UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::DynamicThreadedGe
   ImageScanlineConstIterator inputIt(inputPtr, inputRegionForThread);
   ImageScanlineIterator      outputIt(outputPtr, outputRegionForThread);
 
-  while (!inputIt.IsAtEnd())
+  if constexpr (Functor::HasContiguousScanlines_v<TInputImage> && Functor::HasContiguousScanlines_v<TOutputImage> &&
+                Functor::IsScanlineFunctor_v<TFunction, OutputImagePixelType, InputImagePixelType>)
   {
-    while (!inputIt.IsAtEndOfLine())
+    // The functor processes whole lines, which lie contiguously in the buffers
+    const SizeValueType lineLength = outputRegionForThread.GetSize()[0];
+    while (!inputIt.IsAtEnd())
     {
-      outputIt.Set(m_Functor(inputIt.Get()));
-      ++inputIt;
-      ++outputIt;
+      m_Functor(&inputIt.Value(), &outputIt.Value(), lineLength);
+      inputIt.NextLine();
+      outputIt.NextLine();
+      progress.Completed(lineLength);
+    }
+  }
+  else
+  {
+    while (!inputIt.IsAtEnd())
+    {
+      while (!inputIt.IsAtEndOfLine())
+      {
+        outputIt.Set(m_Functor(inputIt.Get()));
+        ++inputIt;
+        ++outputIt;
+      }
+      inputIt.NextLine();
+      outputIt.NextLine();
+      progress.Completed(outputRegionForThread.GetSize()[0]);
     }
-    inputIt.NextLine();
-    outputIt.NextLine();
-    progress.Completed(outputRegionForThread.GetSize()[0]);
   }
 }
 } // end namespace itk
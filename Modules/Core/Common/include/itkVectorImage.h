@@ -51,6 +51,10 @@ namespace itk
  *
  * The API of this class is similar to Image.
  *
+ * The buffer is allocated by an ImportImageContainer, like the buffer of an
+ * Image. Its alignment is given by GetPixelContainer()->GetBufferAlignment(),
+ * see AlignedImageBufferAllocator.
+ *
  * \par Caveats:
  * When using Iterators on this image, you cannot use the it.Value(). You must use
  * Set/Get() methods instead.
@@ -0,0 +1,196 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWorkStealingThreadPool_h
+#define itkWorkStealingThreadPool_h
+
+#include "itkConfigure.h"
+#include "itkIntTypes.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkSingletonMacro.h"
+
+
+namespace itk
+{
+
+/**
+ * \class WorkStealingThreadPool
+ * \brief Thread pool in which every worker owns a double-ended job queue.
+ *
+ * Each worker thread pushes and pops jobs at the bottom of its own queue
+ * without taking a lock. Idle workers steal jobs from the top of the queues
+ * of the other workers using a single compare-and-swap, following the
+ * Chase-Lev algorithm as formulated for weak memory models by Le et al.
+ * (PPoPP 2013). Jobs submitted by threads which are not part of the pool go
+ * to a shared injection queue guarded by a mutex.
+ *
+ * A thread which waits for the completion of jobs (see HelpUntil) keeps
+ * executing pending jobs instead of blocking, so fork-join style algorithms
+ * can be nested arbitrarily without dead-locking the pool.
+ *
+ * The pool is used by WorkStealingMultiThreader. Initially it is started
+ * with GlobalDefaultNumberOfThreads workers.
+ *
+ * \ingroup OSSystemObjects
+ * \ingroup ITKCommon
+ */
+
+struct WorkStealingThreadPoolGlobals;
+
+class ITKCommon_EXPORT WorkStealingThreadPool : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WorkStealingThreadPool);
+
+  /** Standard class type aliases. */
+  using Self = WorkStealingThreadPool;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Type of the jobs executed by the pool. */
+  using JobType = std::function<void()>;
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(WorkStealingThreadPool);
+
+  /** Returns the global instance */
+  static Pointer
+  New();
+
+  /** Returns the global singleton instance of the WorkStealingThreadPool */
+  static Pointer
+  GetInstance();
+
+  /** Add this job to the pool. When called from one of the workers, the job
+   * is pushed onto that worker's own queue, otherwise onto the injection
+   * queue. The job must not throw: exceptions are to be captured and
+   * transported by the caller (see WorkStealingMultiThreader). */
+  void
+  AddWork(JobType job);
+
+  /** Execute pending jobs (own, stolen or injected) until done() returns
+   * true. If no job is available, the calling thread yields. */
+  void
+  HelpUntil(const std::function<bool()> & done);
+
+  /** Returns true if the queue of the calling worker is empty, meaning that
+   * all the jobs it has made available have been stolen. For threads outside
+   * the pool, the injection queue is examined. Used to split work on demand. */
+  bool
+  IsLocalQueueEmpty() const;
+
+  /** Returns true if the calling thread is one of the workers of this pool. */
+  static bool
+  IsWorkerThread();
+
+  /** Can call this method if we want to add extra threads to the pool. */
+  void
+  AddThreads(ThreadIdType count);
+
+  ThreadIdType
+  GetMaximumNumberOfThreads() const;
+
+  /** The approximate number of idle threads. */
+  int
+  GetNumberOfCurrentlyIdleThreads() const;
+
+protected:
+  WorkStealingThreadPool();
+
+  /** Stop the pool and release threads. To be called by the destructor and atfork. */
+  void
+  CleanUp();
+
+  ~WorkStealingThreadPool() override;
+
+  static void
+  PrepareForFork();
+  static void
+  ResumeFromFork();
+
+private:
+  /** Lock-free single-owner, multi-thief queue of a worker. */
+  class JobDeque;
+
+  /** Only used to synchronize the global variable across static libraries.*/
+  itkGetGlobalDeclarationMacro(WorkStealingThreadPoolGlobals, PimplGlobals);
+
+  /** Pops a job from the calling worker's own queue, steals one from
+   * another worker, or takes one from the injection queue. Returns nullptr
+   * when no job could be found. The caller takes ownership of the job. */
+  JobType *
+  FindJob(ThreadIdType self);
+
+  /** Executes and deletes the job. */
+  static void
+  RunJob(JobType * job);
+
+  /** Wakes up a sleeping worker, if there is any. */
+  void
+  NotifyIdleWorker();
+
+  /** The worker queues, one per thread. Never shrinks, so that a worker
+   * index stays valid for the lifetime of the pool. */
+  std::vector<std::unique_ptr<JobDeque>> m_Deques; // guarded by m_PimplGlobals->m_Mutex
+
+  /** Number of valid entries in m_Deques which can be stolen from. */
+  std::atomic<ThreadIdType> m_NumberOfDeques{ 0 };
+
+  /** Jobs submitted by threads outside of the pool. */
+  std::deque<JobType *> m_InjectionQueue; // guarded by m_PimplGlobals->m_Mutex
+
+  /** Size of m_InjectionQueue, readable without acquiring the mutex. */
+  std::atomic<SizeValueType> m_NumberOfInjectedJobs{ 0 };
+
+  /** Number of jobs in all the queues, used to put idle workers to sleep. */
+  std::atomic<SizeValueType> m_NumberOfQueuedJobs{ 0 };
+
+  /** Number of workers waiting on m_Condition. */
+  std::atomic<int> m_NumberOfSleepingThreads{ 0 };
+
+  /** Sleeping workers wait on m_Condition. AddWork signals it. */
+  std::condition_variable m_Condition;
+
+  /** Vector to hold all thread handles.
+   * Thread handles are used to delete (join) the threads. */
+  std::vector<std::thread> m_Threads; // guarded by m_PimplGlobals->m_Mutex
+
+  /* Has destruction started? */
+  std::atomic<bool> m_Stopping{ false };
+
+  /** To lock on the internal variables */
+  static WorkStealingThreadPoolGlobals * m_PimplGlobals;
+
+  /** The continuously running thread function */
+  static void
+  ThreadExecute(ThreadIdType self);
+};
+
+} // namespace itk
+#endif
@@ -0,0 +1,154 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkAlignedImageBufferAllocator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+namespace itk
+{
+
+namespace
+{
+// Advises the kernel to back the pages entirely contained in the buffer
+// with transparent huge pages. Failures are ignored, as it is only a hint.
+void
+AdviseHugePages(char * buffer, SizeValueType numberOfBytes)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  const auto pageSize = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+  const auto address = reinterpret_cast<std::uintptr_t>(buffer);
+  const auto begin = (address + pageSize - 1) / pageSize * pageSize;
+  const auto end = (address + numberOfBytes) / pageSize * pageSize;
+  if (end > begin)
+  {
+    madvise(reinterpret_cast<void *>(begin), end - begin, MADV_HUGEPAGE);
+  }
+#else
+  (void)buffer;
+  (void)numberOfBytes;
+#endif
+}
+} // namespace
+
+void *
+AlignedImageBufferAllocator::Allocate(SizeValueType numberOfBytes)
+{
+  // The block returned by operator new is enlarged by the alignment, to
+  // align the buffer within it. The address of the block is stored just
+  // before the buffer, so that it can be released whatever the alignment
+  // is by then.
+  const SizeValueType alignment = m_Alignment;
+  char * const        block = static_cast<char *>(::operator new(numberOfBytes + alignment, std::nothrow));
+  if (block == nullptr)
+  {
+    // We cannot construct an error string here because we may be out
+    // of memory.  Do not use the exception macro.
+    throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
+  }
+  const auto   blockAddress = reinterpret_cast<std::uintptr_t>(block);
+  char * const buffer = block + (alignment - blockAddress % alignment);
+  std::memcpy(buffer - sizeof(void *), &block, sizeof(void *));
+
+  if (m_UseHugePages && numberOfBytes >= m_HugePageMinimumBufferSize)
+  {
+    AdviseHugePages(buffer, numberOfBytes);
+  }
+  return buffer;
+}
+
+void
+AlignedImageBufferAllocator::Deallocate(void * buffer, SizeValueType itkNotUsed(numberOfBytes))
+{
+  if (buffer == nullptr)
+  {
+    return;
+  }
+  void * block = nullptr;
+  std::memcpy(&block, static_cast<char *>(buffer) - sizeof(void *), sizeof(void *));
+  ::operator delete(block);
+}
+
+void
+AlignedImageBufferAllocator::SetAlignment(SizeValueType alignment)
+{
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > 4096)
+  {
+    itkExceptionMacro("The alignment must be a power of two, at most 4096, but is " << alignment << '.');
+  }
+  alignment = std::max<SizeValueType>(alignment, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+  if (m_Alignment.exchange(alignment) != alignment)
+  {
+    this->Modified();
+  }
+}
+
+SizeValueType
+AlignedImageBufferAllocator::GetAlignment() const
+{
+  return m_Alignment;
+}
+
+void
+AlignedImageBufferAllocator::SetUseHugePages(bool useHugePages)
+{
+  if (m_UseHugePages.exchange(useHugePages) != useHugePages)
+  {
+    this->Modified();
+  }
+}
+
+bool
+AlignedImageBufferAllocator::GetUseHugePages() const
+{
+  return m_UseHugePages;
+}
+
+void
+AlignedImageBufferAllocator::SetHugePageMinimumBufferSize(SizeValueType numberOfBytes)
+{
+  if (m_HugePageMinimumBufferSize.exchange(numberOfBytes) != numberOfBytes)
+  {
+    this->Modified();
+  }
+}
+
+SizeValueType
+AlignedImageBufferAllocator::GetHugePageMinimumBufferSize() const
+{
+  return m_HugePageMinimumBufferSize;
+}
+
+void
+AlignedImageBufferAllocator::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Alignment: " << m_Alignment << std::endl;
+  os << indent << "UseHugePages: " << (m_UseHugePages ? "On" : "Off") << std::endl;
+  os << indent << "HugePageMinimumBufferSize: " << m_HugePageMinimumBufferSize << std::endl;
+}
+
+} // end namespace itk
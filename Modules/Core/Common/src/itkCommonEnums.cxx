@@ -164,6 +164,25 @@ operator<<(std::ostream & out, const CommonEnums::IOByteOrder value)
   }();
 }
 
+/** Print enum values */
+std::ostream &
+operator<<(std::ostream & out, const CommonEnums::IOMemoryMapping value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case CommonEnums::IOMemoryMapping::Off:
+        return "itk::CommonEnums::IOMemoryMapping::Off";
+      case CommonEnums::IOMemoryMapping::ReadOnly:
+        return "itk::CommonEnums::IOMemoryMapping::ReadOnly";
+      case CommonEnums::IOMemoryMapping::CopyOnWrite:
+        return "itk::CommonEnums::IOMemoryMapping::CopyOnWrite";
+      default:
+        return "INVALID VALUE FOR itk::CommonEnums::IOMemoryMapping";
+    }
+  }();
+}
+
 /** Print enum values */
 std::ostream &
 operator<<(std::ostream & out, const CommonEnums::CellGeometry value)
@@ -305,4 +324,23 @@ operator<<(std::ostream & out, const ObjectFactoryEnums::InsertionPosition value
     }
   }();
 }
+
+/** Print enum values */
+std::ostream &
+operator<<(std::ostream & out, const ImportImageContainerEnums::AllocationPolicy value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case ImportImageContainerEnums::AllocationPolicy::Default:
+        return "itk::ImportImageContainerEnums::AllocationPolicy::Default";
+      case ImportImageContainerEnums::AllocationPolicy::ParallelFirstTouch:
+        return "itk::ImportImageContainerEnums::AllocationPolicy::ParallelFirstTouch";
+      case ImportImageContainerEnums::AllocationPolicy::NUMAInterleave:
+        return "itk::ImportImageContainerEnums::AllocationPolicy::NUMAInterleave";
+      default:
+        return "INVALID VALUE FOR itk::ImportImageContainerEnums::AllocationPolicy";
+    }
+  }();
+}
 } // namespace itk
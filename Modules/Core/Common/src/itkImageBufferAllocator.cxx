@@ -0,0 +1,63 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferAllocator.h"
+#include "itkSingleton.h"
+
+#include <mutex>
+
+namespace itk
+{
+
+struct ImageBufferAllocatorGlobals
+{
+  std::mutex                    m_Mutex;
+  ImageBufferAllocator::Pointer m_GlobalDefaultAllocator{};
+};
+
+itkGetGlobalSimpleMacro(ImageBufferAllocator, ImageBufferAllocatorGlobals, PimplGlobals);
+ImageBufferAllocatorGlobals * ImageBufferAllocator::m_PimplGlobals;
+
+SizeValueType
+ImageBufferAllocator::GetAlignment() const
+{
+  return __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+}
+
+bool
+ImageBufferAllocator::IsBufferReadOnly(const void * itkNotUsed(buffer)) const
+{
+  return false;
+}
+
+void
+ImageBufferAllocator::SetGlobalDefaultAllocator(ImageBufferAllocator * allocator)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_GlobalDefaultAllocator = allocator;
+}
+
+ImageBufferAllocator::Pointer
+ImageBufferAllocator::GetGlobalDefaultAllocator()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_GlobalDefaultAllocator;
+}
+
+} // end namespace itk
@@ -0,0 +1,173 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImportImageContainerCommon.h"
+#include "itkMultiThreaderBase.h"
+#include "itkSingleton.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+namespace itk
+{
+
+struct ImportImageContainerCommonGlobals
+{
+  std::atomic<ImportImageContainerCommon::AllocationPolicyEnum> m_GlobalAllocationPolicy{
+    ImportImageContainerCommon::AllocationPolicyEnum::Default
+  };
+  std::atomic<SizeValueType> m_GlobalAllocationPolicyMinimumBufferSize{ 1024 * 1024 };
+};
+
+itkGetGlobalSimpleMacro(ImportImageContainerCommon, ImportImageContainerCommonGlobals, PimplGlobals);
+ImportImageContainerCommonGlobals * ImportImageContainerCommon::m_PimplGlobals;
+
+namespace
+{
+// Smallest page size of the supported platforms. Writing one byte every
+// touchStride bytes accesses every page at least once.
+constexpr SizeValueType touchStride = 4096;
+
+// Sets the memory policy of the pages entirely contained in the buffer to
+// interleave among the NUMA nodes the process is allowed to use. The call is
+// made directly, so that libnuma is not required. Returns false if the
+// policy could not be set, or if there is a single node.
+bool
+InterleavePages(char * buffer, SizeValueType numberOfBytes)
+{
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_get_mempolicy)
+  constexpr int           mpolInterleave = 3;         // MPOL_INTERLEAVE of <linux/mempolicy.h>
+  constexpr unsigned long mpolFMemsAllowed = 1UL << 2; // MPOL_F_MEMS_ALLOWED of <linux/mempolicy.h>
+  constexpr unsigned long maximumNumberOfNodes = 1024;
+  constexpr unsigned long bitsPerLong = 8 * sizeof(unsigned long);
+
+  unsigned long nodeMask[maximumNumberOfNodes / bitsPerLong]{};
+  int           mode = 0;
+  if (syscall(SYS_get_mempolicy, &mode, nodeMask, maximumNumberOfNodes, nullptr, mpolFMemsAllowed) != 0)
+  {
+    return false;
+  }
+  SizeValueType numberOfNodes = 0;
+  for (const unsigned long word : nodeMask)
+  {
+    numberOfNodes += std::bitset<bitsPerLong>(word).count();
+  }
+  if (numberOfNodes < 2)
+  {
+    return false;
+  }
+
+  // The first and last pages may be shared with other allocations
+  const auto pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  const auto begin = (reinterpret_cast<uintptr_t>(buffer) + pageSize - 1) / pageSize * pageSize;
+  const auto end = (reinterpret_cast<uintptr_t>(buffer) + numberOfBytes) / pageSize * pageSize;
+  if (begin >= end)
+  {
+    return false;
+  }
+  // The kernel ignores the last bit of the mask
+  return syscall(SYS_mbind, begin, end - begin, mpolInterleave, nodeMask, maximumNumberOfNodes + 1, 0) == 0;
+#else
+  (void)buffer;
+  (void)numberOfBytes;
+  return false;
+#endif
+}
+} // namespace
+
+void
+ImportImageContainerCommon::SetGlobalAllocationPolicy(AllocationPolicyEnum policy)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_GlobalAllocationPolicy = policy;
+}
+
+ImportImageContainerCommon::AllocationPolicyEnum
+ImportImageContainerCommon::GetGlobalAllocationPolicy()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_GlobalAllocationPolicy;
+}
+
+void
+ImportImageContainerCommon::SetGlobalAllocationPolicyMinimumBufferSize(SizeValueType numberOfBytes)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_GlobalAllocationPolicyMinimumBufferSize = numberOfBytes;
+}
+
+SizeValueType
+ImportImageContainerCommon::GetGlobalAllocationPolicyMinimumBufferSize()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_GlobalAllocationPolicyMinimumBufferSize;
+}
+
+bool
+ImportImageContainerCommon::IsGlobalAllocationPolicyApplicable(SizeValueType numberOfBytes)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_GlobalAllocationPolicy != AllocationPolicyEnum::Default &&
+         numberOfBytes >= m_PimplGlobals->m_GlobalAllocationPolicyMinimumBufferSize;
+}
+
+void
+ImportImageContainerCommon::PlaceBuffer(void * buffer, SizeValueType numberOfBytes, bool zeroFill)
+{
+  auto * const bytes = static_cast<char *>(buffer);
+  if (GetGlobalAllocationPolicy() == AllocationPolicyEnum::NUMAInterleave)
+  {
+    InterleavePages(bytes, numberOfBytes);
+  }
+
+  // Split the buffer in as many contiguous chunks as a filter has work units,
+  // aligned on page boundaries relative to the start of the buffer
+  const auto          multiThreader = MultiThreaderBase::New();
+  const SizeValueType numberOfChunks = std::max<SizeValueType>(multiThreader->GetNumberOfWorkUnits(), 1);
+  const SizeValueType numberOfPages = (numberOfBytes + touchStride - 1) / touchStride;
+  const SizeValueType chunkSize = (numberOfPages + numberOfChunks - 1) / numberOfChunks * touchStride;
+
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [bytes, numberOfBytes, chunkSize, zeroFill](SizeValueType chunk) {
+      const SizeValueType begin = std::min(chunk * chunkSize, numberOfBytes);
+      const SizeValueType end = std::min(begin + chunkSize, numberOfBytes);
+      if (zeroFill)
+      {
+        std::memset(bytes + begin, 0, end - begin);
+      }
+      else
+      {
+        for (SizeValueType offset = begin; offset < end; offset += touchStride)
+        {
+          bytes[offset] = 0;
+        }
+      }
+    },
+    nullptr);
+}
+
+} // end namespace itk
@@ -30,6 +30,7 @@
 
 #if defined(ITK_USE_POOL_MULTI_THREADER)
 #  include "itkPoolMultiThreader.h"
+#  include "itkWorkStealingMultiThreader.h"
 #endif
 #include "itkNumericTraits.h"
 #include <mutex>
@@ -89,8 +90,17 @@ struct MultiThreaderBaseGlobals
   //  m_GlobalMaximumNumberOfThreads and larger or equal to 1 once it has been
   //  initialized in the constructor of the first MultiThreaderBase instantiation.
   ThreadIdType m_GlobalDefaultNumberOfThreads{ 0 };
+
+  // Number of threads currently executing at least one work unit, see MultiThreaderBase::WorkUnitScope.
+  std::atomic<ThreadIdType> m_NumberOfBusyThreads{ 0 };
 };
 
+namespace
+{
+// Number of nested work units the calling thread is executing.
+thread_local ThreadIdType t_WorkUnitNestingLevel = 0;
+} // namespace
+
 itkGetGlobalSimpleMacro(MultiThreaderBase, MultiThreaderBaseGlobals, PimplGlobals);
 
 
@@ -207,6 +217,10 @@ MultiThreaderBase::ThreaderTypeFromString(std::string threaderString)
   {
     return ThreaderEnum::TBB;
   }
+  else if (threaderString == "WORKSTEALING")
+  {
+    return ThreaderEnum::WorkStealing;
+  }
   else
   {
     return ThreaderEnum::Unknown;
@@ -381,6 +395,53 @@ MultiThreaderBase::GetGlobalDefaultNumberOfThreadsByPlatform()
 #endif
 } // namespace itk
 
+ThreadIdType
+MultiThreaderBase::GetWorkUnitNestingLevel()
+{
+  return t_WorkUnitNestingLevel;
+}
+
+ThreadIdType
+MultiThreaderBase::GetGlobalNumberOfBusyThreads()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_NumberOfBusyThreads;
+}
+
+ThreadIdType
+MultiThreaderBase::GetNumberOfWorkUnitsForCallingThread(ThreadIdType numberOfWorkUnits)
+{
+  numberOfWorkUnits = std::max<ThreadIdType>(numberOfWorkUnits, 1);
+  if (t_WorkUnitNestingLevel == 0)
+  {
+    return numberOfWorkUnits; // outermost parallel section
+  }
+
+  // The calling thread is counted as busy, and takes part in the nested section
+  const ThreadIdType numberOfCores = GetGlobalDefaultNumberOfThreads();
+  const ThreadIdType numberOfBusyThreads = GetGlobalNumberOfBusyThreads();
+  const ThreadIdType numberOfIdleThreads =
+    numberOfCores > numberOfBusyThreads ? numberOfCores - numberOfBusyThreads : 0;
+  return std::min(numberOfWorkUnits, numberOfIdleThreads + 1);
+}
+
+MultiThreaderBase::WorkUnitScope::WorkUnitScope()
+{
+  if (t_WorkUnitNestingLevel++ == 0)
+  {
+    itkInitGlobalsMacro(PimplGlobals);
+    ++m_PimplGlobals->m_NumberOfBusyThreads;
+  }
+}
+
+MultiThreaderBase::WorkUnitScope::~WorkUnitScope()
+{
+  if (--t_WorkUnitNestingLevel == 0)
+  {
+    --m_PimplGlobals->m_NumberOfBusyThreads;
+  }
+}
+
 MultiThreaderBase::Pointer
 MultiThreaderBase::New()
 {
@@ -403,6 +464,12 @@ MultiThreaderBase::New()
         return TBBMultiThreader::New();
 #else
         itkGenericExceptionMacro("ITK has been built without TBB support!");
+#endif
+      case ThreaderEnum::WorkStealing:
+#if defined(ITK_USE_POOL_MULTI_THREADER)
+        return WorkStealingMultiThreader::New();
+#else
+        itkGenericExceptionMacro("ITK has been built without WorkStealingMultiThreader support!");
 #endif
       default:
         itkGenericExceptionMacro("MultiThreaderBase::GetGlobalDefaultThreader returned Unknown!");
@@ -427,6 +494,8 @@ MultiThreaderBase::SingleMethodProxy(void * arg)
   // grab the WorkUnitInfo originally prescribed
   auto * workUnitInfoStruct = static_cast<MultiThreaderBase::WorkUnitInfo *>(arg);
 
+  const WorkUnitScope workUnitScope;
+
   // execute the user specified threader callback, catching any exceptions
   try
   {
@@ -580,6 +649,7 @@ MultiThreaderBase::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "Global Maximum Number Of Threads: " << m_PimplGlobals->m_GlobalMaximumNumberOfThreads << std::endl;
   os << indent << "Global Default Number Of Threads: " << m_PimplGlobals->m_GlobalDefaultNumberOfThreads << std::endl;
   os << indent << "Global Default Threader Type: " << m_PimplGlobals->m_GlobalDefaultThreader << std::endl;
+  os << indent << "Global Number Of Busy Threads: " << m_PimplGlobals->m_NumberOfBusyThreads << std::endl;
   os << indent << "SingleMethod: " << m_SingleMethod << std::endl;
   os << indent << "SingleData: " << m_SingleData << std::endl;
 }
@@ -601,6 +671,8 @@ operator<<(std::ostream & out, const MultiThreaderBaseEnums::Threader value)
         return "itk::MultiThreaderBaseEnums::Threader::Pool";
       case MultiThreaderBaseEnums::Threader::TBB:
         return "itk::MultiThreaderBaseEnums::Threader::TBB";
+      case MultiThreaderBaseEnums::Threader::WorkStealing:
+        return "itk::MultiThreaderBaseEnums::Threader::WorkStealing";
         //      TODO    case MultiThreaderBaseEnums::Threader::Last:
         //                    return "itk::MultiThreaderBaseEnums::Threader::Last";
       case MultiThreaderBaseEnums::Threader::Unknown:
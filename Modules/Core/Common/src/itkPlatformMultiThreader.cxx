@@ -118,6 +118,9 @@ PlatformMultiThreader::SingleMethodExecute()
   // obey the global maximum number of threads limit
   m_NumberOfWorkUnits = std::min(MultiThreaderBase::GetGlobalMaximumNumberOfThreads(), m_NumberOfWorkUnits);
 
+  // do not oversubscribe the cores when nested within another parallel section
+  const ThreadIdType numberOfWorkUnits = GetNumberOfWorkUnitsForCallingThread(m_NumberOfWorkUnits);
+
   // Spawn a set of threads through the SingleMethodProxy. Exceptions
   // thrown from a thread will be caught by the SingleMethodProxy. A
   // naive mechanism is in place for determining whether a thread
@@ -129,10 +132,10 @@ PlatformMultiThreader::SingleMethodExecute()
   std::string exceptionDetails;
   try
   {
-    for (thread_loop = 1; thread_loop < m_NumberOfWorkUnits; ++thread_loop)
+    for (thread_loop = 1; thread_loop < numberOfWorkUnits; ++thread_loop)
     {
       m_ThreadInfoArray[thread_loop].UserData = m_SingleData;
-      m_ThreadInfoArray[thread_loop].NumberOfWorkUnits = m_NumberOfWorkUnits;
+      m_ThreadInfoArray[thread_loop].NumberOfWorkUnits = numberOfWorkUnits;
       m_ThreadInfoArray[thread_loop].ThreadFunction = m_SingleMethod;
 
       process_id[thread_loop] = this->SpawnDispatchSingleMethodThread(&m_ThreadInfoArray[thread_loop]);
@@ -159,14 +162,15 @@ PlatformMultiThreader::SingleMethodExecute()
   try
   {
     m_ThreadInfoArray[0].UserData = m_SingleData;
-    m_ThreadInfoArray[0].NumberOfWorkUnits = m_NumberOfWorkUnits;
+    m_ThreadInfoArray[0].NumberOfWorkUnits = numberOfWorkUnits;
+    const WorkUnitScope workUnitScope;
     m_SingleMethod((void *)(&m_ThreadInfoArray[0]));
   }
   catch (const ProcessAborted &)
   {
     // Need cleanup and rethrow ProcessAborted
     // close down other threads
-    for (thread_loop = 1; thread_loop < m_NumberOfWorkUnits; ++thread_loop)
+    for (thread_loop = 1; thread_loop < numberOfWorkUnits; ++thread_loop)
     {
       try
       {
@@ -195,7 +199,7 @@ PlatformMultiThreader::SingleMethodExecute()
   }
   // The parent thread has finished this->SingleMethod() - so now it
   // waits for each of the other processes to exit
-  for (thread_loop = 1; thread_loop < m_NumberOfWorkUnits; ++thread_loop)
+  for (thread_loop = 1; thread_loop < numberOfWorkUnits; ++thread_loop)
   {
     try
     {
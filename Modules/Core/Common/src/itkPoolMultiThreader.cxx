@@ -30,8 +30,13 @@
 #include "itkProcessObject.h"
 #include "itkImageSourceCommon.h"
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <exception>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
 
 namespace itk
@@ -40,31 +45,117 @@ namespace
 {
 std::chrono::milliseconds threadCompletionPollingInterval = std::chrono::milliseconds(10);
 
-class ExceptionHandler
+/** The jobs of one parallel section. The thread which starts the section
+ * executes itself the jobs which no pool thread has started yet, and only
+ * blocks on the ones being executed by other threads. A section nested
+ * within a work unit therefore never waits for jobs queued behind the work
+ * units of the enclosing section, which would dead-lock the pool. */
+class JobGroup
 {
 public:
-  // This class follows the rule of zero
+  using JobType = std::function<void()>;
 
-  template <typename TFunction>
+  explicit JobGroup(ThreadIdType numberOfJobs)
+    : m_Jobs(numberOfJobs)
+    , m_Started(std::make_unique<std::atomic<bool>[]>(numberOfJobs))
+  {}
+
+  void
+  SetJob(ThreadIdType job, JobType function)
+  {
+    m_Jobs[job] = std::move(function);
+  }
+
+  /** Executes the job, unless another thread has already started it. */
   void
-  TryAndCatch(const TFunction & function)
+  TryExecute(ThreadIdType job)
   {
+    if (m_Started[job].exchange(true))
+    {
+      return;
+    }
     try
     {
-      function();
+      const MultiThreaderBase::WorkUnitScope workUnitScope;
+      m_Jobs[job]();
     }
     catch (...)
     {
-      if (m_FirstCaughtException == nullptr)
-      {
-        m_FirstCaughtException = std::current_exception();
-      }
+      this->RecordException(std::current_exception());
     }
+
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    ++m_NumberOfCompletedJobs;
+    m_Condition.notify_all();
   }
 
+  /** Submits the jobs, except the first one, to the pool. */
+  static void
+  Submit(const std::shared_ptr<JobGroup> & group, ThreadPool * pool)
+  {
+    for (ThreadIdType job = 1; job < static_cast<ThreadIdType>(group->m_Jobs.size()); ++job)
+    {
+      // The pool keeps the group alive until all its jobs have been dequeued
+      pool->AddWork([group, job] { group->TryExecute(job); });
+    }
+  }
+
+  /** Executes the first job, then the jobs not started yet (starting from
+   * the last one, which the pool threads will reach last), then waits for
+   * the other ones to complete. The reporter is notified of each completed
+   * job, and the filter (if any) is polled while waiting. Finally rethrows
+   * the first caught exception, if any. */
   void
-  RethrowFirstCaughtException() const
+  Wait(ProcessObject * filter, ProgressReporter & reporter)
   {
+    ThreadIdType numberOfReportedJobs = 0;
+    const auto   reportProgress = [this, &numberOfReportedJobs, &reporter] {
+      try
+      {
+        for (const ThreadIdType numberOfCompletedJobs = this->GetNumberOfCompletedJobs();
+             numberOfReportedJobs < numberOfCompletedJobs;
+             ++numberOfReportedJobs)
+        {
+          reporter.CompletedPixel();
+        }
+      }
+      catch (...)
+      {
+        this->RecordException(std::current_exception());
+      }
+    };
+
+    const auto numberOfJobs = static_cast<ThreadIdType>(m_Jobs.size());
+    this->TryExecute(0);
+    reportProgress();
+    for (ThreadIdType job = numberOfJobs - 1; job > 0; --job)
+    {
+      this->TryExecute(job);
+      reportProgress();
+    }
+
+    // the jobs still running refer to the caller's data: wait for them even after an exception
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    while (m_NumberOfCompletedJobs < numberOfJobs)
+    {
+      const bool completed = m_Condition.wait_for(
+        lock, threadCompletionPollingInterval, [this, numberOfJobs] { return m_NumberOfCompletedJobs == numberOfJobs; });
+      lock.unlock();
+      reportProgress();
+      if (filter && !completed)
+      {
+        try
+        {
+          filter->IncrementProgress(0);
+        }
+        catch (...)
+        {
+          this->RecordException(std::current_exception());
+        }
+      }
+      lock.lock();
+    }
+
     if (m_FirstCaughtException != nullptr)
     {
       std::rethrow_exception(m_FirstCaughtException);
@@ -72,7 +163,29 @@ public:
   }
 
 private:
-  std::exception_ptr m_FirstCaughtException;
+  ThreadIdType
+  GetNumberOfCompletedJobs()
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    return m_NumberOfCompletedJobs;
+  }
+
+  void
+  RecordException(std::exception_ptr caughtException)
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    if (m_FirstCaughtException == nullptr)
+    {
+      m_FirstCaughtException = std::move(caughtException);
+    }
+  }
+
+  std::vector<JobType>                 m_Jobs;
+  std::unique_ptr<std::atomic<bool>[]> m_Started;
+  std::mutex                           m_Mutex;
+  std::condition_variable              m_Condition;
+  ThreadIdType                         m_NumberOfCompletedJobs{ 0 };
+  std::exception_ptr                   m_FirstCaughtException;
 };
 } // namespace
 
@@ -118,8 +231,6 @@ PoolMultiThreader::SetMaximumNumberOfThreads(ThreadIdType numberOfThreads)
 void
 PoolMultiThreader::SingleMethodExecute()
 {
-  ThreadIdType threadLoop = 0;
-
   if (!m_SingleMethod)
   {
     itkExceptionStringMacro("No single method set!");
@@ -128,27 +239,22 @@ PoolMultiThreader::SingleMethodExecute()
   // obey the global maximum number of threads limit
   m_NumberOfWorkUnits = std::min(this->GetGlobalMaximumNumberOfThreads(), m_NumberOfWorkUnits);
 
-  for (threadLoop = 1; threadLoop < m_NumberOfWorkUnits; ++threadLoop)
-  {
-    m_ThreadInfoArray[threadLoop].UserData = m_SingleData;
-    m_ThreadInfoArray[threadLoop].NumberOfWorkUnits = m_NumberOfWorkUnits;
-    m_ThreadInfoArray[threadLoop].Future = m_ThreadPool->AddWork(m_SingleMethod, &m_ThreadInfoArray[threadLoop]);
-  }
-
-  // Now, the parent thread calls this->SingleMethod() itself
-  m_ThreadInfoArray[0].UserData = m_SingleData;
-  m_ThreadInfoArray[0].NumberOfWorkUnits = m_NumberOfWorkUnits;
-  ExceptionHandler exceptionHandler;
-  exceptionHandler.TryAndCatch([this] { m_SingleMethod(&m_ThreadInfoArray[0]); });
+  // do not oversubscribe the cores when nested within another parallel section
+  const ThreadIdType numberOfWorkUnits = GetNumberOfWorkUnitsForCallingThread(m_NumberOfWorkUnits);
 
-  // The parent thread has finished SingleMethod()
-  // so now it waits for each of the other work units to finish
-  for (threadLoop = 1; threadLoop < m_NumberOfWorkUnits; ++threadLoop)
+  const auto group = std::make_shared<JobGroup>(numberOfWorkUnits);
+  for (ThreadIdType threadLoop = 0; threadLoop < numberOfWorkUnits; ++threadLoop)
   {
-    exceptionHandler.TryAndCatch([this, threadLoop] { m_ThreadInfoArray[threadLoop].Future.get(); });
+    m_ThreadInfoArray[threadLoop].UserData = m_SingleData;
+    m_ThreadInfoArray[threadLoop].NumberOfWorkUnits = numberOfWorkUnits;
+    group->SetJob(threadLoop, [this, threadLoop] { m_SingleMethod(&m_ThreadInfoArray[threadLoop]); });
   }
+  JobGroup::Submit(group, m_ThreadPool);
 
-  exceptionHandler.RethrowFirstCaughtException();
+  // Now, the parent thread calls this->SingleMethod() itself,
+  // then helps with, or waits for, the other work units
+  ProgressReporter reporter(nullptr, 0, numberOfWorkUnits);
+  group->Wait(nullptr, reporter);
 }
 
 void
@@ -164,55 +270,34 @@ PoolMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
 
   if (firstIndex + 1 < lastIndexPlus1)
   {
-    SizeValueType chunkSize = (lastIndexPlus1 - firstIndex) / m_NumberOfWorkUnits;
-    if ((lastIndexPlus1 - firstIndex) % m_NumberOfWorkUnits > 0)
-    {
-      ++chunkSize; // we want slightly bigger chunks to be processed first
-    }
+    // do not oversubscribe the cores when nested within another parallel section
+    const ThreadIdType numberOfWorkUnits = GetNumberOfWorkUnitsForCallingThread(m_NumberOfWorkUnits);
 
-    auto lambda = [aFunc](SizeValueType start, SizeValueType end) {
-      for (SizeValueType ii = start; ii < end; ++ii)
-      {
-        aFunc(ii);
-      }
-      // make this lambda have the same signature as m_SingleMethod
-      return ITK_THREAD_RETURN_DEFAULT_VALUE;
-    };
-
-    SizeValueType workUnit = 1;
-    for (SizeValueType i = firstIndex + chunkSize; i < lastIndexPlus1; i += chunkSize)
+    SizeValueType chunkSize = (lastIndexPlus1 - firstIndex) / numberOfWorkUnits;
+    if ((lastIndexPlus1 - firstIndex) % numberOfWorkUnits > 0)
     {
-      m_ThreadInfoArray[workUnit++].Future = m_ThreadPool->AddWork(lambda, i, std::min(i + chunkSize, lastIndexPlus1));
+      ++chunkSize; // we want slightly bigger chunks to be processed first
     }
-    itkAssertOrThrowMacro(workUnit <= m_NumberOfWorkUnits, "Number of work units was somehow miscounted!");
-
-    ProgressReporter reporter(filter, 0, workUnit);
-
-    // execute this thread's share
-    ExceptionHandler exceptionHandler;
-    exceptionHandler.TryAndCatch([lambda, firstIndex, chunkSize, &reporter] {
-      lambda(firstIndex, firstIndex + chunkSize);
-      reporter.CompletedPixel();
-    });
+    const auto numberOfChunks = static_cast<ThreadIdType>((lastIndexPlus1 - firstIndex + chunkSize - 1) / chunkSize);
+    itkAssertOrThrowMacro(numberOfChunks <= numberOfWorkUnits, "Number of work units was somehow miscounted!");
 
-    // now wait for the other computations to finish
-    for (SizeValueType i = 1; i < workUnit; ++i)
+    const auto group = std::make_shared<JobGroup>(numberOfChunks);
+    for (ThreadIdType chunk = 0; chunk < numberOfChunks; ++chunk)
     {
-      exceptionHandler.TryAndCatch([this, i, &reporter, &filter] {
-        std::future_status status;
-        do
+      const SizeValueType start = firstIndex + chunk * chunkSize;
+      const SizeValueType end = std::min(start + chunkSize, lastIndexPlus1);
+      group->SetJob(chunk, [&aFunc, start, end] {
+        for (SizeValueType ii = start; ii < end; ++ii)
         {
-          status = m_ThreadInfoArray[i].Future.wait_for(threadCompletionPollingInterval);
-          if (filter && status == std::future_status::timeout)
-          {
-            filter->IncrementProgress(0);
-          }
-        } while (status != std::future_status::ready);
-        reporter.CompletedPixel();
+          aFunc(ii);
+        }
       });
     }
+    JobGroup::Submit(group, m_ThreadPool);
 
-    exceptionHandler.RethrowFirstCaughtException();
+    // execute this thread's share, then help with, or wait for, the other computations
+    ProgressReporter reporter(filter, 0, numberOfChunks);
+    group->Wait(filter, reporter);
   }
   else if (firstIndex + 1 == lastIndexPlus1)
   {
@@ -233,7 +318,10 @@ PoolMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
     filter = nullptr;
   }
 
-  if (m_NumberOfWorkUnits == 1) // no multi-threading wanted
+  // do not oversubscribe the cores when nested within another parallel section
+  const ThreadIdType numberOfWorkUnits = GetNumberOfWorkUnitsForCallingThread(m_NumberOfWorkUnits);
+
+  if (numberOfWorkUnits == 1) // no multi-threading wanted
   {
     ProgressReporter reporter(filter, 0, 1);
     funcP(index, size); // process whole region
@@ -254,22 +342,17 @@ PoolMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
     else
     {
       const ImageRegionSplitterBase * splitter = ImageSourceCommon::GetGlobalDefaultSplitter();
-      const ThreadIdType              splitCount = splitter->GetNumberOfSplits(region, m_NumberOfWorkUnits);
-      ProgressReporter                reporter(filter, 0, splitCount);
-      itkAssertOrThrowMacro(splitCount <= m_NumberOfWorkUnits, "Split count is greater than number of work units!");
-      ImageIORegion iRegion;
-      ThreadIdType  total = 0;
-      for (ThreadIdType i = 1; i < splitCount; ++i)
+      const ThreadIdType              splitCount = splitter->GetNumberOfSplits(region, numberOfWorkUnits);
+      itkAssertOrThrowMacro(splitCount <= numberOfWorkUnits, "Split count is greater than number of work units!");
+
+      const auto group = std::make_shared<JobGroup>(splitCount);
+      for (ThreadIdType i = 0; i < splitCount; ++i)
       {
-        iRegion = region;
-        total = splitter->GetSplit(i, splitCount, iRegion);
+        ImageIORegion      iRegion = region;
+        const ThreadIdType total = splitter->GetSplit(i, splitCount, iRegion);
         if (i < total)
         {
-          m_ThreadInfoArray[i].Future = m_ThreadPool->AddWork([funcP, iRegion]() {
-            funcP(&iRegion.GetIndex()[0], &iRegion.GetSize()[0]);
-            // make this lambda have the same signature as m_SingleMethod
-            return ITK_THREAD_RETURN_DEFAULT_VALUE;
-          });
+          group->SetJob(i, [&funcP, iRegion] { funcP(&iRegion.GetIndex()[0], &iRegion.GetSize()[0]); });
         }
         else
         {
@@ -277,35 +360,11 @@ PoolMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
                             << i << " even though we checked possible number of splits beforehand!");
         }
       }
-      iRegion = region;
-      total = splitter->GetSplit(0, splitCount, iRegion);
-
-      // execute this thread's share
-      ExceptionHandler exceptionHandler;
-      exceptionHandler.TryAndCatch([funcP, iRegion, &reporter] {
-        funcP(&iRegion.GetIndex()[0], &iRegion.GetSize()[0]);
-        reporter.CompletedPixel();
-      });
-
-      // now wait for the other computations to finish
-      for (ThreadIdType i = 1; i < splitCount; ++i)
-      {
-        exceptionHandler.TryAndCatch([this, i, &reporter, &filter] {
-          std::future_status status;
-          do
-          {
-            status = m_ThreadInfoArray[i].Future.wait_for(threadCompletionPollingInterval);
-            if (filter && status == std::future_status::timeout)
-            {
-              filter->IncrementProgress(0);
-            }
-          } while (status != std::future_status::ready);
-          m_ThreadInfoArray[i].Future.get();
-          reporter.CompletedPixel();
-        });
-      }
+      JobGroup::Submit(group, m_ThreadPool);
 
-      exceptionHandler.RethrowFirstCaughtException();
+      // execute this thread's share, then help with, or wait for, the other computations
+      ProgressReporter reporter(filter, 0, splitCount);
+      group->Wait(filter, reporter);
     }
   }
 }
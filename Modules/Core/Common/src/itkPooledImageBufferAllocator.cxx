@@ -0,0 +1,248 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPooledImageBufferAllocator.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace itk
+{
+
+PooledImageBufferAllocator::~PooledImageBufferAllocator()
+{
+  FreeBuffers(m_CachedBuffers);
+}
+
+SizeValueType
+PooledImageBufferAllocator::ComputeBufferSize(SizeValueType numberOfBytes, SizeValueType minimumPooledBufferSize)
+{
+  if (numberOfBytes < minimumPooledBufferSize)
+  {
+    return numberOfBytes;
+  }
+
+  // Eight size classes per power of two, multiples of 4 KiB
+  SizeValueType highestBit = 0;
+  while ((numberOfBytes >> highestBit) > 1)
+  {
+    ++highestBit;
+  }
+  const SizeValueType step = SizeValueType{ 1 } << (std::max<SizeValueType>(highestBit, 15) - 3);
+  return (numberOfBytes + step - 1) / step * step;
+}
+
+SizeValueType
+PooledImageBufferAllocator::GetBufferSize(SizeValueType numberOfBytes) const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return ComputeBufferSize(numberOfBytes, m_MinimumPooledBufferSize);
+}
+
+void *
+PooledImageBufferAllocator::Allocate(SizeValueType numberOfBytes)
+{
+  SizeValueType bufferSize = numberOfBytes;
+  bool          pooled = false;
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    pooled = numberOfBytes >= m_MinimumPooledBufferSize;
+    if (pooled)
+    {
+      bufferSize = ComputeBufferSize(numberOfBytes, m_MinimumPooledBufferSize);
+
+      const SizeValueType alignment = this->GetAlignment();
+      const auto cached = std::find_if(m_CachedBuffers.begin(), m_CachedBuffers.end(), [=](const CachedBuffer & entry) {
+        return entry.Size == bufferSize && reinterpret_cast<std::uintptr_t>(entry.Buffer) % alignment == 0;
+      });
+      if (cached != m_CachedBuffers.end())
+      {
+        void * const buffer = cached->Buffer;
+        m_NumberOfCachedBytes -= cached->Size;
+        ++m_NumberOfReusedBuffers;
+        m_CachedBuffers.erase(cached);
+        m_AllocatedBufferSizes.emplace(buffer, bufferSize);
+        return buffer;
+      }
+    }
+  }
+
+  void * buffer = nullptr;
+  try
+  {
+    buffer = Superclass::Allocate(bufferSize);
+  }
+  catch (const MemoryAllocationError &)
+  {
+    // Free the cached buffers (maybe of other sizes), then try again
+    this->ReleaseCachedBuffers();
+    buffer = Superclass::Allocate(bufferSize);
+  }
+
+  // The buffers which are not recorded are freed by Deallocate()
+  if (pooled)
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    m_AllocatedBufferSizes.emplace(buffer, bufferSize);
+  }
+  return buffer;
+}
+
+void
+PooledImageBufferAllocator::Deallocate(void * buffer, SizeValueType numberOfBytes)
+{
+  std::list<CachedBuffer> evictedBuffers;
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    const auto                        allocated = m_AllocatedBufferSizes.find(buffer);
+    if (allocated == m_AllocatedBufferSizes.end())
+    {
+      evictedBuffers.push_back({ buffer, numberOfBytes });
+    }
+    else
+    {
+      // The size class of the buffer may differ from the one of numberOfBytes
+      // with the current settings, hence the recorded size.
+      const SizeValueType bufferSize = allocated->second;
+      m_AllocatedBufferSizes.erase(allocated);
+      if (bufferSize < m_MinimumPooledBufferSize || bufferSize > m_MaximumNumberOfCachedBytes)
+      {
+        evictedBuffers.push_back({ buffer, bufferSize });
+      }
+      else
+      {
+        evictedBuffers = this->TrimCache(m_MaximumNumberOfCachedBytes - bufferSize);
+        m_CachedBuffers.push_front({ buffer, bufferSize });
+        m_NumberOfCachedBytes += bufferSize;
+      }
+    }
+  }
+  FreeBuffers(evictedBuffers);
+}
+
+void
+PooledImageBufferAllocator::SetMaximumNumberOfCachedBytes(SizeValueType numberOfBytes)
+{
+  std::list<CachedBuffer> evictedBuffers;
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    if (m_MaximumNumberOfCachedBytes == numberOfBytes)
+    {
+      return;
+    }
+    m_MaximumNumberOfCachedBytes = numberOfBytes;
+    evictedBuffers = this->TrimCache(numberOfBytes);
+  }
+  FreeBuffers(evictedBuffers);
+  this->Modified();
+}
+
+SizeValueType
+PooledImageBufferAllocator::GetMaximumNumberOfCachedBytes() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_MaximumNumberOfCachedBytes;
+}
+
+void
+PooledImageBufferAllocator::SetMinimumPooledBufferSize(SizeValueType numberOfBytes)
+{
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    if (m_MinimumPooledBufferSize == numberOfBytes)
+    {
+      return;
+    }
+    m_MinimumPooledBufferSize = numberOfBytes;
+  }
+  this->Modified();
+}
+
+SizeValueType
+PooledImageBufferAllocator::GetMinimumPooledBufferSize() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_MinimumPooledBufferSize;
+}
+
+SizeValueType
+PooledImageBufferAllocator::GetNumberOfCachedBytes() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_NumberOfCachedBytes;
+}
+
+SizeValueType
+PooledImageBufferAllocator::GetNumberOfCachedBuffers() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_CachedBuffers.size();
+}
+
+SizeValueType
+PooledImageBufferAllocator::GetNumberOfReusedBuffers() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_NumberOfReusedBuffers;
+}
+
+void
+PooledImageBufferAllocator::ReleaseCachedBuffers()
+{
+  std::list<CachedBuffer> evictedBuffers;
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    evictedBuffers = this->TrimCache(0);
+  }
+  FreeBuffers(evictedBuffers);
+}
+
+std::list<PooledImageBufferAllocator::CachedBuffer>
+PooledImageBufferAllocator::TrimCache(SizeValueType numberOfBytes)
+{
+  std::list<CachedBuffer> evictedBuffers;
+  while (m_NumberOfCachedBytes > numberOfBytes)
+  {
+    m_NumberOfCachedBytes -= m_CachedBuffers.back().Size;
+    evictedBuffers.splice(evictedBuffers.end(), m_CachedBuffers, std::prev(m_CachedBuffers.end()));
+  }
+  return evictedBuffers;
+}
+
+void
+PooledImageBufferAllocator::FreeBuffers(const std::list<CachedBuffer> & buffers)
+{
+  for (const CachedBuffer & entry : buffers)
+  {
+    Superclass::Deallocate(entry.Buffer, entry.Size);
+  }
+}
+
+void
+PooledImageBufferAllocator::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  os << indent << "MaximumNumberOfCachedBytes: " << m_MaximumNumberOfCachedBytes << std::endl;
+  os << indent << "MinimumPooledBufferSize: " << m_MinimumPooledBufferSize << std::endl;
+  os << indent << "NumberOfCachedBytes: " << m_NumberOfCachedBytes << std::endl;
+  os << indent << "NumberOfCachedBuffers: " << m_CachedBuffers.size() << std::endl;
+  os << indent << "NumberOfReusedBuffers: " << m_NumberOfReusedBuffers << std::endl;
+}
+
+} // end namespace itk
@@ -96,6 +96,7 @@ TBBMultiThreader::SingleMethodExecute()
       ti.WorkUnitID = r.begin();
       ti.UserData = m_SingleData;
       ti.NumberOfWorkUnits = m_NumberOfWorkUnits;
+      const WorkUnitScope workUnitScope;
       m_SingleMethod(&ti); // TBB takes care of properly propagating exceptions
     },
     tbb::simple_partitioner());
@@ -142,6 +143,7 @@ TBBMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
         TotalProgressReporter progress(filter, count, 100);
         progress.CheckAbortGenerateData();
 
+        const WorkUnitScope workUnitScope;
         aFunc(r.begin()); // invoke the function
 
         progress.CompletedPixel();
@@ -272,6 +274,7 @@ TBBMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
       TotalProgressReporter progress(filter, totalCount, 100);
       progress.CheckAbortGenerateData();
 
+      const WorkUnitScope workUnitScope;
       funcP(&regionToProcess.GetIndex()[0], &regionToProcess.GetSize()[0]);
 
       progress.Completed(regionToProcess.GetNumberOfPixels());
@@ -0,0 +1,329 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWorkStealingMultiThreader.h"
+#include "itkNumericTraits.h"
+#include "itkProcessObject.h"
+#include "itkTotalProgressReporter.h"
+#include <algorithm>
+#include <exception>
+#include <mutex>
+
+namespace itk
+{
+namespace
+{
+/** Fork-join helper: counts the jobs spawned into the pool, captures the
+ * first exception thrown by any of them and cancels the remaining ones.
+ * Nested groups share the pool of the outer ones: waiting threads execute
+ * pending jobs, so nesting never adds threads. */
+class TaskGroup
+{
+public:
+  explicit TaskGroup(WorkStealingThreadPool * pool)
+    : m_Pool(pool)
+  {}
+
+  template <typename TFunction>
+  void
+  Run(TFunction function)
+  {
+    ++m_PendingJobs;
+    m_Pool->AddWork([this, function]() {
+      this->TryAndCatch(function);
+      --m_PendingJobs; // must be the last access to this group
+    });
+  }
+
+  template <typename TFunction>
+  void
+  TryAndCatch(const TFunction & function)
+  {
+    if (m_Cancelled)
+    {
+      return;
+    }
+    try
+    {
+      const MultiThreaderBase::WorkUnitScope workUnitScope;
+      function();
+    }
+    catch (...)
+    {
+      const std::lock_guard<std::mutex> lockGuard(m_ExceptionMutex);
+      if (m_FirstCaughtException == nullptr)
+      {
+        m_FirstCaughtException = std::current_exception();
+      }
+      m_Cancelled = true;
+    }
+  }
+
+  /** Help executing jobs until all the jobs of this group are done,
+   * then rethrow the first caught exception, if any. */
+  void
+  Wait()
+  {
+    m_Pool->HelpUntil([this] { return m_PendingJobs == 0; });
+    if (m_FirstCaughtException != nullptr)
+    {
+      std::rethrow_exception(m_FirstCaughtException);
+    }
+  }
+
+  [[nodiscard]] bool
+  IsCancelled() const
+  {
+    return m_Cancelled;
+  }
+
+  [[nodiscard]] bool
+  IsLocalQueueEmpty() const
+  {
+    return m_Pool->IsLocalQueueEmpty();
+  }
+
+private:
+  WorkStealingThreadPool *   m_Pool;
+  std::atomic<SizeValueType> m_PendingJobs{ 0 };
+  std::atomic<bool>          m_Cancelled{ false };
+  std::mutex                 m_ExceptionMutex;
+  std::exception_ptr         m_FirstCaughtException;
+};
+
+/** Lazy binary splitting of [begin, end). While the piece offered to the
+ * other threads is still in the local queue, the range is processed
+ * sequentially (recursing on the lower half); as soon as it has been
+ * stolen, the upper half of what remains is offered again. */
+template <typename TChunkFunction>
+void
+ProcessRange(TaskGroup &              group,
+             SizeValueType          begin,
+             SizeValueType          end,
+             SizeValueType          grain,
+             const TChunkFunction & processChunk)
+{
+  while (end - begin > grain && !group.IsCancelled())
+  {
+    const SizeValueType middle = begin + (end - begin) / 2;
+    if (group.IsLocalQueueEmpty())
+    {
+      group.Run(
+        [&group, middle, end, grain, &processChunk] { ProcessRange(group, middle, end, grain, processChunk); });
+    }
+    else
+    {
+      ProcessRange(group, middle, end, grain, processChunk);
+    }
+    end = middle;
+  }
+  group.TryAndCatch([&processChunk, begin, end] { processChunk(begin, end); });
+}
+
+/** Same as ProcessRange, for image regions. Regions are halved along the
+ * highest dimension which has more than one pixel. */
+template <typename TChunkFunction>
+void
+ProcessRegion(TaskGroup & group, ImageIORegion region, SizeValueType grain, const TChunkFunction & processChunk)
+{
+  while (region.GetNumberOfPixels() > grain && !group.IsCancelled())
+  {
+    auto splitDimension = static_cast<int>(region.GetImageDimension()) - 1;
+    while (region.GetSize(splitDimension) <= 1)
+    {
+      --splitDimension; // there is at least one such dimension as grain >= 1
+    }
+
+    ImageIORegion upper = region;
+    const auto    lowerSize = region.GetSize(splitDimension) / 2;
+    region.SetSize(splitDimension, lowerSize);
+    upper.SetIndex(splitDimension, upper.GetIndex(splitDimension) + static_cast<IndexValueType>(lowerSize));
+    upper.SetSize(splitDimension, upper.GetSize(splitDimension) - lowerSize);
+
+    if (group.IsLocalQueueEmpty())
+    {
+      group.Run([&group, upper, grain, &processChunk] { ProcessRegion(group, upper, grain, processChunk); });
+    }
+    else
+    {
+      ProcessRegion(group, upper, grain, processChunk);
+    }
+  }
+  group.TryAndCatch([&processChunk, &region] { processChunk(region); });
+}
+} // namespace
+
+
+WorkStealingMultiThreader::WorkStealingMultiThreader()
+  : m_ThreadPool(WorkStealingThreadPool::GetInstance())
+{
+  for (ThreadIdType i = 0; i < ITK_MAX_THREADS; ++i)
+  {
+    m_ThreadInfoArray[i].WorkUnitID = i;
+  }
+
+  ThreadIdType defaultThreads = std::max(1u, GetGlobalDefaultNumberOfThreads());
+  if (defaultThreads > 1) // one work unit for only one thread
+  {
+    defaultThreads *= 4;
+  }
+  m_NumberOfWorkUnits = std::min<ThreadIdType>(ITK_MAX_THREADS, defaultThreads);
+  m_MaximumNumberOfThreads = m_ThreadPool->GetMaximumNumberOfThreads();
+}
+
+WorkStealingMultiThreader::~WorkStealingMultiThreader() = default;
+
+void
+WorkStealingMultiThreader::SetSingleMethod(ThreadFunctionType f, void * data)
+{
+  m_SingleMethod = std::move(f);
+  m_SingleData = data;
+}
+
+void
+WorkStealingMultiThreader::SetMaximumNumberOfThreads(ThreadIdType numberOfThreads)
+{
+  Superclass::SetMaximumNumberOfThreads(numberOfThreads);
+  const ThreadIdType threadCount = m_ThreadPool->GetMaximumNumberOfThreads();
+  if (threadCount < m_MaximumNumberOfThreads)
+  {
+    m_ThreadPool->AddThreads(m_MaximumNumberOfThreads - threadCount);
+  }
+  m_MaximumNumberOfThreads = m_ThreadPool->GetMaximumNumberOfThreads();
+}
+
+void
+WorkStealingMultiThreader::SingleMethodExecute()
+{
+  if (!m_SingleMethod)
+  {
+    itkExceptionStringMacro("No single method set!");
+  }
+
+  // obey the global maximum number of threads limit
+  m_NumberOfWorkUnits = std::min(this->GetGlobalMaximumNumberOfThreads(), m_NumberOfWorkUnits);
+
+  TaskGroup group(m_ThreadPool);
+  for (ThreadIdType workUnit = 1; workUnit < m_NumberOfWorkUnits; ++workUnit)
+  {
+    m_ThreadInfoArray[workUnit].UserData = m_SingleData;
+    m_ThreadInfoArray[workUnit].NumberOfWorkUnits = m_NumberOfWorkUnits;
+    group.Run([this, workUnit] { m_SingleMethod(&m_ThreadInfoArray[workUnit]); });
+  }
+
+  // Now, the parent thread calls this->SingleMethod() itself
+  m_ThreadInfoArray[0].UserData = m_SingleData;
+  m_ThreadInfoArray[0].NumberOfWorkUnits = m_NumberOfWorkUnits;
+  group.TryAndCatch([this] { m_SingleMethod(&m_ThreadInfoArray[0]); });
+
+  // Execute the other work units (or anything else) until they are done
+  group.Wait();
+}
+
+void
+WorkStealingMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
+                                            SizeValueType             lastIndexPlus1,
+                                            ArrayThreadingFunctorType aFunc,
+                                            ProcessObject *           filter)
+{
+  if (!this->GetUpdateProgress())
+  {
+    filter = nullptr;
+  }
+  ProgressReporter progressStartEnd(filter, 0, 1);
+
+  if (firstIndex + 1 < lastIndexPlus1)
+  {
+    const SizeValueType count = lastIndexPlus1 - firstIndex;
+    const SizeValueType grain = (count + m_NumberOfWorkUnits - 1) / m_NumberOfWorkUnits;
+
+    // Must outlive the jobs of the group, which refer to it
+    const auto processChunk = [&aFunc, filter, count](SizeValueType begin, SizeValueType end) {
+      TotalProgressReporter progress(filter, count, 100);
+      progress.CheckAbortGenerateData();
+      for (SizeValueType ii = begin; ii < end; ++ii)
+      {
+        aFunc(ii);
+      }
+      progress.Completed(end - begin);
+    };
+
+    TaskGroup group(m_ThreadPool);
+    ProcessRange(group, firstIndex, lastIndexPlus1, grain, processChunk);
+    group.Wait();
+  }
+  else if (firstIndex + 1 == lastIndexPlus1)
+  {
+    aFunc(firstIndex);
+  }
+  // else nothing needs to be executed
+}
+
+void
+WorkStealingMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
+                                                  const IndexValueType index[],
+                                                  const SizeValueType  size[],
+                                                  ThreadingFunctorType funcP,
+                                                  ProcessObject *      filter)
+{
+  if (!this->GetUpdateProgress())
+  {
+    filter = nullptr;
+  }
+  ProgressReporter progressStartEnd(filter, 0, 1);
+
+  ImageIORegion region(dimension);
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    region.SetIndex(d, index[d]);
+    region.SetSize(d, size[d]);
+  }
+  const SizeValueType totalCount = region.GetNumberOfPixels();
+
+  if (m_NumberOfWorkUnits == 1 || totalCount <= 1) // no multi-threading wanted or possible
+  {
+    funcP(index, size); // process whole region
+  }
+  else
+  {
+    const SizeValueType grain = (totalCount + m_NumberOfWorkUnits - 1) / m_NumberOfWorkUnits;
+
+    // Must outlive the jobs of the group, which refer to it
+    const auto processChunk = [&funcP, filter, totalCount](const ImageIORegion & regionToProcess) {
+      TotalProgressReporter progress(filter, totalCount, 100);
+      progress.CheckAbortGenerateData();
+
+      funcP(&regionToProcess.GetIndex()[0], &regionToProcess.GetSize()[0]);
+
+      progress.Completed(regionToProcess.GetNumberOfPixels());
+    };
+
+    TaskGroup group(m_ThreadPool);
+    ProcessRegion(group, region, grain, processChunk);
+    group.Wait();
+  }
+}
+
+void
+WorkStealingMultiThreader::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "ThreadPool: " << m_ThreadPool.GetPointer() << std::endl;
+}
+
+} // namespace itk
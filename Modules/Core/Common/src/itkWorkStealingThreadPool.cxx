@@ -0,0 +1,446 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWorkStealingThreadPool.h"
+#include "itkThreadPool.h"
+#include "itkThreadSupport.h"
+#include "itkNumericTraits.h"
+#include "itkMultiThreaderBase.h"
+#include "itkSingleton.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+
+namespace itk
+{
+namespace
+{
+constexpr ThreadIdType invalidWorkerIndex = NumericTraits<ThreadIdType>::max();
+
+// Index of the calling thread in the pool, or invalidWorkerIndex for threads outside of the pool.
+thread_local ThreadIdType t_WorkerIndex = invalidWorkerIndex;
+
+// Number of unsuccessful attempts to find a job before an idle worker goes to sleep.
+constexpr unsigned int numberOfSpinsBeforeSleep = 64;
+} // namespace
+
+/** Fixed capacity Chase-Lev deque. The owner pushes and pops at the bottom,
+ * thieves steal from the top. Push fails when the deque is full, in which
+ * case the owner executes the job immediately. */
+class WorkStealingThreadPool::JobDeque
+{
+public:
+  static constexpr std::int64_t Capacity = 4096;
+
+  bool
+  Push(JobType * job)
+  {
+    const std::int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+    const std::int64_t top = m_Top.load(std::memory_order_acquire);
+    if (bottom - top >= Capacity)
+    {
+      return false;
+    }
+    m_Buffer[bottom & Mask].store(job, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  JobType *
+  Pop()
+  {
+    const std::int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+    m_Bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = m_Top.load(std::memory_order_relaxed);
+
+    JobType * job = nullptr;
+    if (top <= bottom)
+    {
+      job = m_Buffer[bottom & Mask].load(std::memory_order_relaxed);
+      if (top == bottom)
+      {
+        // Last job: race against the thieves
+        if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+          job = nullptr;
+        }
+        m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+      }
+    }
+    else
+    {
+      m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return job;
+  }
+
+  JobType *
+  Steal()
+  {
+    std::int64_t top = m_Top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+    if (top < bottom)
+    {
+      JobType * job = m_Buffer[top & Mask].load(std::memory_order_relaxed);
+      if (m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+      {
+        return job;
+      }
+    }
+    return nullptr;
+  }
+
+  bool
+  IsEmpty() const
+  {
+    return m_Bottom.load(std::memory_order_relaxed) <= m_Top.load(std::memory_order_relaxed);
+  }
+
+private:
+  static constexpr std::int64_t Mask = Capacity - 1;
+  static_assert((Capacity & Mask) == 0, "Capacity must be a power of two");
+
+  // Top and bottom are on separate cache lines, as they are written by different threads.
+  alignas(64) std::atomic<std::int64_t> m_Top{ 0 };
+  alignas(64) std::atomic<std::int64_t> m_Bottom{ 0 };
+  std::atomic<JobType *>                m_Buffer[Capacity];
+};
+
+struct WorkStealingThreadPoolGlobals
+{
+  WorkStealingThreadPoolGlobals() = default;
+
+  // To lock on the various internal variables.
+  std::mutex m_Mutex;
+
+  // To allow singleton creation of WorkStealingThreadPool.
+  std::once_flag m_ThreadPoolOnceFlag;
+
+  // The singleton instance of WorkStealingThreadPool.
+  WorkStealingThreadPool::Pointer m_ThreadPoolInstance;
+};
+
+itkGetGlobalSimpleMacro(WorkStealingThreadPool, WorkStealingThreadPoolGlobals, PimplGlobals);
+
+WorkStealingThreadPool::Pointer
+WorkStealingThreadPool::New()
+{
+  return Self::GetInstance();
+}
+
+
+WorkStealingThreadPool::Pointer
+WorkStealingThreadPool::GetInstance()
+{
+  // This is called once, on-demand to ensure that m_PimplGlobals is
+  // initialized.
+  itkInitGlobalsMacro(PimplGlobals);
+
+  // Create a singleton WorkStealingThreadPool.
+  std::call_once(m_PimplGlobals->m_ThreadPoolOnceFlag, []() {
+    m_PimplGlobals->m_ThreadPoolInstance = ObjectFactory<Self>::Create();
+    if (m_PimplGlobals->m_ThreadPoolInstance.IsNull())
+    {
+      new WorkStealingThreadPool(); // constructor sets m_PimplGlobals->m_ThreadPoolInstance
+    }
+#if defined(ITK_USE_PTHREADS)
+    pthread_atfork(WorkStealingThreadPool::PrepareForFork,
+                   WorkStealingThreadPool::ResumeFromFork,
+                   WorkStealingThreadPool::ResumeFromFork);
+#endif
+  });
+
+  return m_PimplGlobals->m_ThreadPoolInstance;
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool()
+{
+  // m_PimplGlobals->m_Mutex not needed to be acquired here because construction only occurs via GetInstance which is
+  // protected by call_once.
+
+  m_PimplGlobals->m_ThreadPoolInstance = this;        // threads need this
+  m_PimplGlobals->m_ThreadPoolInstance->UnRegister(); // Remove extra reference
+
+  // The deques are never reallocated, so that thieves can access them without locking.
+  m_Deques.resize(ITK_MAX_THREADS);
+  this->AddThreads(MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+  this->CleanUp();
+  for (JobType * job : m_InjectionQueue)
+  {
+    delete job;
+  }
+}
+
+void
+WorkStealingThreadPool::AddThreads(ThreadIdType count)
+{
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  count = std::min<ThreadIdType>(count, ITK_MAX_THREADS - m_Threads.size());
+  m_Threads.reserve(m_Threads.size() + count);
+  for (ThreadIdType i = 0; i < count; ++i)
+  {
+    const auto index = static_cast<ThreadIdType>(m_Threads.size());
+    if (m_Deques[index] == nullptr)
+    {
+      m_Deques[index] = std::make_unique<JobDeque>();
+    }
+    m_NumberOfDeques = std::max<ThreadIdType>(m_NumberOfDeques, index + 1);
+    m_Threads.emplace_back(&WorkStealingThreadPool::ThreadExecute, index);
+  }
+}
+
+ThreadIdType
+WorkStealingThreadPool::GetMaximumNumberOfThreads() const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  return static_cast<ThreadIdType>(m_Threads.size());
+}
+
+int
+WorkStealingThreadPool::GetNumberOfCurrentlyIdleThreads() const
+{
+  return m_NumberOfSleepingThreads;
+}
+
+bool
+WorkStealingThreadPool::IsWorkerThread()
+{
+  return t_WorkerIndex != invalidWorkerIndex;
+}
+
+bool
+WorkStealingThreadPool::IsLocalQueueEmpty() const
+{
+  const ThreadIdType self = t_WorkerIndex;
+  if (self != invalidWorkerIndex)
+  {
+    return m_Deques[self]->IsEmpty();
+  }
+  return m_NumberOfInjectedJobs == 0;
+}
+
+void
+WorkStealingThreadPool::AddWork(JobType job)
+{
+  auto * const       jobPointer = new JobType(std::move(job));
+  const ThreadIdType self = t_WorkerIndex;
+
+  ++m_NumberOfQueuedJobs;
+  if (self != invalidWorkerIndex)
+  {
+    if (!m_Deques[self]->Push(jobPointer))
+    {
+      // Our deque is full, there is plenty of work for the thieves already
+      --m_NumberOfQueuedJobs;
+      RunJob(jobPointer);
+      return;
+    }
+  }
+  else
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+    m_InjectionQueue.push_back(jobPointer);
+    ++m_NumberOfInjectedJobs;
+  }
+  this->NotifyIdleWorker();
+}
+
+void
+WorkStealingThreadPool::NotifyIdleWorker()
+{
+  if (m_NumberOfSleepingThreads > 0)
+  {
+    // Acquiring the mutex guarantees that a worker which has just checked
+    // its wake-up condition is already waiting on m_Condition.
+    {
+      const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+    }
+    m_Condition.notify_one();
+  }
+}
+
+WorkStealingThreadPool::JobType *
+WorkStealingThreadPool::FindJob(ThreadIdType self)
+{
+  if (m_NumberOfQueuedJobs == 0)
+  {
+    return nullptr;
+  }
+
+  JobType * job = nullptr;
+  if (self != invalidWorkerIndex)
+  {
+    job = m_Deques[self]->Pop();
+  }
+
+  if (job == nullptr)
+  {
+    // Start at a different victim for every attempt to spread the thieves
+    thread_local unsigned int victimSeed =
+      static_cast<unsigned int>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    victimSeed = victimSeed * 1664525u + 1013904223u;
+
+    const ThreadIdType numberOfDeques = m_NumberOfDeques;
+    const ThreadIdType first = (victimSeed >> 8) % numberOfDeques;
+    for (ThreadIdType i = 0; i < numberOfDeques && job == nullptr; ++i)
+    {
+      const ThreadIdType victim = (first + i) % numberOfDeques;
+      if (victim != self)
+      {
+        job = m_Deques[victim]->Steal();
+      }
+    }
+  }
+
+  if (job == nullptr && m_NumberOfInjectedJobs > 0)
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+    if (!m_InjectionQueue.empty())
+    {
+      job = m_InjectionQueue.front();
+      m_InjectionQueue.pop_front();
+      --m_NumberOfInjectedJobs;
+    }
+  }
+
+  if (job != nullptr)
+  {
+    --m_NumberOfQueuedJobs;
+  }
+  return job;
+}
+
+void
+WorkStealingThreadPool::RunJob(JobType * job)
+{
+  const std::unique_ptr<JobType> jobHolder(job);
+  (*jobHolder)();
+}
+
+void
+WorkStealingThreadPool::HelpUntil(const std::function<bool()> & done)
+{
+  const ThreadIdType self = t_WorkerIndex;
+  while (!done())
+  {
+    JobType * job = this->FindJob(self);
+    if (job != nullptr)
+    {
+      RunJob(job);
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void
+WorkStealingThreadPool::CleanUp()
+{
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+    m_Stopping = true;
+  }
+  m_Condition.notify_all();
+
+  for (auto & thread : m_Threads)
+  {
+    if (!thread.joinable())
+    {
+      continue;
+    }
+    if (ThreadPool::GetDoNotWaitForThreads())
+    {
+      // See ThreadPoolGlobals::m_WaitForThreads
+      thread.detach();
+    }
+    else
+    {
+      thread.join();
+    }
+  }
+}
+
+void
+WorkStealingThreadPool::PrepareForFork()
+{
+  m_PimplGlobals->m_ThreadPoolInstance->CleanUp();
+}
+
+void
+WorkStealingThreadPool::ResumeFromFork()
+{
+  WorkStealingThreadPool * instance = m_PimplGlobals->m_ThreadPoolInstance.GetPointer();
+  const ThreadIdType       threadCount = instance->m_Threads.size();
+  instance->m_Threads.clear();
+  instance->m_Stopping = false;
+  instance->AddThreads(threadCount);
+}
+
+void
+WorkStealingThreadPool::ThreadExecute(ThreadIdType self)
+{
+  t_WorkerIndex = self;
+
+  // plain pointer does not increase reference count
+  WorkStealingThreadPool * threadPool = m_PimplGlobals->m_ThreadPoolInstance.GetPointer();
+
+  unsigned int failedAttempts = 0;
+  while (true)
+  {
+    JobType * job = threadPool->FindJob(self);
+    if (job != nullptr)
+    {
+      failedAttempts = 0;
+      RunJob(job);
+      continue;
+    }
+
+    if (threadPool->m_Stopping)
+    {
+      return;
+    }
+
+    if (++failedAttempts < numberOfSpinsBeforeSleep)
+    {
+      std::this_thread::yield();
+      continue;
+    }
+
+    failedAttempts = 0;
+    std::unique_lock<std::mutex> mutexHolder(m_PimplGlobals->m_Mutex);
+    ++threadPool->m_NumberOfSleepingThreads;
+    threadPool->m_Condition.wait(
+      mutexHolder, [threadPool] { return threadPool->m_Stopping || threadPool->m_NumberOfQueuedJobs > 0; });
+    --threadPool->m_NumberOfSleepingThreads;
+  }
+}
+
+WorkStealingThreadPoolGlobals * WorkStealingThreadPool::m_PimplGlobals;
+
+} // namespace itk
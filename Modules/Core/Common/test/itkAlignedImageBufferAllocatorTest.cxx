@@ -0,0 +1,149 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImage.h"
+#include "itkVectorImage.h"
+#include "itkAlignedImageBufferAllocator.h"
+#include "itkPooledImageBufferAllocator.h"
+#include "itkTestingMacros.h"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace
+{
+bool
+IsAligned(const void * buffer, itk::SizeValueType alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(buffer) % alignment == 0;
+}
+
+template <typename TImage>
+int
+TestImageAlignment(itk::SizeValueType alignment)
+{
+  auto                            image = TImage::New();
+  const typename TImage::SizeType size = { { 37, 64, 32 } };
+  image->SetRegions(size);
+  if constexpr (std::is_same_v<TImage, itk::VectorImage<float, 3>>)
+  {
+    image->SetNumberOfComponentsPerPixel(3);
+  }
+  image->Allocate(true);
+
+  const auto * const container = image->GetPixelContainer();
+  ITK_TEST_EXPECT_EQUAL(container->GetBufferAlignment(), alignment);
+  ITK_TEST_EXPECT_TRUE(IsAligned(image->GetBufferPointer(), alignment));
+  for (itk::SizeValueType i = 0; i < container->Size(); ++i)
+  {
+    ITK_TEST_EXPECT_EQUAL((*container)[i], 0.0f);
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkAlignedImageBufferAllocatorTest(int, char *[])
+{
+  auto allocator = itk::AlignedImageBufferAllocator::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(allocator, AlignedImageBufferAllocator, ImageBufferAllocator);
+
+  ITK_TEST_EXPECT_EQUAL(allocator->GetAlignment(), 64);
+  ITK_TEST_EXPECT_TRUE(allocator->GetUseHugePages());
+  ITK_TEST_EXPECT_EQUAL(allocator->GetHugePageMinimumBufferSize(), itk::SizeValueType{ 2 } << 20);
+
+  ITK_TEST_SET_GET_BOOLEAN(allocator, UseHugePages, true);
+  allocator->SetHugePageMinimumBufferSize(1 << 20);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetHugePageMinimumBufferSize(), 1 << 20);
+
+  // Invalid alignments
+  ITK_TRY_EXPECT_EXCEPTION(allocator->SetAlignment(0));
+  ITK_TRY_EXPECT_EXCEPTION(allocator->SetAlignment(48));
+  ITK_TRY_EXPECT_EXCEPTION(allocator->SetAlignment(8192));
+  ITK_TEST_EXPECT_EQUAL(allocator->GetAlignment(), 64);
+
+  // Alignments lower than the one of operator new are raised to it
+  allocator->SetAlignment(1);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetAlignment(), __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+  // Direct allocations, including buffers backed by huge pages
+  for (const itk::SizeValueType alignment : { 16, 64, 256, 4096 })
+  {
+    allocator->SetAlignment(alignment);
+    ITK_TEST_EXPECT_EQUAL(allocator->GetAlignment(), alignment);
+    for (const itk::SizeValueType numberOfBytes : { 0, 1, 100, 4 << 20 })
+    {
+      void * const buffer = allocator->Allocate(numberOfBytes);
+      ITK_TEST_EXPECT_TRUE(IsAligned(buffer, alignment));
+      std::memset(buffer, 0xFF, numberOfBytes);
+      allocator->Deallocate(buffer, numberOfBytes);
+    }
+  }
+
+  // A buffer is released correctly after the alignment changed
+  void * const buffer = allocator->Allocate(1000);
+  allocator->SetAlignment(64);
+  allocator->Deallocate(buffer, 1000);
+
+  // Images using the allocator through the global default
+  itk::ImageBufferAllocator::SetGlobalDefaultAllocator(allocator);
+  for (const itk::SizeValueType alignment : { 64, 128 })
+  {
+    allocator->SetAlignment(alignment);
+    if (TestImageAlignment<itk::Image<float, 3>>(alignment) == EXIT_FAILURE ||
+        TestImageAlignment<itk::VectorImage<float, 3>>(alignment) == EXIT_FAILURE)
+    {
+      std::cerr << "Test FAILED!" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  itk::ImageBufferAllocator::SetGlobalDefaultAllocator(nullptr);
+
+  // Imported buffers only have the alignment of their elements
+  using ContainerType = itk::ImportImageContainer<itk::SizeValueType, double>;
+  auto   container = ContainerType::New();
+  double elements[4]{};
+  container->SetImportPointer(elements, 4, false);
+  ITK_TEST_EXPECT_EQUAL(container->GetBufferAlignment(), alignof(double));
+  container->SetBufferAllocator(allocator);
+  container->Reserve(8);
+  ITK_TEST_EXPECT_EQUAL(container->GetBufferAlignment(), allocator->GetAlignment());
+  ITK_TEST_EXPECT_TRUE(IsAligned(container->GetBufferPointer(), allocator->GetAlignment()));
+  // The alignment of a buffer is the one it was allocated with
+  const itk::SizeValueType containerAlignment = container->GetBufferAlignment();
+  allocator->SetAlignment(4096);
+  ITK_TEST_EXPECT_EQUAL(container->GetBufferAlignment(), containerAlignment);
+
+  // A pooled buffer is only reused if it is aligned as currently set
+  auto pooledAllocator = itk::PooledImageBufferAllocator::New();
+  pooledAllocator->SetMinimumPooledBufferSize(4096);
+  pooledAllocator->SetAlignment(64);
+  for (unsigned int i = 0; i < 8; ++i)
+  {
+    pooledAllocator->Deallocate(pooledAllocator->Allocate(10000), 10000);
+  }
+  pooledAllocator->SetAlignment(4096);
+  void * const pooledBuffer = pooledAllocator->Allocate(10000);
+  ITK_TEST_EXPECT_TRUE(IsAligned(pooledBuffer, 4096));
+  pooledAllocator->Deallocate(pooledBuffer, 10000);
+
+  std::cout << "Test PASSED!" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImage.h"
+#include "itkVectorImage.h"
+#include "itkImportImageContainerCommon.h"
+#include "itkTestingMacros.h"
+
+#include <set>
+#include <type_traits>
+
+namespace
+{
+using AllocationPolicyEnum = itk::ImportImageContainerCommon::AllocationPolicyEnum;
+
+template <typename TImage>
+typename TImage::Pointer
+CreateImage(itk::SizeValueType sizeAlongX)
+{
+  auto                            image = TImage::New();
+  const typename TImage::SizeType size = { { sizeAlongX, 64, 32 } };
+  image->SetRegions(size);
+  if constexpr (std::is_same_v<TImage, itk::VectorImage<float, 3>>)
+  {
+    image->SetNumberOfComponentsPerPixel(3);
+  }
+  return image;
+}
+
+template <typename TImage>
+int
+TestAllocation(itk::SizeValueType sizeAlongX)
+{
+  // Zero-initialized allocation
+  const auto zeroImage = CreateImage<TImage>(sizeAlongX);
+  zeroImage->Allocate(true);
+  const auto * const zeroContainer = zeroImage->GetPixelContainer();
+  for (itk::SizeValueType i = 0; i < zeroContainer->Size(); ++i)
+  {
+    ITK_TEST_EXPECT_EQUAL((*zeroContainer)[i], 0.0f);
+  }
+
+  // Allocation without initialization
+  const auto image = CreateImage<TImage>(sizeAlongX);
+  image->Allocate(false);
+  auto * const container = image->GetPixelContainer();
+  for (itk::SizeValueType i = 0; i < container->Size(); ++i)
+  {
+    (*container)[i] = static_cast<float>(i % 251);
+  }
+  for (itk::SizeValueType i = 0; i < container->Size(); ++i)
+  {
+    ITK_TEST_EXPECT_EQUAL((*container)[i], static_cast<float>(i % 251));
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkImportImageContainerAllocationPolicyTest(int, char *[])
+{
+  // Test streaming enumeration for ImportImageContainerEnums::AllocationPolicy elements
+  const std::set<AllocationPolicyEnum> allAllocationPolicy{ AllocationPolicyEnum::Default,
+                                                            AllocationPolicyEnum::ParallelFirstTouch,
+                                                            AllocationPolicyEnum::NUMAInterleave };
+  for (const auto & ee : allAllocationPolicy)
+  {
+    std::cout << "STREAMED ENUM VALUE ImportImageContainerEnums::AllocationPolicy: " << ee << std::endl;
+  }
+
+  ITK_TEST_EXPECT_EQUAL(itk::ImportImageContainerCommon::GetGlobalAllocationPolicy(), AllocationPolicyEnum::Default);
+  ITK_TEST_EXPECT_TRUE(!itk::ImportImageContainerCommon::IsGlobalAllocationPolicyApplicable(1 << 30));
+
+  // Use a small threshold, so that the policy applies to the small images of this test
+  itk::ImportImageContainerCommon::SetGlobalAllocationPolicyMinimumBufferSize(4096);
+  ITK_TEST_EXPECT_EQUAL(itk::ImportImageContainerCommon::GetGlobalAllocationPolicyMinimumBufferSize(), 4096);
+
+  for (const auto & policy : allAllocationPolicy)
+  {
+    std::cout << "Testing allocations with " << policy << std::endl;
+    itk::ImportImageContainerCommon::SetGlobalAllocationPolicy(policy);
+    ITK_TEST_EXPECT_EQUAL(itk::ImportImageContainerCommon::GetGlobalAllocationPolicy(), policy);
+    ITK_TEST_EXPECT_EQUAL(itk::ImportImageContainerCommon::IsGlobalAllocationPolicyApplicable(4096),
+                          policy != AllocationPolicyEnum::Default);
+    ITK_TEST_EXPECT_TRUE(!itk::ImportImageContainerCommon::IsGlobalAllocationPolicyApplicable(4095));
+
+    // Sizes which are, and are not, a multiple of the page size
+    for (const itk::SizeValueType sizeAlongX : { 1, 37, 512 })
+    {
+      if (TestAllocation<itk::Image<float, 3>>(sizeAlongX) == EXIT_FAILURE ||
+          TestAllocation<itk::VectorImage<float, 3>>(sizeAlongX) == EXIT_FAILURE)
+      {
+        std::cerr << "Test FAILED!" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  itk::ImportImageContainerCommon::SetGlobalAllocationPolicy(AllocationPolicyEnum::Default);
+
+  std::cout << "Test PASSED!" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -91,6 +91,7 @@ itkMultiThreaderExceptionsTest(int, char *[])
 #ifdef ITK_USE_TBB
     ThreaderEnum::TBB,
 #endif // ITK_USE_TBB
+    ThreaderEnum::WorkStealing,
   };
   for (auto thType : threadersToTest)
   {
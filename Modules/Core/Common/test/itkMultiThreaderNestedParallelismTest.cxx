@@ -0,0 +1,194 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMultiThreaderBase.h"
+#include "itkTestingMacros.h"
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+using ThreaderEnum = itk::MultiThreaderBase::ThreaderEnum;
+
+namespace
+{
+constexpr itk::ThreadIdType  numberOfThreads = 4;
+constexpr itk::SizeValueType outerSize = 16;
+constexpr itk::SizeValueType innerSize = 64;
+
+int
+TestSchedulingContext()
+{
+  ITK_TEST_EXPECT_EQUAL(itk::MultiThreaderBase::GetWorkUnitNestingLevel(), 0);
+  ITK_TEST_EXPECT_EQUAL(itk::MultiThreaderBase::GetGlobalNumberOfBusyThreads(), 0);
+  // outside of any parallel section, the requested number of work units is used
+  ITK_TEST_EXPECT_EQUAL(itk::MultiThreaderBase::GetNumberOfWorkUnitsForCallingThread(4 * numberOfThreads),
+                        4 * numberOfThreads);
+  ITK_TEST_EXPECT_EQUAL(itk::MultiThreaderBase::GetNumberOfWorkUnitsForCallingThread(0), 1);
+
+  {
+    const itk::MultiThreaderBase::WorkUnitScope outerScope;
+    ITK_TEST_EXPECT_EQUAL(itk::MultiThreaderBase::GetWorkUnitNestingLevel(), 1);
+    ITK_TEST_EXPECT_EQUAL(itk::MultiThreaderBase::GetGlobalNumberOfBusyThreads(), 1);
+    // the other threads are idle, so they can be used in addition to the calling one
+    ITK_TEST_EXPECT_EQUAL(itk::MultiThreaderBase::GetNumberOfWorkUnitsForCallingThread(4 * numberOfThreads),
+                          numberOfThreads);
+    ITK_TEST_EXPECT_EQUAL(itk::MultiThreaderBase::GetNumberOfWorkUnitsForCallingThread(2), 2);
+
+    {
+      const itk::MultiThreaderBase::WorkUnitScope innerScope;
+      ITK_TEST_EXPECT_EQUAL(itk::MultiThreaderBase::GetWorkUnitNestingLevel(), 2);
+      ITK_TEST_EXPECT_EQUAL(itk::MultiThreaderBase::GetGlobalNumberOfBusyThreads(), 1);
+    }
+
+    // keep all the other threads busy: nested sections must run inline
+    std::atomic<itk::ThreadIdType> numberOfStartedThreads{ 0 };
+    std::atomic<bool>              release{ false };
+    std::vector<std::thread>       threads;
+    for (itk::ThreadIdType i = 1; i < numberOfThreads; ++i)
+    {
+      threads.emplace_back([&numberOfStartedThreads, &release] {
+        const itk::MultiThreaderBase::WorkUnitScope scope;
+        ++numberOfStartedThreads;
+        while (!release)
+        {
+          std::this_thread::yield();
+        }
+      });
+    }
+    while (numberOfStartedThreads < numberOfThreads - 1)
+    {
+      std::this_thread::yield();
+    }
+    const itk::ThreadIdType numberOfBusyThreads = itk::MultiThreaderBase::GetGlobalNumberOfBusyThreads();
+    const itk::ThreadIdType numberOfWorkUnits =
+      itk::MultiThreaderBase::GetNumberOfWorkUnitsForCallingThread(4 * numberOfThreads);
+    release = true;
+    for (auto & thread : threads)
+    {
+      thread.join();
+    }
+    ITK_TEST_EXPECT_EQUAL(numberOfBusyThreads, numberOfThreads);
+    ITK_TEST_EXPECT_EQUAL(numberOfWorkUnits, 1);
+  }
+
+  ITK_TEST_EXPECT_EQUAL(itk::MultiThreaderBase::GetWorkUnitNestingLevel(), 0);
+  ITK_TEST_EXPECT_EQUAL(itk::MultiThreaderBase::GetGlobalNumberOfBusyThreads(), 0);
+  return EXIT_SUCCESS;
+}
+
+int
+TestNestedParallelizeArray(ThreaderEnum threaderType)
+{
+  itk::MultiThreaderBase::SetGlobalDefaultThreader(threaderType);
+
+  // Each outer iteration starts a parallel section of its own, like a
+  // composite filter updating an inner pipeline from a work unit
+  std::vector<std::atomic<int>>  visits(outerSize * innerSize);
+  std::atomic<itk::ThreadIdType> minimumOuterLevel{ itk::NumericTraits<itk::ThreadIdType>::max() };
+  std::atomic<itk::ThreadIdType> minimumInnerLevel{ itk::NumericTraits<itk::ThreadIdType>::max() };
+  const auto                     updateMinimum = [](std::atomic<itk::ThreadIdType> & minimum, itk::ThreadIdType value) {
+    itk::ThreadIdType current = minimum;
+    while (value < current && !minimum.compare_exchange_weak(current, value))
+    {
+    }
+  };
+
+  const auto outerThreader = itk::MultiThreaderBase::New();
+  outerThreader->ParallelizeArray(
+    0,
+    outerSize,
+    [&](itk::SizeValueType outer) {
+      updateMinimum(minimumOuterLevel, itk::MultiThreaderBase::GetWorkUnitNestingLevel());
+      const auto innerThreader = itk::MultiThreaderBase::New();
+      innerThreader->ParallelizeArray(
+        0,
+        innerSize,
+        [&, outer](itk::SizeValueType inner) {
+          updateMinimum(minimumInnerLevel, itk::MultiThreaderBase::GetWorkUnitNestingLevel());
+          ++visits[outer * innerSize + inner];
+        },
+        nullptr);
+    },
+    nullptr);
+
+  for (const auto & count : visits)
+  {
+    ITK_TEST_EXPECT_EQUAL(count, 1);
+  }
+  ITK_TEST_EXPECT_TRUE(minimumOuterLevel >= 1);
+  ITK_TEST_EXPECT_TRUE(minimumInnerLevel >= 1);
+  ITK_TEST_EXPECT_EQUAL(itk::MultiThreaderBase::GetWorkUnitNestingLevel(), 0);
+  ITK_TEST_EXPECT_EQUAL(itk::MultiThreaderBase::GetGlobalNumberOfBusyThreads(), 0);
+
+  // An exception thrown by any nested work unit reaches the outermost caller
+  ITK_TRY_EXPECT_EXCEPTION(outerThreader->ParallelizeArray(
+    0,
+    outerSize,
+    [](itk::SizeValueType outer) {
+      itk::MultiThreaderBase::New()->ParallelizeArray(
+        0,
+        innerSize,
+        [outer](itk::SizeValueType inner) {
+          if (outer == outerSize - 1 && inner == innerSize - 1)
+          {
+            itkGenericExceptionMacro("Exception in a nested work unit");
+          }
+        },
+        nullptr);
+    },
+    nullptr));
+  ITK_TEST_EXPECT_EQUAL(itk::MultiThreaderBase::GetGlobalNumberOfBusyThreads(), 0);
+
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkMultiThreaderNestedParallelismTest(int, char *[])
+{
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(numberOfThreads);
+
+  if (TestSchedulingContext() == EXIT_FAILURE)
+  {
+    std::cerr << "Test FAILED!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::set<ThreaderEnum> threadersToTest = {
+    ThreaderEnum::Platform,
+    ThreaderEnum::Pool,
+#ifdef ITK_USE_TBB
+    ThreaderEnum::TBB,
+#endif // ITK_USE_TBB
+    ThreaderEnum::WorkStealing,
+  };
+  for (auto threaderType : threadersToTest)
+  {
+    std::cout << "Testing nested parallel sections with the " << threaderType << " threader" << std::endl;
+    if (TestNestedParallelizeArray(threaderType) == EXIT_FAILURE)
+    {
+      std::cerr << "Test FAILED!" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test PASSED!" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImage.h"
+#include "itkPooledImageBufferAllocator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+
+ImageType::Pointer
+CreateImage(itk::SizeValueType sizeAlongX)
+{
+  auto                      image = ImageType::New();
+  const ImageType::SizeType size = { { sizeAlongX, 64, 32 } };
+  image->SetRegions(size);
+  return image;
+}
+} // namespace
+
+int
+itkPooledImageBufferAllocatorTest(int, char *[])
+{
+  auto allocator = itk::PooledImageBufferAllocator::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(allocator, PooledImageBufferAllocator, AlignedImageBufferAllocator);
+
+  ITK_TEST_EXPECT_EQUAL(allocator->GetMaximumNumberOfCachedBytes(), itk::SizeValueType{ 1 } << 30);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetMinimumPooledBufferSize(), itk::SizeValueType{ 1 } << 20);
+  ITK_TEST_EXPECT_TRUE(itk::ImageBufferAllocator::GetGlobalDefaultAllocator().IsNull());
+
+  // Use a small threshold, so that the buffers of the small images of this test are pooled
+  allocator->SetMinimumPooledBufferSize(4096);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetMinimumPooledBufferSize(), 4096);
+
+  // Size classes
+  ITK_TEST_EXPECT_EQUAL(allocator->GetBufferSize(100), 100);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetBufferSize(4096), 4096);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetBufferSize(4097), 8192);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetBufferSize(1 << 20), 1 << 20);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetBufferSize((1 << 20) + 1), (1 << 20) + (1 << 17));
+
+  // Direct allocations
+  void * const buffer = allocator->Allocate(100000);
+  allocator->Deallocate(buffer, 100000);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBuffers(), 1);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBytes(), allocator->GetBufferSize(100000));
+  // A request of the same size class gets the released buffer
+  ITK_TEST_EXPECT_EQUAL(allocator->Allocate(100001), buffer);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfReusedBuffers(), 1);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBuffers(), 0);
+  allocator->Deallocate(buffer, 100001);
+
+  // Small buffers are not pooled
+  void * const smallBuffer = allocator->Allocate(100);
+  allocator->Deallocate(smallBuffer, 100);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBuffers(), 1);
+
+  allocator->ReleaseCachedBuffers();
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBuffers(), 0);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBytes(), 0);
+
+  // Changing the threshold while buffers are allocated: a buffer allocated
+  // with its exact size is not pooled under a larger size class, and a
+  // rounded one is released with its rounded size.
+  allocator->SetMinimumPooledBufferSize(1 << 20);
+  void * const exactBuffer = allocator->Allocate(5000);
+  allocator->SetMinimumPooledBufferSize(4096);
+  void * const roundedBuffer = allocator->Allocate(5000);
+  allocator->Deallocate(exactBuffer, 5000);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBuffers(), 0);
+  allocator->Deallocate(roundedBuffer, 5000);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBytes(), allocator->GetBufferSize(5000));
+  ITK_TEST_EXPECT_EQUAL(allocator->Allocate(5000), roundedBuffer);
+  allocator->SetMinimumPooledBufferSize(1 << 20);
+  allocator->Deallocate(roundedBuffer, 5000);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBuffers(), 0);
+  allocator->SetMinimumPooledBufferSize(4096);
+
+  // Images using the allocator through the global default
+  itk::ImageBufferAllocator::SetGlobalDefaultAllocator(allocator);
+  ITK_TEST_EXPECT_EQUAL(itk::ImageBufferAllocator::GetGlobalDefaultAllocator(), allocator.GetPointer());
+  const itk::SizeValueType bufferSize = allocator->GetBufferSize(100 * 64 * 32 * sizeof(float));
+  {
+    const auto image = CreateImage(100);
+    image->Allocate(false);
+    image->FillBuffer(42.0f);
+  }
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBuffers(), 1);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBytes(), bufferSize);
+
+  // A zero-initialized image reusing a dirty buffer
+  {
+    const auto image = CreateImage(99);
+    image->Allocate(true);
+    ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfReusedBuffers(), 3);
+    ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBuffers(), 0);
+    const auto * const container = image->GetPixelContainer();
+    for (itk::SizeValueType i = 0; i < container->Size(); ++i)
+    {
+      ITK_TEST_EXPECT_EQUAL((*container)[i], 0.0f);
+    }
+
+    // Reallocation releases the previous buffer to the pool
+    image->SetRegions(CreateImage(200)->GetLargestPossibleRegion());
+    image->Allocate(false);
+    ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBuffers(), 1);
+  }
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBuffers(), 2);
+
+  // Lowering the maximum evicts the least recently released buffers
+  allocator->SetMaximumNumberOfCachedBytes(bufferSize);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetMaximumNumberOfCachedBytes(), bufferSize);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBuffers(), 0);
+  {
+    const auto image = CreateImage(100);
+    image->Allocate(false);
+  }
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBytes(), bufferSize);
+  {
+    // Larger than the maximum: freed on release
+    const auto image = CreateImage(200);
+    image->Allocate(false);
+  }
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBuffers(), 1);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBytes(), bufferSize);
+  itk::ImageBufferAllocator::SetGlobalDefaultAllocator(nullptr);
+
+  // An allocator set on a single container
+  auto containerAllocator = itk::PooledImageBufferAllocator::New();
+  containerAllocator->SetMinimumPooledBufferSize(4096);
+  {
+    const auto image = CreateImage(100);
+    image->GetPixelContainer()->SetBufferAllocator(containerAllocator);
+    ITK_TEST_EXPECT_EQUAL(image->GetPixelContainer()->GetBufferAllocator(), containerAllocator.GetPointer());
+    image->Allocate(true);
+  }
+  ITK_TEST_EXPECT_EQUAL(containerAllocator->GetNumberOfCachedBuffers(), 1);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetNumberOfCachedBuffers(), 1);
+
+  std::cout << "Test PASSED!" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -163,6 +163,15 @@ public:
     return this->EvaluateAtContinuousIndexInternal(x, m_ThreadedEvaluateIndex[threadId], m_ThreadedWeights[threadId]);
   }
 
+  /** Evaluate the function at several ContinuousIndex positions, see
+   * InterpolateImageFunction::EvaluateAtContinuousIndices(). The working
+   * space is allocated once for all the positions, and the coefficients
+   * are read through precomputed buffer offsets rather than by index. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const override;
+
   CovariantVectorType
   EvaluateDerivative(const PointType & point) const
   {
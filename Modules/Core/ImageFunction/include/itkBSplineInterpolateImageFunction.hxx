@@ -518,6 +518,57 @@ BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::Eval
   return interpolated;
 }
 
+template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+void
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::EvaluateAtContinuousIndices(
+  const ContinuousIndexType * indices,
+  OutputType *                values,
+  SizeValueType               numberOfIndices) const
+{
+  vnl_matrix<long>            evaluateIndex(ImageDimension, (m_SplineOrder + 1));
+  vnl_matrix<double>          weights(ImageDimension, (m_SplineOrder + 1));
+  vnl_matrix<OffsetValueType> evaluateOffset(ImageDimension, (m_SplineOrder + 1));
+
+  const TCoefficientType * const coefficients = m_Coefficients->GetBufferPointer();
+  const OffsetValueType * const  offsetTable = m_Coefficients->GetOffsetTable();
+  const IndexType                bufferStartIndex = m_Coefficients->GetBufferedRegion().GetIndex();
+
+  for (SizeValueType i = 0; i < numberOfIndices; ++i)
+  {
+    const ContinuousIndexType & x = indices[i];
+
+    // Same steps as EvaluateAtContinuousIndexInternal()
+    this->DetermineRegionOfSupport(evaluateIndex, x, m_SplineOrder);
+    SetInterpolationWeights(x, evaluateIndex, weights, m_SplineOrder);
+    this->ApplyMirrorBoundaryConditions(evaluateIndex, m_SplineOrder);
+
+    // The offset of a coefficient in the buffer is the sum of the offsets of
+    // its index along each dimension
+    for (unsigned int n = 0; n < ImageDimension; ++n)
+    {
+      for (unsigned int k = 0; k <= m_SplineOrder; ++k)
+      {
+        evaluateOffset[n][k] = (evaluateIndex[n][k] - bufferStartIndex[n]) * offsetTable[n];
+      }
+    }
+
+    double interpolated = 0.0;
+    for (unsigned int p = 0; p < m_MaxNumberInterpolationPoints; ++p)
+    {
+      double          w = 1.0;
+      OffsetValueType offset = 0;
+      for (unsigned int n = 0; n < ImageDimension; ++n)
+      {
+        const unsigned int indx = m_PointsToIndex[p][n];
+        w *= weights[n][indx];
+        offset += evaluateOffset[n][indx];
+      }
+      interpolated += w * coefficients[offset];
+    }
+    values[i] = interpolated;
+  }
+}
+
 template <typename TImageType, typename TCoordinate, typename TCoefficientType>
 void
 BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::
@@ -113,6 +113,27 @@ public:
   OutputType
   EvaluateAtContinuousIndex(const ContinuousIndexType & index) const override = 0;
 
+  /** Interpolate the image at several continuous index positions
+   *
+   * Sets values[i] to EvaluateAtContinuousIndex(indices[i]) for each of the
+   * numberOfIndices positions, typically the positions mapped from a line
+   * of output pixels by a resampling filter. No bounds checking is done.
+   *
+   * The default implementation calls EvaluateAtContinuousIndex() for each
+   * position. Subclasses may override it to avoid the virtual call per
+   * position, and to share the set up of the evaluation between positions.
+   * Just like EvaluateAtContinuousIndex(), it must be thread safe. */
+  virtual void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const
+  {
+    for (SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      values[i] = this->EvaluateAtContinuousIndex(indices[i]);
+    }
+  }
+
   /** Interpolate the image at an index position.
    *
    * Simply returns the image value at the
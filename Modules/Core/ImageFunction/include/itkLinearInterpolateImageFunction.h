@@ -104,6 +104,20 @@ public:
     return this->EvaluateOptimized(Dispatch<ImageDimension>(), index);
   }
 
+  /** Evaluate the function at several ContinuousIndex positions, see
+   * InterpolateImageFunction::EvaluateAtContinuousIndices(). The
+   * interpolation code is inlined in the loop over the positions. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const override
+  {
+    for (SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      values[i] = this->EvaluateOptimized(Dispatch<ImageDimension>(), indices[i]);
+    }
+  }
+
   SizeType
   GetRadius() const override
   {
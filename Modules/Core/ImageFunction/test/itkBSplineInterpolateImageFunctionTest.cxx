@@ -27,6 +27,7 @@
  *=========================================================================*/
 
 #include <iostream>
+#include <vector>
 
 #include "itkBSplineInterpolateImageFunction.h"
 
@@ -651,6 +652,48 @@ testEvaluateValueAndDerivative()
   return EXIT_SUCCESS;
 }
 
+// Test to verify that EvaluateAtContinuousIndices produces the same values as
+// EvaluateAtContinuousIndex, including near the borders of the image.
+int
+testEvaluateAtContinuousIndices()
+{
+  constexpr unsigned int ImageDimension{ 2 };
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, ImageDimension>;
+  using BSplineInterpolatorFunctionType = itk::BSplineInterpolateImageFunction<ImageType, double, double>;
+  using ContinuousIndexType = BSplineInterpolatorFunctionType::ContinuousIndexType;
+  using OutputType = BSplineInterpolatorFunctionType::OutputType;
+
+  std::vector<ContinuousIndexType> indices;
+  for (double x = 0.0; x <= 31.0; x += 0.7)
+  {
+    ContinuousIndexType index;
+    index[0] = x;
+    index[1] = 31.0 - 0.9 * x;
+    indices.push_back(index);
+  }
+
+  for (unsigned int splineOrder = 0; splineOrder <= 5; ++splineOrder)
+  {
+    const BSplineInterpolatorFunctionType::Pointer interpolator =
+      makeRandomImageInterpolator<BSplineInterpolatorFunctionType>(splineOrder);
+
+    std::vector<OutputType> values(indices.size());
+    interpolator->EvaluateAtContinuousIndices(indices.data(), values.data(), indices.size());
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+      const OutputType expectedValue = interpolator->EvaluateAtContinuousIndex(indices[i]);
+      if (itk::Math::NotExactlyEquals(values[i], expectedValue))
+      {
+        std::cout << "[ERROR] Spline order " << splineOrder << ", index " << indices[i] << ": " << values[i]
+                  << " != " << expectedValue << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
 int
 itkBSplineInterpolateImageFunctionTest(int itkNotUsed(argc), char * itkNotUsed(argv)[])
 {
@@ -670,6 +713,8 @@ itkBSplineInterpolateImageFunctionTest(int itkNotUsed(argc), char * itkNotUsed(a
 
   flag += testEvaluateValueAndDerivative();
 
+  flag += testEvaluateAtContinuousIndices();
+
   /* Return results of test */
   if (flag != 0)
   {
@@ -0,0 +1,240 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCompactCellsContainer_h
+#define itkCompactCellsContainer_h
+
+#include "itkCommonEnums.h"
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+
+#include <vector>
+
+namespace itk
+{
+/** \class CompactCellsContainer
+ * \brief Stores the cells of a mesh as flat arrays of cell types, offsets and point identifiers.
+ *
+ * Instead of one heap allocated CellInterface object per cell, the point
+ * identifiers of all the cells are stored one after the other in a single
+ * connectivity array. The point identifiers of the cell \c i are the
+ * elements <tt>[offsets[i], offsets[i + 1])</tt> of that array, and its
+ * geometry is given by the cell type tag \c i. This takes a fraction of the
+ * memory of the cell objects, and traversing the cells reads memory
+ * sequentially.
+ *
+ * The cells are identified by their position in the container, from 0 to
+ * Size() - 1, and are appended by InsertCell(). A Mesh can store its cells
+ * in such a container, see Mesh::SetCompactCells().
+ *
+ * \tparam TCellIdentifier The type of the cell identifiers.
+ * \tparam TPointIdentifier The type of the point identifiers.
+ *
+ * \ingroup MeshObjects
+ * \ingroup ITKMesh
+ */
+template <typename TCellIdentifier, typename TPointIdentifier>
+class ITK_TEMPLATE_EXPORT CompactCellsContainer : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CompactCellsContainer);
+
+  /** Standard class type aliases. */
+  using Self = CompactCellsContainer;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(CompactCellsContainer);
+
+  /** Save the template parameters. */
+  using CellIdentifier = TCellIdentifier;
+  using PointIdentifier = TPointIdentifier;
+
+  using CellGeometryEnum = CommonEnums::CellGeometry;
+  using PointIdConstIterator = const PointIdentifier *;
+
+  /** \class ConstIterator
+   * \brief Iterates over the cells of the container, in the order of their identifiers.
+   * \ingroup ITKMesh
+   */
+  class ConstIterator
+  {
+  public:
+    ConstIterator() = default;
+    ConstIterator(const Self * container, CellIdentifier cellId)
+      : m_Container(container)
+      , m_CellId(cellId)
+    {}
+
+    ConstIterator &
+    operator++()
+    {
+      ++m_CellId;
+      return *this;
+    }
+
+    bool
+    operator==(const ConstIterator & other) const
+    {
+      return m_CellId == other.m_CellId && m_Container == other.m_Container;
+    }
+
+    ITK_UNEQUAL_OPERATOR_MEMBER_FUNCTION(ConstIterator);
+
+    /** Returns the identifier of the current cell. */
+    [[nodiscard]] CellIdentifier
+    Index() const
+    {
+      return m_CellId;
+    }
+
+    /** Return the type and the point identifiers of the current cell. */
+    /** @ITKStartGrouping */
+    [[nodiscard]] CellGeometryEnum
+    GetType() const
+    {
+      return m_Container->GetCellType(m_CellId);
+    }
+    [[nodiscard]] unsigned int
+    GetNumberOfPoints() const
+    {
+      return m_Container->GetNumberOfPoints(m_CellId);
+    }
+    [[nodiscard]] PointIdConstIterator
+    PointIdsBegin() const
+    {
+      return m_Container->PointIdsBegin(m_CellId);
+    }
+    [[nodiscard]] PointIdConstIterator
+    PointIdsEnd() const
+    {
+      return m_Container->PointIdsEnd(m_CellId);
+    }
+    /** @ITKEndGrouping */
+
+  private:
+    const Self *   m_Container{};
+    CellIdentifier m_CellId{};
+  };
+
+  /** Appends a cell made of the given points, and returns its identifier. */
+  CellIdentifier
+  InsertCell(CellGeometryEnum cellType, const PointIdentifier * pointIds, unsigned int numberOfPoints);
+
+  /** Allocates the memory of numberOfCells cells, holding connectivitySize
+   * point identifiers in total, so that inserting them does not reallocate. */
+  void
+  Reserve(CellIdentifier numberOfCells, SizeValueType connectivitySize);
+
+  /** Releases the memory which is allocated but not used by the cells. */
+  void
+  Squeeze();
+
+  /** Removes all the cells. */
+  void
+  Initialize();
+
+  /** Returns the number of cells. */
+  [[nodiscard]] CellIdentifier
+  Size() const
+  {
+    return static_cast<CellIdentifier>(m_CellTypes.size());
+  }
+
+  /** Return the type and the point identifiers of a cell. The identifier
+   * of the cell must be less than Size(). */
+  /** @ITKStartGrouping */
+  [[nodiscard]] CellGeometryEnum
+  GetCellType(CellIdentifier cellId) const
+  {
+    return m_CellTypes[cellId];
+  }
+  [[nodiscard]] unsigned int
+  GetNumberOfPoints(CellIdentifier cellId) const
+  {
+    return static_cast<unsigned int>(m_Offsets[cellId + 1] - m_Offsets[cellId]);
+  }
+  [[nodiscard]] PointIdConstIterator
+  PointIdsBegin(CellIdentifier cellId) const
+  {
+    return m_Connectivity.data() + m_Offsets[cellId];
+  }
+  [[nodiscard]] PointIdConstIterator
+  PointIdsEnd(CellIdentifier cellId) const
+  {
+    return m_Connectivity.data() + m_Offsets[cellId + 1];
+  }
+  /** @ITKEndGrouping */
+
+  /** Iterate over the cells. */
+  /** @ITKStartGrouping */
+  [[nodiscard]] ConstIterator
+  Begin() const
+  {
+    return ConstIterator(this, 0);
+  }
+  [[nodiscard]] ConstIterator
+  End() const
+  {
+    return ConstIterator(this, this->Size());
+  }
+  /** @ITKEndGrouping */
+
+  /** Return the arrays in which the cells are stored: the type of each
+   * cell, the Size() + 1 offsets of the cells in the connectivity array,
+   * and the connectivity array itself. */
+  /** @ITKStartGrouping */
+  [[nodiscard]] const std::vector<CellGeometryEnum> &
+  GetCellTypes() const
+  {
+    return m_CellTypes;
+  }
+  [[nodiscard]] const std::vector<SizeValueType> &
+  GetOffsets() const
+  {
+    return m_Offsets;
+  }
+  [[nodiscard]] const std::vector<PointIdentifier> &
+  GetConnectivity() const
+  {
+    return m_Connectivity;
+  }
+  /** @ITKEndGrouping */
+
+protected:
+  CompactCellsContainer() = default;
+  ~CompactCellsContainer() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  std::vector<CellGeometryEnum> m_CellTypes{};
+  std::vector<SizeValueType>    m_Offsets{ 0 };
+  std::vector<PointIdentifier>  m_Connectivity{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkCompactCellsContainer.hxx"
+#endif
+
+#endif
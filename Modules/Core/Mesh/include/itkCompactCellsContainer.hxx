@@ -0,0 +1,78 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCompactCellsContainer_hxx
+#define itkCompactCellsContainer_hxx
+
+namespace itk
+{
+
+template <typename TCellIdentifier, typename TPointIdentifier>
+auto
+CompactCellsContainer<TCellIdentifier, TPointIdentifier>::InsertCell(CellGeometryEnum        cellType,
+                                                                     const PointIdentifier * pointIds,
+                                                                     unsigned int numberOfPoints) -> CellIdentifier
+{
+  const CellIdentifier cellId = this->Size();
+  m_CellTypes.push_back(cellType);
+  m_Connectivity.insert(m_Connectivity.end(), pointIds, pointIds + numberOfPoints);
+  m_Offsets.push_back(m_Connectivity.size());
+  this->Modified();
+  return cellId;
+}
+
+template <typename TCellIdentifier, typename TPointIdentifier>
+void
+CompactCellsContainer<TCellIdentifier, TPointIdentifier>::Reserve(CellIdentifier numberOfCells,
+                                                                  SizeValueType  connectivitySize)
+{
+  m_CellTypes.reserve(numberOfCells);
+  m_Offsets.reserve(numberOfCells + 1);
+  m_Connectivity.reserve(connectivitySize);
+}
+
+template <typename TCellIdentifier, typename TPointIdentifier>
+void
+CompactCellsContainer<TCellIdentifier, TPointIdentifier>::Squeeze()
+{
+  m_CellTypes.shrink_to_fit();
+  m_Offsets.shrink_to_fit();
+  m_Connectivity.shrink_to_fit();
+}
+
+template <typename TCellIdentifier, typename TPointIdentifier>
+void
+CompactCellsContainer<TCellIdentifier, TPointIdentifier>::Initialize()
+{
+  m_CellTypes.clear();
+  m_Offsets.assign(1, 0);
+  m_Connectivity.clear();
+  this->Modified();
+}
+
+template <typename TCellIdentifier, typename TPointIdentifier>
+void
+CompactCellsContainer<TCellIdentifier, TPointIdentifier>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number Of Cells: " << this->Size() << std::endl;
+  os << indent << "Connectivity Size: " << m_Connectivity.size() << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -33,6 +33,7 @@
 
 #include "itkBoundingBox.h"
 #include "itkCellInterface.h"
+#include "itkCompactCellsContainer.h"
 #include "itkMapContainer.h"
 #include "itkCommonEnums.h"
 #include "ITKMeshExport.h"
@@ -82,6 +83,10 @@ namespace itk
  * intersection does not need to be performed); then Mesh can be further
  * extended by adding explicit boundary assignments.
  *
+ * The cells of large meshes can instead be stored compactly, as flat arrays
+ * of cell types and point identifiers, see SetCompactCells(). ForEachCell()
+ * iterates over the cells in either case.
+ *
  * \par Usage
  * Mesh has three template parameters.  The first is the pixel type, or the
  * type of data stored (optionally) with points, cells, and/or boundaries.
@@ -187,6 +192,10 @@ public:
   using PointDataContainer = typename MeshTraits::PointDataContainer;
   using CellDataContainer = typename MeshTraits::CellDataContainer;
 
+  /** Stores the cells as flat arrays instead of cell objects. */
+  using CompactCellsContainer = itk::CompactCellsContainer<CellIdentifier, PointIdentifier>;
+  using CompactCellsContainerPointer = typename CompactCellsContainer::Pointer;
+
   /** For improving Python support for Triangle Meshes **/
   using CellsVectorContainer = typename itk::VectorContainer<IdentifierType>;
   using CellsVectorContainerPointer = typename CellsVectorContainer::Pointer;
@@ -299,6 +308,10 @@ protected:
    *  through cell identifiers.  */
   CellsContainerPointer m_CellsContainer{};
 
+  /** Holds the cells instead of m_CellsContainer, when they are stored
+   *  compactly. */
+  CompactCellsContainerPointer m_CompactCellsContainer{};
+
   CellsVectorContainerPointer cellOutputVectorContainer;
   /** An object containing data associated with the mesh's cells.
    *  Optionally, this can be nullptr, indicating that no data are associated
@@ -392,7 +405,8 @@ public:
   virtual CellsVectorContainer *
   GetCellsArray();
 
-  /** Get the cells container. */
+  /** Get the cells container. This is nullptr when the cells are stored
+   * compactly. */
   CellsContainer *
   GetCells();
 
@@ -400,6 +414,32 @@ public:
   const CellsContainer *
   GetCells() const;
 
+  /** Store the cells of the mesh as flat arrays of cell types and point
+   * identifiers, instead of one cell object per cell. The cells container
+   * is released, and GetCells() returns nullptr until SetCells() is called.
+   * GetNumberOfCells(), GetCell(), ForEachCell(), BuildCellLinks() and
+   * Accept() work with either storage, cell boundaries and SetCell() require
+   * cell objects. Passing nullptr goes back to an empty cells container. */
+  void
+  SetCompactCells(CompactCellsContainer *);
+
+  /** Get the container of the compactly stored cells, or nullptr when the
+   * cells are stored as cell objects. */
+  /** @ITKStartGrouping */
+  CompactCellsContainer *
+  GetCompactCells();
+  const CompactCellsContainer *
+  GetCompactCells() const;
+  /** @ITKEndGrouping */
+
+  /** Calls cellFunction(cellId, cellType, pointIdsBegin, pointIdsEnd) for
+   * each cell of the mesh, in the order of the cells container, whether the
+   * cells are stored as cell objects or compactly. The point identifiers
+   * are given as a range of PointIdentifier pointers. */
+  template <typename TCellFunction>
+  void
+  ForEachCell(TCellFunction && cellFunction) const;
+
   /** Set the cell data container, which contains data associated with
    *  the mesh's cells.  Optionally, this can be nullptr, indicating that
    *  no data are associated with the cells.  The data for a cell can
@@ -455,6 +495,8 @@ public:
    * Otherwise, false is returned, and the cell is not modified.
    * If the cell is nullptr, then it is never set, but the existence of the cell
    * is still returned.
+   * When the cells are stored compactly, a new cell object owned by the
+   * CellAutoPointer is created.
    */
   bool
   GetCell(CellIdentifier, CellAutoPointer &) const;
@@ -601,7 +643,7 @@ private:
 
   /** Create a new cell of a given type. */
   void
-  CreateCell(int cellType, CellAutoPointer &);
+  CreateCell(int cellType, CellAutoPointer &) const;
 }; // End Class: Mesh
 
 /** Define how to print enumeration */
@@ -42,7 +42,8 @@ Mesh<TPixelType, VDimension, TMeshTraits>::PrintSelf(std::ostream & os, Indent i
   os << indent << "Number Of Points: " << ((this->m_PointsContainer.GetPointer()) ? this->m_PointsContainer->Size() : 0)
      << std::endl;
   os << indent << "Number Of Cell Links: " << ((m_CellLinksContainer) ? m_CellLinksContainer->Size() : 0) << std::endl;
-  os << indent << "Number Of Cells: " << ((m_CellsContainer) ? m_CellsContainer->Size() : 0) << std::endl;
+  os << indent << "Number Of Cells: " << this->GetNumberOfCells() << std::endl;
+  os << indent << "Compact Cells: " << (m_CompactCellsContainer ? "On" : "Off") << std::endl;
   os << indent
      << "Cell Data Container pointer: " << ((m_CellDataContainer) ? m_CellDataContainer.GetPointer() : nullptr)
      << std::endl;
@@ -90,10 +91,63 @@ Mesh<TPixelType, VDimension, TMeshTraits>::SetCells(CellsContainer * cells)
   {
     this->ReleaseCellsMemory();
     m_CellsContainer = cells;
+    m_CompactCellsContainer = nullptr;
+    this->Modified();
+  }
+}
+
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+void
+Mesh<TPixelType, VDimension, TMeshTraits>::SetCompactCells(CompactCellsContainer * cells)
+{
+  itkDebugMacro("setting compact Cells container to " << cells);
+  if (m_CompactCellsContainer != cells)
+  {
+    this->ReleaseCellsMemory();
+    m_CompactCellsContainer = cells;
+    m_CellsContainer = cells ? nullptr : CellsContainer::New();
     this->Modified();
   }
 }
 
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+auto
+Mesh<TPixelType, VDimension, TMeshTraits>::GetCompactCells() -> CompactCellsContainer *
+{
+  return m_CompactCellsContainer;
+}
+
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+auto
+Mesh<TPixelType, VDimension, TMeshTraits>::GetCompactCells() const -> const CompactCellsContainer *
+{
+  return m_CompactCellsContainer;
+}
+
+template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
+template <typename TCellFunction>
+void
+Mesh<TPixelType, VDimension, TMeshTraits>::ForEachCell(TCellFunction && cellFunction) const
+{
+  if (m_CompactCellsContainer)
+  {
+    const auto end = m_CompactCellsContainer->End();
+    for (auto cellItr = m_CompactCellsContainer->Begin(); cellItr != end; ++cellItr)
+    {
+      cellFunction(cellItr.Index(), cellItr.GetType(), cellItr.PointIdsBegin(), cellItr.PointIdsEnd());
+    }
+  }
+  else if (m_CellsContainer)
+  {
+    const CellsContainerConstIterator end = m_CellsContainer->End();
+    for (CellsContainerConstIterator cellItr = m_CellsContainer->Begin(); cellItr != end; ++cellItr)
+    {
+      const CellType * cell = cellItr->Value();
+      cellFunction(cellItr->Index(), cell->GetType(), cell->PointIdsBegin(), cell->PointIdsEnd());
+    }
+  }
+}
+
 template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
 auto
 Mesh<TPixelType, VDimension, TMeshTraits>::GetCellsArray() -> CellsVectorContainer *
@@ -110,31 +164,25 @@ Mesh<TPixelType, VDimension, TMeshTraits>::GetCellsArray() -> CellsVectorContain
   }
 
   IdentifierType index = 0;
-  for (auto cellItr = m_CellsContainer->Begin(); cellItr != m_CellsContainer->End(); ++cellItr)
-  {
-    auto               cellPointer = cellItr->Value();
-    const unsigned int numOfPoints = cellPointer->GetNumberOfPoints();
-
+  this->ForEachCell([this, &index](CellIdentifier, CellGeometryEnum cellType, auto pointIdsBegin, auto pointIdsEnd) {
     // Insert the cell type
-    cellOutputVectorContainer->InsertElement(index++, static_cast<IdentifierType>(cellPointer->GetType()));
+    cellOutputVectorContainer->InsertElement(index++, static_cast<IdentifierType>(cellType));
     // Insert the number of points in the cell
-    cellOutputVectorContainer->InsertElement(index++, numOfPoints);
-
-    auto pointIds = cellPointer->GetPointIds();
+    cellOutputVectorContainer->InsertElement(index++, static_cast<IdentifierType>(pointIdsEnd - pointIdsBegin));
 
     // Insert the points in the cell
-    for (unsigned int i = 0; i < numOfPoints; ++i)
+    for (auto pointId = pointIdsBegin; pointId != pointIdsEnd; ++pointId)
     {
-      cellOutputVectorContainer->InsertElement(index++, pointIds[i]);
+      cellOutputVectorContainer->InsertElement(index++, *pointId);
     }
-  }
+  });
 
   return cellOutputVectorContainer;
 }
 
 template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
 void
-Mesh<TPixelType, VDimension, TMeshTraits>::CreateCell(int cellType, CellAutoPointer & cellPointer)
+Mesh<TPixelType, VDimension, TMeshTraits>::CreateCell(int cellType, CellAutoPointer & cellPointer) const
 {
   auto cellTypeEnum = static_cast<CellGeometryEnum>(cellType);
 
@@ -330,6 +378,11 @@ template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
 void
 Mesh<TPixelType, VDimension, TMeshTraits>::SetCell(CellIdentifier cellId, CellAutoPointer & cellPointer)
 {
+  if (m_CompactCellsContainer)
+  {
+    itkExceptionStringMacro("Cell objects cannot be inserted into compactly stored cells");
+  }
+
   /**
    * Make sure a cells container exists.
    */
@@ -348,6 +401,19 @@ template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
 bool
 Mesh<TPixelType, VDimension, TMeshTraits>::GetCell(CellIdentifier cellId, CellAutoPointer & cellPointer) const
 {
+  if (m_CompactCellsContainer)
+  {
+    if (cellId >= m_CompactCellsContainer->Size())
+    {
+      cellPointer.Reset();
+      return false;
+    }
+    this->CreateCell(static_cast<int>(m_CompactCellsContainer->GetCellType(cellId)), cellPointer);
+    cellPointer->SetPointIds(m_CompactCellsContainer->PointIdsBegin(cellId),
+                             m_CompactCellsContainer->PointIdsEnd(cellId));
+    return true;
+  }
+
   /**
    * If the cells container doesn't exist, then the cell doesn't exist.
    */
@@ -530,6 +596,11 @@ template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
 auto
 Mesh<TPixelType, VDimension, TMeshTraits>::GetNumberOfCells() const -> CellIdentifier
 {
+  if (m_CompactCellsContainer)
+  {
+    return m_CompactCellsContainer->Size();
+  }
+
   if (!m_CellsContainer)
   {
     return 0;
@@ -548,6 +619,7 @@ Mesh<TPixelType, VDimension, TMeshTraits>::Initialize()
   this->ReleaseCellsMemory();
 
   m_CellsContainer = nullptr;
+  m_CompactCellsContainer = nullptr;
   m_CellDataContainer = nullptr;
   m_CellLinksContainer = nullptr;
 }
@@ -887,6 +959,17 @@ template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
 void
 Mesh<TPixelType, VDimension, TMeshTraits>::Accept(CellMultiVisitorType * mv) const
 {
+  if (this->m_CompactCellsContainer)
+  {
+    CellAutoPointer cell;
+    for (CellIdentifier cellId = 0; cellId < this->m_CompactCellsContainer->Size(); ++cellId)
+    {
+      this->GetCell(cellId, cell);
+      cell->Accept(cellId, mv);
+    }
+    return;
+  }
+
   if (!this->m_CellsContainer)
   {
     return;
@@ -915,7 +998,7 @@ Mesh<TPixelType, VDimension, TMeshTraits>::BuildCellLinks() const
   /**
    * Make sure we have a cells and a points container.
    */
-  if (!this->m_PointsContainer || !m_CellsContainer)
+  if (!this->m_PointsContainer || (!m_CellsContainer && !m_CompactCellsContainer))
   {
     /**
      * TODO: Throw EXCEPTION here?
@@ -935,21 +1018,16 @@ Mesh<TPixelType, VDimension, TMeshTraits>::BuildCellLinks() const
    * Loop through each cell, and add its identifier to the CellLinks of each
    * of its points.
    */
-  for (CellsContainerIterator cellItr = m_CellsContainer->Begin(); cellItr != m_CellsContainer->End(); ++cellItr)
-  {
-    const CellIdentifier cellId = cellItr->Index();
-    CellType *           cellptr = cellItr->Value();
-
+  this->ForEachCell([this](CellIdentifier cellId, CellGeometryEnum, auto pointIdsBegin, auto pointIdsEnd) {
     /**
      * For each point, make sure the cell links container has its index,
      * and then insert the cell ID into the point's set.
      */
-    for (typename CellType::PointIdConstIterator pointId = cellptr->PointIdsBegin(); pointId != cellptr->PointIdsEnd();
-         ++pointId)
+    for (auto pointId = pointIdsBegin; pointId != pointIdsEnd; ++pointId)
     {
       (m_CellLinksContainer->CreateElementAt(*pointId)).insert(cellId);
     }
-  }
+  });
 }
 
 template <typename TPixelType, unsigned int VDimension, typename TMeshTraits>
@@ -1088,6 +1166,7 @@ Mesh<TPixelType, VDimension, TMeshTraits>::Graft(const DataObject * data)
 
   this->ReleaseCellsMemory();
   this->m_CellsContainer = mesh->m_CellsContainer;
+  this->m_CompactCellsContainer = mesh->m_CompactCellsContainer;
   this->m_CellDataContainer = mesh->m_CellDataContainer;
   this->m_CellLinksContainer = mesh->m_CellLinksContainer;
   this->m_BoundaryAssignmentsContainers = mesh->m_BoundaryAssignmentsContainers;
@@ -1110,7 +1189,8 @@ Mesh<TPixelType, VDimension, TMeshTraits>::DeleteUnusedCellData()
   std::vector<typename CellDataContainer::ElementIdentifier> cell_data_to_delete;
   for (auto it = this->GetCellData()->Begin(); it != this->GetCellData()->End(); ++it)
   {
-    if (!this->GetCells()->IndexExists(it.Index()))
+    if (m_CompactCellsContainer ? it.Index() >= m_CompactCellsContainer->Size()
+                                : !this->GetCells()->IndexExists(it.Index()))
     {
       cell_data_to_delete.push_back(it.Index());
     }
@@ -97,6 +97,21 @@ protected:
 
   void
   CopyInputMeshToOutputMeshCellData();
+
+  /** Makes the output mesh use the cells of the input mesh, rather than a
+   * copy of them, when both meshes are itk::Mesh objects of the same type.
+   * The cells are released by the last mesh using them. Otherwise the cells
+   * are copied by CopyInputMeshToOutputMeshCells(). */
+  void
+  ShareInputMeshCellsWithOutputMesh();
+
+  /** Reserves one output point per input point, and calls
+   * pointFunction(inputPoint, outputPoint) to compute each of them. The
+   * points are processed in parallel when both meshes store them in
+   * VectorContainers, so pointFunction must be thread safe. */
+  template <typename TPointFunction>
+  void
+  GenerateOutputMeshPoints(TPointFunction && pointFunction);
 };
 } // end namespace itk
 
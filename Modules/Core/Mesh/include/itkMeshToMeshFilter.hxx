@@ -29,6 +29,10 @@
 #define itkMeshToMeshFilter_hxx
 
 #include "itkMesh.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <type_traits>
 
 namespace itk
 {
@@ -172,6 +176,26 @@ MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshCells()
   using InputCellsContainer = typename TInputMesh::CellsContainer;
   using CellAutoPointer = typename TOutputMesh::CellAutoPointer;
 
+  // Compactly stored cells are copied as a whole
+  if (const auto * inputCompactCells = inputMesh->GetCompactCells())
+  {
+    using OutputCompactCellsContainer = typename TOutputMesh::CompactCellsContainer;
+    using OutputPointIdentifier = typename TOutputMesh::PointIdentifier;
+
+    auto outputCompactCells = OutputCompactCellsContainer::New();
+    outputCompactCells->Reserve(inputCompactCells->Size(), inputCompactCells->GetConnectivity().size());
+
+    std::vector<OutputPointIdentifier> pointIds;
+    inputMesh->ForEachCell([&outputCompactCells, &pointIds](
+                             auto, CellGeometryEnum cellType, auto pointIdsBegin, auto pointIdsEnd) {
+      pointIds.assign(pointIdsBegin, pointIdsEnd);
+      outputCompactCells->InsertCell(cellType, pointIds.data(), static_cast<unsigned int>(pointIds.size()));
+    });
+
+    outputMesh->SetCompactCells(outputCompactCells);
+    return;
+  }
+
   outputMesh->SetCellsAllocationMethod(MeshEnums::MeshClassCellsAllocationMethod::CellsAllocatedDynamicallyCellByCell);
 
   auto                        outputCells = OutputCellsContainer::New();
@@ -236,6 +260,95 @@ MeshToMeshFilter<TInputMesh, TOutputMesh>::CopyInputMeshToOutputMeshCellData()
     outputMesh->SetCellData(outputCellData);
   }
 }
+template <typename TInputMesh, typename TOutputMesh>
+void
+MeshToMeshFilter<TInputMesh, TOutputMesh>::ShareInputMeshCellsWithOutputMesh()
+{
+  if constexpr (std::is_same_v<TInputMesh, TOutputMesh> &&
+                std::is_same_v<TOutputMesh,
+                               Mesh<typename TOutputMesh::PixelType,
+                                    TOutputMesh::PointDimension,
+                                    typename TOutputMesh::MeshTraits>>)
+  {
+    const InputMeshType *   inputMesh = this->GetInput();
+    const OutputMeshPointer outputMesh = this->GetOutput();
+
+    // The pipeline is not const-correct so the const_casts are required here
+    if (const auto * inputCompactCells = inputMesh->GetCompactCells())
+    {
+      outputMesh->SetCompactCells(const_cast<typename TOutputMesh::CompactCellsContainer *>(inputCompactCells));
+    }
+    else
+    {
+      // The previous cells of the output are released before it takes the
+      // allocation method of the shared cells
+      outputMesh->SetCells(const_cast<typename TOutputMesh::CellsContainer *>(inputMesh->GetCells()));
+      outputMesh->SetCellsAllocationMethod(inputMesh->GetCellsAllocationMethod());
+    }
+  }
+  else
+  {
+    this->CopyInputMeshToOutputMeshCells();
+  }
+}
+
+template <typename TInputMesh, typename TOutputMesh>
+template <typename TPointFunction>
+void
+MeshToMeshFilter<TInputMesh, TOutputMesh>::GenerateOutputMeshPoints(TPointFunction && pointFunction)
+{
+  using InputPointsContainer = typename TInputMesh::PointsContainer;
+  using OutputPointsContainer = typename TOutputMesh::PointsContainer;
+
+  const InputPointsContainer *  inPoints = this->GetInput()->GetPoints();
+  OutputPointsContainer * const outPoints = this->GetOutput()->GetPoints();
+
+  outPoints->Reserve(inPoints->Size());
+  outPoints->Squeeze(); // in case the previous mesh had
+                        // allocated a larger memory
+
+  if constexpr (std::is_same_v<InputPointsContainer,
+                               VectorContainer<typename TInputMesh::PointIdentifier, typename TInputMesh::PointType>> &&
+                std::is_same_v<OutputPointsContainer,
+                               VectorContainer<typename TOutputMesh::PointIdentifier, typename TOutputMesh::PointType>>)
+  {
+    // Each work unit processes a contiguous range of points
+    const auto &        inputPoints = inPoints->CastToSTLConstContainer();
+    auto &              outputPoints = outPoints->CastToSTLContainer();
+    const SizeValueType numberOfPoints = inputPoints.size();
+    const SizeValueType numberOfWorkUnits =
+      std::min(numberOfPoints, static_cast<SizeValueType>(this->GetNumberOfWorkUnits()));
+    if (numberOfWorkUnits == 0)
+    {
+      return;
+    }
+
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      numberOfWorkUnits,
+      [&](SizeValueType workUnit) {
+        const SizeValueType end = numberOfPoints * (workUnit + 1) / numberOfWorkUnits;
+        for (SizeValueType id = numberOfPoints * workUnit / numberOfWorkUnits; id < end; ++id)
+        {
+          pointFunction(inputPoints[id], outputPoints[id]);
+        }
+      },
+      this);
+  }
+  else
+  {
+    typename InputPointsContainer::ConstIterator inputPoint = inPoints->Begin();
+    typename OutputPointsContainer::Iterator     outputPoint = outPoints->Begin();
+
+    while (inputPoint != inPoints->End())
+    {
+      pointFunction(inputPoint.Value(), outputPoint.Value());
+
+      ++inputPoint;
+      ++outputPoint;
+    }
+  }
+}
 } // end namespace itk
 
 #endif
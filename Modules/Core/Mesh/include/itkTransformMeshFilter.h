@@ -31,6 +31,9 @@ namespace itk
  *
  * The additional content of the mesh is passed untouched. Including the
  * connectivity and the additional information contained on cells and points.
+ * The points are processed in parallel when they are stored in
+ * VectorContainers, and the output mesh shares the cells of the input mesh
+ * when both have the same type.
  *
  * Meshes that have added information like normal vector on the points, will
  * have to take care of transforming this data by other means.
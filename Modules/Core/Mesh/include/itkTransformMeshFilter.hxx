@@ -51,12 +51,6 @@ template <typename TInputMesh, typename TOutputMesh, typename TTransform>
 void
 TransformMeshFilter<TInputMesh, TOutputMesh, TTransform>::GenerateData()
 {
-  using InputPointsContainer = typename TInputMesh::PointsContainer;
-  using OutputPointsContainer = typename TOutputMesh::PointsContainer;
-
-  using InputPointsContainerConstPointer = typename TInputMesh::PointsContainerConstPointer;
-  using OutputPointsContainerPointer = typename TOutputMesh::PointsContainerPointer;
-
   const InputMeshType *   inputMesh = this->GetInput();
   const OutputMeshPointer outputMesh = this->GetOutput();
 
@@ -77,32 +71,19 @@ TransformMeshFilter<TInputMesh, TOutputMesh, TTransform>::GenerateData()
 
   outputMesh->SetBufferedRegion(outputMesh->GetRequestedRegion());
 
-  const InputPointsContainerConstPointer inPoints = inputMesh->GetPoints();
-  const OutputPointsContainerPointer     outPoints = outputMesh->GetPoints();
-
-  outPoints->Reserve(inputMesh->GetNumberOfPoints());
-  outPoints->Squeeze(); // in case the previous mesh had
-                        // allocated a larger memory
-
-  typename InputPointsContainer::ConstIterator inputPoint = inPoints->Begin();
-  typename OutputPointsContainer::Iterator     outputPoint = outPoints->Begin();
-
-  while (inputPoint != inPoints->End())
-  {
-    outputPoint.Value() = m_Transform->TransformPoint(inputPoint.Value());
-
-    ++inputPoint;
-    ++outputPoint;
-  }
+  // The points are transformed in parallel
+  const TransformType * transform = m_Transform;
+  this->GenerateOutputMeshPoints([transform](const auto & inputPoint, auto & outputPoint) {
+    outputPoint = transform->TransformPoint(inputPoint);
+  });
 
   // Create duplicate references to the rest of data on the mesh
   this->CopyInputMeshToOutputMeshPointData();
   this->CopyInputMeshToOutputMeshCellLinks();
-  this->CopyInputMeshToOutputMeshCells();
+  this->ShareInputMeshCellsWithOutputMesh();
   this->CopyInputMeshToOutputMeshCellData();
 
   // FIXME: DELETEME outputMesh->SetCellLinks(  inputMesh->GetCellLinks() );
-  // FIXME: DELETEME outputMesh->SetCells(  inputMesh->GetCells() );
   // FIXME: DELETEME outputMesh->SetCellData(  inputMesh->GetCellData() );
 
   const unsigned int maxDimension = TInputMesh::MaxTopologicalDimension;
@@ -359,16 +359,8 @@ TriangleMeshToBinaryImageFilter<TInputMesh, TOutputImage>::RasterizeTriangles()
   Point1DArray zymatrix(zInc * zSize);
   PointVector  coords;
 
-  const CellsContainerPointer cells = input->GetCells();
-  CellsContainerIterator      cellIt = cells->Begin();
-
-  while (cellIt != cells->End())
-  {
-    CellType *                         nextCell = cellIt->Value();
-    typename CellType::PointIdIterator pointIt = nextCell->PointIdsBegin();
-    PointType                          p;
-
-    switch (nextCell->GetType())
+  input->ForEachCell([&](auto, CellGeometryEnum cellType, auto pointIdsBegin, auto pointIdsEnd) {
+    switch (cellType)
     {
       case CellGeometryEnum::VERTEX_CELL:
       case CellGeometryEnum::LINE_CELL:
@@ -377,12 +369,13 @@ TriangleMeshToBinaryImageFilter<TInputMesh, TOutputImage>::RasterizeTriangles()
       case CellGeometryEnum::POLYGON_CELL:
       {
         coords.clear();
-        while (pointIt != nextCell->PointIdsEnd())
+        for (auto pointIt = pointIdsBegin; pointIt != pointIdsEnd; ++pointIt)
         {
-          if (!NewPointSet->GetPoint(*pointIt++, &newpoint))
+          if (!NewPointSet->GetPoint(*pointIt, &newpoint))
           {
-            itkExceptionMacro("Point with id " << *pointIt - 1 << " does not exist in the new pointset");
+            itkExceptionMacro("Point with id " << *pointIt << " does not exist in the new pointset");
           }
+          PointType p;
           p[0] = newpoint[0];
           p[1] = newpoint[1];
           p[2] = newpoint[2];
@@ -394,8 +387,7 @@ TriangleMeshToBinaryImageFilter<TInputMesh, TOutputImage>::RasterizeTriangles()
       default:
         itkExceptionStringMacro("Need Triangle or Polygon cells ONLY");
     }
-    ++cellIt;
-  }
+  });
 
   const OutputImagePointer outputImage = this->GetOutput();
   outputImage->FillBuffer(m_OutsideValue);
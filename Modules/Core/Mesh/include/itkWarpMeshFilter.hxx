@@ -68,11 +68,6 @@ template <typename TInputMesh, typename TOutputMesh, typename TDisplacementField
 void
 WarpMeshFilter<TInputMesh, TOutputMesh, TDisplacementField>::GenerateData()
 {
-  using InputPointsContainer = typename TInputMesh::PointsContainer;
-  using OutputPointsContainer = typename TOutputMesh::PointsContainer;
-
-  using OutputPointsContainerPointer = typename TOutputMesh::PointsContainerPointer;
-
   const InputMeshType *          inputMesh = this->GetInput();
   const OutputMeshPointer        outputMesh = this->GetOutput();
   const DisplacementFieldPointer fieldPtr = this->GetDisplacementField();
@@ -89,46 +84,28 @@ WarpMeshFilter<TInputMesh, TOutputMesh, TDisplacementField>::GenerateData()
 
   outputMesh->SetBufferedRegion(outputMesh->GetRequestedRegion());
 
-  const InputPointsContainer *       inPoints = inputMesh->GetPoints();
-  const OutputPointsContainerPointer outPoints = outputMesh->GetPoints();
-
-  outPoints->Reserve(inputMesh->GetNumberOfPoints());
-  outPoints->Squeeze(); // in case the previous mesh had
-                        // allocated a larger memory
-
-  typename InputPointsContainer::ConstIterator inputPoint = inPoints->Begin();
-  typename OutputPointsContainer::Iterator     outputPoint = outPoints->Begin();
-
   using InputPointType = typename InputMeshType::PointType;
   using OutputPointType = typename OutputMeshType::PointType;
 
-  OutputPointType displacedPoint;
-
-  DisplacementType displacement;
+  const DisplacementFieldType * field = fieldPtr;
+  const unsigned int            Dimension = field->GetImageDimension();
 
-  const unsigned int Dimension = fieldPtr->GetImageDimension();
+  // The points are displaced in parallel
+  this->GenerateOutputMeshPoints(
+    [field, Dimension](const InputPointType & originalPoint, OutputPointType & displacedPoint) {
+      const auto             index = field->TransformPhysicalPointToIndex(originalPoint);
+      const DisplacementType displacement = field->GetPixel(index);
 
-  while (inputPoint != inPoints->End())
-  {
-    const InputPointType & originalPoint = inputPoint.Value();
-    const auto             index = fieldPtr->TransformPhysicalPointToIndex(originalPoint);
-    displacement = fieldPtr->GetPixel(index);
-
-    for (unsigned int i = 0; i < Dimension; ++i)
-    {
-      displacedPoint[i] = originalPoint[i] + displacement[i];
-    }
-
-    outputPoint.Value() = displacedPoint;
-
-    ++inputPoint;
-    ++outputPoint;
-  }
+      for (unsigned int i = 0; i < Dimension; ++i)
+      {
+        displacedPoint[i] = originalPoint[i] + displacement[i];
+      }
+    });
 
   // Create duplicate references to the rest of data on the mesh
 
   this->CopyInputMeshToOutputMeshPointData();
-  this->CopyInputMeshToOutputMeshCells();
+  this->ShareInputMeshCellsWithOutputMesh();
   this->CopyInputMeshToOutputMeshCellLinks();
   this->CopyInputMeshToOutputMeshCellData();
 
@@ -0,0 +1,167 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegionConstIterator.h"
+#include "itkMesh.h"
+#include "itkRegularSphereMeshSource.h"
+#include "itkTestingMacros.h"
+#include "itkTransformMeshFilter.h"
+#include "itkTranslationTransform.h"
+#include "itkTriangleMeshToBinaryImageFilter.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+using MeshType = itk::Mesh<float, Dimension>;
+using CompactCellsContainer = MeshType::CompactCellsContainer;
+using PointIdentifier = MeshType::PointIdentifier;
+using ImageType = itk::Image<unsigned char, Dimension>;
+
+// Returns a copy of the mesh, with its cells stored compactly
+MeshType::Pointer
+CreateCompactMesh(const MeshType * mesh)
+{
+  auto cells = CompactCellsContainer::New();
+  mesh->ForEachCell([&cells](MeshType::CellIdentifier,
+                             itk::CellGeometryEnum        cellType,
+                             const PointIdentifier *      pointIdsBegin,
+                             const PointIdentifier *      pointIdsEnd) {
+    cells->InsertCell(cellType, pointIdsBegin, static_cast<unsigned int>(pointIdsEnd - pointIdsBegin));
+  });
+
+  auto compactMesh = MeshType::New();
+  compactMesh->SetPoints(const_cast<MeshType::PointsContainer *>(mesh->GetPoints()));
+  compactMesh->SetCompactCells(cells);
+  return compactMesh;
+}
+
+ImageType::Pointer
+Rasterize(MeshType * mesh)
+{
+  auto filter = itk::TriangleMeshToBinaryImageFilter<MeshType, ImageType>::New();
+  filter->SetInput(mesh);
+  ImageType::SizeType size;
+  size.Fill(32);
+  filter->SetSize(size);
+  ImageType::PointType origin;
+  origin.Fill(-16.0);
+  filter->SetOrigin(origin);
+  filter->Update();
+  return filter->GetOutput();
+}
+} // namespace
+
+int
+itkMeshCompactCellsTest(int, char *[])
+{
+  // The cells are stored one after the other
+  auto cells = CompactCellsContainer::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(cells, CompactCellsContainer, Object);
+  cells->Reserve(3, 10);
+  const std::vector<PointIdentifier> triangle = { 0, 1, 2 };
+  const std::vector<PointIdentifier> polygon = { 1, 3, 4, 2 };
+  const std::vector<PointIdentifier> line = { 4, 5, 6 };
+  ITK_TEST_EXPECT_EQUAL(cells->InsertCell(itk::CellGeometryEnum::TRIANGLE_CELL, triangle.data(), 3), 0);
+  ITK_TEST_EXPECT_EQUAL(cells->InsertCell(itk::CellGeometryEnum::POLYGON_CELL, polygon.data(), 4), 1);
+  ITK_TEST_EXPECT_EQUAL(cells->InsertCell(itk::CellGeometryEnum::POLYLINE_CELL, line.data(), 3), 2);
+  ITK_TEST_EXPECT_EQUAL(cells->Size(), 3);
+  ITK_TEST_EXPECT_EQUAL(cells->GetConnectivity().size(), 10);
+  ITK_TEST_EXPECT_TRUE((cells->GetOffsets() == std::vector<itk::SizeValueType>{ 0, 3, 7, 10 }));
+  ITK_TEST_EXPECT_EQUAL(cells->GetCellType(1), itk::CellGeometryEnum::POLYGON_CELL);
+  ITK_TEST_EXPECT_EQUAL(cells->GetNumberOfPoints(1), 4);
+  ITK_TEST_EXPECT_TRUE(std::equal(polygon.cbegin(), polygon.cend(), cells->PointIdsBegin(1), cells->PointIdsEnd(1)));
+
+  auto mesh = MeshType::New();
+  for (PointIdentifier pointId = 0; pointId < 7; ++pointId)
+  {
+    mesh->SetPoint(pointId, MeshType::PointType(static_cast<float>(pointId)));
+  }
+  mesh->SetCompactCells(cells);
+  ITK_TEST_EXPECT_TRUE(mesh->GetCompactCells() == cells);
+  ITK_TEST_EXPECT_TRUE(mesh->GetCells() == nullptr);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfCells(), 3);
+
+  // The mesh iterates over the cells as over cell objects
+  std::vector<PointIdentifier> pointIds;
+  mesh->ForEachCell([&pointIds](MeshType::CellIdentifier,
+                                itk::CellGeometryEnum,
+                                const PointIdentifier * pointIdsBegin,
+                                const PointIdentifier * pointIdsEnd) {
+    pointIds.insert(pointIds.end(), pointIdsBegin, pointIdsEnd);
+  });
+  ITK_TEST_EXPECT_TRUE(pointIds == cells->GetConnectivity());
+
+  // and creates them on request
+  MeshType::CellAutoPointer cell;
+  ITK_TEST_EXPECT_TRUE(mesh->GetCell(1, cell));
+  ITK_TEST_EXPECT_EQUAL(cell->GetType(), itk::CellGeometryEnum::POLYGON_CELL);
+  ITK_TEST_EXPECT_TRUE(std::equal(polygon.cbegin(), polygon.cend(), cell->PointIdsBegin(), cell->PointIdsEnd()));
+  ITK_TEST_EXPECT_TRUE(!mesh->GetCell(3, cell));
+  MeshType::CellAutoPointer newCell;
+  newCell.TakeOwnership(new itk::TriangleCell<MeshType::CellType>);
+  ITK_TRY_EXPECT_EXCEPTION(mesh->SetCell(3, newCell));
+
+  mesh->BuildCellLinks();
+  ITK_TEST_EXPECT_EQUAL(mesh->GetCellLinks()->GetElement(2).size(), 2);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetCellLinks()->GetElement(4).size(), 2);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetCellsArray()->Size(), 2 * 3 + 10);
+
+  // The filters use either storage
+  using TransformType = itk::TranslationTransform<double, Dimension>;
+  auto transform = TransformType::New();
+  transform->SetOffset(TransformType::OutputVectorType(2.0));
+  auto transformFilter = itk::TransformMeshFilter<MeshType, MeshType, TransformType>::New();
+  transformFilter->SetInput(mesh);
+  transformFilter->SetTransform(transform);
+  ITK_TRY_EXPECT_NO_EXCEPTION(transformFilter->Update());
+  const MeshType * transformedMesh = transformFilter->GetOutput();
+  ITK_TEST_EXPECT_TRUE(transformedMesh->GetCompactCells() == cells);
+  ITK_TEST_EXPECT_EQUAL(transformedMesh->GetPoint(3)[0], 5.0f);
+
+  auto sphereSource = itk::RegularSphereMeshSource<MeshType>::New();
+  sphereSource->SetScale(MeshType::PointType::VectorType(10.0));
+  sphereSource->SetResolution(3);
+  sphereSource->Update();
+  MeshType * sphere = sphereSource->GetOutput();
+  const auto compactSphere = CreateCompactMesh(sphere);
+  ITK_TEST_EXPECT_EQUAL(compactSphere->GetNumberOfCells(), sphere->GetNumberOfCells());
+
+  const auto image = Rasterize(sphere);
+  const auto compactImage = Rasterize(compactSphere);
+  itk::ImageRegionConstIterator<ImageType> it(image, image->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> compactIt(compactImage, compactImage->GetLargestPossibleRegion());
+  unsigned int                             numberOfInsidePixels = 0;
+  for (; !it.IsAtEnd(); ++it, ++compactIt)
+  {
+    ITK_TEST_EXPECT_EQUAL(compactIt.Get(), it.Get());
+    numberOfInsidePixels += it.Get() == 1;
+  }
+  ITK_TEST_EXPECT_TRUE(numberOfInsidePixels > 0);
+
+  // Going back to cell objects
+  mesh->SetCompactCells(nullptr);
+  ITK_TEST_EXPECT_TRUE(mesh->GetCells() != nullptr);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfCells(), 0);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -84,6 +84,16 @@ itkTransformMeshFilterTest(int, char *[])
     }
   }
 
+  // and a few cells
+  for (MeshType::CellIdentifier cellId = 0; cellId < 3; ++cellId)
+  {
+    MeshType::CellAutoPointer cell;
+    cell.TakeOwnership(new itk::TriangleCell<MeshType::CellType>);
+    const MeshType::PointIdentifier pointIds[] = { cellId, cellId + 1, cellId + 2 };
+    cell->SetPointIds(pointIds);
+    inputMesh->SetCell(cellId, cell);
+  }
+
   std::cout << "Input Mesh has " << inputMesh->GetNumberOfPoints();
   std::cout << "   points " << std::endl;
 
@@ -121,7 +131,8 @@ itkTransformMeshFilterTest(int, char *[])
   filterwithbasetrfs->SetInput(inputMesh);
   filterwithbasetrfs->SetTransform(affineTransform);
 
-  // Execute the filter
+  // Execute the filter, the points being shared by a few work units
+  filter->SetNumberOfWorkUnits(4);
   filter->Update();
   std::cout << "Filter: " << filter;
 
@@ -166,6 +177,18 @@ itkTransformMeshFilterTest(int, char *[])
     ++itfwb;
   }
 
+  // The points are transformed in order
+  ITK_TEST_EXPECT_EQUAL(outputMesh->GetNumberOfPoints(), inputMesh->GetNumberOfPoints());
+  for (MeshType::PointIdentifier pointId = 0; pointId < inputMesh->GetNumberOfPoints(); ++pointId)
+  {
+    const PointType expectedPoint = affineTransform->TransformPoint(inputMesh->GetPoint(pointId));
+    ITK_TEST_EXPECT_TRUE(outputMesh->GetPoint(pointId) == expectedPoint);
+  }
+
+  // and the output mesh shares the cells of the input mesh
+  ITK_TEST_EXPECT_TRUE(outputMesh->GetCells() == inputMesh->GetCells());
+  ITK_TEST_EXPECT_EQUAL(outputMesh->GetNumberOfCells(), 3);
+
   // All objects should be automatically destroyed at this point
 
   return EXIT_SUCCESS;
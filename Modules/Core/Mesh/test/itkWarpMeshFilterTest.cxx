@@ -145,6 +145,10 @@ itkWarpMeshFilterTest(int, char *[])
     ++inputPoint;
     ++outputPoint;
   }
+  ITK_TEST_EXPECT_EQUAL(outPoints->Size(), inPoints->Size());
+
+  // The output mesh shares the cells of the input mesh
+  ITK_TEST_EXPECT_TRUE(outputMesh->GetCells() == inputMesh->GetCells());
 
   return EXIT_SUCCESS;
 }
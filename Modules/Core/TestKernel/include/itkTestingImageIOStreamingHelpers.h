@@ -0,0 +1,118 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkTestingImageIOStreamingHelpers_h
+#define itkTestingImageIOStreamingHelpers_h
+
+#include "itkImageFileReader.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkStreamingImageFilter.h"
+
+#include <algorithm>
+#include <iostream>
+
+/** \file
+ * Helpers of the tests reading regions of images from files, to check that
+ * an ImageIO reads the right pixels when streaming.
+ * \ingroup ITKTestKernel
+ */
+
+namespace itk::Testing
+{
+/** Fills the buffered region of a scalar image with values which differ
+ * along each dimension and between neighboring rows, so that pixels read at
+ * the wrong place are detected. The values are negated if negate is true. */
+template <typename TImage>
+void
+FillWithIndexPattern(TImage * image, bool negate = false)
+{
+  constexpr unsigned int               dimension = TImage::ImageDimension;
+  constexpr IndexValueType             factors[] = { 1, 3, -100 };
+  ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const typename TImage::IndexType index = it.GetIndex();
+    IndexValueType                   value = (index[0] * index[std::min(1u, dimension - 1)]) % 7;
+    for (unsigned int i = 0; i < std::min(3u, dimension); ++i)
+    {
+      value += factors[i] * index[i];
+    }
+    it.Set(static_cast<typename TImage::PixelType>(negate ? -value : value));
+  }
+}
+
+/** Returns whether the buffered region of an image holds the same pixels as
+ * this region of the expected image, reporting the first differing pixel. */
+template <typename TImage>
+bool
+HasExpectedPixels(const TImage * image, const TImage * expectedImage)
+{
+  ImageRegionConstIteratorWithIndex<TImage> it(image, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != expectedImage->GetPixel(it.GetIndex()))
+    {
+      std::cerr << "Pixel " << it.GetIndex() << " is " << it.Get() << " instead of "
+                << expectedImage->GetPixel(it.GetIndex()) << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+/** Reads a region of an image with the given ImageIO, or the one created by
+ * the factories if it is null. */
+template <typename TImage>
+typename TImage::Pointer
+ReadImageRegion(const std::string &                 fileName,
+                const typename TImage::RegionType & region,
+                ImageIOBase *                       imageIO = nullptr)
+{
+  auto reader = ImageFileReader<TImage>::New();
+  reader->SetFileName(fileName);
+  if (imageIO != nullptr)
+  {
+    reader->SetImageIO(imageIO);
+  }
+  reader->UpdateOutputInformation();
+  reader->GetOutput()->SetRequestedRegion(region);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+/** Reads a whole image in the given number of streamed pieces with the given
+ * ImageIO, or the one created by the factories if it is null. */
+template <typename TImage>
+typename TImage::Pointer
+ReadImageStreamed(const std::string & fileName, unsigned int numberOfStreamDivisions, ImageIOBase * imageIO = nullptr)
+{
+  auto reader = ImageFileReader<TImage>::New();
+  reader->SetFileName(fileName);
+  if (imageIO != nullptr)
+  {
+    reader->SetImageIO(imageIO);
+  }
+  reader->SetUseStreaming(true);
+  auto streamer = StreamingImageFilter<TImage, TImage>::New();
+  streamer->SetInput(reader->GetOutput());
+  streamer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+  streamer->Update();
+  return streamer->GetOutput();
+}
+} // namespace itk::Testing
+
+#endif
@@ -45,6 +45,12 @@ namespace itk
  * the pipeline. The SetConstant() and GetConstant() methods are provided as shortcuts
  * to set or get the constant value without manipulating the decorator.
  *
+ * When the functor also processes whole scanlines (see
+ * Functor::IsScanlineFunctor_v) and the images store their lines
+ * contiguously, the functor is called once per line of the output region
+ * rather than once per pixel, with a constant passed as a line filled with
+ * its value.
+ *
  * \sa UnaryGeneratorImageFilter
  * \sa BinaryFunctorImageFilter
  *
@@ -19,8 +19,10 @@
 #define itkBinaryGeneratorImageFilter_hxx
 
 #include "itkImageScanlineIterator.h"
+#include "itkScanlineFunctorTraits.h"
 #include "itkTotalProgressReporter.h"
 
+#include <vector>
 
 namespace itk
 {
@@ -186,7 +188,62 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
-  if (inputPtr1 && inputPtr2)
+  constexpr bool processesScanlines =
+    Functor::HasContiguousScanlines_v<TInputImage1> && Functor::HasContiguousScanlines_v<TInputImage2> &&
+    Functor::HasContiguousScanlines_v<TOutputImage> &&
+    Functor::IsScanlineFunctor_v<TFunctor, OutputImagePixelType, Input1ImagePixelType, Input2ImagePixelType>;
+
+  if constexpr (processesScanlines)
+  {
+    if (!inputPtr1 && !inputPtr2)
+    {
+      itkGenericExceptionMacro("At most one of the inputs can be a constant.");
+    }
+
+    // The functor processes whole lines, which lie contiguously in the
+    // buffers. A constant is passed as a line filled with its value.
+    const SizeValueType lineLength = outputRegionForThread.GetSize()[0];
+
+    ImageScanlineConstIterator<TInputImage1> inputIt1;
+    ImageScanlineConstIterator<TInputImage2> inputIt2;
+    std::vector<Input1ImagePixelType>        constantLine1;
+    std::vector<Input2ImagePixelType>        constantLine2;
+    if (inputPtr1)
+    {
+      inputIt1 = ImageScanlineConstIterator<TInputImage1>(inputPtr1, outputRegionForThread);
+    }
+    else
+    {
+      constantLine1.assign(lineLength, this->GetConstant1());
+    }
+    if (inputPtr2)
+    {
+      inputIt2 = ImageScanlineConstIterator<TInputImage2>(inputPtr2, outputRegionForThread);
+    }
+    else
+    {
+      constantLine2.assign(lineLength, this->GetConstant2());
+    }
+    ImageScanlineIterator outputIt(outputPtr, outputRegionForThread);
+
+    while (!outputIt.IsAtEnd())
+    {
+      const Input1ImagePixelType * line1 = inputPtr1 ? &inputIt1.Value() : constantLine1.data();
+      const Input2ImagePixelType * line2 = inputPtr2 ? &inputIt2.Value() : constantLine2.data();
+      functor(line1, line2, &outputIt.Value(), lineLength);
+      if (inputPtr1)
+      {
+        inputIt1.NextLine();
+      }
+      if (inputPtr2)
+      {
+        inputIt2.NextLine();
+      }
+      outputIt.NextLine();
+      progress.Completed(lineLength);
+    }
+  }
+  else if (inputPtr1 && inputPtr2)
   {
     ImageScanlineConstIterator inputIt1(inputPtr1, outputRegionForThread);
     ImageScanlineConstIterator inputIt2(inputPtr2, outputRegionForThread);
@@ -0,0 +1,158 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFusedFunctorImageFilter_h
+#define itkFusedFunctorImageFilter_h
+
+#include "itkUnaryGeneratorImageFilter.h"
+
+#include <tuple>
+
+namespace itk
+{
+namespace Functor
+{
+/** \class Fused
+ * \brief Applies a sequence of unary functors one after the other.
+ *
+ * Fused<F1, F2, ..., Fn> computes Fn(...F2(F1(x))) for each pixel x, so
+ * that a chain of pixel-wise operations is evaluated as a single one. The
+ * intermediate values are the return types of the functors, and do not need
+ * to be pixel types of any image.
+ *
+ * The functor also processes whole scanlines (see
+ * Functor::IsScanlineFunctor_v), with a single loop over the pixels which
+ * applies all the functors to each of them.
+ *
+ * \sa FusedFunctorImageFilter
+ * \ingroup ITKImageFilterBase
+ */
+template <typename... TFunctors>
+class ITK_TEMPLATE_EXPORT Fused
+{
+public:
+  static_assert(sizeof...(TFunctors) > 0, "At least one functor must be fused.");
+
+  Fused() = default;
+
+  explicit Fused(const TFunctors &... functors)
+    : m_Functors(functors...)
+  {}
+
+  template <typename TInput>
+  inline auto
+  operator()(const TInput & input) const
+  {
+    return this->Apply<0>(input);
+  }
+
+  /** Processes numberOfPixels pixels at once, see Functor::IsScanlineFunctor_v. */
+  template <typename TInput, typename TOutput>
+  void
+  operator()(const TInput * input, TOutput * output, SizeValueType numberOfPixels) const
+  {
+    ApplyToScanline(*this, output, numberOfPixels, input);
+  }
+
+private:
+  template <size_t VIndex, typename TValue>
+  inline auto
+  Apply(const TValue & value) const
+  {
+    if constexpr (VIndex + 1 == sizeof...(TFunctors))
+    {
+      return std::get<VIndex>(m_Functors)(value);
+    }
+    else
+    {
+      return this->Apply<VIndex + 1>(std::get<VIndex>(m_Functors)(value));
+    }
+  }
+
+  std::tuple<TFunctors...> m_Functors{};
+};
+} // end namespace Functor
+
+
+/** \class FusedFunctorImageFilter
+ * \brief Applies a chain of pixel-wise operations in a single pass over the image.
+ *
+ * A pipeline of pixel-wise filters, like
+ * Subtract -> Multiply -> Clamp -> Cast, allocates and fills one full image
+ * per filter, and reads it back in the next one. Since these filters do very
+ * little work per pixel, such a pipeline is limited by the memory bandwidth.
+ * This filter takes the functors of the stages instead, and applies all of
+ * them to each pixel while reading the input image once and writing the
+ * output image once:
+ *
+ * \code
+ *   auto filter = itk::FusedFunctorImageFilter<InputImageType, OutputImageType>::New();
+ *   filter->SetInput(image);
+ *   filter->SetFunctors([](float x) { return x - 100.0f; },
+ *                       [](float x) { return 0.5f * x; },
+ *                       clampFunctor);
+ * \endcode
+ *
+ * The first functor takes InputImagePixelType, each following functor takes
+ * the return type of the previous one, and the value returned by the last
+ * functor is converted to OutputImagePixelType. Like with
+ * UnaryGeneratorImageFilter::SetFunctor(), the functors are copied and the
+ * copies are shared by all the threads. When the images store their lines
+ * contiguously, the fused functor runs a single loop per line, which the
+ * compiler can vectorize when the functors are inlined.
+ *
+ * \sa Functor::Fused
+ * \sa UnaryGeneratorImageFilter
+ *
+ * \ingroup IntensityImageFilters MultiThreaded
+ * \ingroup ITKImageFilterBase
+ */
+template <typename TInputImage, typename TOutputImage = TInputImage>
+class ITK_TEMPLATE_EXPORT FusedFunctorImageFilter : public UnaryGeneratorImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(FusedFunctorImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = FusedFunctorImageFilter;
+  using Superclass = UnaryGeneratorImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(FusedFunctorImageFilter);
+
+#if !defined(ITK_WRAPPING_PARSER)
+  /** Set the functors applied one after the other to each pixel. */
+  template <typename... TFunctors>
+  void
+  SetFunctors(const TFunctors &... functors)
+  {
+    this->SetFunctor(Functor::Fused<TFunctors...>(functors...));
+  }
+#endif // !defined( ITK_WRAPPING_PARSER )
+
+protected:
+  FusedFunctorImageFilter() = default;
+  ~FusedFunctorImageFilter() override = default;
+};
+} // end namespace itk
+
+#endif
@@ -30,6 +30,11 @@ namespace itk
  * and the type of the output image.  It is also parameterized by the
  * operation to be applied, using a Functor style.
  *
+ * When the functor also processes whole scanlines (see
+ * Functor::IsScanlineFunctor_v) and all the images store their lines
+ * contiguously, the functor is called once per line of the output region
+ * rather than once per pixel.
+ *
  * \sa BinaryFunctorImageFilter UnaryFunctorImageFilter
  *
  * \ingroup IntensityImageFilters MultiThreaded
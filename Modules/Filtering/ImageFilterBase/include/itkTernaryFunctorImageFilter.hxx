@@ -19,6 +19,7 @@
 #define itkTernaryFunctorImageFilter_hxx
 
 #include "itkImageScanlineIterator.h"
+#include "itkScanlineFunctorTraits.h"
 #include "itkTotalProgressReporter.h"
 
 namespace itk
@@ -135,21 +136,44 @@ TernaryFunctorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage
   ImageScanlineConstIterator inputIt3(inputPtr3, outputRegionForThread);
   ImageScanlineIterator      outputIt(outputPtr, outputRegionForThread);
 
-  while (!inputIt1.IsAtEnd())
+  if constexpr (Functor::HasContiguousScanlines_v<TInputImage1> && Functor::HasContiguousScanlines_v<TInputImage2> &&
+                Functor::HasContiguousScanlines_v<TInputImage3> && Functor::HasContiguousScanlines_v<TOutputImage> &&
+                Functor::IsScanlineFunctor_v<TFunction,
+                                             OutputImagePixelType,
+                                             Input1ImagePixelType,
+                                             Input2ImagePixelType,
+                                             Input3ImagePixelType>)
   {
-    while (!inputIt1.IsAtEndOfLine())
+    // The functor processes whole lines, which lie contiguously in the buffers
+    const SizeValueType lineLength = outputRegionForThread.GetSize()[0];
+    while (!inputIt1.IsAtEnd())
     {
-      outputIt.Set(m_Functor(inputIt1.Get(), inputIt2.Get(), inputIt3.Get()));
-      ++inputIt1;
-      ++inputIt2;
-      ++inputIt3;
-      ++outputIt;
+      m_Functor(&inputIt1.Value(), &inputIt2.Value(), &inputIt3.Value(), &outputIt.Value(), lineLength);
+      inputIt1.NextLine();
+      inputIt2.NextLine();
+      inputIt3.NextLine();
+      outputIt.NextLine();
+      progress.Completed(lineLength);
+    }
+  }
+  else
+  {
+    while (!inputIt1.IsAtEnd())
+    {
+      while (!inputIt1.IsAtEndOfLine())
+      {
+        outputIt.Set(m_Functor(inputIt1.Get(), inputIt2.Get(), inputIt3.Get()));
+        ++inputIt1;
+        ++inputIt2;
+        ++inputIt3;
+        ++outputIt;
+      }
+      inputIt1.NextLine();
+      inputIt2.NextLine();
+      inputIt3.NextLine();
+      outputIt.NextLine();
+      progress.Completed(outputRegionForThread.GetSize()[0]);
     }
-    inputIt1.NextLine();
-    inputIt2.NextLine();
-    inputIt3.NextLine();
-    outputIt.NextLine();
-    progress.Completed(outputRegionForThread.GetSize()[0]);
   }
 }
 } // end namespace itk
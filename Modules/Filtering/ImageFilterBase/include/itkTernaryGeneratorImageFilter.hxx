@@ -19,6 +19,7 @@
 #define itkTernaryGeneratorImageFilter_hxx
 
 #include "itkImageScanlineIterator.h"
+#include "itkScanlineFunctorTraits.h"
 #include "itkTotalProgressReporter.h"
 
 namespace itk
@@ -259,6 +260,15 @@ TernaryGeneratorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputIma
   std::unique_ptr<ImageScanlineConstIterator<TInputImage3>> inputIt3;
   ImageScanlineIterator                                     outputIt(outputPtr, outputRegionForThread);
 
+  constexpr bool processesScanlines =
+    Functor::HasContiguousScanlines_v<TInputImage1> && Functor::HasContiguousScanlines_v<TInputImage2> &&
+    Functor::HasContiguousScanlines_v<TInputImage3> && Functor::HasContiguousScanlines_v<TOutputImage> &&
+    Functor::IsScanlineFunctor_v<TFunctor,
+                                 OutputImagePixelType,
+                                 Input1ImagePixelType,
+                                 Input2ImagePixelType,
+                                 Input3ImagePixelType>;
+
   if (inputPtr1 && inputPtr2 && inputPtr3)
   {
     inputIt1 = std::make_unique<ImageScanlineConstIterator<TInputImage1>>(inputPtr1, outputRegionForThread);
@@ -267,13 +277,25 @@ TernaryGeneratorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputIma
 
     while (!outputIt.IsAtEnd())
     {
-      while (!outputIt.IsAtEndOfLine())
+      if constexpr (processesScanlines)
       {
-        outputIt.Set(functor(inputIt1->Get(), inputIt2->Get(), inputIt3->Get()));
-        ++*inputIt1;
-        ++*inputIt2;
-        ++*inputIt3;
-        ++outputIt;
+        // The functor processes whole lines, which lie contiguously in the buffers
+        functor(&inputIt1->Value(),
+                &inputIt2->Value(),
+                &inputIt3->Value(),
+                &outputIt.Value(),
+                outputRegionForThread.GetSize()[0]);
+      }
+      else
+      {
+        while (!outputIt.IsAtEndOfLine())
+        {
+          outputIt.Set(functor(inputIt1->Get(), inputIt2->Get(), inputIt3->Get()));
+          ++*inputIt1;
+          ++*inputIt2;
+          ++*inputIt3;
+          ++outputIt;
+        }
       }
       inputIt1->NextLine();
       inputIt2->NextLine();
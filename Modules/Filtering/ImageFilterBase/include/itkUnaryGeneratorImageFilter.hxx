@@ -20,6 +20,7 @@
 
 #include "itkImageScanlineIterator.h"
 #include "itkProgressReporter.h"
+#include "itkScanlineFunctorTraits.h"
 #include "itkTotalProgressReporter.h"
 
 namespace itk
@@ -97,17 +98,32 @@ UnaryGeneratorImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDat
   ImageScanlineConstIterator inputIt(inputPtr, inputRegionForThread);
   ImageScanlineIterator      outputIt(outputPtr, outputRegionForThread);
 
-  while (!inputIt.IsAtEnd())
+  if constexpr (Functor::HasContiguousScanlines_v<TInputImage> && Functor::HasContiguousScanlines_v<TOutputImage> &&
+                Functor::IsScanlineFunctor_v<TFunctor, OutputImagePixelType, InputImagePixelType>)
   {
-    while (!inputIt.IsAtEndOfLine())
+    // The functor processes whole lines, which lie contiguously in the buffers
+    while (!inputIt.IsAtEnd())
     {
-      outputIt.Set(functor(inputIt.Get()));
-      ++inputIt;
-      ++outputIt;
+      functor(&inputIt.Value(), &outputIt.Value(), regionSize[0]);
+      progress.Completed(regionSize[0]);
+      inputIt.NextLine();
+      outputIt.NextLine();
+    }
+  }
+  else
+  {
+    while (!inputIt.IsAtEnd())
+    {
+      while (!inputIt.IsAtEndOfLine())
+      {
+        outputIt.Set(functor(inputIt.Get()));
+        ++inputIt;
+        ++outputIt;
+      }
+      progress.Completed(regionSize[0]);
+      inputIt.NextLine();
+      outputIt.NextLine();
     }
-    progress.Completed(regionSize[0]);
-    inputIt.NextLine();
-    outputIt.NextLine();
   }
 }
 } // end namespace itk
@@ -0,0 +1,109 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkCastImageFilter.h"
+#include "itkClampImageFilter.h"
+#include "itkFusedFunctorImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkMultiplyImageFilter.h"
+#include "itkRandomImageSource.h"
+#include "itkSubtractImageFilter.h"
+#include "itkTestingMacros.h"
+#include "itkTimeProbe.h"
+
+// Compares the chain Subtract -> Multiply -> Clamp -> Cast, run as four
+// filters and as a single FusedFunctorImageFilter, and reports their timings.
+int
+itkFusedFunctorImageFilterTest(int argc, char * argv[])
+{
+  constexpr unsigned int Dimension = 3;
+  using InputImageType = itk::Image<float, Dimension>;
+  using OutputImageType = itk::Image<unsigned char, Dimension>;
+
+  const itk::SizeValueType imageSize = argc > 1 ? std::stoul(argv[1]) : 128;
+  constexpr unsigned int   numberOfRuns = 5;
+
+  auto source = itk::RandomImageSource<InputImageType>::New();
+  source->SetSize(InputImageType::SizeType::Filled(imageSize));
+  source->SetMin(0.0);
+  source->SetMax(1000.0);
+  source->Update();
+  const InputImageType::Pointer input = source->GetOutput();
+
+  constexpr float offset = 100.0f;
+  constexpr float scale = 0.5f;
+
+  auto subtract = itk::SubtractImageFilter<InputImageType>::New();
+  subtract->SetInput1(input);
+  subtract->SetConstant2(offset);
+  auto multiply = itk::MultiplyImageFilter<InputImageType>::New();
+  multiply->SetInput1(subtract->GetOutput());
+  multiply->SetConstant2(scale);
+  auto clamp = itk::ClampImageFilter<InputImageType, InputImageType>::New();
+  clamp->SetInput(multiply->GetOutput());
+  clamp->SetBounds(0.0f, 255.0f);
+  auto cast = itk::CastImageFilter<InputImageType, OutputImageType>::New();
+  cast->SetInput(clamp->GetOutput());
+
+  itk::Functor::Clamp<float, float> clampFunctor;
+  clampFunctor.SetBounds(0.0f, 255.0f);
+
+  using FusedFilterType = itk::FusedFunctorImageFilter<InputImageType, OutputImageType>;
+  auto fused = FusedFilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(fused, FusedFunctorImageFilter, UnaryGeneratorImageFilter);
+  fused->SetInput(input);
+  fused->SetFunctors([](float value) { return value - offset; },
+                     [](float value) { return value * scale; },
+                     clampFunctor);
+
+  itk::TimeProbe chainProbe;
+  itk::TimeProbe fusedProbe;
+  for (unsigned int run = 0; run < numberOfRuns; ++run)
+  {
+    subtract->Modified();
+    chainProbe.Start();
+    cast->Update();
+    chainProbe.Stop();
+
+    fused->Modified();
+    fusedProbe.Start();
+    fused->Update();
+    fusedProbe.Stop();
+  }
+
+  itk::ImageRegionConstIterator<OutputImageType> chainIt(cast->GetOutput(), cast->GetOutput()->GetBufferedRegion());
+  itk::ImageRegionConstIterator<OutputImageType> fusedIt(fused->GetOutput(), fused->GetOutput()->GetBufferedRegion());
+  for (; !chainIt.IsAtEnd(); ++chainIt, ++fusedIt)
+  {
+    if (fusedIt.Get() != chainIt.Get())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error at index " << fusedIt.GetIndex() << ": expected " << static_cast<int>(chainIt.Get())
+                << ", got " << static_cast<int>(fusedIt.Get()) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Image size: " << input->GetLargestPossibleRegion().GetSize() << std::endl;
+  std::cout << "Four filters average time: " << chainProbe.GetMean() << chainProbe.GetUnit() << std::endl;
+  std::cout << "Fused filter average time: " << fusedProbe.GetMean() << fusedProbe.GetUnit() << std::endl;
+  std::cout << "The fused filter is " << chainProbe.GetMean() / fusedProbe.GetMean() << " times faster" << std::endl;
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
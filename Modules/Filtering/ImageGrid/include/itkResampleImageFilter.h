@@ -21,12 +21,19 @@
 #include "itkFixedArray.h"
 #include "itkTransform.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
 #include "itkImageToImageFilter.h"
 #include "itkExtrapolateImageFunction.h"
 #include "itkLinearInterpolateImageFunction.h"
 #include "itkSize.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkDataObjectDecorator.h"
+#include "itkScanlineFunctorTraits.h"
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 
 namespace itk
@@ -71,6 +78,13 @@ namespace itk
  *
  * This filter is implemented as a multithreaded filter.  It provides a
  * DynamicThreadedGenerateData() method for its implementation.
+ * When the transform is linear and maps each output axis to the same input
+ * axis, like an identity, a translation or a scaling with matching
+ * directions, and the interpolator is a LinearInterpolateImageFunction or a
+ * NearestNeighborInterpolateImageFunction, the filter computes the input
+ * positions and interpolation weights once per axis, see
+ * SeparableThreadedGenerateData(). This speeds up upsampling and
+ * downsampling of images of scalar pixels.
  * \warning For multithreading, the TransformPoint method of the
  * user-designated coordinate transform must be threadsafe.
  *
@@ -278,6 +292,40 @@ public:
   itkBooleanMacro(UseReferenceImage);
   itkGetConstMacro(UseReferenceImage, bool);
   /** @ITKEndGrouping */
+
+  /** Turn on/off whether the positions in the input image to which the
+   *  transform maps the output pixels are kept after an update, to be
+   *  reused by the next updates. Resampling several images with the same
+   *  geometry, like the channels or time points of an acquisition, through
+   *  the same transform onto the same output grid then only evaluates the
+   *  transform for the first image, and just interpolates the other ones:
+   *
+   *  \code
+   *    filter->CacheMappedIndicesOn();
+   *    for (const auto & image : images)
+   *    {
+   *      filter->SetInput(image);
+   *      filter->Update();
+   *      outputs.push_back(filter->GetOutput());
+   *      outputs.back()->DisconnectPipeline();
+   *    }
+   *  \endcode
+   *
+   *  The positions are computed again when the transform, one of the
+   *  transforms of a CompositeTransform, the output region or the geometry
+   *  of the input or output image changes. A transform whose parameters,
+   *  like the pixels of a displacement field, are changed in place must be
+   *  marked with Modified() for the change to be noticed.
+   *  The cache takes one ContinuousIndex per output pixel, which is stored
+   *  with the TInterpolatorPrecisionType precision: float halves its size.
+   *  It is released by the first update with CacheMappedIndices off. It is
+   *  not used by separable resampling, which does not map the pixels one by
+   *  one, nor for SpecialCoordinatesImage images. The default is off. */
+  /** @ITKStartGrouping */
+  itkSetMacro(CacheMappedIndices, bool);
+  itkBooleanMacro(CacheMappedIndices);
+  itkGetConstMacro(CacheMappedIndices, bool);
+  /** @ITKEndGrouping */
   itkConceptMacro(OutputHasNumericTraitsCheck, (Concept::HasNumericTraits<PixelComponentType>));
 
 protected:
@@ -348,6 +396,14 @@ protected:
   virtual void
   LinearThreadedGenerateData(const OutputImageRegionType & outputRegionForThread);
 
+  /** Implementation for resampling with a linear transformation which maps
+   * each output axis to the same input axis, like a translation or a scaling
+   * with matching directions, and a linear or nearest neighbor interpolator.
+   * The interpolation weights are then products of weights along each axis,
+   * which are computed once per axis by BeforeThreadedGenerateData(). */
+  virtual void
+  SeparableThreadedGenerateData(const OutputImageRegionType & outputRegionForThread);
+
 #if !defined(ITK_LEGACY_REMOVE)
   /** Cast pixel from interpolator output to PixelType. */
   itkLegacyMacro(virtual PixelType CastPixelWithBoundsChecking(const InterpolatorOutputType value,
@@ -373,6 +429,72 @@ private:
   void
   InitializeTransform();
 
+  /** Per-thread buffers holding the positions in the input image of a line
+   * of output pixels. */
+  struct ScanlineBuffers
+  {
+    std::vector<ContinuousInputIndexType> inputIndices;
+    std::vector<bool>                     isInside;
+    std::vector<ContinuousInputIndexType> insideIndices;
+    std::vector<InterpolatorOutputType>   insideValues;
+  };
+
+  /** Sets the pixels of the current line of outIt, from the positions
+   * buffers.inputIndices of these pixels in the input image. The positions
+   * inside the input buffer are interpolated with a single call to
+   * InterpolatorType::EvaluateAtContinuousIndices(), the other ones are
+   * extrapolated or set to the default pixel value. */
+  void
+  SetScanline(ImageScanlineIterator<TOutputImage> & outIt, ScanlineBuffers & buffers) const;
+
+  /** Whether SeparableThreadedGenerateData() supports the image types: the
+   * input image must have as many dimensions as the output image, and store
+   * scalar pixels in its buffer. */
+  static constexpr bool SupportsSeparableResampling =
+    InputImageDimension == OutputImageDimension && std::is_arithmetic_v<InputPixelType> &&
+    Functor::HasContiguousScanlines_v<InputImageType>;
+
+  /** Position in the input image of an output pixel index along one axis,
+   * for SeparableThreadedGenerateData(). */
+  struct SeparableSample
+  {
+    TInterpolatorPrecisionType position{};   // Continuous index along the input axis
+    TInterpolatorPrecisionType distance{};   // Interpolation weight of the next pixel, 0 if it is not used
+    OffsetValueType            offset{};     // Buffer offset of the (lower) nearest pixel along the axis
+    OffsetValueType            nextOffset{}; // Buffer offset of the next pixel along the axis
+    bool                       isInside{};   // Whether position is inside the buffer of the interpolator
+  };
+
+  /** Implementation for resampling with the positions in m_MappedIndices. */
+  void
+  MappedIndicesThreadedGenerateData(const OutputImageRegionType & outputRegionForThread);
+
+  /** Sets whether m_MappedIndices is read or written by the coming update. */
+  void
+  PrepareMappedIndices();
+
+  /** Returns the latest modification time of the transform, and of the
+   * transforms it is composed of when it is a MultiTransform, like a
+   * CompositeTransform, since modifying these does not modify it. */
+  static ModifiedTimeType
+  GetTransformMTime(const TransformType * transform);
+
+  /** Copies the positions of the line of output pixels starting at lineIndex
+   * to m_MappedIndices, when the update writes it. */
+  void
+  StoreMappedIndices(const IndexType & lineIndex, const ScanlineBuffers & buffers);
+
+  /** Computes m_SeparableSamples, and returns whether SeparableThreadedGenerateData()
+   * can be used for the current transform, interpolator and images. */
+  bool
+  ComputeSeparableSamples();
+
+  /** Interpolates the input buffer at the pixel given by samples[0..VDimension],
+   * from the pixel at the buffer offset given by the samples of the higher axes. */
+  template <unsigned int VDimension>
+  static InterpolatorOutputType
+  InterpolateSeparable(const InputPixelType * buffer, const SeparableSample * const * samples, OffsetValueType offset);
+
   SizeType                m_Size{};         // Size of the output image
   InterpolatorPointerType m_Interpolator{}; // Image function for
                                             // interpolation
@@ -386,6 +508,31 @@ private:
   DirectionType   m_OutputDirection{};      // output image direction cosines
   IndexType       m_OutputStartIndex{};     // output image start index
   bool            m_UseReferenceImage{ false };
+
+  // For each output axis, the samples of the output pixel indices of the
+  // largest possible region, when SeparableThreadedGenerateData() is used
+  std::array<std::vector<SeparableSample>, OutputImageDimension> m_SeparableSamples{};
+  bool                                                            m_UseSeparableResampling{ false };
+
+  // What determines the positions in the input image of the output pixels
+  using MappedIndicesKeyType = std::tuple<const TransformType *,
+                                          ModifiedTimeType,
+                                          OutputImageRegionType,
+                                          OriginPointType,
+                                          SpacingType,
+                                          DirectionType,
+                                          typename InputImageType::PointType,
+                                          typename InputImageType::SpacingType,
+                                          typename InputImageType::DirectionType>;
+
+  // The positions in the input image of the pixels of the output buffer, when
+  // CacheMappedIndices is on, and what they were computed from
+  bool                                  m_CacheMappedIndices{ false };
+  std::vector<ContinuousInputIndexType> m_MappedIndices{};
+  MappedIndicesKeyType                  m_MappedIndicesKey{};
+  bool                                  m_MappedIndicesAreValid{ false };
+  bool                                  m_ReadMappedIndices{ false };
+  bool                                  m_WriteMappedIndices{ false };
 };
 } // end namespace itk
 
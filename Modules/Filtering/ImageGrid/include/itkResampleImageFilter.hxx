@@ -26,9 +26,12 @@
 #include "itkSpecialCoordinatesImage.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkImageAlgorithm.h"
+#include "itkMultiTransform.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
 
 #include <algorithm>   // For max.
 #include <type_traits> // For is_same.
+#include <typeinfo>
 
 namespace itk
 {
@@ -180,6 +183,9 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
       PixelConvertType::SetNthComponent(n, m_DefaultPixelValue, zeroComponent);
     }
   }
+
+  m_UseSeparableResampling = this->ComputeSeparableSamples();
+  this->PrepareMappedIndices();
 }
 
 template <typename TInputImage,
@@ -197,6 +203,14 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
     // Disconnect input image from the extrapolator
     m_Extrapolator->SetInputImage(nullptr);
   }
+
+  m_SeparableSamples = {};
+  m_UseSeparableResampling = false;
+
+  // The positions written by this update can be read by the next ones
+  m_MappedIndicesAreValid = m_MappedIndicesAreValid || m_WriteMappedIndices;
+  m_ReadMappedIndices = false;
+  m_WriteMappedIndices = false;
 }
 
 template <typename TInputImage,
@@ -218,6 +232,18 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
     return;
   }
 
+  if (m_UseSeparableResampling)
+  {
+    this->SeparableThreadedGenerateData(outputRegionForThread);
+    return;
+  }
+
+  if (m_ReadMappedIndices)
+  {
+    this->MappedIndicesThreadedGenerateData(outputRegionForThread);
+    return;
+  }
+
   const bool isSpecialCoordinatesImage =
     ((dynamic_cast<const InputSpecialCoordinatesImageType *>(this->GetInput()) != nullptr) ||
      (dynamic_cast<const OutputSpecialCoordinatesImageType *>(this->GetOutput()) != nullptr));
@@ -378,45 +404,32 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
   const bool isSpecialCoordinatesImage = (dynamic_cast<const InputSpecialCoordinatesImageType *>(inputPtr) != nullptr);
 
 
-  // Create an iterator that will walk the output region for this thread.
-  using OutputIterator = ImageRegionIteratorWithIndex<TOutputImage>;
-
-  using OutputType = typename InterpolatorType::OutputType;
+  const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+  ScanlineBuffers     buffers;
+  buffers.inputIndices.resize(lineLength);
+  buffers.isInside.resize(lineLength);
 
-  // Walk the output region
-  for (OutputIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); ++outIt)
+  // Walk the output region, one line at a time
+  for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
   {
-    // Determine the index of the current output pixel
-
-    OutputPointType outputPoint; // Coordinates of current output pixel
-    outputPtr->TransformIndexToPhysicalPoint(outIt.GetIndex(), outputPoint);
-
-    // Compute corresponding input pixel position
-    const InputPointType inputPoint = transformPtr->TransformPoint(outputPoint);
+    IndexType index = outIt.GetIndex();
+    for (SizeValueType i = 0; i < lineLength; ++i, ++index[0])
+    {
+      OutputPointType outputPoint; // Coordinates of current output pixel
+      outputPtr->TransformIndexToPhysicalPoint(index, outputPoint);
 
-    ContinuousInputIndexType inputIndex;
-    const bool               isInsideInput = inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
+      // Compute corresponding input pixel position
+      const InputPointType inputPoint = transformPtr->TransformPoint(outputPoint);
 
-    OutputType value;
-    // Evaluate input at right position and copy to the output
-    if (m_Interpolator->IsInsideBuffer(inputIndex) && (!isSpecialCoordinatesImage || isInsideInput))
-    {
-      value = m_Interpolator->EvaluateAtContinuousIndex(inputIndex);
-      outIt.Set(Self::CastPixelWithBoundsChecking(value));
+      ContinuousInputIndexType & inputIndex = buffers.inputIndices[i];
+      const bool isInsideInput = inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
+      buffers.isInside[i] = m_Interpolator->IsInsideBuffer(inputIndex) && (!isSpecialCoordinatesImage || isInsideInput);
     }
-    else
-    {
-      if (m_Extrapolator.IsNull())
-      {
-        outIt.Set(m_DefaultPixelValue); // default background value
-      }
-      else
-      {
-        value = m_Extrapolator->EvaluateAtContinuousIndex(inputIndex);
-        outIt.Set(Self::CastPixelWithBoundsChecking(value));
-      }
-    }
-    progress.CompletedPixel();
+    this->StoreMappedIndices(outIt.GetIndex(), buffers);
+
+    // Evaluate input at the positions and copy to the output
+    this->SetScanline(outIt, buffers);
+    progress.Completed(lineLength);
   }
 }
 
@@ -439,8 +452,10 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
   const auto firstIndexValueOfLargestPossibleRegion = largestPossibleRegion.GetIndex(0);
   const auto firstSizeValueOfLargestPossibleRegion = static_cast<double>(largestPossibleRegion.GetSize(0));
 
-  // Cache information from the superclass
-  const PixelType defaultValue = this->GetDefaultPixelValue();
+  const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+  ScanlineBuffers     buffers;
+  buffers.inputIndices.resize(lineLength);
+  buffers.isInside.resize(lineLength);
 
   // As we walk across a scan line in the output image, we trace
   // an oriented/scaled/translated line in the input image. Each scan
@@ -475,41 +490,411 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
 
     IndexValueType scanlineIndex = outIt.GetIndex()[0];
 
-
-    while (!outIt.IsAtEndOfLine())
+    for (SizeValueType i = 0; i < lineLength; ++i, ++scanlineIndex)
     {
-
       // Perform linear interpolation from startIndex, along vectorFromStartIndex
       const double alpha =
         (scanlineIndex - firstIndexValueOfLargestPossibleRegion) / firstSizeValueOfLargestPossibleRegion;
 
-      ContinuousInputIndexType inputIndex(startIndex);
-      for (unsigned int i = 0; i < InputImageDimension; ++i)
+      ContinuousInputIndexType & inputIndex = buffers.inputIndices[i];
+      inputIndex = startIndex;
+      for (unsigned int j = 0; j < InputImageDimension; ++j)
+      {
+        inputIndex[j] += alpha * vectorFromStartIndex[j];
+      }
+      buffers.isInside[i] = m_Interpolator->IsInsideBuffer(inputIndex);
+    }
+    this->StoreMappedIndices(outIt.GetIndex(), buffers);
+
+    // Evaluate input at the positions and copy to the output
+    this->SetScanline(outIt, buffers);
+    progress.Completed(lineLength);
+  }
+}
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+void
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  MappedIndicesThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  OutputImageType * outputPtr = this->GetOutput();
+
+  TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+
+  const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+  ScanlineBuffers     buffers;
+  buffers.inputIndices.resize(lineLength);
+  buffers.isInside.resize(lineLength);
+
+  for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
+  {
+    const auto lineBegin = m_MappedIndices.cbegin() + outputPtr->ComputeOffset(outIt.GetIndex());
+    std::copy(lineBegin, lineBegin + lineLength, buffers.inputIndices.begin());
+    for (SizeValueType i = 0; i < lineLength; ++i)
+    {
+      buffers.isInside[i] = m_Interpolator->IsInsideBuffer(buffers.inputIndices[i]);
+    }
+
+    // Evaluate input at the positions and copy to the output
+    this->SetScanline(outIt, buffers);
+    progress.Completed(lineLength);
+  }
+}
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+void
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  PrepareMappedIndices()
+{
+  using OutputSpecialCoordinatesImageType = SpecialCoordinatesImage<PixelType, OutputImageDimension>;
+  using InputSpecialCoordinatesImageType = SpecialCoordinatesImage<InputPixelType, InputImageDimension>;
+
+  const InputImageType * inputPtr = this->GetInput();
+  OutputImageType *      outputPtr = this->GetOutput();
+  const TransformType *  transformPtr = this->GetTransform();
+
+  m_ReadMappedIndices = false;
+  m_WriteMappedIndices = false;
+  if (!m_CacheMappedIndices)
+  {
+    m_MappedIndices = {};
+    m_MappedIndicesAreValid = false;
+    return;
+  }
+
+  // The special coordinates images tell whether a position is inside the
+  // input image when mapping it, which is not kept
+  if (m_UseSeparableResampling || dynamic_cast<const InputSpecialCoordinatesImageType *>(inputPtr) != nullptr ||
+      dynamic_cast<const OutputSpecialCoordinatesImageType *>(outputPtr) != nullptr)
+  {
+    return;
+  }
+
+  const MappedIndicesKeyType key(transformPtr,
+                                 GetTransformMTime(transformPtr),
+                                 outputPtr->GetBufferedRegion(),
+                                 outputPtr->GetOrigin(),
+                                 outputPtr->GetSpacing(),
+                                 outputPtr->GetDirection(),
+                                 inputPtr->GetOrigin(),
+                                 inputPtr->GetSpacing(),
+                                 inputPtr->GetDirection());
+  if (m_MappedIndicesAreValid && key == m_MappedIndicesKey)
+  {
+    m_ReadMappedIndices = true;
+    return;
+  }
+
+  m_MappedIndicesKey = key;
+  m_MappedIndicesAreValid = false;
+  m_MappedIndices.resize(outputPtr->GetBufferedRegion().GetNumberOfPixels());
+  m_WriteMappedIndices = true;
+}
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+ModifiedTimeType
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  GetTransformMTime(const TransformType * transform)
+{
+  ModifiedTimeType latestTime = transform->GetMTime();
+  if constexpr (InputImageDimension == OutputImageDimension)
+  {
+    using MultiTransformType = MultiTransform<TTransformPrecisionType, OutputImageDimension, OutputImageDimension>;
+    if (const auto * multiTransform = dynamic_cast<const MultiTransformType *>(transform))
+    {
+      for (SizeValueType n = 0; n < multiTransform->GetNumberOfTransforms(); ++n)
+      {
+        latestTime = std::max(latestTime, GetTransformMTime(multiTransform->GetNthTransformConstPointer(n)));
+      }
+    }
+  }
+  return latestTime;
+}
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+void
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  StoreMappedIndices(const IndexType & lineIndex, const ScanlineBuffers & buffers)
+{
+  if (m_WriteMappedIndices)
+  {
+    std::copy(buffers.inputIndices.cbegin(),
+              buffers.inputIndices.cend(),
+              m_MappedIndices.begin() + this->GetOutput()->ComputeOffset(lineIndex));
+  }
+}
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+bool
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  ComputeSeparableSamples()
+{
+  if constexpr (SupportsSeparableResampling)
+  {
+    using OutputSpecialCoordinatesImageType = SpecialCoordinatesImage<PixelType, OutputImageDimension>;
+    using InputSpecialCoordinatesImageType = SpecialCoordinatesImage<InputPixelType, InputImageDimension>;
+    using NearestNeighborInterpolatorType =
+      NearestNeighborInterpolateImageFunction<InputImageType, TInterpolatorPrecisionType>;
+
+    const InputImageType * inputPtr = this->GetInput();
+    OutputImageType *      outputPtr = this->GetOutput();
+    const TransformType *  transformPtr = this->GetTransform();
+
+    if (dynamic_cast<const InputSpecialCoordinatesImageType *>(inputPtr) != nullptr ||
+        dynamic_cast<const OutputSpecialCoordinatesImageType *>(outputPtr) != nullptr ||
+        transformPtr->GetTransformCategory() != TransformType::TransformCategoryEnum::Linear)
+    {
+      return false;
+    }
+
+    // The exact classes are required, as a subclass may interpolate differently
+    const std::type_info & interpolatorType = typeid(*m_Interpolator);
+    const bool             isNearestNeighbor = interpolatorType == typeid(NearestNeighborInterpolatorType);
+    if (!isNearestNeighbor && interpolatorType != typeid(LinearInterpolatorType))
+    {
+      return false;
+    }
+
+    const auto transformIndex = [outputPtr, transformPtr, inputPtr](const IndexType & index) {
+      return inputPtr->template TransformPhysicalPointToContinuousIndex<TInterpolatorPrecisionType>(
+        transformPtr->TransformPoint(outputPtr->template TransformIndexToPhysicalPoint<double>(index)));
+    };
+
+    // Map the first pixel of the largest possible region, and the ends of the
+    // lines which start from it along each axis. The mapping is separable when
+    // moving along an output axis only moves along the same input axis, up to
+    // a negligible fraction of a pixel over the whole image.
+    constexpr double                         tolerance = 1e-6;
+    const OutputImageRegionType &            largestPossibleRegion = outputPtr->GetLargestPossibleRegion();
+    const ContinuousInputIndexType           startIndex = transformIndex(largestPossibleRegion.GetIndex());
+    std::array<double, OutputImageDimension> vectorsFromStartIndex{};
+    for (unsigned int i = 0; i < OutputImageDimension; ++i)
+    {
+      IndexType index = largestPossibleRegion.GetIndex();
+      index[i] += largestPossibleRegion.GetSize(i);
+      const auto vectorFromStartIndex = transformIndex(index) - startIndex;
+      for (unsigned int j = 0; j < InputImageDimension; ++j)
       {
-        inputIndex[i] += alpha * vectorFromStartIndex[i];
+        if (j != i && !(std::abs(vectorFromStartIndex[j]) <= tolerance))
+        {
+          return false;
+        }
       }
+      vectorsFromStartIndex[i] = vectorFromStartIndex[i];
+    }
+
+    // Sample each axis the way the interpolator does. As in
+    // LinearThreadedGenerateData(), the positions along the first axis are
+    // interpolated along the line, and the other ones are mapped directly.
+    const OffsetValueType * const offsetTable = inputPtr->GetOffsetTable();
+    const IndexType &             bufferStartIndex = inputPtr->GetBufferedRegion().GetIndex();
+    const auto &                  startContinuousIndex = m_Interpolator->GetStartContinuousIndex();
+    const auto &                  endContinuousIndex = m_Interpolator->GetEndContinuousIndex();
+    const auto &                  endIndex = m_Interpolator->GetEndIndex();
+    for (unsigned int i = 0; i < OutputImageDimension; ++i)
+    {
+      const auto size = static_cast<double>(largestPossibleRegion.GetSize(i));
+      m_SeparableSamples[i].resize(largestPossibleRegion.GetSize(i));
+      for (SizeValueType k = 0; k < m_SeparableSamples[i].size(); ++k)
+      {
+        SeparableSample & sample = m_SeparableSamples[i][k];
+        if (i == 0)
+        {
+          sample.position = startIndex[i] + (k / size) * vectorsFromStartIndex[i];
+        }
+        else
+        {
+          IndexType index = largestPossibleRegion.GetIndex();
+          index[i] += static_cast<IndexValueType>(k);
+          sample.position = transformIndex(index)[i];
+        }
+        sample.isInside = sample.position >= startContinuousIndex[i] && sample.position < endContinuousIndex[i];
+        if (!sample.isInside)
+        {
+          continue;
+        }
+
+        IndexValueType nearestIndex = 0;
+        if (isNearestNeighbor)
+        {
+          nearestIndex = Math::Round<IndexValueType>(sample.position);
+        }
+        else
+        {
+          nearestIndex = std::max(Math::Floor<IndexValueType>(sample.position), bufferStartIndex[i]);
+          sample.distance = sample.position - static_cast<TInterpolatorPrecisionType>(nearestIndex);
+          if (!(sample.distance > 0.0) || nearestIndex + 1 > endIndex[i])
+          {
+            sample.distance = 0.0;
+          }
+        }
+        sample.offset = (nearestIndex - bufferStartIndex[i]) * offsetTable[i];
+        sample.nextOffset = sample.offset + offsetTable[i];
+      }
+    }
+    return true;
+  }
+  else
+  {
+    return false;
+  }
+}
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+template <unsigned int VDimension>
+auto
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  InterpolateSeparable(const InputPixelType * buffer, const SeparableSample * const * samples, OffsetValueType offset)
+    -> InterpolatorOutputType
+{
+  // Interpolates along the lower axes first, in the same order as
+  // LinearInterpolateImageFunction, so that the values are the same
+  const SeparableSample & sample = *samples[VDimension];
+  InterpolatorOutputType  value0{};
+  InterpolatorOutputType  value1{};
+  if constexpr (VDimension == 0)
+  {
+    value0 = static_cast<InterpolatorOutputType>(buffer[offset + sample.offset]);
+    if (sample.distance == 0.0)
+    {
+      return value0;
+    }
+    value1 = static_cast<InterpolatorOutputType>(buffer[offset + sample.nextOffset]);
+  }
+  else
+  {
+    value0 = InterpolateSeparable<VDimension - 1>(buffer, samples, offset + sample.offset);
+    if (sample.distance == 0.0)
+    {
+      return value0;
+    }
+    value1 = InterpolateSeparable<VDimension - 1>(buffer, samples, offset + sample.nextOffset);
+  }
+  return value0 + (value1 - value0) * sample.distance;
+}
 
-      // Evaluate input at right position and copy to the output
-      if (m_Interpolator->IsInsideBuffer(inputIndex))
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+void
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  SeparableThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  if constexpr (SupportsSeparableResampling)
+  {
+    OutputImageType *            outputPtr = this->GetOutput();
+    const InputPixelType * const buffer = this->GetInput()->GetBufferPointer();
+
+    TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+
+    const IndexType &   largestPossibleStartIndex = outputPtr->GetLargestPossibleRegion().GetIndex();
+    const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+
+    for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
+    {
+      // The samples along the other axes are the same for the whole line
+      const IndexType &                                         lineIndex = outIt.GetIndex();
+      std::array<const SeparableSample *, OutputImageDimension> samples{};
+      bool                                                      isLineInside = true;
+      for (unsigned int i = 0; i < OutputImageDimension; ++i)
       {
-        outIt.Set(Self::CastPixelWithBoundsChecking(m_Interpolator->EvaluateAtContinuousIndex(inputIndex)));
+        samples[i] = &m_SeparableSamples[i][lineIndex[i] - largestPossibleStartIndex[i]];
+        isLineInside = isLineInside && (i == 0 || samples[i]->isInside);
       }
-      else
+
+      for (SizeValueType k = 0; k < lineLength; ++k, ++samples[0], ++outIt)
       {
-        if (m_Extrapolator.IsNull())
+        if (isLineInside && samples[0]->isInside)
         {
-          outIt.Set(defaultValue); // default background value
+          outIt.Set(Self::CastPixelWithBoundsChecking(
+            Self::InterpolateSeparable<OutputImageDimension - 1>(buffer, samples.data(), 0)));
+        }
+        else if (m_Extrapolator.IsNull())
+        {
+          outIt.Set(m_DefaultPixelValue); // default background value
         }
         else
         {
+          ContinuousInputIndexType inputIndex;
+          for (unsigned int i = 0; i < InputImageDimension; ++i)
+          {
+            inputIndex[i] = samples[i]->position;
+          }
           outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndex)));
         }
       }
+      progress.Completed(lineLength);
+    }
+  }
+  else
+  {
+    itkExceptionMacro("Separable resampling is not supported for these image types");
+  }
+}
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+void
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::SetScanline(
+  ImageScanlineIterator<TOutputImage> & outIt,
+  ScanlineBuffers &                     buffers) const
+{
+  const SizeValueType lineLength = buffers.inputIndices.size();
+
+  // Gather the positions inside the buffer, unless they all are
+  const ContinuousInputIndexType * insideIndices = buffers.inputIndices.data();
+  SizeValueType numberOfInsideIndices = std::count(buffers.isInside.cbegin(), buffers.isInside.cend(), true);
+  if (numberOfInsideIndices < lineLength)
+  {
+    buffers.insideIndices.clear();
+    for (SizeValueType i = 0; i < lineLength; ++i)
+    {
+      if (buffers.isInside[i])
+      {
+        buffers.insideIndices.push_back(buffers.inputIndices[i]);
+      }
+    }
+    insideIndices = buffers.insideIndices.data();
+  }
+  buffers.insideValues.resize(numberOfInsideIndices);
+  m_Interpolator->EvaluateAtContinuousIndices(insideIndices, buffers.insideValues.data(), numberOfInsideIndices);
 
-      ++outIt;
-      ++scanlineIndex;
+  numberOfInsideIndices = 0;
+  for (SizeValueType i = 0; i < lineLength; ++i, ++outIt)
+  {
+    if (buffers.isInside[i])
+    {
+      outIt.Set(Self::CastPixelWithBoundsChecking(buffers.insideValues[numberOfInsideIndices++]));
+    }
+    else if (m_Extrapolator.IsNull())
+    {
+      outIt.Set(m_DefaultPixelValue); // default background value
+    }
+    else
+    {
+      outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(buffers.inputIndices[i])));
     }
-    progress.Completed(outputRegionForThread.GetSize()[0]);
   }
 }
 
@@ -669,6 +1054,7 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
   os << indent << "Interpolator: " << m_Interpolator.GetPointer() << std::endl;
   os << indent << "Extrapolator: " << m_Extrapolator.GetPointer() << std::endl;
   itkPrintSelfBooleanMacro(UseReferenceImage);
+  itkPrintSelfBooleanMacro(CacheMappedIndices);
 }
 } // end namespace itk
 
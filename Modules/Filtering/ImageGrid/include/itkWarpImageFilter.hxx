@@ -20,6 +20,7 @@
 
 #include "itkImageRegionIterator.h"
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageScanlineIterator.h"
 #include "itkImageAlgorithm.h"
 #include "itkNumericTraits.h"
 #include "itkDefaultConvertPixelTraits.h"
@@ -28,6 +29,8 @@
 #include "itkMath.h"
 #include "itkTransform.h"
 
+#include <vector>
+
 namespace itk
 {
 template <typename TInputImage, typename TOutputImage, typename TDisplacementField>
@@ -281,76 +284,85 @@ WarpImageFilter<TInputImage, TOutputImage, TDisplacementField>::DynamicThreadedG
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
-  // iterator for the output image
-  ImageRegionIteratorWithIndex<OutputImageType> outputIt(outputPtr, outputRegionForThread);
-  IndexType                                     index{};
-  PointType                                     point{};
-  DisplacementType                              displacement{};
-  NumericTraits<DisplacementType>::SetLength(displacement, ImageDimension);
-  static_assert(PointType::Dimension == ImageDimension, "ERROR: Point type and ImageDimension must be the same!");
-  if (this->m_DefFieldSameInformation)
-  {
-    // iterator for the deformation field
-    ImageRegionConstIterator<DisplacementFieldType> fieldIt(fieldPtr, outputRegionForThread);
+  using ContinuousIndexType = typename InterpolatorType::ContinuousIndexType;
+  using InterpolatorOutputType = typename InterpolatorType::OutputType;
+  const InputImageType * inputPtr = m_Interpolator->GetInputImage();
 
-    while (!outputIt.IsAtEnd())
-    {
-      // get the output image index
-      index = outputIt.GetIndex();
-      outputPtr->TransformIndexToPhysicalPoint(index, point);
+  // The positions of a line are computed first, and the ones inside the
+  // buffer are then interpolated together
+  const SizeValueType                 lineLength = outputRegionForThread.GetSize(0);
+  std::vector<bool>                   isInside(lineLength);
+  std::vector<ContinuousIndexType>    insideIndices;
+  std::vector<InterpolatorOutputType> insideValues(lineLength);
+  insideIndices.reserve(lineLength);
 
-      // get the required displacement
-      displacement = fieldIt.Get();
+  static_assert(PointType::Dimension == ImageDimension, "ERROR: Point type and ImageDimension must be the same!");
 
-      // compute the required input image point
-      for (unsigned int j = 0; j < ImageDimension; ++j)
-      {
-        point[j] += displacement[j];
-      }
+  // Walks the output region, getDisplacement(point, displacement) giving the displacement of each pixel
+  auto warpRegion = [&](auto && getDisplacement) {
+    PointType        point{};
+    DisplacementType displacement{};
+    NumericTraits<DisplacementType>::SetLength(displacement, ImageDimension);
 
-      // get the interpolated value
-      if (m_Interpolator->IsInsideBuffer(point))
+    for (ImageScanlineIterator outputIt(outputPtr, outputRegionForThread); !outputIt.IsAtEnd(); outputIt.NextLine())
+    {
+      IndexType index = outputIt.GetIndex();
+      insideIndices.clear();
+      for (SizeValueType i = 0; i < lineLength; ++i, ++index[0])
       {
-        auto value = static_cast<PixelType>(m_Interpolator->Evaluate(point));
-        outputIt.Set(value);
+        outputPtr->TransformIndexToPhysicalPoint(index, point);
+
+        // get the required displacement
+        getDisplacement(point, displacement);
+
+        // compute the required input image point
+        for (unsigned int j = 0; j < ImageDimension; ++j)
+        {
+          point[j] += displacement[j];
+        }
+
+        const ContinuousIndexType inputIndex =
+          inputPtr->template TransformPhysicalPointToContinuousIndex<CoordinateType>(point);
+        isInside[i] = m_Interpolator->IsInsideBuffer(inputIndex);
+        if (isInside[i])
+        {
+          insideIndices.push_back(inputIndex);
+        }
       }
-      else
+
+      // get the interpolated values
+      m_Interpolator->EvaluateAtContinuousIndices(insideIndices.data(), insideValues.data(), insideIndices.size());
+
+      SizeValueType insideIndex = 0;
+      for (SizeValueType i = 0; i < lineLength; ++i, ++outputIt)
       {
-        outputIt.Set(m_EdgePaddingValue);
+        if (isInside[i])
+        {
+          outputIt.Set(static_cast<PixelType>(insideValues[insideIndex++]));
+        }
+        else
+        {
+          outputIt.Set(m_EdgePaddingValue);
+        }
       }
-      ++outputIt;
-      ++fieldIt;
-      progress.CompletedPixel();
+      progress.Completed(lineLength);
     }
+  };
+
+  if (this->m_DefFieldSameInformation)
+  {
+    // iterator for the deformation field
+    ImageRegionConstIterator<DisplacementFieldType> fieldIt(fieldPtr, outputRegionForThread);
+    warpRegion([&fieldIt](const PointType &, DisplacementType & displacement) {
+      displacement = fieldIt.Get();
+      ++fieldIt;
+    });
   }
   else
   {
-    while (!outputIt.IsAtEnd())
-    {
-      // get the output image index
-      index = outputIt.GetIndex();
-      outputPtr->TransformIndexToPhysicalPoint(index, point);
-
+    warpRegion([this, fieldPtr](const PointType & point, DisplacementType & displacement) {
       this->EvaluateDisplacementAtPhysicalPoint(point, fieldPtr, displacement);
-      // compute the required input image point
-      for (unsigned int j = 0; j < ImageDimension; ++j)
-      {
-        point[j] += displacement[j];
-      }
-
-      // get the interpolated value
-      if (m_Interpolator->IsInsideBuffer(point))
-      {
-        auto value = static_cast<PixelType>(m_Interpolator->Evaluate(point));
-        outputIt.Set(value);
-      }
-      else
-      {
-        outputIt.Set(m_EdgePaddingValue);
-      }
-      ++outputIt;
-      progress.CompletedPixel();
-    }
+    });
   }
 }
 
@@ -19,12 +19,18 @@
 // The header file to be tested:
 #include "itkResampleImageFilter.h"
 
+#include "itkAffineTransform.h"
+#include "itkCompositeTransform.h"
 #include "itkImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
+#include "itkScaleTransform.h"
 
 // Google Test header file:
 #include <gtest/gtest.h>
 
 // Standard C++ header files:
+#include <atomic>
 #include <limits>
 #include <random>
 
@@ -32,6 +38,46 @@
 namespace
 {
 
+// A linear interpolator whose values are offset by one, as an example of a
+// subclass of LinearInterpolateImageFunction which interpolates differently.
+template <typename TImage>
+class OffsetLinearInterpolateImageFunction : public itk::LinearInterpolateImageFunction<TImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(OffsetLinearInterpolateImageFunction);
+
+  using Self = OffsetLinearInterpolateImageFunction;
+  using Superclass = itk::LinearInterpolateImageFunction<TImage>;
+  using Pointer = itk::SmartPointer<Self>;
+  using typename Superclass::ContinuousIndexType;
+  using typename Superclass::OutputType;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(OffsetLinearInterpolateImageFunction);
+
+  OutputType
+  EvaluateAtContinuousIndex(const ContinuousIndexType & index) const override
+  {
+    return Superclass::EvaluateAtContinuousIndex(index) + 1.0;
+  }
+
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              itk::SizeValueType          numberOfIndices) const override
+  {
+    for (itk::SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      values[i] = this->EvaluateAtContinuousIndex(indices[i]);
+    }
+  }
+
+protected:
+  OffsetLinearInterpolateImageFunction() = default;
+  ~OffsetLinearInterpolateImageFunction() override = default;
+};
+
+
 // Returns the first pixel value from the output image of a ResampleImageFilter
 // whose input is a 1x1 image, having the specified input pixel value. The
 // filter uses a default interpolator and a default (identity) transform.
@@ -101,6 +147,113 @@ Expect_ResampleImageFilter_preserves_pixel_value(const TPixel inputPixel)
 }
 
 
+// Tests that scaling an image with the specified interpolator yields the
+// values of the interpolator at the mapped positions, or the default pixel
+// value outside the input image. Such a transform maps each output axis to the
+// same input axis, which lets the filter use separable resampling.
+template <typename TInterpolator>
+void
+Expect_ResampleImageFilter_scaling_yields_interpolated_values(const double scale)
+{
+  using ImageType = itk::Image<double, 3>;
+  using TransformType = itk::ScaleTransform<double, 3>;
+
+  const auto                         image = ImageType::New();
+  const typename ImageType::SizeType imageSize = { { 9, 8, 7 } };
+  image->SetRegions(imageSize);
+  image->Allocate();
+  std::default_random_engine randomEngine;
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(std::uniform_real_distribution<>{ -100.0, 100.0 }(randomEngine));
+  }
+
+  auto transform = TransformType::New();
+  transform->SetScale(itk::MakeVector(scale, 1.1 * scale, 0.9 * scale));
+  transform->SetCenter(itk::MakePoint(0.3, -0.2, 0.1));
+
+  constexpr double defaultPixelValue = 1000.0;
+  const auto       filter = itk::ResampleImageFilter<ImageType, ImageType>::New();
+  filter->SetInput(image);
+  filter->SetTransform(transform);
+  filter->SetInterpolator(TInterpolator::New());
+  filter->SetSize(ImageType::SizeType::Filled(12));
+  filter->SetOutputStartIndex(ImageType::IndexType::Filled(-1));
+  filter->SetDefaultPixelValue(defaultPixelValue);
+  filter->Update();
+  const ImageType * const output = filter->GetOutput();
+
+  const auto interpolator = TInterpolator::New();
+  interpolator->SetInputImage(image);
+  unsigned int numberOfInsidePixels = 0;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto index = image->TransformPhysicalPointToContinuousIndex<double>(
+      transform->TransformPoint(output->TransformIndexToPhysicalPoint<double>(it.GetIndex())));
+    if (interpolator->IsInsideBuffer(index))
+    {
+      EXPECT_NEAR(it.Get(), interpolator->EvaluateAtContinuousIndex(index), 1e-9) << "Index: " << it.GetIndex();
+      ++numberOfInsidePixels;
+    }
+    else
+    {
+      EXPECT_EQ(it.Get(), defaultPixelValue) << "Index: " << it.GetIndex();
+    }
+  }
+  EXPECT_GT(numberOfInsidePixels, 0U);
+  EXPECT_LT(numberOfInsidePixels, output->GetBufferedRegion().GetNumberOfPixels());
+}
+
+
+// Affine transform which counts the points it transforms, and does not tell
+// the filter that it is linear.
+class CountingTransform : public itk::AffineTransform<double, 2>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CountingTransform);
+
+  using Self = CountingTransform;
+  using Superclass = itk::AffineTransform<double, 2>;
+  using Pointer = itk::SmartPointer<Self>;
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(CountingTransform);
+
+  TransformCategoryEnum
+  GetTransformCategory() const override
+  {
+    return TransformCategoryEnum::UnknownTransformCategory;
+  }
+
+  OutputPointType
+  TransformPoint(const InputPointType & point) const override
+  {
+    ++m_NumberOfTransformedPoints;
+    return Superclass::TransformPoint(point);
+  }
+
+  mutable std::atomic<size_t> m_NumberOfTransformedPoints{ 0 };
+
+protected:
+  CountingTransform() = default;
+  ~CountingTransform() override = default;
+};
+
+
+// Returns an image of the specified size filled with random values.
+itk::Image<float>::Pointer
+MakeRandomImage(const itk::Size<2> & size, std::default_random_engine & randomEngine)
+{
+  const auto image = itk::Image<float>::New();
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIterator<itk::Image<float>> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(std::uniform_real_distribution<float>{ 0.0f, 100.0f }(randomEngine));
+  }
+  return image;
+}
+
+
 // Tests that a useful diagnostic is provided via a thrown exception if the
 // resample image filter has used "SetReferenceImage()" but not "UseReferenceImageOn()".
 template <typename TPixel>
@@ -172,3 +325,122 @@ TEST(ResampleImageFilter, ThrowsOnIncompleteConfiguration)
 {
   Expect_ResampleImageFilter_thows_on_incomplete_configuration(128.0);
 }
+
+
+TEST(ResampleImageFilter, ScalingYieldsInterpolatedValues)
+{
+  using ImageType = itk::Image<double, 3>;
+
+  for (const double scale : { 0.37, 0.8, 2.5 })
+  {
+    Expect_ResampleImageFilter_scaling_yields_interpolated_values<itk::LinearInterpolateImageFunction<ImageType>>(
+      scale);
+    Expect_ResampleImageFilter_scaling_yields_interpolated_values<
+      itk::NearestNeighborInterpolateImageFunction<ImageType>>(scale);
+    // A subclass of a supported interpolator is not resampled as the base class
+    Expect_ResampleImageFilter_scaling_yields_interpolated_values<OffsetLinearInterpolateImageFunction<ImageType>>(
+      scale);
+  }
+}
+
+
+TEST(ResampleImageFilter, CachedMappedIndicesYieldSameOutput)
+{
+  using ImageType = itk::Image<float>;
+
+  std::default_random_engine randomEngine;
+  const ImageType::SizeType  size = { { 21, 17 } };
+  const auto                 transform = CountingTransform::New();
+  transform->Rotate2D(0.3);
+  transform->Translate(itk::MakeVector(1.5, -2.0));
+
+  const auto filter = itk::ResampleImageFilter<ImageType, ImageType>::New();
+  EXPECT_FALSE(filter->GetCacheMappedIndices());
+  filter->CacheMappedIndicesOn();
+  filter->SetTransform(transform);
+  filter->SetSize(size);
+  filter->SetDefaultPixelValue(-1.0f);
+
+  const auto uncachedFilter = itk::ResampleImageFilter<ImageType, ImageType>::New();
+  uncachedFilter->SetTransform(transform);
+  uncachedFilter->SetSize(size);
+  uncachedFilter->SetDefaultPixelValue(-1.0f);
+
+  const auto expectSameOutputs = [&filter, &uncachedFilter](const ImageType * image) {
+    filter->SetInput(image);
+    filter->Update();
+    uncachedFilter->SetInput(image);
+    uncachedFilter->Update();
+    const ImageType * const output = filter->GetOutput();
+    const ImageType * const expectedOutput = uncachedFilter->GetOutput();
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd();
+         ++it)
+    {
+      EXPECT_EQ(it.Get(), expectedOutput->GetPixel(it.GetIndex())) << "Index: " << it.GetIndex();
+    }
+  };
+
+  // The transform is evaluated by the first update only
+  const size_t numberOfPixels = size.CalculateProductOfElements();
+  expectSameOutputs(MakeRandomImage(size, randomEngine));
+  EXPECT_EQ(transform->m_NumberOfTransformedPoints, 2 * numberOfPixels);
+  expectSameOutputs(MakeRandomImage(size, randomEngine));
+  EXPECT_EQ(transform->m_NumberOfTransformedPoints, 3 * numberOfPixels);
+
+  // and again after it is modified
+  transform->Rotate2D(0.1);
+  expectSameOutputs(MakeRandomImage(size, randomEngine));
+  EXPECT_EQ(transform->m_NumberOfTransformedPoints, 5 * numberOfPixels);
+
+  // or when the geometry of the input image changes
+  const auto shiftedImage = MakeRandomImage(size, randomEngine);
+  shiftedImage->SetOrigin(itk::MakePoint(0.5, 0.25));
+  expectSameOutputs(shiftedImage);
+  EXPECT_EQ(transform->m_NumberOfTransformedPoints, 7 * numberOfPixels);
+
+  // Without the cache, each update evaluates the transform
+  filter->CacheMappedIndicesOff();
+  expectSameOutputs(shiftedImage);
+  EXPECT_EQ(transform->m_NumberOfTransformedPoints, 8 * numberOfPixels);
+}
+
+
+TEST(ResampleImageFilter, CachedMappedIndicesFollowSubTransforms)
+{
+  using ImageType = itk::Image<float>;
+
+  std::default_random_engine randomEngine;
+  const ImageType::SizeType  size = { { 21, 17 } };
+  const auto                 affineTransform = itk::AffineTransform<double, 2>::New();
+  affineTransform->Rotate2D(0.3);
+  const auto compositeTransform = itk::CompositeTransform<double, 2>::New();
+  compositeTransform->AddTransform(affineTransform);
+
+  const auto filter = itk::ResampleImageFilter<ImageType, ImageType>::New();
+  filter->CacheMappedIndicesOn();
+  filter->SetTransform(compositeTransform);
+  filter->SetSize(size);
+  filter->SetInput(MakeRandomImage(size, randomEngine));
+  filter->Update();
+
+  // Modifying the sub-transform does not modify the composite transform
+  const itk::ModifiedTimeType compositeTransformMTime = compositeTransform->GetMTime();
+  affineTransform->Translate(itk::MakeVector(1.5, -2.0));
+  EXPECT_EQ(compositeTransform->GetMTime(), compositeTransformMTime);
+
+  // but the next image is resampled through the modified transform
+  const auto image = MakeRandomImage(size, randomEngine);
+  filter->SetInput(image);
+  filter->Update();
+  const auto uncachedFilter = itk::ResampleImageFilter<ImageType, ImageType>::New();
+  uncachedFilter->SetTransform(compositeTransform);
+  uncachedFilter->SetSize(size);
+  uncachedFilter->SetInput(image);
+  uncachedFilter->Update();
+  const ImageType * const output = filter->GetOutput();
+  const ImageType * const expectedOutput = uncachedFilter->GetOutput();
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    EXPECT_EQ(it.Get(), expectedOutput->GetPixel(it.GetIndex())) << "Index: " << it.GetIndex();
+  }
+}
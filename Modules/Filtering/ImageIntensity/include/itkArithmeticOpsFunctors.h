@@ -19,6 +19,7 @@
 #define itkArithmeticOpsFunctors_h
 
 #include "itkMath.h"
+#include "itkScanlineFunctorTraits.h"
 
 namespace itk::Functor
 {
@@ -28,9 +29,11 @@ namespace itk::Functor
  * \ingroup ITKImageIntensity
  */
 template <typename TInput1, typename TInput2 = TInput1, typename TOutput = TInput1>
-class ITK_TEMPLATE_EXPORT Add2
+class ITK_TEMPLATE_EXPORT Add2 : public ScanlineFunctor<Add2<TInput1, TInput2, TOutput>, TOutput, TInput1, TInput2>
 {
 public:
+  using ScanlineFunctor<Add2, TOutput, TInput1, TInput2>::operator();
+
   bool
   operator==(const Add2 &) const
   {
@@ -54,8 +57,11 @@ public:
  */
 template <typename TInput1, typename TInput2, typename TInput3, typename TOutput>
 class ITK_TEMPLATE_EXPORT Add3
+  : public ScanlineFunctor<Add3<TInput1, TInput2, TInput3, TOutput>, TOutput, TInput1, TInput2, TInput3>
 {
 public:
+  using ScanlineFunctor<Add3, TOutput, TInput1, TInput2, TInput3>::operator();
+
   bool
   operator==(const Add3 &) const
   {
@@ -78,9 +84,11 @@ public:
  * \ingroup ITKImageIntensity
  */
 template <typename TInput1, typename TInput2 = TInput1, typename TOutput = TInput1>
-class ITK_TEMPLATE_EXPORT Sub2
+class ITK_TEMPLATE_EXPORT Sub2 : public ScanlineFunctor<Sub2<TInput1, TInput2, TOutput>, TOutput, TInput1, TInput2>
 {
 public:
+  using ScanlineFunctor<Sub2, TOutput, TInput1, TInput2>::operator();
+
   bool
   operator==(const Sub2 &) const
   {
@@ -103,9 +111,11 @@ public:
  * \ingroup ITKImageIntensity
  */
 template <typename TInput1, typename TInput2 = TInput1, typename TOutput = TInput1>
-class ITK_TEMPLATE_EXPORT Mult
+class ITK_TEMPLATE_EXPORT Mult : public ScanlineFunctor<Mult<TInput1, TInput2, TOutput>, TOutput, TInput1, TInput2>
 {
 public:
+  using ScanlineFunctor<Mult, TOutput, TInput1, TInput2>::operator();
+
   bool
   operator==(const Mult &) const
   {
@@ -128,9 +138,11 @@ public:
  * \ingroup ITKImageIntensity
  */
 template <typename TInput1, typename TInput2, typename TOutput>
-class ITK_TEMPLATE_EXPORT Div
+class ITK_TEMPLATE_EXPORT Div : public ScanlineFunctor<Div<TInput1, TInput2, TOutput>, TOutput, TInput1, TInput2>
 {
 public:
+  using ScanlineFunctor<Div, TOutput, TInput1, TInput2>::operator();
+
   bool
   operator==(const Div &) const
   {
@@ -159,8 +171,11 @@ public:
  */
 template <typename TNumerator, typename TDenominator = TNumerator, typename TOutput = TNumerator>
 class ITK_TEMPLATE_EXPORT DivideOrZeroOut
+  : public ScanlineFunctor<DivideOrZeroOut<TNumerator, TDenominator, TOutput>, TOutput, TNumerator, TDenominator>
 {
 public:
+  using ScanlineFunctor<DivideOrZeroOut, TOutput, TNumerator, TDenominator>::operator();
+
   DivideOrZeroOut()
     : m_Threshold(1e-5 * NumericTraits<TDenominator>::OneValue())
     , m_Constant(TOutput{})
@@ -199,8 +214,11 @@ public:
  */
 template <typename TInput1, typename TInput2, typename TOutput>
 class ITK_TEMPLATE_EXPORT Modulus
+  : public ScanlineFunctor<Modulus<TInput1, TInput2, TOutput>, TOutput, TInput1, TInput2>
 {
 public:
+  using ScanlineFunctor<Modulus, TOutput, TInput1, TInput2>::operator();
+
   bool
   operator==(const Modulus &) const
   {
@@ -275,9 +293,11 @@ private:
  * \ingroup ITKImageIntensity
  */
 template <class TInput1, class TInput2, class TOutput>
-class DivFloor
+class DivFloor : public ScanlineFunctor<DivFloor<TInput1, TInput2, TOutput>, TOutput, TInput1, TInput2>
 {
 public:
+  using ScanlineFunctor<DivFloor, TOutput, TInput1, TInput2>::operator();
+
   bool
   operator==(const DivFloor &) const
   {
@@ -315,9 +335,11 @@ public:
  * \ingroup ITKImageIntensity
  */
 template <class TInput1, class TInput2, class TOutput>
-class DivReal
+class DivReal : public ScanlineFunctor<DivReal<TInput1, TInput2, TOutput>, TOutput, TInput1, TInput2>
 {
 public:
+  using ScanlineFunctor<DivReal, TOutput, TInput1, TInput2>::operator();
+
   // Use default copy, assigned and destructor
   bool
   operator==(const DivReal &) const
@@ -342,9 +364,11 @@ public:
  * \ingroup ITKImageIntensity
  */
 template <class TInput1, class TOutput = TInput1>
-class UnaryMinus
+class UnaryMinus : public ScanlineFunctor<UnaryMinus<TInput1, TOutput>, TOutput, TInput1>
 {
 public:
+  using ScanlineFunctor<UnaryMinus, TOutput, TInput1>::operator();
+
   bool
   operator==(const UnaryMinus &) const
   {
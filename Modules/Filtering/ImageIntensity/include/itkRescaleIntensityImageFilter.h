@@ -29,8 +29,11 @@ namespace Functor
 {
 template <typename TInput, typename TOutput>
 class ITK_TEMPLATE_EXPORT IntensityLinearTransform
+  : public ScanlineFunctor<IntensityLinearTransform<TInput, TOutput>, TOutput, TInput>
 {
 public:
+  using ScanlineFunctor<IntensityLinearTransform, TOutput, TInput>::operator();
+
   using RealType = typename NumericTraits<TInput>::RealType;
   IntensityLinearTransform()
     : m_Factor(1.0)
@@ -49,9 +49,11 @@ namespace itk
 namespace Functor
 {
 template <typename TInput, typename TOutput>
-class Sigmoid
+class Sigmoid : public ScanlineFunctor<Sigmoid<TInput, TOutput>, TOutput, TInput>
 {
 public:
+  using ScanlineFunctor<Sigmoid, TOutput, TInput>::operator();
+
   Sigmoid()
     : m_OutputMinimum(NumericTraits<TOutput>::min())
     , m_OutputMaximum(NumericTraits<TOutput>::max())
@@ -18,7 +18,13 @@
 
 #include <gtest/gtest.h>
 
+#include "itkAddImageFilter.h"
 #include "itkArithmeticOpsFunctors.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTernaryAddImageFilter.h"
+#include "itkVectorImage.h"
+
+#include <vector>
 
 TEST(ArithmeticOpsTest, DivFloorFloat)
 {
@@ -89,3 +95,86 @@ TEST(ArithmeticOpsTest, UnaryMinus)
   EXPECT_EQ(-1, op1(1));
   EXPECT_EQ(2, op1(-2));
 }
+
+TEST(ArithmeticOpsTest, Scanline)
+{
+  using OpType = itk::Functor::Sub2<short, float, float>;
+  static_assert(itk::Functor::IsScanlineFunctor_v<OpType, float, short, float>);
+  static_assert(itk::Functor::IsScanlineFunctor_v<itk::Functor::UnaryMinus<short>, short, short>);
+  static_assert(!itk::Functor::IsScanlineFunctor_v<itk::Functor::UnaryMinus<short>, short, short, short>);
+
+  constexpr OpType         op;
+  const std::vector<short> input1{ 1, -2, 3, 4, -5, 6, 7 };
+  const std::vector<float> input2{ 0.5f, 1.5f, -2.5f, 3.5f, 4.5f, -5.5f, 6.5f };
+  std::vector<float>       output(input1.size());
+
+  op(input1.data(), input2.data(), output.data(), output.size());
+  for (size_t i = 0; i < output.size(); ++i)
+  {
+    EXPECT_EQ(op(input1[i], input2[i]), output[i]);
+  }
+
+  // The output may be one of the inputs
+  std::vector<float> values = input2;
+  itk::Functor::Mult<float>{}(values.data(), input2.data(), values.data(), values.size());
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    EXPECT_EQ(input2[i] * input2[i], values[i]);
+  }
+}
+
+TEST(ArithmeticOpsTest, ScanlineFilters)
+{
+  constexpr unsigned int Dimension = 2;
+  using ImageType = itk::Image<float, Dimension>;
+  static_assert(itk::Functor::HasContiguousScanlines_v<ImageType>);
+  static_assert(!itk::Functor::HasContiguousScanlines_v<itk::VectorImage<float, Dimension>>);
+
+  const ImageType::RegionType region(ImageType::SizeType{ { 23, 7 } });
+  std::vector<ImageType::Pointer> inputs;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    auto image = ImageType::New();
+    image->SetRegions(region);
+    image->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+    {
+      it.Set(static_cast<float>((i + 1) * it.GetIndex()[0] - it.GetIndex()[1]));
+    }
+    inputs.push_back(image);
+  }
+
+  // Only the lines of a subregion of the output are computed
+  const ImageType::RegionType requestedRegion(ImageType::IndexType{ { 3, 2 } }, ImageType::SizeType{ { 17, 4 } });
+
+  auto addFilter = itk::AddImageFilter<ImageType>::New();
+  addFilter->SetInput1(inputs[0]);
+  addFilter->SetInput2(inputs[1]);
+  addFilter->UpdateOutputInformation();
+  addFilter->GetOutput()->SetRequestedRegion(requestedRegion);
+  addFilter->GetOutput()->Update();
+
+  auto addConstantFilter = itk::AddImageFilter<ImageType>::New();
+  addConstantFilter->SetInput1(inputs[0]);
+  addConstantFilter->SetConstant2(2.5f);
+  addConstantFilter->Update();
+
+  auto ternaryAddFilter = itk::TernaryAddImageFilter<ImageType, ImageType, ImageType, ImageType>::New();
+  ternaryAddFilter->SetInput1(inputs[0]);
+  ternaryAddFilter->SetInput2(inputs[1]);
+  ternaryAddFilter->SetInput3(inputs[2]);
+  ternaryAddFilter->Update();
+
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(inputs[0], region); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    const float                value1 = inputs[0]->GetPixel(index);
+    const float                value2 = inputs[1]->GetPixel(index);
+    if (requestedRegion.IsInside(index))
+    {
+      EXPECT_EQ(value1 + value2, addFilter->GetOutput()->GetPixel(index));
+    }
+    EXPECT_EQ(value1 + 2.5f, addConstantFilter->GetOutput()->GetPixel(index));
+    EXPECT_EQ(value1 + value2 + inputs[2]->GetPixel(index), ternaryAddFilter->GetOutput()->GetPixel(index));
+  }
+}
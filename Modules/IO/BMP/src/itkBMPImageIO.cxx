@@ -48,6 +48,7 @@ BMPImageIO::BMPImageIO()
     this->AddSupportedWriteExtension(ext);
     this->AddSupportedReadExtension(ext);
   }
+  this->AddSupportedReadSignature("BM");
 }
 
 BMPImageIO::~BMPImageIO() = default;
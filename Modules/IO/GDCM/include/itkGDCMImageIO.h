@@ -269,6 +269,11 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Creates a GDCMImageIO with the same reading and writing options, e.g.
+   * to read the slices of a series concurrently. */
+  LightObject::Pointer
+  InternalClone() const override;
+
   void
   InternalReadImageInformation();
 
@@ -51,6 +51,12 @@ namespace itk
  *    DICOM objects, you may want to try calling SetUseSeriesDetails(true)
  *    prior to calling SetDirectory().
  *
+ *  The files of the directory are read ahead concurrently, by the
+ *    MultiThreader of this object, whose number of work units may be set
+ *    prior to calling SetDirectory(), before gdcm::SerieHelper parses them
+ *    from the file system cache. The series and their ordering do not
+ *    depend on it.
+ *
  * \ingroup IOFilters
  *
  * \ingroup ITKIOGDCM
@@ -108,6 +108,8 @@ GDCMImageIO::GDCMImageIO()
     this->AddSupportedWriteExtension(ext);
     this->AddSupportedReadExtension(ext);
   }
+  // the DICOM prefix, after the preamble of the files
+  this->AddSupportedReadSignature("DICM", 128);
 }
 
 GDCMImageIO::~GDCMImageIO() { delete this->m_DICOMHeader; }
@@ -1445,6 +1447,26 @@ GDCMImageIO::InternalSetCompressor(const std::string & _compressor)
   }
 }
 
+LightObject::Pointer
+GDCMImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->SetUIDPrefix(m_UIDPrefix);
+  rval->SetKeepOriginalUID(m_KeepOriginalUID);
+  rval->SetLoadPrivateTags(m_LoadPrivateTags);
+  rval->SetReadYBRtoRGB(m_ReadYBRtoRGB);
+  rval->SetUseCompression(this->GetUseCompression());
+  rval->SetCompressionLevel(this->GetCompressionLevel());
+  rval->SetCompressionType(m_CompressionType);
+  return loPtr;
+}
+
 void
 GDCMImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
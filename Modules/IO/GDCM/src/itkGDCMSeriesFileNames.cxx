@@ -20,10 +20,41 @@
 #include "itksys/SystemTools.hxx"
 #include "itkProgressReporter.h"
 #include "itkPrintHelper.h"
+#include "itkMultiThreaderBase.h"
 #include "gdcmSerieHelper.h"
+#include "gdcmDirectory.h"
+
+#include <fstream>
 
 namespace itk
 {
+namespace
+{
+// Reads the files of the directory concurrently, so that SerieHelper, which
+// parses them one after the other, finds them in the file system cache
+void
+ReadAheadDirectoryFiles(const std::string & directory, bool recursive, MultiThreaderBase * multiThreader)
+{
+  if (multiThreader->GetNumberOfWorkUnits() < 2)
+  {
+    return;
+  }
+  gdcm::Directory directoryList;
+  directoryList.Load(directory, recursive);
+  const gdcm::Directory::FilenamesType & fileNames = directoryList.GetFilenames();
+  multiThreader->ParallelizeArray(
+    0,
+    fileNames.size(),
+    [&fileNames](SizeValueType i) {
+      std::ifstream     file(fileNames[i].c_str(), std::ios::in | std::ios::binary);
+      std::vector<char> buffer(1 << 16);
+      while (file.read(buffer.data(), static_cast<std::streamsize>(buffer.size())))
+      {
+      }
+    },
+    nullptr);
+}
+} // namespace
 
 
 GDCMSeriesFileNames::GDCMSeriesFileNames()
@@ -71,6 +102,7 @@ GDCMSeriesFileNames::SetInputDirectory(const std::string & name)
   m_SerieHelper->Clear();
   m_SerieHelper->SetUseSeriesDetails(m_UseSeriesDetails);
   m_SerieHelper->SetLoadMode((m_LoadSequences ? 0 : gdcm::LD_NOSEQ) | (m_LoadPrivateTags ? 0 : gdcm::LD_NOSHADOW));
+  ReadAheadDirectoryFiles(name, m_Recursive, this->GetMultiThreader());
   m_SerieHelper->SetDirectory(name, m_Recursive);
   // as a side effect it also execute
   this->Modified();
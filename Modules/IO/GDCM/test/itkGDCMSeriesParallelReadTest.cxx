@@ -0,0 +1,142 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGDCMImageIO.h"
+#include "itkGDCMSeriesFileNames.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageSeriesReader.h"
+#include "itkMetaDataObject.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+
+#include <fstream>
+
+namespace
+{
+using ImageType = itk::Image<short, 3>;
+
+// Writes a JPEG lossless compressed slice of the series, at z = 2.5 * sliceNumber
+void
+WriteSlice(const std::string & fileName, int sliceNumber)
+{
+  auto                      slice = ImageType::New();
+  const ImageType::SizeType size = { { 32, 24, 1 } };
+  slice->SetRegions(size);
+  slice->Allocate();
+  ImageType::PointType origin{};
+  origin[2] = 2.5 * sliceNumber;
+  slice->SetOrigin(origin);
+  itk::ImageRegionIteratorWithIndex<ImageType> it(slice, slice->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<short>(100 * sliceNumber + 3 * it.GetIndex()[1] + it.GetIndex()[0]));
+  }
+
+  itk::MetaDataDictionary & dictionary = slice->GetMetaDataDictionary();
+  itk::EncapsulateMetaData<std::string>(dictionary, "0008|0060", "CT");
+  itk::EncapsulateMetaData<std::string>(dictionary, "0020|000d", "1.2.826.0.1.3680043.2.1125.1.1");
+  itk::EncapsulateMetaData<std::string>(dictionary, "0020|000e", "1.2.826.0.1.3680043.2.1125.1.2");
+  itk::EncapsulateMetaData<std::string>(dictionary, "0020|0013", std::to_string(sliceNumber));
+
+  auto gdcmImageIO = itk::GDCMImageIO::New();
+  gdcmImageIO->KeepOriginalUIDOn();
+  gdcmImageIO->SetCompressionType(itk::GDCMImageIO::CompressionEnum::JPEG);
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(slice);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(gdcmImageIO);
+  writer->UseCompressionOn();
+  writer->Update();
+}
+
+ImageType::Pointer
+ReadSeries(const std::vector<std::string> & fileNames, bool useParallelReading)
+{
+  auto gdcmImageIO = itk::GDCMImageIO::New();
+  gdcmImageIO->LoadPrivateTagsOn();
+  auto reader = itk::ImageSeriesReader<ImageType>::New();
+  reader->SetImageIO(gdcmImageIO);
+  reader->SetFileNames(fileNames);
+  reader->SetUseParallelReading(useParallelReading);
+  reader->Update();
+  return reader->GetOutput();
+}
+} // namespace
+
+int
+itkGDCMSeriesParallelReadTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = std::string(argv[1]) + "/itkGDCMSeriesParallelReadTest";
+  itksys::SystemTools::RemoveADirectory(directory);
+  itksys::SystemTools::MakeDirectory(directory);
+
+  // The file names are not in the order of the slices, and a file which is
+  // not a DICOM one is in the directory
+  constexpr int            numberOfSlices = 13;
+  std::vector<std::string> expectedFileNames;
+  for (int i = 0; i < numberOfSlices; ++i)
+  {
+    expectedFileNames.push_back(directory + "/slice" + std::to_string((5 * i) % numberOfSlices) + ".dcm");
+    WriteSlice(expectedFileNames.back(), i);
+  }
+  std::ofstream(directory + "/README.txt") << "Not a DICOM file" << std::endl;
+
+  // The headers are read concurrently, even on a single core
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(4);
+
+  for (const unsigned int numberOfWorkUnits : { 1, 4, 16 })
+  {
+    std::cout << "NumberOfWorkUnits " << numberOfWorkUnits << std::endl;
+    auto seriesFileNames = itk::GDCMSeriesFileNames::New();
+    seriesFileNames->SetNumberOfWorkUnits(numberOfWorkUnits);
+    seriesFileNames->SetInputDirectory(directory);
+    ITK_TEST_EXPECT_EQUAL(seriesFileNames->GetSeriesUIDs().size(), 1);
+    ITK_TEST_EXPECT_TRUE(seriesFileNames->GetInputFileNames() == expectedFileNames);
+  }
+
+  // The ImageIO of each slice has the options of the one of the reader
+  auto gdcmImageIO = itk::GDCMImageIO::New();
+  gdcmImageIO->LoadPrivateTagsOn();
+  gdcmImageIO->ReadYBRtoRGBOff();
+  const auto clone = itk::GDCMImageIO::Pointer(dynamic_cast<itk::GDCMImageIO *>(gdcmImageIO->Clone().GetPointer()));
+  ITK_TEST_EXPECT_TRUE(clone.IsNotNull());
+  ITK_TEST_EXPECT_TRUE(clone->GetLoadPrivateTags());
+  ITK_TEST_EXPECT_TRUE(!clone->GetReadYBRtoRGB());
+
+  // The slices are decompressed concurrently
+  ImageType::Pointer expectedImage;
+  ITK_TRY_EXPECT_NO_EXCEPTION(expectedImage = ReadSeries(expectedFileNames, false));
+  ImageType::Pointer image;
+  ITK_TRY_EXPECT_NO_EXCEPTION(image = ReadSeries(expectedFileNames, true));
+  ITK_TEST_EXPECT_EQUAL(image->GetBufferedRegion(), expectedImage->GetBufferedRegion());
+  ITK_TEST_EXPECT_EQUAL(image->GetBufferedRegion().GetSize(2), static_cast<itk::SizeValueType>(numberOfSlices));
+  ITK_TEST_EXPECT_TRUE(std::equal(image->GetBufferPointer(),
+                                  image->GetBufferPointer() + image->GetBufferedRegion().GetNumberOfPixels(),
+                                  expectedImage->GetBufferPointer()));
+  ITK_TEST_EXPECT_EQUAL(image->GetPixel({ { 5, 7, 9 } }), 100 * 9 + 3 * 7 + 5);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
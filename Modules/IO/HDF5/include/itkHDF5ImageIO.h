@@ -80,6 +80,18 @@ namespace itk
  *                             in the MetaDataDictionary
  * re-arrangement.
  *
+ * The voxel data is stored in chunks, which HDF5 compresses and
+ * decompresses individually. By default, a chunk holds one slice of the
+ * image, along its slowest dimension; SetChunkSize() selects smaller blocks,
+ * so that reading a small region only decompresses the chunks overlapping it.
+ * Streamed writes are split at chunk boundaries whenever possible, and
+ * pasting a region into an existing file only rewrites the chunks of the region.
+ *
+ * The compression filter of the chunks is selected with SetCompressor():
+ * "GZIP" (or "DEFLATE", the default), "SHUFFLE" for a byte shuffle followed by
+ * gzip, which often compresses multi-byte pixels better, or "NOCOMPRESSION".
+ * For compatibility with files written by previous versions, the chunks are
+ * compressed whether or not UseCompression is enabled.
  *
  */
 
@@ -138,6 +150,53 @@ public:
   void
   Write(const void * buffer) override;
 
+  /** Shape of the chunks of the voxel data, in pixels along each dimension
+   * of the image. A missing or zero entry selects the default along that
+   * dimension: the whole extent of the image, except one pixel along the
+   * slowest dimension of an image of more than one dimension. Entries are
+   * clipped to the size of the image. Only used when writing a new file,
+   * see GetFileChunkSize() for the chunk shape of a file read.
+   * @ITKStartGrouping */
+  void
+  SetChunkSize(const std::vector<SizeValueType> & chunkSize)
+  {
+    if (m_ChunkSize != chunkSize)
+    {
+      m_ChunkSize = chunkSize;
+      this->Modified();
+    }
+  }
+  const std::vector<SizeValueType> &
+  GetChunkSize() const
+  {
+    return m_ChunkSize;
+  }
+  /** @ITKEndGrouping */
+
+  /** Chunk shape of the voxel data of the file, in pixels along each
+   * dimension of the image, after ReadImageInformation(), or an empty vector
+   * if it is not chunked. */
+  const std::vector<SizeValueType> &
+  GetFileChunkSize() const
+  {
+    return m_FileChunkSize;
+  }
+
+  /** Starts a new write session: closes the file of a previous one, and when
+   * pasting a region into an existing file, gets the chunk shape of that file. */
+  unsigned int
+  GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion) override;
+
+  /** Splits the paste region along chunk boundaries, so that each chunk is
+   * only written once, unless there are fewer chunks than requested splits. */
+  ImageIORegion
+  GetSplitRegionForWriting(unsigned int          ithPiece,
+                           unsigned int          numberOfActualSplits,
+                           const ImageIORegion & pasteRegion,
+                           const ImageIORegion & largestPossibleRegion) override;
+
 protected:
   HDF5ImageIO();
   ~HDF5ImageIO() override;
@@ -148,6 +207,9 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  void
+  InternalSetCompressor(const std::string & _compressor) override;
+
 private:
   void
   WriteString(const std::string & path, const std::string & value);
@@ -214,9 +276,30 @@ private:
   void
   ResetToInitialState();
 
+  /** Chunk shape of a new file, in ITK order, from m_ChunkSize and the
+   * dimensions of the image. */
+  std::vector<SizeValueType>
+  GetChunkSizeForWriting() const;
+
+  /** Number of chunks along the dimension along which the paste region is
+   * split, i.e. the slowest one spanning more than one chunk, or 0 if the
+   * region lies within a single chunk. */
+  unsigned int
+  GetNumberOfChunkSlabs(const ImageIORegion & pasteRegion, unsigned int & splitDimension) const;
+
   std::unique_ptr<H5::H5File>  m_H5File;
   std::unique_ptr<H5::DataSet> m_VoxelDataSet;
   bool                         m_ImageInformationWritten{ false };
+
+  std::vector<SizeValueType> m_ChunkSize{};
+  std::vector<SizeValueType> m_FileChunkSize{};
+  bool                       m_DeflateChunks{ true };
+  bool                       m_ShuffleChunks{ false };
+
+  // Chunk shape of the file of the current write session, and whether its
+  // paste region is written into an existing file, until the header is written
+  std::vector<SizeValueType> m_ChunkSizeOfWrittenFile{};
+  bool                       m_PasteIntoExistingFile{ false };
 };
 } // end namespace itk
 
@@ -22,6 +22,7 @@
 #include "itksys/SystemTools.hxx"
 #include "itk_H5Cpp.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkPrintHelper.h"
 
 #include <algorithm>
 
@@ -40,8 +41,10 @@ HDF5ImageIO::HDF5ImageIO()
     this->AddSupportedWriteExtension(ext);
     this->AddSupportedReadExtension(ext);
   }
+  this->AddSupportedReadSignature("\x89HDF\r\n\x1a\n");
   this->Self::SetMaximumCompressionLevel(9);
   this->Self::SetCompressionLevel(5);
+  this->Self::SetCompressor("");
 }
 
 HDF5ImageIO::~HDF5ImageIO() { this->ResetToInitialState(); }
@@ -52,6 +55,36 @@ HDF5ImageIO::PrintSelf(std::ostream & os, Indent indent) const
   Superclass::PrintSelf(os, indent);
   // just prints out the pointer value.
   os << indent << "H5File: " << m_H5File.get() << std::endl;
+
+  using namespace print_helper;
+  os << indent << "ChunkSize: " << m_ChunkSize << std::endl;
+  os << indent << "FileChunkSize: " << m_FileChunkSize << std::endl;
+  os << indent << "DeflateChunks: " << (m_DeflateChunks ? "On" : "Off") << std::endl;
+  os << indent << "ShuffleChunks: " << (m_ShuffleChunks ? "On" : "Off") << std::endl;
+}
+
+void
+HDF5ImageIO::InternalSetCompressor(const std::string & _compressor)
+{
+  if (_compressor.empty() || _compressor == "GZIP" || _compressor == "DEFLATE")
+  {
+    m_DeflateChunks = true;
+    m_ShuffleChunks = false;
+  }
+  else if (_compressor == "SHUFFLE")
+  {
+    m_DeflateChunks = true;
+    m_ShuffleChunks = true;
+  }
+  else if (_compressor == "NOCOMPRESSION")
+  {
+    m_DeflateChunks = false;
+    m_ShuffleChunks = false;
+  }
+  else
+  {
+    this->Superclass::InternalSetCompressor(_compressor);
+  }
 }
 
 //
@@ -648,6 +681,7 @@ HDF5ImageIO::ResetToInitialState()
   // a state similar to constructing
   // anew.
   m_ImageInformationWritten = false;
+  m_PasteIntoExistingFile = false;
 }
 
 void
@@ -711,6 +745,22 @@ HDF5ImageIO::ReadImageInformation()
     H5::DataSet         imageSet = *(m_VoxelDataSet);
     const H5::DataSpace imageSpace = imageSet.getSpace();
     //
+    // the chunk shape, from the slowest dimension, without the components
+    {
+      m_FileChunkSize.clear();
+      const H5::DSetCreatPropList createPropertyList = imageSet.getCreatePlist();
+      if (createPropertyList.getLayout() == H5D_CHUNKED)
+      {
+        const int  chunkRank = createPropertyList.getChunk(0, nullptr);
+        const auto chunkDims = make_unique_for_overwrite<hsize_t[]>(chunkRank);
+        createPropertyList.getChunk(chunkRank, chunkDims.get());
+        for (int i = numDims - 1; i >= 0; --i)
+        {
+          m_FileChunkSize.push_back(static_cast<SizeValueType>(chunkDims[i]));
+        }
+      }
+    }
+    //
     // set the componentType
     H5::DataType imageVoxelType = imageSet.getDataType();
     this->m_ComponentType = PredTypeToComponentType(imageVoxelType);
@@ -1010,8 +1060,23 @@ HDF5ImageIO::WriteImageInformation()
 
   try
   {
+    // the paste mode of the write session is reset with the file
+    const bool pasteIntoExistingFile = m_PasteIntoExistingFile;
     this->ResetToInitialState();
 
+    if (pasteIntoExistingFile && this->CanStreamWrite())
+    {
+      // only the voxel data of the paste region is written, into the
+      // existing dataset, whose header was checked to match
+      m_H5File = std::make_unique<H5::H5File>(this->GetFileName(), H5F_ACC_RDWR);
+      std::string VoxelDataName(ImageGroup);
+      VoxelDataName += "/0";
+      VoxelDataName += VoxelData;
+      m_VoxelDataSet = std::make_unique<H5::DataSet>(m_H5File->openDataSet(VoxelDataName));
+      m_ImageInformationWritten = true;
+      return;
+    }
+
     const H5::FileAccPropList fapl;
 #if (H5_VERS_MAJOR > 1) || (H5_VERS_MAJOR == 1) && (H5_VERS_MINOR > 10) || \
   (H5_VERS_MAJOR == 1) && (H5_VERS_MINOR == 10) && (H5_VERS_RELEASE >= 2)
@@ -1070,14 +1135,21 @@ HDF5ImageIO::WriteImageInformation()
     const H5::PredType  dataType = ComponentToPredType(this->GetComponentType());
 
     // set up properties for chunked, compressed writes.
-    // in this case, set the chunk size to be the N-1 dimension
-    // region
+    // voxel components are always kept together in a chunk
+    const std::vector<SizeValueType> chunkSize = this->GetChunkSizeForWriting();
+    for (int i(0), j(this->GetNumberOfDimensions() - 1); j >= 0; i++, j--)
+    {
+      dims[j] = chunkSize[i];
+    }
     const H5::DSetCreatPropList plist;
-
-    // we have implicit compression enabled here?
-    plist.setDeflate(this->GetCompressionLevel());
-
-    dims[0] = 1;
+    if (m_ShuffleChunks)
+    {
+      plist.setShuffle();
+    }
+    if (m_DeflateChunks)
+    {
+      plist.setDeflate(this->GetCompressionLevel());
+    }
     plist.setChunk(numDims, dims.get());
     dims.reset();
 
@@ -1311,6 +1383,105 @@ HDF5ImageIO::Write(const void * buffer)
   // this->ResetToInitialState();
 }
 
+std::vector<ImageIOBase::SizeValueType>
+HDF5ImageIO::GetChunkSizeForWriting() const
+{
+  const unsigned int         numDims = this->GetNumberOfDimensions();
+  std::vector<SizeValueType> chunkSize(numDims);
+  for (unsigned int i = 0; i < numDims; ++i)
+  {
+    // by default, one chunk per slice
+    SizeValueType size = (numDims > 1 && i == numDims - 1) ? 1 : this->m_Dimensions[i];
+    if (i < m_ChunkSize.size() && m_ChunkSize[i] > 0)
+    {
+      size = m_ChunkSize[i];
+    }
+    chunkSize[i] = std::max<SizeValueType>(std::min<SizeValueType>(size, this->m_Dimensions[i]), 1);
+  }
+  return chunkSize;
+}
+
+unsigned int
+HDF5ImageIO::GetNumberOfChunkSlabs(const ImageIORegion & pasteRegion, unsigned int & splitDimension) const
+{
+  for (int i = static_cast<int>(pasteRegion.GetImageDimension()) - 1; i >= 0; --i)
+  {
+    if (static_cast<unsigned int>(i) >= m_ChunkSizeOfWrittenFile.size() || pasteRegion.GetSize(i) == 0)
+    {
+      continue;
+    }
+    const auto          chunkSize = static_cast<IndexValueType>(m_ChunkSizeOfWrittenFile[i]);
+    const IndexValueType firstChunk = pasteRegion.GetIndex(i) / chunkSize;
+    const IndexValueType lastChunk =
+      (pasteRegion.GetIndex(i) + static_cast<IndexValueType>(pasteRegion.GetSize(i)) - 1) / chunkSize;
+    if (lastChunk > firstChunk)
+    {
+      splitDimension = i;
+      return static_cast<unsigned int>(lastChunk - firstChunk + 1);
+    }
+  }
+  return 0;
+}
+
+unsigned int
+HDF5ImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                               const ImageIORegion & pasteRegion,
+                                               const ImageIORegion & largestPossibleRegion)
+{
+  // a file written in a previous session must be closed before it is
+  // removed or reopened
+  this->ResetToInitialState();
+
+  const unsigned int numberOfSplits =
+    Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+
+  m_PasteIntoExistingFile = this->CanStreamWrite() && pasteRegion != largestPossibleRegion &&
+                            itksys::SystemTools::FileExists(this->GetFileName());
+  if (m_PasteIntoExistingFile)
+  {
+    // the superclass checked that the header of the file matches
+    const Pointer fileImageIO = Self::New();
+    fileImageIO->SetFileName(this->GetFileName());
+    fileImageIO->ReadImageInformation();
+    m_ChunkSizeOfWrittenFile = fileImageIO->GetFileChunkSize();
+  }
+  else
+  {
+    m_ChunkSizeOfWrittenFile = this->GetChunkSizeForWriting();
+  }
+  return numberOfSplits;
+}
+
+ImageIORegion
+HDF5ImageIO::GetSplitRegionForWriting(unsigned int          ithPiece,
+                                      unsigned int          numberOfActualSplits,
+                                      const ImageIORegion & pasteRegion,
+                                      const ImageIORegion & largestPossibleRegion)
+{
+  unsigned int       splitDimension = 0;
+  const unsigned int numberOfSlabs = this->GetNumberOfChunkSlabs(pasteRegion, splitDimension);
+  if (numberOfActualSplits <= 1 || numberOfSlabs < numberOfActualSplits)
+  {
+    // a chunk is written by several pieces
+    return Superclass::GetSplitRegionForWriting(ithPiece, numberOfActualSplits, pasteRegion, largestPossibleRegion);
+  }
+
+  // distribute the chunk slabs evenly over the pieces
+  const auto           chunkSize = static_cast<IndexValueType>(m_ChunkSizeOfWrittenFile[splitDimension]);
+  const IndexValueType regionBegin = pasteRegion.GetIndex(splitDimension);
+  const IndexValueType regionEnd = regionBegin + static_cast<IndexValueType>(pasteRegion.GetSize(splitDimension));
+  const IndexValueType firstChunk = regionBegin / chunkSize;
+  const IndexValueType firstSlab = static_cast<IndexValueType>(ithPiece) * numberOfSlabs / numberOfActualSplits;
+  const IndexValueType endSlab = static_cast<IndexValueType>(ithPiece + 1) * numberOfSlabs / numberOfActualSplits;
+  const IndexValueType pieceBegin = std::max(regionBegin, (firstChunk + firstSlab) * chunkSize);
+  const IndexValueType pieceEnd = std::min(regionEnd, (firstChunk + endSlab) * chunkSize);
+
+  ImageIORegion splitRegion = pasteRegion;
+  splitRegion.SetIndex(splitDimension, pieceBegin);
+  splitRegion.SetSize(splitDimension, static_cast<SizeValueType>(pieceEnd - pieceBegin));
+  return splitRegion;
+}
+
 //
 // GetHeaderSize -- return 0
 ImageIOBase::SizeType
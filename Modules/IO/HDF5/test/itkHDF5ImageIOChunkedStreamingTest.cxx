@@ -0,0 +1,200 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHDF5ImageIO.h"
+#include "itkHDF5ImageIOFactory.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingImageIOStreamingHelpers.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+using ImageType = itk::Image<short, 3>;
+using ChunkSizeType = std::vector<itk::SizeValueType>;
+
+// Creates an image whose buffer only holds bufferedRegion, as the output of a
+// streamed filter, so that the writer does not write the whole image at once
+ImageType::Pointer
+CreateImage(const ImageType::SizeType & size, bool negate, const ImageType::RegionType & bufferedRegion)
+{
+  auto image = ImageType::New();
+  image->SetLargestPossibleRegion(ImageType::RegionType(size));
+  image->SetBufferedRegion(bufferedRegion);
+  image->SetRequestedRegion(bufferedRegion);
+  image->Allocate();
+  itk::Testing::FillWithIndexPattern(image.GetPointer(), negate);
+  return image;
+}
+
+ChunkSizeType
+ReadChunkSize(const std::string & fileName)
+{
+  auto hdf5ImageIO = itk::HDF5ImageIO::New();
+  hdf5ImageIO->SetFileName(fileName);
+  hdf5ImageIO->ReadImageInformation();
+  return hdf5ImageIO->GetFileChunkSize();
+}
+
+void
+WriteStreamed(const ImageType *                   image,
+              const std::string &                 fileName,
+              itk::HDF5ImageIO *                  hdf5ImageIO,
+              unsigned int                        numberOfStreamDivisions,
+              const ImageType::RegionType * const pasteRegion = nullptr)
+{
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(hdf5ImageIO);
+  writer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+  if (pasteRegion != nullptr)
+  {
+    itk::ImageIORegion ioRegion(ImageType::ImageDimension);
+    itk::ImageIORegionAdaptor<ImageType::ImageDimension>::Convert(
+      *pasteRegion, ioRegion, image->GetLargestPossibleRegion().GetIndex());
+    writer->SetIORegion(ioRegion);
+  }
+  writer->Update();
+}
+
+} // namespace
+
+int
+itkHDF5ImageIOChunkedStreamingTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+  itk::ObjectFactoryBase::RegisterFactory(itk::HDF5ImageIOFactory::New());
+
+  const ImageType::SizeType   size = { { 45, 37, 20 } };
+  const ImageType::Pointer    image = CreateImage(size, false, ImageType::RegionType(size));
+  const ChunkSizeType         chunkSize = { 16, 16, 8 };
+  // across the corner of eight chunks
+  const ImageType::RegionType region({ { 10, 12, 5 } }, { { 20, 10, 6 } });
+  const std::string           fileName = outputDirectory + "/itkHDF5ImageIOChunkedStreamingTest.hdf5";
+
+  // The same ImageIO writes several files
+  auto hdf5ImageIO = itk::HDF5ImageIO::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(hdf5ImageIO, HDF5ImageIO, StreamingImageIOBase);
+  ITK_TEST_EXPECT_TRUE(hdf5ImageIO->GetChunkSize().empty());
+  hdf5ImageIO->SetChunkSize(chunkSize);
+  ITK_TEST_EXPECT_TRUE(hdf5ImageIO->GetChunkSize() == chunkSize);
+
+  ImageType::Pointer readImage;
+  for (const std::string compressor : { "", "SHUFFLE", "NOCOMPRESSION", "GZIP" })
+  {
+    std::cout << "Compressor \"" << compressor << '"' << std::endl;
+    hdf5ImageIO->SetCompressor(compressor);
+    ITK_TRY_EXPECT_NO_EXCEPTION(WriteStreamed(image, fileName, hdf5ImageIO, 3));
+    ITK_TEST_EXPECT_TRUE(ReadChunkSize(fileName) == chunkSize);
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(readImage = itk::ReadImage<ImageType>(fileName));
+    ITK_TEST_EXPECT_EQUAL(readImage->GetBufferedRegion(), image->GetLargestPossibleRegion());
+    ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(readImage.GetPointer(), image.GetPointer()));
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(readImage = itk::Testing::ReadImageRegion<ImageType>(fileName, region));
+    ITK_TEST_EXPECT_EQUAL(readImage->GetBufferedRegion(), region);
+    ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(readImage.GetPointer(), image.GetPointer()));
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(readImage = itk::Testing::ReadImageStreamed<ImageType>(fileName, 7));
+    ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(readImage.GetPointer(), image.GetPointer()));
+  }
+
+  // Reading a file keeps the chunk shape of the files to write
+  {
+    auto                readImageIO = itk::HDF5ImageIO::New();
+    const ChunkSizeType writeChunkSize = { 8, 8, 8 };
+    readImageIO->SetChunkSize(writeChunkSize);
+    readImageIO->SetFileName(fileName);
+    ITK_TRY_EXPECT_NO_EXCEPTION(readImageIO->ReadImageInformation());
+    ITK_TEST_EXPECT_TRUE(readImageIO->GetFileChunkSize() == chunkSize);
+    ITK_TEST_EXPECT_TRUE(readImageIO->GetChunkSize() == writeChunkSize);
+  }
+
+  // Writes are split at chunk boundaries of the slowest dimension
+  {
+    auto splitImageIO = itk::HDF5ImageIO::New();
+    splitImageIO->SetFileName(outputDirectory + "/itkHDF5ImageIOChunkedStreamingTestNotWritten.hdf5");
+    splitImageIO->SetNumberOfDimensions(3);
+    itk::ImageIORegion largestRegion(3);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      splitImageIO->SetDimensions(i, size[i]);
+      largestRegion.SetSize(i, size[i]);
+    }
+    splitImageIO->SetChunkSize(chunkSize);
+    splitImageIO->SetUseStreamedWriting(true);
+    const unsigned int numberOfSplits =
+      splitImageIO->GetActualNumberOfSplitsForWriting(3, largestRegion, largestRegion);
+    ITK_TEST_EXPECT_EQUAL(numberOfSplits, 3);
+    const itk::SizeValueType expectedBegins[] = { 0, 8, 16, 20 };
+    for (unsigned int i = 0; i < numberOfSplits; ++i)
+    {
+      const itk::ImageIORegion split = splitImageIO->GetSplitRegionForWriting(i, 3, largestRegion, largestRegion);
+      ITK_TEST_EXPECT_EQUAL(static_cast<itk::SizeValueType>(split.GetIndex(2)), expectedBegins[i]);
+      ITK_TEST_EXPECT_EQUAL(split.GetSize(2), expectedBegins[i + 1] - expectedBegins[i]);
+      ITK_TEST_EXPECT_EQUAL(split.GetSize(0), size[0]);
+    }
+  }
+
+  // Pasting a region keeps the chunk shape and the rest of the file
+  const ImageType::RegionType pasteRegion({ { 3, 10, 5 } }, { { 30, 20, 14 } });
+  const ImageType::Pointer    pastedImage = CreateImage(size, true, pasteRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(WriteStreamed(pastedImage, fileName, hdf5ImageIO, 2, &pasteRegion));
+  ITK_TEST_EXPECT_TRUE(ReadChunkSize(fileName) == chunkSize);
+  ITK_TRY_EXPECT_NO_EXCEPTION(readImage = itk::ReadImage<ImageType>(fileName));
+  itk::ImageRegionConstIteratorWithIndex<ImageType> it(readImage, readImage->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const short expectedValue =
+      pasteRegion.IsInside(it.GetIndex()) ? pastedImage->GetPixel(it.GetIndex()) : image->GetPixel(it.GetIndex());
+    if (it.Get() != expectedValue)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Pixel " << it.GetIndex() << " is " << it.Get() << " after pasting instead of " << expectedValue
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // By default, one chunk per slice
+  hdf5ImageIO->SetChunkSize({});
+  ITK_TRY_EXPECT_NO_EXCEPTION(WriteStreamed(image, fileName, hdf5ImageIO, 4));
+  const ChunkSizeType sliceChunkSize = { 45, 37, 1 };
+  ITK_TEST_EXPECT_TRUE(ReadChunkSize(fileName) == sliceChunkSize);
+  ITK_TRY_EXPECT_NO_EXCEPTION(readImage = itk::Testing::ReadImageRegion<ImageType>(fileName, region));
+  ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(readImage.GetPointer(), image.GetPointer()));
+
+  // Chunks larger than the image are clipped to it
+  hdf5ImageIO->SetChunkSize({ 100, 0, 7 });
+  ITK_TRY_EXPECT_NO_EXCEPTION(WriteStreamed(image, fileName, hdf5ImageIO, 1));
+  const ChunkSizeType clippedChunkSize = { 45, 37, 7 };
+  ITK_TEST_EXPECT_TRUE(ReadChunkSize(fileName) == clippedChunkSize);
+  ITK_TRY_EXPECT_NO_EXCEPTION(readImage = itk::ReadImage<ImageType>(fileName));
+  ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(readImage.GetPointer(), image.GetPointer()));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,31 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+/*
+   This file tests whether struct stat has the nanoseconds of the
+   modification time of files in st_mtim (POSIX.1-2008)
+*/
+
+#include <sys/stat.h>
+
+int
+main()
+{
+  struct stat status{};
+  stat(".", &status);
+  return static_cast<int>(status.st_mtim.tv_nsec % 2);
+}
@@ -0,0 +1,105 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkAsynchronousImageIOWriter_h
+#define itkAsynchronousImageIOWriter_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkImageIOBase.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace itk
+{
+/** \class AsynchronousImageIOWriter
+ * \brief Writes the pieces of a streamed image with an ImageIO, on a background thread.
+ *
+ * Write() queues a piece, given by its IO region and its buffer, and returns
+ * as soon as the number of pieces queued or being written is below the
+ * maximum, so that the caller computes the next piece while the previous ones
+ * are written. The pieces are written in the order in which they are queued,
+ * by a single thread which is the only user of the ImageIO until Wait()
+ * returns or the writer is destroyed.
+ *
+ * The first exception thrown by the ImageIO discards the pieces which are not
+ * written yet, and is rethrown by the next call to Write() or Wait().
+ *
+ * \sa ImageFileWriter
+ * \ingroup IOFilters
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT AsynchronousImageIOWriter
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(AsynchronousImageIOWriter);
+
+  /** The maximum number of pieces in flight is at least one, in which case
+   * a piece is written while the next one is computed. */
+  AsynchronousImageIOWriter(ImageIOBase * imageIO, unsigned int maximumNumberOfPiecesInFlight);
+
+  /** Discards the pieces which are not written yet, and waits for the one
+   * being written. */
+  ~AsynchronousImageIOWriter();
+
+  /** Queues the buffer of the given IO region for writing, blocking while the
+   * maximum number of pieces are in flight. bufferOwner, e.g. the image which
+   * holds the buffer, is kept alive until the piece is written. */
+  void
+  Write(const ImageIORegion & region, const void * buffer, const LightObject * bufferOwner);
+
+  /** Waits until all the queued pieces are written, after which the ImageIO
+   * may be used again by the caller. */
+  void
+  Wait();
+
+  /** Returns the number of pieces written so far. */
+  unsigned int
+  GetNumberOfWrittenPieces() const;
+
+private:
+  struct Piece
+  {
+    ImageIORegion             Region{};
+    const void *              Buffer{ nullptr };
+    LightObject::ConstPointer BufferOwner{};
+  };
+
+  void
+  WritePieces();
+
+  /** Stops the thread once the queue is empty, and joins it. */
+  void
+  StopThread();
+
+  ImageIOBase::Pointer    m_ImageIO{};
+  const unsigned int      m_MaximumNumberOfPiecesInFlight{ 1 };
+  std::deque<Piece>       m_Pieces{};
+  bool                    m_IsWritingPiece{ false };
+  bool                    m_IsStopping{ false };
+  unsigned int            m_NumberOfWrittenPieces{ 0 };
+  std::exception_ptr      m_Exception{};
+  mutable std::mutex      m_Mutex{};
+  std::condition_variable m_Condition{};
+  std::thread             m_Thread{};
+};
+} // end namespace itk
+
+#endif // itkAsynchronousImageIOWriter_h
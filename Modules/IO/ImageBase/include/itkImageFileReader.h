@@ -28,6 +28,11 @@
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkSimpleDataObjectDecorator.h"
 
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+
 namespace itk
 {
 
@@ -55,6 +60,10 @@ namespace itk
  * raw binary format) have no accepted suffix, so you will have to
  * manually create the ImageIO instance of the write type.
  *
+ * When the ImageIOInformationCache is enabled, the ImageIO created by the
+ * factory and the image information come from it for the files it has
+ * already seen, which speeds up repeated calls to UpdateOutputInformation().
+ *
  * \sa ImageSeriesReader
  * \sa ImageIOBase
  *
@@ -121,9 +130,50 @@ public:
   itkGetConstReferenceMacro(UseStreaming, bool);
   itkBooleanMacro(UseStreaming);
   /** @ITKEndGrouping */
+
+  /** Set/Get whether, and how, the file is memory mapped instead of read.
+   * The file is mapped when the ImageIO reports that the pixels of the whole
+   * image are stored as they are laid out in memory (see
+   * ImageIOBase::CanMapPixelData()), and the pixel type of the output matches
+   * the one of the file. The output then buffers its largest possible
+   * region, and the pixels are only read from the file when first accessed.
+   * Otherwise, the file is read as usual. The default is Off.
+   * MemoryMappingOn() maps the file copy-on-write, so that the output can be
+   * written to like any other image. Only request ReadOnly when nothing
+   * writes to the output: writing to a read-only mapping crashes the process.
+   * \sa MemoryMappedImageBufferAllocator */
+  /** @ITKStartGrouping */
+  itkSetEnumMacro(MemoryMapping, IOMemoryMappingEnum);
+  itkGetEnumMacro(MemoryMapping, IOMemoryMappingEnum);
+  void
+  MemoryMappingOn()
+  {
+    this->SetMemoryMapping(IOMemoryMappingEnum::CopyOnWrite);
+  }
+  void
+  MemoryMappingOff()
+  {
+    this->SetMemoryMapping(IOMemoryMappingEnum::Off);
+  }
+  /** @ITKEndGrouping */
+
+  /** Set/Get whether the next region of a streamed pipeline is read ahead.
+   * After reading a region which is not the whole image, the reader then
+   * reads the one which follows it along the slowest dimension which is not
+   * read whole, on a background thread, while the downstream filters process
+   * the current region. That is the order of the pieces of a StreamingImageFilter
+   * or a streamed ImageFileWriter, with their default splitters. If the
+   * next requested region is the one read ahead, its buffer is swapped into
+   * the output instead of being read; otherwise it is read as usual. The
+   * default is Off. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UsePrefetching, bool);
+  itkGetConstReferenceMacro(UsePrefetching, bool);
+  itkBooleanMacro(UsePrefetching);
+  /** @ITKEndGrouping */
 protected:
   ImageFileReader();
-  ~ImageFileReader() override = default;
+  ~ImageFileReader() override;
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
@@ -156,6 +206,21 @@ protected:
   void
   GenerateData() override;
 
+  /** Maps the file into the buffer of the output, if possible. Returns
+   * whether it did. */
+  bool
+  MapOutputBuffer();
+
+  /** Starts reading ahead the region which follows m_ActualIORegion, into a
+   * buffer of the file pixel type, or into a pixel container of the output. */
+  void
+  PrefetchNextRegion(bool convertBuffer);
+
+  /** Waits for the region being read ahead, which is discarded if its
+   * reading failed, so that the ImageIO may be used. */
+  void
+  WaitForPrefetchedRegion();
+
   ImageIOBase::Pointer m_ImageIO{};
 
   bool m_UserSpecifiedImageIO{}; // keep track whether the
@@ -163,12 +228,35 @@ protected:
 
   bool m_UseStreaming{};
 
+  IOMemoryMappingEnum m_MemoryMapping{ IOMemoryMappingEnum::Off };
+
 private:
   std::string m_ExceptionMessage{};
 
   // The region that the ImageIO class will return when we ask to
   // produce the requested region.
   ImageIORegion m_ActualIORegion{};
+
+  // Whether the information of m_ImageIO comes from the ImageIOInformationCache,
+  // without the header of the file being parsed yet
+  bool m_ImageIOInformationIsCached{ false };
+
+  bool m_UsePrefetching{ false };
+
+  // The region read ahead, and its buffer
+  ImageIORegion                                m_PrefetchedIORegion{};
+  std::unique_ptr<char[]>                      m_PrefetchedBuffer{};
+  typename TOutputImage::PixelContainerPointer m_PrefetchedPixelContainer{};
+
+  // Reading ahead, run by a job of the ThreadPool unless the reader needs
+  // the region before any thread of the pool has started the job
+  struct Prefetch
+  {
+    std::atomic<bool>     m_Started{ false };
+    std::function<void()> m_Read{};
+    std::future<void>     m_Finished{};
+  };
+  std::shared_ptr<Prefetch> m_Prefetch{};
 };
 
 
@@ -20,13 +20,17 @@
 
 #include "itkObjectFactory.h"
 #include "itkImageIOFactory.h"
+#include "itkImageIOInformationCache.h"
 #include "itkConvertPixelBuffer.h"
 #include "itkPixelTraits.h"
 #include "itkVectorImage.h"
 #include "itkMetaDataObject.h"
+#include "itkMemoryMappedImageBufferAllocator.h"
+#include "itkThreadPool.h"
 
 #include "itksys/SystemTools.hxx"
 #include "itkMakeUniqueForOverwrite.h"
+#include <algorithm>
 #include <fstream>
 
 namespace itk
@@ -49,11 +53,23 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::PrintSelf(std::ostream & os,
 
   itkPrintSelfBooleanMacro(UserSpecifiedImageIO);
   itkPrintSelfBooleanMacro(UseStreaming);
+  os << indent << "MemoryMapping: " << m_MemoryMapping << std::endl;
+  itkPrintSelfBooleanMacro(UsePrefetching);
 
   os << indent << "ExceptionMessage: " << m_ExceptionMessage << std::endl;
   os << indent << "ActualIORegion: " << m_ActualIORegion << std::endl;
 }
 
+template <typename TOutputImage, typename ConvertPixelTraits>
+ImageFileReader<TOutputImage, ConvertPixelTraits>::~ImageFileReader()
+{
+  // the buffer of a region being read ahead must outlive its reading
+  if (m_Prefetch && m_Prefetch->m_Started.exchange(true))
+  {
+    m_Prefetch->m_Finished.wait();
+  }
+}
+
 template <typename TOutputImage, typename ConvertPixelTraits>
 void
 ImageFileReader<TOutputImage, ConvertPixelTraits>::SetImageIO(ImageIOBase * imageIO)
@@ -75,6 +91,12 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateOutputInformation()
 
   itkDebugMacro("Reading file for GenerateOutputInformation()" << this->GetFileName());
 
+  // the file may have changed, so the region read ahead is discarded
+  this->WaitForPrefetchedRegion();
+  m_PrefetchedIORegion = ImageIORegion();
+  m_PrefetchedBuffer.reset();
+  m_PrefetchedPixelContainer = nullptr;
+
   // Check to see if we can read the file given the name or prefix
   //
   if (this->GetFileName().empty())
@@ -97,9 +119,17 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateOutputInformation()
     m_ExceptionMessage = err.GetDescription();
   }
 
+  m_ImageIOInformationIsCached = false;
   if (m_UserSpecifiedImageIO == false) // try creating via factory
   {
-    m_ImageIO = ImageIOFactory::CreateImageIO(this->GetFileName().c_str(), ImageIOFactory::IOFileModeEnum::ReadMode);
+    // unless the information of the file is cached
+    m_ImageIO = ImageIOInformationCache::CreateImageIO(this->GetFileName());
+    m_ImageIOInformationIsCached = m_ImageIO.IsNotNull();
+    if (!m_ImageIOInformationIsCached)
+    {
+      m_ImageIO =
+        ImageIOFactory::CreateImageIO(this->GetFileName().c_str(), ImageIOFactory::IOFileModeEnum::ReadMode);
+    }
   }
 
   if (m_ImageIO.IsNull())
@@ -141,7 +171,14 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateOutputInformation()
   // the image.
   //
   m_ImageIO->SetFileName(this->GetFileName().c_str());
-  m_ImageIO->ReadImageInformation();
+  if (!m_ImageIOInformationIsCached)
+  {
+    m_ImageIO->ReadImageInformation();
+    if (m_UserSpecifiedImageIO == false)
+    {
+      ImageIOInformationCache::AddImageIO(this->GetFileName(), m_ImageIO);
+    }
+  }
 
   SizeType                             dimSize;
   double                               spacing[TOutputImage::ImageDimension];
@@ -306,6 +343,18 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::EnlargeOutputRequestedRegion(
 
   ImageIOAdaptor::Convert(imageRequestedRegion, ioRequestedRegion, largestRegion.GetIndex());
 
+  this->WaitForPrefetchedRegion();
+
+  if (m_ImageIOInformationIsCached)
+  {
+    // The ImageIO parses the header of the file before reading it, keeping
+    // the dictionary given to the output
+    const MetaDataDictionary dictionary = m_ImageIO->GetMetaDataDictionary();
+    m_ImageIO->ReadImageInformation();
+    m_ImageIO->SetMetaDataDictionary(dictionary);
+    m_ImageIOInformationIsCached = false;
+  }
+
   // Tell the IO if we should use streaming while reading
   m_ImageIO->SetUseStreamedReading(m_UseStreaming);
 
@@ -356,6 +405,38 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
 
   const typename TOutputImage::Pointer output = this->GetOutput();
 
+  if (m_MemoryMapping != IOMemoryMappingEnum::Off && this->MapOutputBuffer())
+  {
+    this->UpdateProgress(1.0f);
+    return;
+  }
+
+  // Use the region read ahead, if it is the requested one
+  this->WaitForPrefetchedRegion();
+  const bool                                         isPrefetched = m_PrefetchedIORegion == m_ActualIORegion;
+  std::unique_ptr<char[]>                            prefetchedBuffer = std::move(m_PrefetchedBuffer);
+  const typename TOutputImage::PixelContainerPointer prefetchedPixelContainer = m_PrefetchedPixelContainer;
+  m_PrefetchedIORegion = ImageIORegion();
+  m_PrefetchedPixelContainer = nullptr;
+
+  const IOComponentEnum ioType = ImageIOBase::MapPixelType<typename ConvertPixelTraits::ComponentType>::CType;
+  const bool            convertBuffer = m_ImageIO->GetComponentType() != ioType ||
+                             (m_ImageIO->GetNumberOfComponents() != ConvertPixelTraits::GetNumberOfComponents());
+
+  if (isPrefetched && prefetchedPixelContainer && !convertBuffer &&
+      m_ActualIORegion.GetNumberOfPixels() == output->GetRequestedRegion().GetNumberOfPixels())
+  {
+    itkDebugMacro("Swapping the region read ahead into the output.");
+    output->SetBufferedRegion(output->GetRequestedRegion());
+    output->SetPixelContainer(prefetchedPixelContainer);
+    if (m_UsePrefetching)
+    {
+      this->PrefetchNextRegion(convertBuffer);
+    }
+    this->UpdateProgress(1.0f);
+    return;
+  }
+
   itkDebugMacro("ImageFileReader::GenerateData() \n"
                 << "Allocating the buffer with the EnlargedRequestedRegion \n"
                 << output->GetRequestedRegion() << '\n');
@@ -391,9 +472,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   const size_t sizeOfActualIORegion =
     m_ActualIORegion.GetNumberOfPixels() * (m_ImageIO->GetComponentSize() * m_ImageIO->GetNumberOfComponents());
 
-  const IOComponentEnum ioType = ImageIOBase::MapPixelType<typename ConvertPixelTraits::ComponentType>::CType;
-  if (m_ImageIO->GetComponentType() != ioType ||
-      (m_ImageIO->GetNumberOfComponents() != ConvertPixelTraits::GetNumberOfComponents()))
+  if (convertBuffer)
   {
     // the pixel types don't match so a type conversion needs to be
     // performed
@@ -403,8 +482,16 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
                   << ConvertPixelTraits::GetNumberOfComponents() << " m_ImageIO->NumComponents "
                   << m_ImageIO->GetNumberOfComponents());
 
-    const auto loadBuffer = make_unique_for_overwrite<char[]>(sizeOfActualIORegion);
-    m_ImageIO->Read(static_cast<void *>(loadBuffer.get()));
+    std::unique_ptr<char[]> loadBuffer;
+    if (isPrefetched && prefetchedBuffer)
+    {
+      loadBuffer = std::move(prefetchedBuffer);
+    }
+    else
+    {
+      loadBuffer = make_unique_for_overwrite<char[]>(sizeOfActualIORegion);
+      m_ImageIO->Read(static_cast<void *>(loadBuffer.get()));
+    }
 
     // See note below as to why the buffered region is needed and
     // not actualIORegion
@@ -421,12 +508,22 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
 
     OutputImagePixelType * outputBuffer = output->GetPixelContainer()->GetBufferPointer();
 
-    const auto loadBuffer = make_unique_for_overwrite<char[]>(sizeOfActualIORegion);
-    m_ImageIO->Read(static_cast<void *>(loadBuffer.get()));
+    std::unique_ptr<char[]> readBuffer;
+    const void *            loadBuffer = nullptr;
+    if (isPrefetched && prefetchedPixelContainer)
+    {
+      loadBuffer = prefetchedPixelContainer->GetBufferPointer();
+    }
+    else
+    {
+      readBuffer = make_unique_for_overwrite<char[]>(sizeOfActualIORegion);
+      m_ImageIO->Read(static_cast<void *>(readBuffer.get()));
+      loadBuffer = readBuffer.get();
+    }
 
     // we use std::copy_n here as it should be optimized to memcpy for
     // plain old data, but still is object oriented programming
-    std::copy_n(reinterpret_cast<const OutputImagePixelType *>(loadBuffer.get()),
+    std::copy_n(static_cast<const OutputImagePixelType *>(loadBuffer),
                 output->GetBufferedRegion().GetNumberOfPixels(),
                 outputBuffer);
   }
@@ -438,9 +535,160 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
     m_ImageIO->Read(outputBuffer);
   }
 
+  if (m_UsePrefetching)
+  {
+    this->PrefetchNextRegion(convertBuffer);
+  }
+
   this->UpdateProgress(1.0f);
 }
 
+template <typename TOutputImage, typename ConvertPixelTraits>
+bool
+ImageFileReader<TOutputImage, ConvertPixelTraits>::MapOutputBuffer()
+{
+  using ElementType = typename TOutputImage::PixelContainer::Element;
+
+  const typename TOutputImage::Pointer output = this->GetOutput();
+  const ImageRegionType                largestRegion = output->GetLargestPossibleRegion();
+
+  // The pixels must be used as they are stored, and the whole file buffered
+  const IOComponentEnum ioType = ImageIOBase::MapPixelType<typename ConvertPixelTraits::ComponentType>::CType;
+  if (m_ImageIO->GetComponentType() != ioType ||
+      m_ImageIO->GetNumberOfComponents() != ConvertPixelTraits::GetNumberOfComponents() ||
+      static_cast<SizeValueType>(m_ImageIO->GetImageSizeInPixels()) != largestRegion.GetNumberOfPixels())
+  {
+    return false;
+  }
+
+  std::string         dataFileName;
+  SizeValueType       dataOffset = 0;
+  const SizeValueType numberOfBytes = m_ImageIO->GetImageSizeInBytes();
+  if (!m_ImageIO->CanMapPixelData(dataFileName, dataOffset) || dataOffset % alignof(ElementType) != 0 ||
+      numberOfBytes == 0 || numberOfBytes % sizeof(ElementType) != 0)
+  {
+    itkDebugMacro("The pixels of " << this->GetFileName() << " cannot be mapped.");
+    return false;
+  }
+
+  const auto allocator = MemoryMappedImageBufferAllocator::New();
+  void *     buffer = nullptr;
+  try
+  {
+    buffer = allocator->MapFile(dataFileName, dataOffset, numberOfBytes, m_MemoryMapping);
+  }
+  catch (const ExceptionObject & err)
+  {
+    itkDebugMacro("Reading " << this->GetFileName() << " instead of mapping it: " << err.GetDescription());
+    return false;
+  }
+
+  itkDebugMacro("Mapping " << numberOfBytes << " bytes at offset " << dataOffset << " of " << dataFileName);
+  output->SetBufferedRegion(largestRegion);
+  output->GetPixelContainer()->SetImportPointer(
+    static_cast<ElementType *>(buffer), numberOfBytes / sizeof(ElementType), allocator.GetPointer());
+  return true;
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>::PrefetchNextRegion(bool convertBuffer)
+{
+  // The pieces of a streamed pipeline follow each other along the slowest
+  // dimension which is split, the dimensions of the file beyond the ones of
+  // the output not being streamed
+  ImageIORegion      nextIORegion = m_ActualIORegion;
+  const unsigned int numberOfDimensions = std::min(
+    { nextIORegion.GetImageDimension(), m_ImageIO->GetNumberOfDimensions(), TOutputImage::ImageDimension });
+  unsigned int splitDimension = numberOfDimensions;
+  while (splitDimension > 0 &&
+         nextIORegion.GetSize(splitDimension - 1) >= m_ImageIO->GetDimensions(splitDimension - 1))
+  {
+    --splitDimension;
+  }
+  if (splitDimension == 0)
+  {
+    // the whole image is read
+    return;
+  }
+  --splitDimension;
+
+  const auto nextIndex = nextIORegion.GetIndex(splitDimension) +
+                         static_cast<ImageIORegion::IndexValueType>(nextIORegion.GetSize(splitDimension));
+  const auto endIndex = static_cast<ImageIORegion::IndexValueType>(m_ImageIO->GetDimensions(splitDimension));
+  if (nextIndex >= endIndex)
+  {
+    // the last region is read
+    return;
+  }
+  nextIORegion.SetIndex(splitDimension, nextIndex);
+  nextIORegion.SetSize(
+    splitDimension, std::min(nextIORegion.GetSize(splitDimension), static_cast<SizeValueType>(endIndex - nextIndex)));
+
+  const size_t sizeOfNextIORegion =
+    nextIORegion.GetNumberOfPixels() * (m_ImageIO->GetComponentSize() * m_ImageIO->GetNumberOfComponents());
+  void * buffer = nullptr;
+  if (convertBuffer)
+  {
+    m_PrefetchedBuffer = make_unique_for_overwrite<char[]>(sizeOfNextIORegion);
+    buffer = m_PrefetchedBuffer.get();
+  }
+  else
+  {
+    using PixelContainerType = typename TOutputImage::PixelContainer;
+    m_PrefetchedPixelContainer = PixelContainerType::New();
+    m_PrefetchedPixelContainer->Reserve(sizeOfNextIORegion / sizeof(typename PixelContainerType::Element));
+    buffer = m_PrefetchedPixelContainer->GetBufferPointer();
+  }
+
+  itkDebugMacro("Reading ahead the IORegion: " << nextIORegion);
+  m_PrefetchedIORegion = nextIORegion;
+  m_Prefetch = std::make_shared<Prefetch>();
+  m_Prefetch->m_Read = [imageIO = m_ImageIO, nextIORegion, buffer] {
+    imageIO->SetIORegion(nextIORegion);
+    imageIO->Read(buffer);
+  };
+  // the job only refers weakly to the reading ahead, which holds its future
+  const std::weak_ptr<Prefetch> weakPrefetch = m_Prefetch;
+  m_Prefetch->m_Finished = ThreadPool::GetInstance()->AddWork([weakPrefetch] {
+    const std::shared_ptr<Prefetch> prefetch = weakPrefetch.lock();
+    if (prefetch && !prefetch->m_Started.exchange(true))
+    {
+      prefetch->m_Read();
+    }
+  });
+}
+
+template <typename TOutputImage, typename ConvertPixelTraits>
+void
+ImageFileReader<TOutputImage, ConvertPixelTraits>::WaitForPrefetchedRegion()
+{
+  if (m_Prefetch)
+  {
+    const std::shared_ptr<Prefetch> prefetch = std::move(m_Prefetch);
+    try
+    {
+      // the region is read by this thread if no thread of the pool has
+      // started reading it, so that a busy pool does not hold the reader
+      if (!prefetch->m_Started.exchange(true))
+      {
+        prefetch->m_Read();
+      }
+      else
+      {
+        prefetch->m_Finished.get();
+      }
+    }
+    catch (...)
+    {
+      // the region is read again, and the error reported, if it is requested
+      m_PrefetchedIORegion = ImageIORegion();
+      m_PrefetchedBuffer.reset();
+      m_PrefetchedPixelContainer = nullptr;
+    }
+  }
+}
+
 template <typename TOutputImage, typename ConvertPixelTraits>
 void
 ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(const void * inputData, size_t numberOfPixels)
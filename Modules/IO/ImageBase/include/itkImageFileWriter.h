@@ -167,6 +167,26 @@ public:
   itkSetMacro(NumberOfStreamDivisions, unsigned int);
   itkGetConstReferenceMacro(NumberOfStreamDivisions, unsigned int);
   /** @ITKEndGrouping */
+
+  /** Set/Get whether the pieces are written asynchronously. When streaming
+   * a pipeline in several divisions, each piece is then copied and written by
+   * a background thread while the next pieces are computed upstream, instead
+   * of alternating the computation and the writing. The file written is the
+   * same. Off by default. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseAsynchronousWriting, bool);
+  itkGetConstReferenceMacro(UseAsynchronousWriting, bool);
+  itkBooleanMacro(UseAsynchronousWriting);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the maximum number of pieces which are copied and waiting to be
+   * written, or being written, when writing asynchronously. It bounds the
+   * memory used by the copies. The default, 1, double buffers the pieces. */
+  /** @ITKStartGrouping */
+  itkSetClampMacro(MaximumNumberOfPiecesInFlight, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstReferenceMacro(MaximumNumberOfPiecesInFlight, unsigned int);
+  /** @ITKEndGrouping */
+
   /** Aliased to the Write() method to be consistent with the rest of the
    * pipeline. */
   void
@@ -235,6 +255,9 @@ private:
   bool m_UseCompression{ false };
   int  m_CompressionLevel{ -1 };
   bool m_UseInputMetaDataDictionary{ true };
+
+  bool         m_UseAsynchronousWriting{ false };
+  unsigned int m_MaximumNumberOfPiecesInFlight{ 1 };
 };
 
 
@@ -31,7 +31,9 @@
 #include "itkDiffusionTensor3D.h"
 #include "itkMatrix.h"
 #include "itkImageAlgorithm.h"
+#include "itkAsynchronousImageIOWriter.h"
 #include <complex>
+#include <memory>
 
 namespace itk
 {
@@ -256,6 +258,19 @@ ImageFileWriter<TInputImage>::Write()
   unsigned int numDivisions =
     m_ImageIO->GetActualNumberOfSplitsForWriting(m_NumberOfStreamDivisions, pasteIORegion, largestIORegion);
 
+  // When writing asynchronously, the ImageIO is used by the writing thread
+  // only, so the pieces are split beforehand
+  std::vector<ImageIORegion> streamIORegions;
+  if (m_UseAsynchronousWriting && numDivisions > 1)
+  {
+    for (unsigned int piece = 0; piece < numDivisions; ++piece)
+    {
+      streamIORegions.push_back(
+        m_ImageIO->GetSplitRegionForWriting(piece, numDivisions, pasteIORegion, largestIORegion));
+    }
+  }
+  std::unique_ptr<AsynchronousImageIOWriter> asynchronousWriter;
+
   /**
    * Loop over the number of pieces, execute the upstream pipeline on each
    * piece, and copy the results into the output image.
@@ -265,7 +280,8 @@ ImageFileWriter<TInputImage>::Write()
   {
     // get the actual piece to write
     ImageIORegion streamIORegion =
-      m_ImageIO->GetSplitRegionForWriting(piece, numDivisions, pasteIORegion, largestIORegion);
+      streamIORegions.empty() ? m_ImageIO->GetSplitRegionForWriting(piece, numDivisions, pasteIORegion, largestIORegion)
+                              : streamIORegions[piece];
 
     // Check whether the paste region is fully contained inside the
     // largest region or not.
@@ -309,12 +325,41 @@ ImageFileWriter<TInputImage>::Write()
       }
     }
 
-    m_ImageIO->SetIORegion(streamIORegion);
+    if (!streamIORegions.empty() && numDivisions > 1)
+    {
+      // copy the piece, so that the next one is computed upstream while it
+      // is written
+      const auto pieceImage = InputImageType::New();
+      pieceImage->CopyInformation(input);
+      pieceImage->SetBufferedRegion(streamRegion);
+      pieceImage->Allocate();
+      ImageAlgorithm::Copy(input, pieceImage.GetPointer(), streamRegion, streamRegion);
+
+      if (!asynchronousWriter)
+      {
+        asynchronousWriter = std::make_unique<AsynchronousImageIOWriter>(m_ImageIO, m_MaximumNumberOfPiecesInFlight);
+      }
+      asynchronousWriter->Write(streamIORegion, pieceImage->GetBufferPointer(), pieceImage);
+
+      this->UpdateProgress(static_cast<float>(asynchronousWriter->GetNumberOfWrittenPieces()) /
+                           static_cast<float>(numDivisions));
+    }
+    else
+    {
+      m_ImageIO->SetIORegion(streamIORegion);
+
+      // write the data
+      this->GenerateData();
 
-    // write the data
-    this->GenerateData();
+      this->UpdateProgress(static_cast<float>(piece + 1) / static_cast<float>(numDivisions));
+    }
+  }
 
-    this->UpdateProgress(static_cast<float>(piece + 1) / static_cast<float>(numDivisions));
+  if (asynchronousWriter)
+  {
+    // wait for the pieces which are still being written
+    asynchronousWriter->Wait();
+    this->UpdateProgress(1.0f);
   }
 
   // Notify end event observers
@@ -395,6 +440,8 @@ ImageFileWriter<TInputImage>::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "CompressionLevel: " << m_CompressionLevel << std::endl;
   itkPrintSelfBooleanMacro(UseCompression);
   itkPrintSelfBooleanMacro(UseInputMetaDataDictionary);
+  itkPrintSelfBooleanMacro(UseAsynchronousWriting);
+  os << indent << "MaximumNumberOfPiecesInFlight: " << m_MaximumNumberOfPiecesInFlight << std::endl;
   itkPrintSelfBooleanMacro(FactorySpecifiedImageIO);
 }
 } // end namespace itk
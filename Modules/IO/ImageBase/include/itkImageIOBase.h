@@ -40,6 +40,7 @@
 #include <fstream>
 #include <string>
 #include <type_traits> // For is_same_v and is_signed_v.
+#include <utility>
 
 namespace itk
 {
@@ -518,6 +519,18 @@ public:
   virtual void
   Read(void * buffer) = 0;
 
+  /** Determine if the pixels of the whole image are stored in a single file
+   * exactly as Read() returns them: uncompressed, contiguous, and in the byte
+   * order of the system. If so, dataFileName is set to this file and
+   * dataOffset to the position of the first pixel in it, so that the file can
+   * be memory mapped instead of read. This can be queried only after the
+   * header of the file has been read. Default is false. */
+  virtual bool
+  CanMapPixelData(std::string & itkNotUsed(dataFileName), SizeValueType & itkNotUsed(dataOffset))
+  {
+    return false;
+  }
+
   /*-------- This part of the interfaces deals with writing data ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -623,6 +636,18 @@ public:
   const ArrayOfExtensionsType &
   GetSupportedWriteExtensions() const;
 
+  /** Type for the list of signatures, the bytes found at a given offset from
+   * the beginning of the files of a format, with their offsets. */
+  using ArrayOfSignaturesType = std::vector<std::pair<SizeValueType, std::string>>;
+
+  /** This method returns an array with the list of signatures of the files
+   * supported for reading by this ImageIO class. The ImageIOFactory asks the
+   * ImageIO classes whose signature is found in a file whether they can read
+   * it before the other ones.
+   */
+  const ArrayOfSignaturesType &
+  GetSupportedReadSignatures() const;
+
 #ifndef ITK_LEGACY_REMOVE
   // This member function (template) is not implemented and not specialized.
   template <typename TPixel>
@@ -968,6 +993,10 @@ protected:
   void
   AddSupportedWriteExtension(const char * extension);
 
+  /** Insert a signature to the list of supported signatures for reading,
+   * found at offset bytes from the beginning of the files. */
+  void
+  AddSupportedReadSignature(const std::string & signature, SizeValueType offset = 0);
 
   void
   SetSupportedReadExtensions(const ArrayOfExtensionsType &);
@@ -1029,6 +1058,7 @@ private:
 
   ArrayOfExtensionsType m_SupportedReadExtensions{};
   ArrayOfExtensionsType m_SupportedWriteExtensions{};
+  ArrayOfSignaturesType m_SupportedReadSignatures{};
 };
 
 /** Utility function for writing RAW bytes */
@@ -57,6 +57,12 @@ public:
   static constexpr IOFileModeEnum WriteMode = IOFileModeEnum::WriteMode;
 #endif
   /** Create the appropriate ImageIO depending on the particulars of the file.
+   *
+   * For reading, the ImageIO classes whose supported read extensions end the
+   * file name are asked first whether they can read the file, then the ones
+   * whose supported read signatures are found in the first bytes of the
+   * file, read once, and then all the other ones, each in the order of
+   * registration.
    */
   static ImageIOBasePointer
   CreateImageIO(const char * path, IOFileModeEnum mode);
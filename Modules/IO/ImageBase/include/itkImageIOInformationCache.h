@@ -0,0 +1,109 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageIOInformationCache_h
+#define itkImageIOInformationCache_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkObject.h"
+#include "itkImageIOBase.h"
+
+namespace itk
+{
+/** \class ImageIOInformationCache
+ * \brief Process-wide cache of the ImageIO classes and image information of files.
+ *
+ * When enabled, ImageFileReader looks up the file in this cache before
+ * creating an ImageIO with the ImageIOFactory and reading the image
+ * information. If the file is in the cache, and has the same size,
+ * modification time and file serial number as when it was added, the
+ * reader gets a new ImageIO of the same class, with the dimensions,
+ * spacing, origin, direction, pixel type and meta data dictionary of the
+ * file, without probing the registered ImageIO classes nor parsing the
+ * header of the file again. The header is then only parsed again when the
+ * pixels are read.
+ *
+ * The cache holds at most MaximumNumberOfEntries files, the least recently
+ * used ones being evicted first. It is only used for the ImageIO created by
+ * the factory, not for the ones set by ImageFileReader::SetImageIO().
+ *
+ * \warning The modification time of the files has a resolution of one
+ * second, so a file rewritten in place with the same size during the same
+ * second may not be detected as changed. Clear() forgets all files.
+ *
+ * \sa ImageFileReader
+ * \sa ImageIOFactory
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT ImageIOInformationCache : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageIOInformationCache);
+
+  /** Standard class type aliases. */
+  using Self = ImageIOInformationCache;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ImageIOInformationCache);
+
+  /** Set/Get whether the cache is used. Off by default. Turning it off
+   * clears it. */
+  /** @ITKStartGrouping */
+  static void
+  SetEnabled(bool enabled);
+  static bool
+  GetEnabled();
+  /** @ITKEndGrouping */
+
+  /** Set/Get the maximum number of files in the cache, 256 by default. */
+  /** @ITKStartGrouping */
+  static void
+  SetMaximumNumberOfEntries(SizeValueType maximumNumberOfEntries);
+  static SizeValueType
+  GetMaximumNumberOfEntries();
+  /** @ITKEndGrouping */
+
+  /** Returns the number of files in the cache. */
+  static SizeValueType
+  GetNumberOfEntries();
+
+  /** Forgets all the files. */
+  static void
+  Clear();
+
+  /** Returns a new ImageIO of the class which read the information of the
+   * file, with that information, if the file is in the cache and has not
+   * changed since, and nullptr otherwise. The ReadImageInformation() of the
+   * ImageIO must still be called before reading the pixels. */
+  static ImageIOBase::Pointer
+  CreateImageIO(const std::string & fileName);
+
+  /** Adds the file to the cache, with the class and the information of the
+   * ImageIO which has just read its information, if the cache is enabled. */
+  static void
+  AddImageIO(const std::string & fileName, const ImageIOBase * imageIO);
+
+protected:
+  ImageIOInformationCache();
+  ~ImageIOInformationCache() override;
+};
+} // end namespace itk
+
+#endif // itkImageIOInformationCache_h
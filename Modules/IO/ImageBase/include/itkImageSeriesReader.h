@@ -179,6 +179,23 @@ public:
   itkBooleanMacro(UseStreaming);
   /** @ITKEndGrouping */
 
+  /** Set/Get whether the slices are read concurrently. When on, up to
+   * NumberOfWorkUnits files are opened and decoded at the same time on the
+   * threads of the multi-threader of the reader, each one directly into its
+   * slab of the output buffer, so that the memory used does not grow with
+   * the number of concurrent reads. This mostly helps with long series of
+   * small files, whose reading is limited by the latency of opening and
+   * parsing each file. The array of dictionaries keeps the order of the
+   * slices. As an ImageIO cannot read several files at once, each slice is
+   * read with a new instance of the ImageIO set with SetImageIO(), created
+   * by Clone(), which has the settings of that instance if the ImageIO
+   * overrides InternalClone(), e.g. GDCMImageIO. Off by default. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseParallelReading, bool);
+  itkGetConstMacro(UseParallelReading, bool);
+  itkBooleanMacro(UseParallelReading);
+  /** @ITKEndGrouping */
+
   /** Set the relative threshold for issuing warnings about non-uniform sampling */
   /** @ITKStartGrouping */
   itkSetMacro(SpacingWarningRelThreshold, double);
@@ -218,6 +235,8 @@ protected:
 
   bool m_UseStreaming{ true };
 
+  bool m_UseParallelReading{ false };
+
   bool m_SpacingDefined{ false };
 
   double m_SpacingWarningRelThreshold{ 1e-4 };
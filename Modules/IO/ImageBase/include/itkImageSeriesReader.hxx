@@ -25,7 +25,9 @@
 #include "itkMath.h"
 #include "itkProgressReporter.h"
 #include "itkMetaDataObject.h"
+#include "itkMultiThreaderBase.h"
 #include <cstddef> // For ptrdiff_t.
+#include <exception>
 #include <iomanip>
 
 namespace itk
@@ -39,6 +41,7 @@ ImageSeriesReader<TOutputImage>::PrintSelf(std::ostream & os, Indent indent) con
   os << indent << "ReverseOrder: " << m_ReverseOrder << std::endl;
   os << indent << "ForceOrthogonalDirection: " << m_ForceOrthogonalDirection << std::endl;
   os << indent << "UseStreaming: " << m_UseStreaming << std::endl;
+  os << indent << "UseParallelReading: " << m_UseParallelReading << std::endl;
   os << indent << "FileNames:" << std::endl;
   for (const auto & fileName : m_FileNames)
   {
@@ -259,9 +262,6 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   output->SetBufferedRegion(requestedRegion);
   output->Allocate();
 
-  // progress reported on a per slice basis
-  ProgressReporter progress(this, 0, requestedRegion.GetSize(TOutputImage::ImageDimension - 1), 100);
-
   // We utilize the modified time of the output information to
   // know when the meta array needs to be updated, when the output
   // information is updated so should the meta array.
@@ -271,32 +271,40 @@ ImageSeriesReader<TOutputImage>::GenerateData()
     this->m_OutputInformationMTime > this->m_MetaDataDictionaryArrayMTime && m_MetaDataDictionaryArrayUpdate;
 
   typename TOutputImage::InternalPixelType * outputBuffer = output->GetBufferPointer();
-  IndexType                                  sliceStartIndex = requestedRegion.GetIndex();
   const auto                                 numberOfFiles = static_cast<int>(m_FileNames.size());
 
-  typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
-  typename TOutputImage::SpacingType outputSpacing = output->GetSpacing();
-  double                             maxSpacingDeviation = 0.0;
-  bool                               prevSliceIsValid = false;
-
-  m_InternalMetaDataDictionaries.reserve(static_cast<size_t>(numberOfFiles));
-
-  for (int i = 0; i != numberOfFiles; ++i)
+  // What is kept of each slice, to check the spacing between the slices and
+  // to fill the array of dictionaries in slice order once they are all read
+  struct SliceInformation
   {
+    bool                             IsRead{ false };
+    bool                             IsInsideRequestedRegion{ false };
+    typename TOutputImage::PointType Origin{};
+    MetaDataDictionary               Dictionary{};
+    bool                             HasDictionary{ false };
+    std::exception_ptr               Exception{};
+  };
+  std::vector<SliceInformation> slices(static_cast<size_t>(numberOfFiles));
+
+  // Reads the data of a slice into its slab of the output buffer, or only
+  // its information when it is outside of the requested region. Slices are
+  // independent of each other, so that they may be read concurrently.
+  const bool useParallelReading = m_UseParallelReading && numberOfFiles > 1;
+  const auto readSlice = [&, this](const int i) {
+    IndexType sliceStartIndex = requestedRegion.GetIndex();
     if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
     {
       sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
     }
 
-    const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
-    const int  iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
-    bool       nonUniformSampling = false;
-    double     spacingDeviation = 0.0;
+    SliceInformation & slice = slices[i];
+    slice.IsInsideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
+    const int iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
 
     // check if we need this slice
-    if (!insideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
+    if (!slice.IsInsideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
     {
-      continue;
+      return;
     }
 
     // configure reader
@@ -307,13 +315,22 @@ ImageSeriesReader<TOutputImage>::GenerateData()
 
     if (m_ImageIO)
     {
-      reader->SetImageIO(m_ImageIO);
+      if (useParallelReading)
+      {
+        // an ImageIO reads a single file at a time, so each slice has its own
+        // one, with the same options
+        reader->SetImageIO(dynamic_cast<ImageIOBase *>(m_ImageIO->Clone().GetPointer()));
+      }
+      else
+      {
+        reader->SetImageIO(m_ImageIO);
+      }
     }
     reader->SetUseStreaming(m_UseStreaming);
     readerOutput->SetRequestedRegion(sliceRegionToRequest);
 
     // update the data or info
-    if (!insideRequestedRegion)
+    if (!slice.IsInsideRequestedRegion)
     {
       reader->UpdateOutputInformation();
     }
@@ -397,13 +414,80 @@ ImageSeriesReader<TOutputImage>::GenerateData()
 
         ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
       }
+      slice.Origin = readerOutput->GetOrigin();
+    } // end !insideRequestedRegion
+    slice.IsRead = true;
+
+    // the dictionary is only known to be needed once the spacing is checked
+    if (reader->GetImageIO())
+    {
+      slice.Dictionary = reader->GetImageIO()->GetMetaDataDictionary();
+      slice.HasDictionary = true;
+    }
+  };
+
+  if (useParallelReading)
+  {
+    // progress reported by the multi-threader, on a per file basis
+    this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      static_cast<SizeValueType>(numberOfFiles),
+      [&slices, &readSlice](SizeValueType i) {
+        try
+        {
+          readSlice(static_cast<int>(i));
+        }
+        catch (...)
+        {
+          slices[i].Exception = std::current_exception();
+        }
+      },
+      this);
+    for (const SliceInformation & slice : slices)
+    {
+      if (slice.Exception)
+      {
+        std::rethrow_exception(slice.Exception);
+      }
+    }
+  }
+  else
+  {
+    // progress reported on a per slice basis
+    ProgressReporter progress(this, 0, requestedRegion.GetSize(TOutputImage::ImageDimension - 1), 100);
+    for (int i = 0; i != numberOfFiles; ++i)
+    {
+      readSlice(i);
+      if (slices[i].IsInsideRequestedRegion)
+      {
+        // report progress for read slices
+        progress.CompletedPixel();
+      }
+    }
+  }
+
+  typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
+  typename TOutputImage::SpacingType outputSpacing = output->GetSpacing();
+  double                             maxSpacingDeviation = 0.0;
+  bool                               prevSliceIsValid = false;
+
+  m_InternalMetaDataDictionaries.reserve(static_cast<size_t>(numberOfFiles));
+
+  for (int i = 0; i != numberOfFiles; ++i)
+  {
+    SliceInformation & slice = slices[i];
+    bool               nonUniformSampling = false;
+    double             spacingDeviation = 0.0;
 
+    if (slice.IsInsideRequestedRegion)
+    {
       // verify that slice spacing is the expected one
       // since we can be skipping some slices because they are outside of requested region
       // I am using additional variable
       if (prevSliceIsValid)
       {
-        typename TOutputImage::PointType sliceOrigin = readerOutput->GetOrigin();
+        const typename TOutputImage::PointType & sliceOrigin = slice.Origin;
         using SpacingScalarType = typename TOutputImage::SpacingValueType;
         Vector<SpacingScalarType, TOutputImage::ImageDimension> dirN;
         for (size_t j = 0; j < TOutputImage::ImageDimension; ++j)
@@ -430,24 +514,25 @@ ImageSeriesReader<TOutputImage>::GenerateData()
       }
       else
       {
-        prevSliceOrigin = readerOutput->GetOrigin();
+        prevSliceOrigin = slice.Origin;
         prevSliceIsValid = true;
       }
-
-      // report progress for read slices
-      progress.CompletedPixel();
-    } // end !insideRequestedRegion
+    }
+    else if (!slice.IsRead && needToUpdateMetaDataDictionaryArray)
+    {
+      // the dictionaries became needed after this slice was skipped
+      readSlice(i);
+    }
 
     // Deep copy the MetaDataDictionary into the array
-    if (reader->GetImageIO() && needToUpdateMetaDataDictionaryArray)
+    if (slice.HasDictionary && needToUpdateMetaDataDictionaryArray)
     {
-      MetaDataDictionary newDictionary = reader->GetImageIO()->GetMetaDataDictionary();
       if (nonUniformSampling)
       {
         // slice-specific information
-        EncapsulateMetaData<double>(newDictionary, "ITK_non_uniform_sampling_deviation", spacingDeviation);
+        EncapsulateMetaData<double>(slice.Dictionary, "ITK_non_uniform_sampling_deviation", spacingDeviation);
       }
-      m_InternalMetaDataDictionaries.push_back(std::move(newDictionary));
+      m_InternalMetaDataDictionaries.push_back(std::move(slice.Dictionary));
     }
   } // end per slice loop
 
@@ -0,0 +1,102 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryMappedImageBufferAllocator_h
+#define itkMemoryMappedImageBufferAllocator_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkImageBufferAllocator.h"
+#include "itkCommonEnums.h"
+#include "itkObjectFactory.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+namespace itk
+{
+
+/** \class MemoryMappedImageBufferAllocator
+ * \brief Image buffer allocator providing memory mapped buffers.
+ *
+ * MapFile() maps a range of a file into memory, so that an image can use
+ * the pixels of an uncompressed file in place: the pages are only read from
+ * the file when first accessed, and use the page cache of the system rather
+ * than anonymous memory. This is how ImageFileReader memory maps files, see
+ * ImageFileReader::SetMemoryMapping().
+ *
+ * Allocate() provides anonymous mappings, which are zero-filled and aligned
+ * on pages. As the mapped files are only aligned as their offset,
+ * GetAlignment() returns 1.
+ *
+ * All the buffers are released by Deallocate(), which unmaps them.
+ *
+ * The buffers of the ReadOnly mappings are reported by IsBufferReadOnly(),
+ * so that in-place filters do not write to them, which would crash.
+ *
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT MemoryMappedImageBufferAllocator : public ImageBufferAllocator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MemoryMappedImageBufferAllocator);
+
+  /** Standard class type aliases. */
+  using Self = MemoryMappedImageBufferAllocator;
+  using Superclass = ImageBufferAllocator;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(MemoryMappedImageBufferAllocator);
+
+  void *
+  Allocate(SizeValueType numberOfBytes) override;
+
+  void
+  Deallocate(void * buffer, SizeValueType numberOfBytes) override;
+
+  SizeValueType
+  GetAlignment() const override;
+
+  bool
+  IsBufferReadOnly(const void * buffer) const override;
+
+  /** Maps numberOfBytes bytes of a file, from the given offset, with the
+   * given access (ReadOnly or CopyOnWrite). The file does not need to be kept
+   * open. The returned buffer is only aligned as the offset, modulo the page
+   * size. Throws an ExceptionObject if the file cannot be mapped. */
+  void *
+  MapFile(const std::string & fileName, SizeValueType offset, SizeValueType numberOfBytes, IOMemoryMappingEnum access);
+
+protected:
+  MemoryMappedImageBufferAllocator() = default;
+  ~MemoryMappedImageBufferAllocator() override = default;
+
+private:
+  mutable std::mutex m_Mutex;
+
+  /** Buffers of the ReadOnly mappings. */
+  std::unordered_set<const void *> m_ReadOnlyBuffers; // guarded by m_Mutex
+};
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,114 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkParallelDeflateCodec_h
+#define itkParallelDeflateCodec_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkIntTypes.h"
+
+#include <ostream>
+#include <vector>
+
+namespace itk
+{
+/** \class ParallelDeflateCodecEnums
+ * \brief Contains all enum classes used by ParallelDeflateCodec class.
+ * \ingroup ITKIOImageBase
+ */
+class ParallelDeflateCodecEnums
+{
+public:
+  /**
+   * \ingroup ITKIOImageBase
+   * Container of the deflate stream: zlib (RFC 1950) or gzip (RFC 1952).
+   */
+  enum class Format : uint8_t
+  {
+    Zlib,
+    Gzip
+  };
+};
+// Define how to print enumeration
+extern ITKIOImageBase_EXPORT std::ostream &
+                             operator<<(std::ostream & out, const ParallelDeflateCodecEnums::Format value);
+
+/** \class ParallelDeflateCodec
+ * \brief Multi-threaded deflate compression and decompression.
+ *
+ * Compress() splits the data into blocks which are deflated concurrently on
+ * the ITK thread pool, each one ending with a sync flush, and concatenates them
+ * into a single zlib or gzip stream whose checksum is combined from the ones of
+ * the blocks. The result is a standard stream that any zlib reader decompresses.
+ * As the blocks do not share their history, the compression ratio is slightly
+ * lower than with a serial deflate of the whole data, but any block can be
+ * decompressed on its own, given its offset in the stream.
+ *
+ * Decompress() splits a stream at the flush markers closest to evenly spaced
+ * positions and inflates the parts concurrently. A part is only kept if the
+ * previous one ends exactly at its start, on a block boundary, and the checksum
+ * of the whole data is verified; otherwise, e.g. for a stream written by a
+ * serial deflate, the stream is inflated serially.
+ *
+ * \ingroup IOFilters
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT ParallelDeflateCodec
+{
+public:
+  using FormatEnum = ParallelDeflateCodecEnums::Format;
+
+  /** Default number of uncompressed bytes per compressed block. */
+  static constexpr SizeValueType DefaultBlockSize = SizeValueType{ 1 } << 20;
+
+  /** Compresses numberOfBytes bytes of data at the given zlib compression
+   * level (-1 for the default level, 0 to 9 otherwise), in blocks of blockSize
+   * bytes. Throws an ExceptionObject if deflate fails. */
+  static std::vector<unsigned char>
+  Compress(const void *  data,
+           SizeValueType numberOfBytes,
+           int           compressionLevel,
+           FormatEnum    format,
+           SizeValueType blockSize = DefaultBlockSize);
+
+  /** Same as above, also returning the offsets in the stream at which the
+   * blocks start, from which DecompressBlock() inflates them independently. */
+  static std::vector<unsigned char>
+  Compress(const void *                 data,
+           SizeValueType                numberOfBytes,
+           int                          compressionLevel,
+           FormatEnum                   format,
+           SizeValueType                blockSize,
+           std::vector<SizeValueType> & blockOffsets);
+
+  /** Decompresses a zlib or gzip stream, as detected from its header, into
+   * the numberOfBytes bytes of data. Throws an ExceptionObject if the stream
+   * is corrupted or does not decompress into exactly numberOfBytes bytes. */
+  static void
+  Decompress(const void * compressedData, SizeValueType compressedSize, void * data, SizeValueType numberOfBytes);
+
+  /** Decompresses a single block of a stream written by Compress(), from its
+   * compressedSize bytes up to the start of the next block, or of the trailer
+   * for the last block, into its numberOfBytes bytes. The checksum of the
+   * stream is not verified. Throws an ExceptionObject if the block is
+   * corrupted or does not decompress into exactly numberOfBytes bytes. */
+  static void
+  DecompressBlock(const void * compressedBlock, SizeValueType compressedSize, void * data, SizeValueType numberOfBytes);
+};
+} // end namespace itk
+
+#endif // itkParallelDeflateCodec_h
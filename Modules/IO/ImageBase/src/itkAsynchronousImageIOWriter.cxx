@@ -0,0 +1,147 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkAsynchronousImageIOWriter.h"
+
+#include <algorithm>
+
+namespace itk
+{
+AsynchronousImageIOWriter::AsynchronousImageIOWriter(ImageIOBase * imageIO, unsigned int maximumNumberOfPiecesInFlight)
+  : m_ImageIO(imageIO)
+  , m_MaximumNumberOfPiecesInFlight(std::max(maximumNumberOfPiecesInFlight, 1u))
+{}
+
+AsynchronousImageIOWriter::~AsynchronousImageIOWriter()
+{
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Pieces.clear();
+  }
+  this->StopThread();
+}
+
+void
+AsynchronousImageIOWriter::Write(const ImageIORegion & region, const void * buffer, const LightObject * bufferOwner)
+{
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Condition.wait(lock, [this] {
+      return m_Exception || m_Pieces.size() + (m_IsWritingPiece ? 1 : 0) < m_MaximumNumberOfPiecesInFlight;
+    });
+    if (m_Exception)
+    {
+      std::rethrow_exception(m_Exception);
+    }
+    m_Pieces.push_back({ region, buffer, bufferOwner });
+  }
+  m_Condition.notify_all();
+
+  // the thread is started by the first piece
+  if (!m_Thread.joinable())
+  {
+    m_Thread = std::thread([this] { this->WritePieces(); });
+  }
+}
+
+void
+AsynchronousImageIOWriter::Wait()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Condition.wait(lock, [this] { return m_Exception || (m_Pieces.empty() && !m_IsWritingPiece); });
+  }
+  this->StopThread();
+  if (m_Exception)
+  {
+    std::rethrow_exception(m_Exception);
+  }
+}
+
+unsigned int
+AsynchronousImageIOWriter::GetNumberOfWrittenPieces() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfWrittenPieces;
+}
+
+void
+AsynchronousImageIOWriter::WritePieces()
+{
+  for (;;)
+  {
+    Piece piece;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_Condition.wait(lock, [this] { return m_IsStopping || !m_Pieces.empty(); });
+      if (m_Pieces.empty())
+      {
+        return;
+      }
+      piece = std::move(m_Pieces.front());
+      m_Pieces.pop_front();
+      m_IsWritingPiece = true;
+    }
+
+    std::exception_ptr exception;
+    try
+    {
+      m_ImageIO->SetIORegion(piece.Region);
+      m_ImageIO->Write(piece.Buffer);
+    }
+    catch (...)
+    {
+      exception = std::current_exception();
+    }
+    // the buffer may be released as soon as it is written
+    piece.BufferOwner = nullptr;
+
+    {
+      const std::lock_guard<std::mutex> lock(m_Mutex);
+      m_IsWritingPiece = false;
+      if (exception)
+      {
+        m_Exception = exception;
+        m_Pieces.clear();
+      }
+      else
+      {
+        ++m_NumberOfWrittenPieces;
+      }
+    }
+    m_Condition.notify_all();
+    if (exception)
+    {
+      return;
+    }
+  }
+}
+
+void
+AsynchronousImageIOWriter::StopThread()
+{
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    m_IsStopping = true;
+  }
+  m_Condition.notify_all();
+  if (m_Thread.joinable())
+  {
+    m_Thread.join();
+  }
+}
+} // end namespace itk
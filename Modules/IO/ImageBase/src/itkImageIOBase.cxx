@@ -61,6 +61,12 @@ ImageIOBase::GetSupportedReadExtensions() const
   return this->m_SupportedReadExtensions;
 }
 
+const ImageIOBase::ArrayOfSignaturesType &
+ImageIOBase::GetSupportedReadSignatures() const
+{
+  return this->m_SupportedReadSignatures;
+}
+
 void
 ImageIOBase::AddSupportedReadExtension(const char * extension)
 {
@@ -73,6 +79,12 @@ ImageIOBase::AddSupportedWriteExtension(const char * extension)
   this->m_SupportedWriteExtensions.emplace_back(extension);
 }
 
+void
+ImageIOBase::AddSupportedReadSignature(const std::string & signature, SizeValueType offset)
+{
+  this->m_SupportedReadSignatures.emplace_back(offset, signature);
+}
+
 void
 ImageIOBase::SetSupportedReadExtensions(const ArrayOfExtensionsType & extensions)
 {
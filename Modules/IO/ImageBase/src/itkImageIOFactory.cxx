@@ -17,7 +17,10 @@
  *=========================================================================*/
 
 #include "itkImageIOFactory.h"
+#include "itksys/SystemTools.hxx"
 
+#include <algorithm>
+#include <fstream>
 #include <mutex>
 
 
@@ -27,12 +30,57 @@ namespace itk
 namespace
 {
 std::mutex createImageIOMutex;
+
+// Whether the file name ends with one of the extensions, ignoring the case
+bool
+HasExtension(const std::string & lowerCaseFileName, const ImageIOBase::ArrayOfExtensionsType & extensions)
+{
+  return std::any_of(extensions.cbegin(), extensions.cend(), [&lowerCaseFileName](const std::string & extension) {
+    return !extension.empty() && lowerCaseFileName.size() > extension.size() &&
+           lowerCaseFileName.compare(lowerCaseFileName.size() - extension.size(),
+                                     extension.size(),
+                                     itksys::SystemTools::LowerCase(extension)) == 0;
+  });
+}
+
+// Whether one of the signatures is found in the bytes at the beginning of the file
+bool
+HasSignature(const std::string & header, const ImageIOBase::ArrayOfSignaturesType & signatures)
+{
+  return std::any_of(signatures.cbegin(), signatures.cend(), [&header](const auto & signature) {
+    return !signature.second.empty() && header.size() >= signature.first + signature.second.size() &&
+           header.compare(signature.first, signature.second.size(), signature.second) == 0;
+  });
 }
 
+// Reads the bytes at the beginning of the file which hold the signatures of the ImageIOs
+std::string
+ReadHeader(const char * path, const std::vector<ImageIOBase::Pointer> & imageIOs)
+{
+  size_t headerSize = 0;
+  for (const auto & imageIO : imageIOs)
+  {
+    for (const auto & signature : imageIO->GetSupportedReadSignatures())
+    {
+      headerSize = std::max(headerSize, static_cast<size_t>(signature.first + signature.second.size()));
+    }
+  }
+  std::string   header(headerSize, '\0');
+  std::ifstream file;
+  if (headerSize > 0 && !itksys::SystemTools::FileIsDirectory(path))
+  {
+    file.open(path, std::ios::binary);
+  }
+  file.read(&header[0], static_cast<std::streamsize>(headerSize));
+  header.resize(static_cast<size_t>(file.gcount()));
+  return header;
+}
+} // namespace
+
 ImageIOBase::Pointer
 ImageIOFactory::CreateImageIO(const char * path, IOFileModeEnum mode)
 {
-  std::list<ImageIOBase::Pointer> possibleImageIO;
+  std::vector<ImageIOBase::Pointer> possibleImageIO;
 
   const std::lock_guard<std::mutex> lockGuard(createImageIOMutex);
 
@@ -48,24 +96,62 @@ ImageIOFactory::CreateImageIO(const char * path, IOFileModeEnum mode)
       std::cerr << "Error ImageIO factory did not return an ImageIOBase: " << allobject->GetNameOfClass() << std::endl;
     }
   }
-  for (auto & k : possibleImageIO)
+
+  if (mode == IOFileModeEnum::WriteMode)
   {
-    if (mode == IOFileModeEnum::ReadMode)
+    for (auto & k : possibleImageIO)
     {
-      if (k->CanReadFile(path))
+      if (k->CanWriteFile(path))
       {
         return k;
       }
     }
-    else if (mode == IOFileModeEnum::WriteMode)
+    return nullptr;
+  }
+  if (mode != IOFileModeEnum::ReadMode)
+  {
+    return nullptr;
+  }
+
+  // Most of the ImageIOs open the file to know whether they can read it, so
+  // the ones claiming the extension of the file are asked first, then the
+  // ones whose signature is found in the file, and the others last, each in
+  // the order of registration
+  std::vector<bool> isAsked(possibleImageIO.size(), false);
+
+  const auto askImageIOs = [&possibleImageIO, &isAsked, path](const auto & isCandidate) -> ImageIOBase::Pointer {
+    for (size_t i = 0; i < possibleImageIO.size(); ++i)
     {
-      if (k->CanWriteFile(path))
+      if (!isAsked[i] && isCandidate(*possibleImageIO[i]))
       {
-        return k;
+        isAsked[i] = true;
+        if (possibleImageIO[i]->CanReadFile(path))
+        {
+          return possibleImageIO[i];
+        }
       }
     }
+    return nullptr;
+  };
+
+  const std::string lowerCaseFileName = itksys::SystemTools::LowerCase(path != nullptr ? path : "");
+  if (auto io = askImageIOs([&lowerCaseFileName](const ImageIOBase & imageIO) {
+        return HasExtension(lowerCaseFileName, imageIO.GetSupportedReadExtensions());
+      }))
+  {
+    return io;
+  }
+  if (path != nullptr && *path != '\0')
+  {
+    const std::string header = ReadHeader(path, possibleImageIO);
+    if (auto io = askImageIOs([&header](const ImageIOBase & imageIO) {
+          return HasSignature(header, imageIO.GetSupportedReadSignatures());
+        }))
+    {
+      return io;
+    }
   }
-  return nullptr;
+  return askImageIOs([](const ImageIOBase &) { return true; });
 }
 
 } // end namespace itk
@@ -0,0 +1,247 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageIOInformationCache.h"
+#include "itkIOConfigure.h"
+#include "itksys/SystemTools.hxx"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace itk
+{
+namespace
+{
+// What identifies a version of a file
+struct FileStamp
+{
+  unsigned long long Size{ 0 };
+  long long          ModificationTime{ 0 };
+  long long          ModificationTimeNanoseconds{ 0 };
+  unsigned long long SerialNumber{ 0 };
+
+  bool
+  operator==(const FileStamp & other) const
+  {
+    return Size == other.Size && ModificationTime == other.ModificationTime &&
+           ModificationTimeNanoseconds == other.ModificationTimeNanoseconds && SerialNumber == other.SerialNumber;
+  }
+};
+
+bool
+GetFileStamp(const std::string & fileName, FileStamp & stamp)
+{
+  itksys::SystemTools::Stat_t status;
+  if (itksys::SystemTools::Stat(fileName, &status) != 0)
+  {
+    return false;
+  }
+  stamp.Size = static_cast<unsigned long long>(status.st_size);
+  stamp.ModificationTime = static_cast<long long>(status.st_mtime);
+  // A file rewritten with the same size within a second is only detected
+  // where the modification time is known to the nanosecond
+#if defined(ITK_HAS_STAT_ST_MTIM)
+  stamp.ModificationTimeNanoseconds = static_cast<long long>(status.st_mtim.tv_nsec);
+#elif defined(ITK_HAS_STAT_ST_MTIMESPEC)
+  stamp.ModificationTimeNanoseconds = static_cast<long long>(status.st_mtimespec.tv_nsec);
+#endif
+  stamp.SerialNumber = static_cast<unsigned long long>(status.st_ino);
+  return true;
+}
+
+// Copies the information read by an ImageIO into another one of the same class
+void
+CopyImageInformation(const ImageIOBase & source, ImageIOBase & destination)
+{
+  const unsigned int numberOfDimensions = source.GetNumberOfDimensions();
+  destination.SetNumberOfDimensions(numberOfDimensions);
+  for (unsigned int i = 0; i < numberOfDimensions; ++i)
+  {
+    destination.SetDimensions(i, source.GetDimensions(i));
+    destination.SetSpacing(i, source.GetSpacing(i));
+    destination.SetOrigin(i, source.GetOrigin(i));
+    destination.SetDirection(i, source.GetDirection(i));
+  }
+  destination.SetPixelType(source.GetPixelType());
+  destination.SetComponentType(source.GetComponentType());
+  destination.SetNumberOfComponents(source.GetNumberOfComponents());
+  destination.SetByteOrder(source.GetByteOrder());
+  destination.SetFileType(source.GetFileType());
+  destination.SetMetaDataDictionary(source.GetMetaDataDictionary());
+}
+
+struct Entry
+{
+  std::string               FileName;
+  FileStamp                 Stamp;
+  ImageIOBase::ConstPointer ImageIO;
+};
+
+// The entries, from the most recently used to the least recently used one
+struct Cache
+{
+  std::mutex                                                  Mutex;
+  bool                                                        Enabled{ false };
+  SizeValueType                                               MaximumNumberOfEntries{ 256 };
+  std::list<Entry>                                            Entries;
+  std::unordered_map<std::string, std::list<Entry>::iterator> Index;
+
+  void
+  EvictEntries(SizeValueType maximumNumberOfEntries)
+  {
+    while (Entries.size() > maximumNumberOfEntries)
+    {
+      Index.erase(Entries.back().FileName);
+      Entries.pop_back();
+    }
+  }
+};
+
+Cache &
+GetCache()
+{
+  static Cache cache;
+  return cache;
+}
+} // namespace
+
+ImageIOInformationCache::ImageIOInformationCache() = default;
+
+ImageIOInformationCache::~ImageIOInformationCache() = default;
+
+void
+ImageIOInformationCache::SetEnabled(bool enabled)
+{
+  Cache &                           cache = GetCache();
+  const std::lock_guard<std::mutex> lock(cache.Mutex);
+  cache.Enabled = enabled;
+  if (!enabled)
+  {
+    cache.EvictEntries(0);
+  }
+}
+
+bool
+ImageIOInformationCache::GetEnabled()
+{
+  Cache &                           cache = GetCache();
+  const std::lock_guard<std::mutex> lock(cache.Mutex);
+  return cache.Enabled;
+}
+
+void
+ImageIOInformationCache::SetMaximumNumberOfEntries(SizeValueType maximumNumberOfEntries)
+{
+  Cache &                           cache = GetCache();
+  const std::lock_guard<std::mutex> lock(cache.Mutex);
+  cache.MaximumNumberOfEntries = maximumNumberOfEntries;
+  cache.EvictEntries(maximumNumberOfEntries);
+}
+
+SizeValueType
+ImageIOInformationCache::GetMaximumNumberOfEntries()
+{
+  Cache &                           cache = GetCache();
+  const std::lock_guard<std::mutex> lock(cache.Mutex);
+  return cache.MaximumNumberOfEntries;
+}
+
+SizeValueType
+ImageIOInformationCache::GetNumberOfEntries()
+{
+  Cache &                           cache = GetCache();
+  const std::lock_guard<std::mutex> lock(cache.Mutex);
+  return static_cast<SizeValueType>(cache.Entries.size());
+}
+
+void
+ImageIOInformationCache::Clear()
+{
+  Cache &                           cache = GetCache();
+  const std::lock_guard<std::mutex> lock(cache.Mutex);
+  cache.EvictEntries(0);
+}
+
+ImageIOBase::Pointer
+ImageIOInformationCache::CreateImageIO(const std::string & fileName)
+{
+  FileStamp stamp;
+  if (!GetEnabled() || !GetFileStamp(fileName, stamp))
+  {
+    return nullptr;
+  }
+
+  Cache &                   cache = GetCache();
+  ImageIOBase::ConstPointer cachedImageIO;
+  {
+    const std::lock_guard<std::mutex> lock(cache.Mutex);
+    const auto                        found = cache.Index.find(fileName);
+    if (found == cache.Index.end())
+    {
+      return nullptr;
+    }
+    if (!(stamp == found->second->Stamp))
+    {
+      // the file has changed
+      cache.Entries.erase(found->second);
+      cache.Index.erase(found);
+      return nullptr;
+    }
+    cache.Entries.splice(cache.Entries.begin(), cache.Entries, found->second);
+    cachedImageIO = found->second->ImageIO;
+  }
+
+  // the cached ImageIO is never modified, so it is copied without the lock
+  const ImageIOBase::Pointer imageIO = dynamic_cast<ImageIOBase *>(cachedImageIO->CreateAnother().GetPointer());
+  if (imageIO.IsNull())
+  {
+    return nullptr;
+  }
+  imageIO->SetFileName(fileName);
+  CopyImageInformation(*cachedImageIO, *imageIO);
+  return imageIO;
+}
+
+void
+ImageIOInformationCache::AddImageIO(const std::string & fileName, const ImageIOBase * imageIO)
+{
+  FileStamp stamp;
+  if (imageIO == nullptr || !GetEnabled() || !GetFileStamp(fileName, stamp))
+  {
+    return;
+  }
+  const ImageIOBase::Pointer cachedImageIO = dynamic_cast<ImageIOBase *>(imageIO->CreateAnother().GetPointer());
+  if (cachedImageIO.IsNull())
+  {
+    return;
+  }
+  CopyImageInformation(*imageIO, *cachedImageIO);
+
+  Cache &                           cache = GetCache();
+  const std::lock_guard<std::mutex> lock(cache.Mutex);
+  const auto                        found = cache.Index.find(fileName);
+  if (found != cache.Index.end())
+  {
+    cache.Entries.erase(found->second);
+    cache.Index.erase(found);
+  }
+  cache.Entries.push_front({ fileName, stamp, cachedImageIO.GetPointer() });
+  cache.Index[fileName] = cache.Entries.begin();
+  cache.EvictEntries(cache.MaximumNumberOfEntries);
+}
+} // end namespace itk
@@ -0,0 +1,196 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMemoryMappedImageBufferAllocator.h"
+#include "itkInternationalizationIOHelpers.h"
+#include "itksys/SystemTools.hxx"
+
+#include <cstdint>
+
+#if defined(_WIN32)
+#  include <io.h>
+#  include <windows.h>
+#else
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+namespace itk
+{
+
+namespace
+{
+// Granularity of the offsets of the mappings: the views of a file must
+// start at a multiple of it.
+std::uintptr_t
+GetMappingGranularity()
+{
+#if defined(_WIN32)
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  return systemInfo.dwAllocationGranularity;
+#else
+  return static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+// Unmaps the view starting at viewBegin, of viewSize bytes.
+void
+Unmap(void * viewBegin, std::uintptr_t viewSize)
+{
+#if defined(_WIN32)
+  (void)viewSize;
+  UnmapViewOfFile(viewBegin);
+#else
+  munmap(viewBegin, viewSize);
+#endif
+}
+} // namespace
+
+SizeValueType
+MemoryMappedImageBufferAllocator::GetAlignment() const
+{
+  return 1;
+}
+
+bool
+MemoryMappedImageBufferAllocator::IsBufferReadOnly(const void * buffer) const
+{
+  const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+  return m_ReadOnlyBuffers.count(buffer) > 0;
+}
+
+void *
+MemoryMappedImageBufferAllocator::Allocate(SizeValueType numberOfBytes)
+{
+  // Mappings cannot be empty
+  const SizeValueType mappingSize = numberOfBytes > 0 ? numberOfBytes : 1;
+#if defined(_WIN32)
+  void *       buffer = nullptr;
+  const HANDLE mapping = CreateFileMappingW(INVALID_HANDLE_VALUE,
+                                            nullptr,
+                                            PAGE_READWRITE,
+                                            static_cast<DWORD>(static_cast<std::uint64_t>(mappingSize) >> 32),
+                                            static_cast<DWORD>(mappingSize & 0xFFFFFFFFu),
+                                            nullptr);
+  if (mapping != nullptr)
+  {
+    buffer = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, mappingSize);
+    CloseHandle(mapping);
+  }
+  if (buffer == nullptr)
+#else
+  void * buffer = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (buffer == MAP_FAILED)
+#endif
+  {
+    // We cannot construct an error string here because we may be out
+    // of memory.  Do not use the exception macro.
+    throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
+  }
+  return buffer;
+}
+
+void
+MemoryMappedImageBufferAllocator::Deallocate(void * buffer, SizeValueType numberOfBytes)
+{
+  if (buffer == nullptr)
+  {
+    return;
+  }
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    m_ReadOnlyBuffers.erase(buffer);
+  }
+  // The view starts at the beginning of the granule containing the buffer
+  const std::uintptr_t granularity = GetMappingGranularity();
+  const auto           address = reinterpret_cast<std::uintptr_t>(buffer);
+  const std::uintptr_t viewBegin = address / granularity * granularity;
+  Unmap(reinterpret_cast<void *>(viewBegin), (address - viewBegin) + (numberOfBytes > 0 ? numberOfBytes : 1));
+}
+
+void *
+MemoryMappedImageBufferAllocator::MapFile(const std::string & fileName,
+                                          SizeValueType       offset,
+                                          SizeValueType       numberOfBytes,
+                                          IOMemoryMappingEnum access)
+{
+  if (access == IOMemoryMappingEnum::Off)
+  {
+    itkExceptionMacro("Cannot map " << fileName << " with access " << access << '.');
+  }
+  if (numberOfBytes == 0)
+  {
+    itkExceptionMacro("Cannot map an empty range of " << fileName << '.');
+  }
+  if (!itksys::SystemTools::FileExists(fileName, true))
+  {
+    itkExceptionMacro("Cannot map " << fileName << ": the file does not exist.");
+  }
+  if (itksys::SystemTools::FileLength(fileName) < offset + numberOfBytes)
+  {
+    itkExceptionMacro("Cannot map " << numberOfBytes << " bytes at offset " << offset << " of " << fileName
+                                    << ": the file is too short.");
+  }
+
+  const int fileDescriptor = i18n::I18nOpenForReading(fileName);
+  if (fileDescriptor < 0)
+  {
+    itkExceptionMacro("Cannot open " << fileName << " for mapping: " << itksys::SystemTools::GetLastSystemError());
+  }
+
+  // The view starts at the beginning of the granule containing the offset
+  const SizeValueType viewOffset = offset / GetMappingGranularity() * GetMappingGranularity();
+  const SizeValueType viewSize = (offset - viewOffset) + numberOfBytes;
+#if defined(_WIN32)
+  void * view = nullptr;
+  const auto fileHandle = reinterpret_cast<HANDLE>(_get_osfhandle(fileDescriptor));
+  const HANDLE mapping = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping != nullptr)
+  {
+    view = MapViewOfFile(mapping,
+                         access == IOMemoryMappingEnum::ReadOnly ? FILE_MAP_READ : FILE_MAP_COPY,
+                         static_cast<DWORD>(static_cast<std::uint64_t>(viewOffset) >> 32),
+                         static_cast<DWORD>(viewOffset & 0xFFFFFFFFu),
+                         viewSize);
+    CloseHandle(mapping);
+  }
+  _close(fileDescriptor);
+  if (view == nullptr)
+#else
+  void * view = mmap(nullptr,
+                     viewSize,
+                     access == IOMemoryMappingEnum::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE,
+                     fileDescriptor,
+                     static_cast<off_t>(viewOffset));
+  close(fileDescriptor);
+  if (view == MAP_FAILED)
+#endif
+  {
+    itkExceptionMacro("Cannot map " << fileName << ": " << itksys::SystemTools::GetLastSystemError());
+  }
+  void * const buffer = static_cast<char *>(view) + (offset - viewOffset);
+  if (access == IOMemoryMappingEnum::ReadOnly)
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    m_ReadOnlyBuffers.insert(buffer);
+  }
+  return buffer;
+}
+
+} // end namespace itk
@@ -0,0 +1,611 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkParallelDeflateCodec.h"
+#include "itkMacro.h"
+#include "itkMultiThreaderBase.h"
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace itk
+{
+
+namespace
+{
+using FormatEnum = ParallelDeflateCodecEnums::Format;
+
+// Window bits of a raw deflate stream, without zlib or gzip wrapper
+constexpr int rawWindowBits = -MAX_WBITS;
+
+// zlib counts bytes with uInt: larger ranges are processed in chunks
+constexpr SizeValueType maximumChunkSize = SizeValueType{ 1 } << 30;
+
+// Minimum number of compressed bytes of the parts inflated concurrently
+constexpr SizeValueType minimumPartSize = SizeValueType{ 64 } << 10;
+
+// End of a sync flush: the length fields of an empty stored block
+constexpr unsigned char syncFlushMarker[] = { 0x00, 0x00, 0xFF, 0xFF };
+
+// State of an inflate stream which stopped right after the end of a block which
+// is not the last one, on a byte boundary (see z_stream::data_type)
+constexpr int blockBoundaryDataType = 128;
+
+// Checksum of a range, and the number of bytes it covers
+struct Checksum
+{
+  uLong         value;
+  SizeValueType numberOfBytes;
+};
+
+uLong
+InitialChecksum(FormatEnum format)
+{
+  return format == FormatEnum::Gzip ? crc32(0L, Z_NULL, 0) : adler32(0L, Z_NULL, 0);
+}
+
+// Appends the checksums of the chunks of a range, which are combined after
+// the checksums of all the ranges are computed
+void
+AppendChecksums(FormatEnum format, const Bytef * data, SizeValueType numberOfBytes, std::vector<Checksum> & checksums)
+{
+  for (SizeValueType begin = 0; begin < numberOfBytes; begin += maximumChunkSize)
+  {
+    const auto size = static_cast<uInt>(std::min(numberOfBytes - begin, maximumChunkSize));
+    const uLong initial = InitialChecksum(format);
+    checksums.push_back(
+      { format == FormatEnum::Gzip ? crc32(initial, data + begin, size) : adler32(initial, data + begin, size), size });
+  }
+}
+
+uLong
+CombineChecksums(FormatEnum format, const std::vector<std::vector<Checksum>> & checksums)
+{
+  uLong combined = InitialChecksum(format);
+  for (const auto & rangeChecksums : checksums)
+  {
+    for (const Checksum & checksum : rangeChecksums)
+    {
+      const auto length = static_cast<z_off_t>(checksum.numberOfBytes);
+      combined = format == FormatEnum::Gzip ? crc32_combine(combined, checksum.value, length)
+                                            : adler32_combine(combined, checksum.value, length);
+    }
+  }
+  return combined;
+}
+
+// Deflates a block into a raw deflate stream, ending with a sync flush, or
+// with the end of the stream for the last block
+bool
+DeflateBlock(const Bytef *                input,
+             uInt                         inputSize,
+             int                          compressionLevel,
+             bool                         isLast,
+             std::vector<unsigned char> & output)
+{
+  z_stream stream{};
+  if (deflateInit2(&stream, compressionLevel, Z_DEFLATED, rawWindowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+  {
+    return false;
+  }
+  // The bound does not account for the flush marker
+  output.resize(deflateBound(&stream, inputSize) + sizeof(syncFlushMarker) + 8);
+  stream.next_in = const_cast<Bytef *>(input);
+  stream.avail_in = inputSize;
+  stream.next_out = output.data();
+  stream.avail_out = static_cast<uInt>(output.size());
+
+  const int flush = isLast ? Z_FINISH : Z_SYNC_FLUSH;
+  bool      succeeded = false;
+  while (true)
+  {
+    if (stream.avail_out == 0)
+    {
+      const SizeValueType used = output.size();
+      output.resize(2 * used);
+      stream.next_out = output.data() + used;
+      stream.avail_out = static_cast<uInt>(output.size() - used);
+    }
+    const int status = deflate(&stream, flush);
+    if (status == Z_STREAM_END || (!isLast && status == Z_OK && stream.avail_out > 0))
+    {
+      succeeded = true;
+      break;
+    }
+    if ((status != Z_OK && status != Z_BUF_ERROR) || stream.avail_out > 0)
+    {
+      break;
+    }
+  }
+  output.resize(output.size() - stream.avail_out);
+  deflateEnd(&stream);
+  return succeeded;
+}
+
+// Returns the size of the zlib or gzip header at the beginning of a stream,
+// or 0 if there is none
+SizeValueType
+ParseHeader(const Bytef * input, SizeValueType inputSize, FormatEnum & format)
+{
+  if (inputSize >= 10 && input[0] == 0x1F && input[1] == 0x8B && input[2] == Z_DEFLATED && (input[3] & 0xE0) == 0)
+  {
+    format = FormatEnum::Gzip;
+    const unsigned int flags = input[3];
+    SizeValueType      headerSize = 10;
+    if (flags & 0x04) // FEXTRA
+    {
+      if (headerSize + 2 > inputSize)
+      {
+        return 0;
+      }
+      headerSize += 2 + (input[headerSize] | (SizeValueType{ input[headerSize + 1] } << 8));
+    }
+    for (const unsigned int stringFlag : { 0x08u, 0x10u }) // FNAME, FCOMMENT
+    {
+      if (flags & stringFlag)
+      {
+        while (headerSize < inputSize && input[headerSize] != 0)
+        {
+          ++headerSize;
+        }
+        ++headerSize;
+      }
+    }
+    if (flags & 0x02) // FHCRC
+    {
+      headerSize += 2;
+    }
+    return headerSize <= inputSize ? headerSize : 0;
+  }
+  if (inputSize >= 2 && (input[0] & 0x0F) == Z_DEFLATED && (input[0] >> 4) + 8 <= MAX_WBITS &&
+      ((input[0] << 8) | input[1]) % 31 == 0 && (input[1] & 0x20) == 0)
+  {
+    format = FormatEnum::Zlib;
+    return 2;
+  }
+  return 0;
+}
+
+// Inflates input[consumed, inputSize) into output[produced, outputSize), and
+// updates consumed and produced. Returns the status of the last call to
+// inflate: Z_STREAM_END at the end of the deflate stream, Z_BUF_ERROR when the
+// input is exhausted or the output full, or an error.
+int
+Inflate(z_stream &      stream,
+        const Bytef *   input,
+        SizeValueType   inputSize,
+        SizeValueType & consumed,
+        Bytef *         output,
+        SizeValueType   outputSize,
+        SizeValueType & produced)
+{
+  int status = Z_OK;
+  while (status == Z_OK)
+  {
+    const auto inputChunkSize = static_cast<uInt>(std::min(inputSize - consumed, maximumChunkSize));
+    const auto outputChunkSize = static_cast<uInt>(std::min(outputSize - produced, maximumChunkSize));
+    stream.next_in = const_cast<Bytef *>(input) + consumed;
+    stream.avail_in = inputChunkSize;
+    stream.next_out = output + produced;
+    stream.avail_out = outputChunkSize;
+    status = inflate(&stream, Z_NO_FLUSH);
+    consumed += inputChunkSize - stream.avail_in;
+    produced += outputChunkSize - stream.avail_out;
+    if (status == Z_OK && consumed == inputSize)
+    {
+      // Stop right after the last input: a further call would not report the
+      // state of the stream at its end
+      status = Z_BUF_ERROR;
+    }
+  }
+  return status;
+}
+
+// A range of a raw deflate stream, inflated independently of the others
+struct Part
+{
+  SizeValueType         begin;
+  SizeValueType         end;
+  Bytef *               output;
+  std::vector<Bytef>    buffer;
+  SizeValueType         numberOfBytes;
+  std::vector<Checksum> checksums;
+  bool                  succeeded;
+  SizeValueType         trailerBegin;
+};
+
+// Inflates a part, which must end exactly on a block boundary, or at the end
+// of the deflate stream for the last part.
+bool
+InflatePart(const Bytef * input, Part & part, bool isLast, SizeValueType maximumNumberOfBytes, SizeValueType estimate)
+{
+  z_stream stream{};
+  if (inflateInit2(&stream, rawWindowBits) != Z_OK)
+  {
+    return false;
+  }
+  const SizeValueType inputSize = part.end - part.begin;
+  SizeValueType       consumed = 0;
+  SizeValueType       outputSize = maximumNumberOfBytes;
+  if (part.output == nullptr)
+  {
+    outputSize = std::min(estimate, maximumNumberOfBytes);
+    part.buffer.resize(outputSize);
+  }
+  int status = Z_OK;
+  while (true)
+  {
+    Bytef * const output = part.output != nullptr ? part.output : part.buffer.data();
+    status = Inflate(stream, input + part.begin, inputSize, consumed, output, outputSize, part.numberOfBytes);
+    if (status != Z_BUF_ERROR || part.numberOfBytes < outputSize || consumed == inputSize ||
+        outputSize == maximumNumberOfBytes)
+    {
+      break;
+    }
+    outputSize = std::min(2 * outputSize + 1, maximumNumberOfBytes);
+    part.buffer.resize(outputSize);
+  }
+  const int dataType = stream.data_type;
+  inflateEnd(&stream);
+
+  if (isLast)
+  {
+    part.trailerBegin = part.begin + consumed;
+    return status == Z_STREAM_END;
+  }
+  return status == Z_BUF_ERROR && consumed == inputSize && dataType == blockBoundaryDataType;
+}
+
+// Inflates the raw deflate stream from deflateBegin in parallel, and returns
+// whether it could be split consistently and matches the trailer
+bool
+InflateInParallel(const Bytef * input,
+                  SizeValueType inputSize,
+                  SizeValueType deflateBegin,
+                  FormatEnum    format,
+                  Bytef *       data,
+                  SizeValueType numberOfBytes)
+{
+  const auto          multiThreader = MultiThreaderBase::New();
+  const SizeValueType deflateSize = inputSize - deflateBegin;
+  const SizeValueType maximumNumberOfParts =
+    std::min<SizeValueType>(multiThreader->GetNumberOfWorkUnits(), deflateSize / minimumPartSize);
+  if (maximumNumberOfParts < 2)
+  {
+    return false;
+  }
+
+  // Start the parts right after the flush markers following evenly spaced positions
+  std::vector<Part> parts;
+  parts.push_back({ deflateBegin, 0, data, {}, 0, {}, false, 0 });
+  for (SizeValueType i = 1; i < maximumNumberOfParts; ++i)
+  {
+    const SizeValueType position =
+      std::max(deflateBegin + i * (deflateSize / maximumNumberOfParts), parts.back().begin + minimumPartSize);
+    if (position >= inputSize)
+    {
+      break;
+    }
+    const Bytef * const marker = std::search(
+      input + position, input + inputSize, std::begin(syncFlushMarker), std::end(syncFlushMarker));
+    if (marker == input + inputSize)
+    {
+      break;
+    }
+    const auto begin = static_cast<SizeValueType>(marker - input) + sizeof(syncFlushMarker);
+    parts.back().end = begin;
+    parts.push_back({ begin, 0, nullptr, {}, 0, {}, false, 0 });
+  }
+  // The end of the deflate stream is only known once inflated
+  parts.back().end = inputSize;
+  if (parts.size() < 2)
+  {
+    return false;
+  }
+
+  const double ratio = static_cast<double>(numberOfBytes) / static_cast<double>(deflateSize);
+  multiThreader->ParallelizeArray(
+    0,
+    parts.size(),
+    [&](SizeValueType i) {
+      Part &     part = parts[i];
+      const bool isLast = i + 1 == parts.size();
+      const auto compressedSize = static_cast<double>(part.end - part.begin);
+      const auto estimate = static_cast<SizeValueType>(1.25 * ratio * compressedSize) + 4096;
+      try
+      {
+        part.succeeded = InflatePart(input, part, isLast, numberOfBytes, estimate);
+        if (part.succeeded)
+        {
+          const Bytef * const output = part.output != nullptr ? part.output : part.buffer.data();
+          AppendChecksums(format, output, part.numberOfBytes, part.checksums);
+        }
+      }
+      catch (const std::bad_alloc &)
+      {
+        part.succeeded = false;
+      }
+    },
+    nullptr);
+
+  SizeValueType              total = 0;
+  std::vector<SizeValueType> offsets;
+  for (const Part & part : parts)
+  {
+    if (!part.succeeded)
+    {
+      return false;
+    }
+    offsets.push_back(total);
+    total += part.numberOfBytes;
+  }
+  if (total != numberOfBytes)
+  {
+    return false;
+  }
+
+  // Verify the trailer
+  std::vector<std::vector<Checksum>> checksums;
+  for (Part & part : parts)
+  {
+    checksums.push_back(std::move(part.checksums));
+  }
+  const uLong         checksum = CombineChecksums(format, checksums);
+  const SizeValueType trailerBegin = parts.back().trailerBegin;
+  const Bytef * const trailer = input + trailerBegin;
+  if (format == FormatEnum::Gzip)
+  {
+    if (trailerBegin + 8 > inputSize)
+    {
+      return false;
+    }
+    const uLong storedChecksum = trailer[0] | (uLong{ trailer[1] } << 8) | (uLong{ trailer[2] } << 16) |
+                                 (uLong{ trailer[3] } << 24);
+    const uLong storedSize = trailer[4] | (uLong{ trailer[5] } << 8) | (uLong{ trailer[6] } << 16) |
+                             (uLong{ trailer[7] } << 24);
+    if (storedChecksum != checksum || storedSize != (numberOfBytes & 0xFFFFFFFFu))
+    {
+      return false;
+    }
+  }
+  else
+  {
+    if (trailerBegin + 4 > inputSize)
+    {
+      return false;
+    }
+    const uLong storedChecksum = (uLong{ trailer[0] } << 24) | (uLong{ trailer[1] } << 16) |
+                                 (uLong{ trailer[2] } << 8) | trailer[3];
+    if (storedChecksum != checksum)
+    {
+      return false;
+    }
+  }
+
+  multiThreader->ParallelizeArray(
+    1,
+    parts.size(),
+    [&parts, &offsets, data](SizeValueType i) {
+      std::memcpy(data + offsets[i], parts[i].buffer.data(), parts[i].numberOfBytes);
+    },
+    nullptr);
+  return true;
+}
+
+// Inflates a whole zlib or gzip stream, checked by zlib
+void
+InflateSerially(const Bytef * input, SizeValueType inputSize, Bytef * data, SizeValueType numberOfBytes)
+{
+  z_stream stream{};
+  // Automatic detection of the zlib or gzip header
+  if (inflateInit2(&stream, MAX_WBITS + 32) != Z_OK)
+  {
+    itkGenericExceptionMacro("Cannot initialize the decompression of data.");
+  }
+  SizeValueType consumed = 0;
+  SizeValueType produced = 0;
+  const int     status = Inflate(stream, input, inputSize, consumed, data, numberOfBytes, produced);
+  const std::string message = stream.msg != nullptr ? stream.msg : "invalid stream";
+  inflateEnd(&stream);
+  if (status != Z_STREAM_END)
+  {
+    itkGenericExceptionMacro("Cannot decompress data: "
+                             << (status == Z_BUF_ERROR ? "the data is truncated or larger than expected" : message)
+                             << '.');
+  }
+  if (produced != numberOfBytes)
+  {
+    itkGenericExceptionMacro("Cannot decompress data: expected " << numberOfBytes << " bytes, but got " << produced
+                                                                 << '.');
+  }
+}
+} // namespace
+
+std::vector<unsigned char>
+ParallelDeflateCodec::Compress(const void *  data,
+                               SizeValueType numberOfBytes,
+                               int           compressionLevel,
+                               FormatEnum    format,
+                               SizeValueType blockSize)
+{
+  std::vector<SizeValueType> blockOffsets;
+  return Compress(data, numberOfBytes, compressionLevel, format, blockSize, blockOffsets);
+}
+
+std::vector<unsigned char>
+ParallelDeflateCodec::Compress(const void *                 data,
+                               SizeValueType                numberOfBytes,
+                               int                          compressionLevel,
+                               FormatEnum                   format,
+                               SizeValueType                blockSize,
+                               std::vector<SizeValueType> & blockOffsets)
+{
+  if (compressionLevel < Z_DEFAULT_COMPRESSION || compressionLevel > Z_BEST_COMPRESSION)
+  {
+    itkGenericExceptionMacro("Invalid compression level: " << compressionLevel << '.');
+  }
+  blockSize = std::clamp(blockSize, SizeValueType{ 1 }, maximumChunkSize);
+
+  const auto * const  input = static_cast<const Bytef *>(data);
+  const SizeValueType numberOfBlocks = std::max<SizeValueType>((numberOfBytes + blockSize - 1) / blockSize, 1);
+
+  std::vector<std::vector<unsigned char>> blocks(numberOfBlocks);
+  std::vector<std::vector<Checksum>>      checksums(numberOfBlocks);
+  std::vector<char>                       succeeded(numberOfBlocks, false);
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](SizeValueType block) {
+      const SizeValueType begin = block * blockSize;
+      const auto          size = static_cast<uInt>(std::min(blockSize, numberOfBytes - begin));
+      try
+      {
+        AppendChecksums(format, input + begin, size, checksums[block]);
+        succeeded[block] =
+          DeflateBlock(input + begin, size, compressionLevel, block + 1 == numberOfBlocks, blocks[block]);
+      }
+      catch (const std::bad_alloc &)
+      {
+        succeeded[block] = false;
+      }
+    },
+    nullptr);
+  if (std::find(succeeded.cbegin(), succeeded.cend(), false) != succeeded.cend())
+  {
+    itkGenericExceptionMacro("Cannot compress " << numberOfBytes << " bytes of data.");
+  }
+
+  std::vector<unsigned char> compressedData;
+  if (format == FormatEnum::Gzip)
+  {
+    // No file name nor modification time, unknown operating system
+    const unsigned char extraFlags = compressionLevel == Z_BEST_COMPRESSION ? 2 : (compressionLevel == 1 ? 4 : 0);
+    compressedData = { 0x1F, 0x8B, Z_DEFLATED, 0, 0, 0, 0, 0, extraFlags, 255 };
+  }
+  else
+  {
+    // 32K window, and the level of compression as zlib sets it
+    const unsigned int levelFlags = compressionLevel == Z_DEFAULT_COMPRESSION || compressionLevel == 6
+                                      ? 2
+                                      : (compressionLevel < 2 ? 0 : (compressionLevel < 6 ? 1 : 3));
+    const unsigned int header = (0x78u << 8) | (levelFlags << 6);
+    compressedData = { 0x78, static_cast<unsigned char>((header + (31 - header % 31) % 31) & 0xFF) };
+  }
+  blockOffsets.clear();
+  for (const auto & block : blocks)
+  {
+    blockOffsets.push_back(compressedData.size());
+    compressedData.insert(compressedData.end(), block.cbegin(), block.cend());
+  }
+
+  const uLong checksum = CombineChecksums(format, checksums);
+  if (format == FormatEnum::Gzip)
+  {
+    for (const uLong value : { checksum, static_cast<uLong>(numberOfBytes & 0xFFFFFFFFu) })
+    {
+      for (unsigned int byte = 0; byte < 4; ++byte)
+      {
+        compressedData.push_back(static_cast<unsigned char>((value >> (8 * byte)) & 0xFF));
+      }
+    }
+  }
+  else
+  {
+    for (unsigned int byte = 0; byte < 4; ++byte)
+    {
+      compressedData.push_back(static_cast<unsigned char>((checksum >> (8 * (3 - byte))) & 0xFF));
+    }
+  }
+  return compressedData;
+}
+
+void
+ParallelDeflateCodec::Decompress(const void *  compressedData,
+                                 SizeValueType compressedSize,
+                                 void *        data,
+                                 SizeValueType numberOfBytes)
+{
+  const auto * const  input = static_cast<const Bytef *>(compressedData);
+  FormatEnum          format = FormatEnum::Zlib;
+  const SizeValueType headerSize = ParseHeader(input, compressedSize, format);
+  if (headerSize == 0)
+  {
+    itkGenericExceptionMacro("Cannot decompress data: the stream has neither a zlib nor a gzip header.");
+  }
+
+  // zlib requires an output buffer, even if empty
+  Bytef        emptyOutput;
+  auto * const output = numberOfBytes > 0 ? static_cast<Bytef *>(data) : &emptyOutput;
+  if (!InflateInParallel(input, compressedSize, headerSize, format, output, numberOfBytes))
+  {
+    InflateSerially(input, compressedSize, output, numberOfBytes);
+  }
+}
+
+void
+ParallelDeflateCodec::DecompressBlock(const void *  compressedBlock,
+                                      SizeValueType compressedSize,
+                                      void *        data,
+                                      SizeValueType numberOfBytes)
+{
+  z_stream stream{};
+  if (inflateInit2(&stream, rawWindowBits) != Z_OK)
+  {
+    itkGenericExceptionMacro("Cannot initialize the decompression of data.");
+  }
+  const auto * const input = static_cast<const Bytef *>(compressedBlock);
+  Bytef              emptyOutput;
+  auto * const       output = numberOfBytes > 0 ? static_cast<Bytef *>(data) : &emptyOutput;
+  SizeValueType      consumed = 0;
+  SizeValueType      produced = 0;
+  const int          status = Inflate(stream, input, compressedSize, consumed, output, numberOfBytes, produced);
+  const int          dataType = stream.data_type;
+  const std::string  message = stream.msg != nullptr ? stream.msg : "invalid stream";
+  inflateEnd(&stream);
+  if (status != Z_STREAM_END && status != Z_BUF_ERROR)
+  {
+    itkGenericExceptionMacro("Cannot decompress block: " << message << '.');
+  }
+  // A block ends with a sync flush, or with the end of the deflate stream
+  if (consumed != compressedSize || produced != numberOfBytes ||
+      (status == Z_BUF_ERROR && dataType != blockBoundaryDataType))
+  {
+    itkGenericExceptionMacro("Cannot decompress block: expected " << numberOfBytes << " bytes from " << compressedSize
+                                                                  << ", but got " << produced << " bytes from "
+                                                                  << consumed << '.');
+  }
+}
+
+std::ostream &
+operator<<(std::ostream & out, const ParallelDeflateCodecEnums::Format value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case ParallelDeflateCodecEnums::Format::Zlib:
+        return "itk::ParallelDeflateCodecEnums::Format::Zlib";
+      case ParallelDeflateCodecEnums::Format::Gzip:
+        return "itk::ParallelDeflateCodecEnums::Format::Gzip";
+      default:
+        return "INVALID VALUE FOR itk::ParallelDeflateCodecEnums::Format";
+    }
+  }();
+}
+
+} // end namespace itk
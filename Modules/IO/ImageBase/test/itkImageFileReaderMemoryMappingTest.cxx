@@ -0,0 +1,187 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkMemoryMappedImageBufferAllocator.h"
+#include "itkMultiplyImageFilter.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+using ImageType = itk::Image<short, 3>;
+
+bool
+HaveSamePixels(const ImageType * image1, const ImageType * image2)
+{
+  itk::ImageRegionConstIterator<ImageType> it1(image1, image1->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> it2(image2, image2->GetLargestPossibleRegion());
+  for (; !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    if (it2.IsAtEnd() || it1.Get() != it2.Get())
+    {
+      return false;
+    }
+  }
+  return it2.IsAtEnd();
+}
+
+// Reads the file with the given memory mapping
+template <typename TImage>
+typename TImage::Pointer
+ReadImage(const std::string & fileName, itk::IOMemoryMappingEnum memoryMapping)
+{
+  auto reader = itk::ImageFileReader<TImage>::New();
+  reader->SetFileName(fileName);
+  reader->SetMemoryMapping(memoryMapping);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+template <typename TImage>
+bool
+IsMemoryMapped(const TImage * image)
+{
+  return dynamic_cast<const itk::MemoryMappedImageBufferAllocator *>(
+           image->GetPixelContainer()->GetImportPointerAllocator()) != nullptr;
+}
+} // namespace
+
+int
+itkImageFileReaderMemoryMappingTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  for (const auto memoryMapping :
+       { itk::IOMemoryMappingEnum::Off, itk::IOMemoryMappingEnum::ReadOnly, itk::IOMemoryMappingEnum::CopyOnWrite })
+  {
+    std::cout << "STREAMED ENUM VALUE IOMemoryMappingEnum: " << memoryMapping << std::endl;
+  }
+
+  auto                      image = ImageType::New();
+  const ImageType::SizeType size = { { 31, 17, 9 } };
+  image->SetRegions(size);
+  image->Allocate();
+  auto * const container = image->GetPixelContainer();
+  for (itk::SizeValueType i = 0; i < container->Size(); ++i)
+  {
+    (*container)[i] = static_cast<short>(-1000 + 7 * static_cast<int>(i));
+  }
+
+  // Attached and detached data, and compressed data that cannot be mapped
+  const std::string attachedFileName = outputDirectory + "/itkImageFileReaderMemoryMappingTest.mha";
+  const std::string detachedFileName = outputDirectory + "/itkImageFileReaderMemoryMappingTest.mhd";
+  const std::string compressedFileName = outputDirectory + "/itkImageFileReaderMemoryMappingTestCompressed.mha";
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(image, attachedFileName));
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(image, detachedFileName));
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(image, compressedFileName, true));
+
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(reader, ImageFileReader, ImageSource);
+  ITK_TEST_EXPECT_EQUAL(reader->GetMemoryMapping(), itk::IOMemoryMappingEnum::Off);
+  reader->SetMemoryMapping(itk::IOMemoryMappingEnum::ReadOnly);
+  ITK_TEST_SET_GET_VALUE(itk::IOMemoryMappingEnum::ReadOnly, reader->GetMemoryMapping());
+  reader->MemoryMappingOn();
+  ITK_TEST_EXPECT_EQUAL(reader->GetMemoryMapping(), itk::IOMemoryMappingEnum::CopyOnWrite);
+  reader->MemoryMappingOff();
+  ITK_TEST_EXPECT_EQUAL(reader->GetMemoryMapping(), itk::IOMemoryMappingEnum::Off);
+
+  ImageType::Pointer readImage;
+  for (const std::string & fileName : { attachedFileName, detachedFileName })
+  {
+    ITK_TRY_EXPECT_NO_EXCEPTION(readImage = ReadImage<ImageType>(fileName, itk::IOMemoryMappingEnum::Off));
+    ITK_TEST_EXPECT_TRUE(!IsMemoryMapped(readImage.GetPointer()));
+    ITK_TEST_EXPECT_TRUE(HaveSamePixels(image, readImage));
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(readImage = ReadImage<ImageType>(fileName, itk::IOMemoryMappingEnum::ReadOnly));
+    ITK_TEST_EXPECT_TRUE(IsMemoryMapped(readImage.GetPointer()));
+    ITK_TEST_EXPECT_TRUE(readImage->GetPixelContainer()->IsBufferReadOnly());
+    ITK_TEST_EXPECT_TRUE(HaveSamePixels(image, readImage));
+    ITK_TEST_EXPECT_EQUAL(readImage->GetBufferedRegion(), image->GetLargestPossibleRegion());
+
+    // An in-place filter allocates its output instead of writing to a read-only mapping
+    auto multiply = itk::MultiplyImageFilter<ImageType, ImageType, ImageType>::New();
+    multiply->SetInput1(readImage);
+    multiply->SetConstant2(2);
+    multiply->InPlaceOn();
+    ITK_TRY_EXPECT_NO_EXCEPTION(multiply->Update());
+    ITK_TEST_EXPECT_TRUE(multiply->GetOutput()->GetBufferPointer() != readImage->GetBufferPointer());
+    ITK_TEST_EXPECT_TRUE(HaveSamePixels(image, readImage));
+    ITK_TEST_EXPECT_EQUAL(multiply->GetOutput()->GetPixel({ { 1, 0, 0 } }), -1986);
+
+    // Modifying a copy-on-write mapping does not modify the file
+    ITK_TRY_EXPECT_NO_EXCEPTION(readImage = ReadImage<ImageType>(fileName, itk::IOMemoryMappingEnum::CopyOnWrite));
+    ITK_TEST_EXPECT_TRUE(IsMemoryMapped(readImage.GetPointer()));
+    ITK_TEST_EXPECT_TRUE(!readImage->GetPixelContainer()->IsBufferReadOnly());
+    ITK_TEST_EXPECT_TRUE(HaveSamePixels(image, readImage));
+    readImage->FillBuffer(42);
+    readImage = nullptr;
+    ITK_TRY_EXPECT_NO_EXCEPTION(readImage = ReadImage<ImageType>(fileName, itk::IOMemoryMappingEnum::ReadOnly));
+    ITK_TEST_EXPECT_TRUE(HaveSamePixels(image, readImage));
+  }
+
+  // The file is read instead when it cannot be mapped
+  ITK_TRY_EXPECT_NO_EXCEPTION(readImage = ReadImage<ImageType>(compressedFileName, itk::IOMemoryMappingEnum::ReadOnly));
+  ITK_TEST_EXPECT_TRUE(!IsMemoryMapped(readImage.GetPointer()));
+  ITK_TEST_EXPECT_TRUE(HaveSamePixels(image, readImage));
+
+  using FloatImageType = itk::Image<float, 3>;
+  FloatImageType::Pointer floatImage;
+  ITK_TRY_EXPECT_NO_EXCEPTION(floatImage =
+                                ReadImage<FloatImageType>(attachedFileName, itk::IOMemoryMappingEnum::ReadOnly));
+  ITK_TEST_EXPECT_TRUE(!IsMemoryMapped(floatImage.GetPointer()));
+  ITK_TEST_EXPECT_EQUAL(floatImage->GetPixel({ { 1, 0, 0 } }), -993.0f);
+
+  // Direct mappings
+  auto allocator = itk::MemoryMappedImageBufferAllocator::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(allocator, MemoryMappedImageBufferAllocator, ImageBufferAllocator);
+  ITK_TEST_EXPECT_EQUAL(allocator->GetAlignment(), 1);
+
+  ITK_TRY_EXPECT_EXCEPTION(allocator->MapFile(attachedFileName, 0, 16, itk::IOMemoryMappingEnum::Off));
+  ITK_TRY_EXPECT_EXCEPTION(allocator->MapFile(attachedFileName, 0, 0, itk::IOMemoryMappingEnum::ReadOnly));
+  ITK_TRY_EXPECT_EXCEPTION(allocator->MapFile(attachedFileName, 0, 1 << 30, itk::IOMemoryMappingEnum::ReadOnly));
+  ITK_TRY_EXPECT_EXCEPTION(
+    allocator->MapFile(outputDirectory + "/nonexistent.raw", 0, 16, itk::IOMemoryMappingEnum::ReadOnly));
+
+  const std::string        rawFileName = outputDirectory + "/itkImageFileReaderMemoryMappingTest.raw";
+  const itk::SizeValueType numberOfBytes = image->GetPixelContainer()->Size() * sizeof(short);
+  for (const itk::SizeValueType offset : { 0, 2, 4098 })
+  {
+    const itk::SizeValueType mappedBytes = numberOfBytes - offset;
+    void * const buffer = allocator->MapFile(rawFileName, offset, mappedBytes, itk::IOMemoryMappingEnum::ReadOnly);
+    ITK_TEST_EXPECT_EQUAL(static_cast<const short *>(buffer)[0], image->GetBufferPointer()[offset / sizeof(short)]);
+    ITK_TEST_EXPECT_TRUE(allocator->IsBufferReadOnly(buffer));
+    allocator->Deallocate(buffer, mappedBytes);
+  }
+
+  // Anonymous mappings are zero-filled
+  auto * const zeros = static_cast<short *>(allocator->Allocate(numberOfBytes));
+  ITK_TEST_EXPECT_EQUAL(zeros[0], 0);
+  ITK_TEST_EXPECT_EQUAL(zeros[numberOfBytes / sizeof(short) - 1], 0);
+  allocator->Deallocate(zeros, numberOfBytes);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
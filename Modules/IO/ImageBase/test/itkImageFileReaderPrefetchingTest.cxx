@@ -0,0 +1,129 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageRegionSplitterMultidimensional.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+// Streams the file through a reader which reads ahead, and compares the
+// result with the pixels of the image written in the file
+template <typename TImage, typename TFileImage>
+bool
+TestPrefetching(const std::string & fileName, const TFileImage * fileImage, bool useMultidimensionalSplitter)
+{
+  auto reader = itk::ImageFileReader<TImage>::New();
+  reader->SetFileName(fileName);
+  reader->UsePrefetchingOn();
+  auto streamer = itk::StreamingImageFilter<TImage, TImage>::New();
+  streamer->SetInput(reader->GetOutput());
+  streamer->SetNumberOfStreamDivisions(6);
+  if (useMultidimensionalSplitter)
+  {
+    streamer->SetRegionSplitter(itk::ImageRegionSplitterMultidimensional::New());
+  }
+
+  // the pipeline is updated twice, to read again the regions read ahead
+  for (int i = 0; i < 2; ++i)
+  {
+    streamer->Modified();
+    streamer->Update();
+    const TImage * image = streamer->GetOutput();
+    itk::ImageRegionConstIteratorWithIndex<TImage> it(image, image->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+      typename TFileImage::IndexType fileIndex{};
+      for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+      {
+        fileIndex[d] = it.GetIndex()[d];
+      }
+      if (it.Get() != static_cast<typename TImage::PixelType>(fileImage->GetPixel(fileIndex)))
+      {
+        std::cerr << "Pixel " << it.GetIndex() << " is " << it.Get() << " instead of "
+                  << fileImage->GetPixel(fileIndex) << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkImageFileReaderPrefetchingTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  using ImageType = itk::Image<short, 3>;
+  auto                      image = ImageType::New();
+  const ImageType::SizeType size = { { 37, 29, 23 } };
+  image->SetRegions(size);
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<short>(index[0] + 37 * index[1] - 50 * index[2]));
+  }
+  const std::string fileName = std::string(argv[1]) + "/itkImageFileReaderPrefetchingTest.mha";
+  itk::WriteImage(image, fileName);
+
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(reader, ImageFileReader, ImageSource);
+  ITK_TEST_SET_GET_BOOLEAN(reader, UsePrefetching, false);
+
+  bool succeeded = true;
+  for (const bool useMultidimensionalSplitter : { false, true })
+  {
+    std::cout << "Multidimensional splitter " << useMultidimensionalSplitter << std::endl;
+    // the regions read ahead are swapped into the output
+    succeeded &= TestPrefetching<ImageType>(fileName, image.get(), useMultidimensionalSplitter);
+    // or converted
+    succeeded &= TestPrefetching<itk::Image<float, 3>>(fileName, image.get(), useMultidimensionalSplitter);
+    // or copied, when reading the first slice of the file
+    succeeded &= TestPrefetching<itk::Image<short, 2>>(fileName, image.get(), useMultidimensionalSplitter);
+  }
+
+  // A reader released while it reads ahead waits for the read region
+  {
+    auto prefetchingReader = itk::ImageFileReader<ImageType>::New();
+    prefetchingReader->SetFileName(fileName);
+    prefetchingReader->UsePrefetchingOn();
+    prefetchingReader->UpdateOutputInformation();
+    prefetchingReader->GetOutput()->SetRequestedRegion(ImageType::RegionType({ { 0, 0, 0 } }, { { 37, 29, 4 } }));
+    ITK_TRY_EXPECT_NO_EXCEPTION(prefetchingReader->Update());
+  }
+
+  if (!succeeded)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkTestingMacros.h"
+
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+using ImageType = itk::Image<short, 3>;
+using WriterType = itk::ImageFileWriter<ImageType>;
+
+std::string
+ReadFile(const std::string & fileName)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+// Streams the input file through the writer, and checks that the pipeline is streamed
+bool
+StreamFile(const std::string & inputFileName, WriterType * writer)
+{
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(inputFileName);
+  reader->SetUseStreaming(true);
+  auto monitor = itk::PipelineMonitorImageFilter<ImageType>::New();
+  monitor->SetInput(reader->GetOutput());
+
+  writer->SetInput(monitor->GetOutput());
+  writer->SetNumberOfStreamDivisions(5);
+  writer->Update();
+  return monitor->VerifyAllInputCanStream(5);
+}
+} // namespace
+
+int
+itkImageFileWriterAsynchronousTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  auto                      image = ImageType::New();
+  const ImageType::SizeType size = { { 61, 47, 23 } };
+  image->SetRegions(size);
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<short>(index[0] + 61 * index[1] - 100 * index[2]));
+  }
+  const std::string inputFileName = outputDirectory + "/itkImageFileWriterAsynchronousTestInput.mha";
+  itk::WriteImage(image, inputFileName);
+
+  auto writer = WriterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(writer, ImageFileWriter, ProcessObject);
+  ITK_TEST_SET_GET_BOOLEAN(writer, UseAsynchronousWriting, false);
+  ITK_TEST_SET_GET_VALUE(1, writer->GetMaximumNumberOfPiecesInFlight());
+  writer->SetMaximumNumberOfPiecesInFlight(0);
+  ITK_TEST_SET_GET_VALUE(1, writer->GetMaximumNumberOfPiecesInFlight());
+
+  const std::string expectedFileName = outputDirectory + "/itkImageFileWriterAsynchronousTestSynchronous.mha";
+  writer->SetFileName(expectedFileName);
+  bool streamed = false;
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamed = StreamFile(inputFileName, writer));
+  ITK_TEST_EXPECT_TRUE(streamed);
+  const std::string expectedFile = ReadFile(expectedFileName);
+
+  // The pieces are written in the same order, whatever the number of them in flight
+  for (const unsigned int maximumNumberOfPiecesInFlight : { 1, 2, 10 })
+  {
+    std::cout << "MaximumNumberOfPiecesInFlight " << maximumNumberOfPiecesInFlight << std::endl;
+    const std::string fileName = outputDirectory + "/itkImageFileWriterAsynchronousTest" +
+                                 std::to_string(maximumNumberOfPiecesInFlight) + ".mha";
+    writer = WriterType::New();
+    writer->SetFileName(fileName);
+    writer->UseAsynchronousWritingOn();
+    writer->SetMaximumNumberOfPiecesInFlight(maximumNumberOfPiecesInFlight);
+    ITK_TEST_SET_GET_VALUE(maximumNumberOfPiecesInFlight, writer->GetMaximumNumberOfPiecesInFlight());
+    ITK_TRY_EXPECT_NO_EXCEPTION(streamed = StreamFile(inputFileName, writer));
+    ITK_TEST_EXPECT_TRUE(streamed);
+    ITK_TEST_EXPECT_EQUAL(writer->GetProgress(), 1.0f);
+    ITK_TEST_EXPECT_TRUE(ReadFile(fileName) == expectedFile);
+  }
+
+  // An image which is not streamed upstream is written at once
+  writer = WriterType::New();
+  writer->SetInput(image);
+  writer->SetFileName(outputDirectory + "/itkImageFileWriterAsynchronousTestNotStreamed.mha");
+  writer->UseAsynchronousWritingOn();
+  writer->SetNumberOfStreamDivisions(5);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  const ImageType::Pointer readImage = itk::ReadImage<ImageType>(writer->GetFileName());
+  ITK_TEST_EXPECT_TRUE(std::equal(image->GetBufferPointer(),
+                                  image->GetBufferPointer() + image->GetBufferedRegion().GetNumberOfPixels(),
+                                  readImage->GetBufferPointer()));
+
+  // The errors of the writing thread are reported by the writer
+  writer = WriterType::New();
+  writer->SetFileName(outputDirectory + "/NonExistingDirectory/itkImageFileWriterAsynchronousTest.mha");
+  writer->UseAsynchronousWritingOn();
+  ITK_TRY_EXPECT_EXCEPTION(StreamFile(inputFileName, writer));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGDCMImageIO.h"
+#include "itkImageFileWriter.h"
+#include "itkImageIOFactory.h"
+#include "itkMetaImageIO.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+
+namespace
+{
+// Returns the name of the class of the ImageIO created for reading the file
+std::string
+GetNameOfReadingImageIO(const std::string & fileName)
+{
+  const itk::ImageIOBase::Pointer imageIO =
+    itk::ImageIOFactory::CreateImageIO(fileName.c_str(), itk::IOFileModeEnum::ReadMode);
+  return imageIO ? imageIO->GetNameOfClass() : "";
+}
+} // namespace
+
+int
+itkImageIOFactoryDispatchTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string prefix = std::string(argv[1]) + "/itkImageIOFactoryDispatchTest";
+
+  const auto                                      gdcmImageIO = itk::GDCMImageIO::New();
+  const itk::ImageIOBase::ArrayOfSignaturesType & signatures = gdcmImageIO->GetSupportedReadSignatures();
+  const auto dicomSignature = std::make_pair(itk::SizeValueType{ 128 }, std::string("DICM"));
+  ITK_TEST_EXPECT_TRUE(std::find(signatures.cbegin(), signatures.cend(), dicomSignature) != signatures.cend());
+  ITK_TEST_EXPECT_TRUE(itk::MetaImageIO::New()->GetSupportedReadSignatures().empty());
+
+  using ImageType = itk::Image<short, 2>;
+  auto                      image = ImageType::New();
+  const ImageType::SizeType size = { { 16, 8 } };
+  image->SetRegions(size);
+  image->AllocateInitialized();
+
+  // The ImageIOs claiming the extension are asked first
+  const std::string dicomFileName = prefix + ".dcm";
+  itk::WriteImage(image, dicomFileName);
+  ITK_TEST_EXPECT_EQUAL(GetNameOfReadingImageIO(dicomFileName), "GDCMImageIO");
+  const std::string metaFileName = prefix + ".mha";
+  itk::WriteImage(image, metaFileName);
+  ITK_TEST_EXPECT_EQUAL(GetNameOfReadingImageIO(metaFileName), "MetaImageIO");
+
+  // then the ones recognizing the signature of the file
+  const std::string renamedDicomFileName = prefix + "DICOM.mha";
+  itksys::SystemTools::CopyAFile(dicomFileName, renamedDicomFileName);
+  ITK_TEST_EXPECT_EQUAL(GetNameOfReadingImageIO(renamedDicomFileName), "GDCMImageIO");
+  const std::string unknownDicomFileName = prefix + "DICOM.unknown";
+  itksys::SystemTools::CopyAFile(dicomFileName, unknownDicomFileName);
+  ITK_TEST_EXPECT_EQUAL(GetNameOfReadingImageIO(unknownDicomFileName), "GDCMImageIO");
+  const std::string upperCaseDicomFileName = prefix + "Upper.DCM";
+  itksys::SystemTools::CopyAFile(dicomFileName, upperCaseDicomFileName);
+  ITK_TEST_EXPECT_EQUAL(GetNameOfReadingImageIO(upperCaseDicomFileName), "GDCMImageIO");
+
+  // The other ImageIOs are asked last, none of them reads a file in another format
+  const std::string renamedMetaFileName = prefix + "Meta.dcm";
+  itksys::SystemTools::CopyAFile(metaFileName, renamedMetaFileName);
+  ITK_TEST_EXPECT_EQUAL(GetNameOfReadingImageIO(renamedMetaFileName), "");
+  ITK_TEST_EXPECT_EQUAL(GetNameOfReadingImageIO(prefix + "NonExisting.dcm"), "");
+
+  const itk::ImageIOBase::Pointer writingImageIO =
+    itk::ImageIOFactory::CreateImageIO(dicomFileName.c_str(), itk::IOFileModeEnum::WriteMode);
+  ITK_TEST_EXPECT_TRUE(writingImageIO.IsNotNull());
+  ITK_TEST_EXPECT_EQUAL(std::string(writingImageIO->GetNameOfClass()), "GDCMImageIO");
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,147 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkIOConfigure.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageIOInformationCache.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaDataObject.h"
+#include "itkTestingMacros.h"
+
+#include <chrono>
+#include <thread>
+
+namespace
+{
+using ImageType = itk::Image<short, 3>;
+
+void
+WriteImage(const std::string & fileName, const ImageType::SizeType & size, double spacing)
+{
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  image->SetSpacing(spacing);
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<short>(index[0] + 7 * index[1] - 11 * index[2]));
+  }
+  itk::EncapsulateMetaData<std::string>(image->GetMetaDataDictionary(), "ITKCacheTestKey", "cached");
+  itk::WriteImage(image, fileName);
+}
+
+itk::ImageFileReader<ImageType>::Pointer
+ReadInformation(const std::string & fileName)
+{
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->UpdateOutputInformation();
+  return reader;
+}
+} // namespace
+
+int
+itkImageIOInformationCacheTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = std::string(argv[1]) + "/itkImageIOInformationCacheTest.mha";
+  const std::string otherFileName = std::string(argv[1]) + "/itkImageIOInformationCacheTestOther.mha";
+  const ImageType::SizeType size = { { 13, 9, 5 } };
+  WriteImage(fileName, size, 0.5);
+  WriteImage(otherFileName, size, 0.5);
+
+  // The cache is not used by default
+  ITK_TEST_EXPECT_TRUE(!itk::ImageIOInformationCache::GetEnabled());
+  ITK_TEST_EXPECT_EQUAL(itk::ImageIOInformationCache::GetMaximumNumberOfEntries(), 256);
+  ReadInformation(fileName);
+  ITK_TEST_EXPECT_EQUAL(itk::ImageIOInformationCache::GetNumberOfEntries(), 0);
+  ITK_TEST_EXPECT_TRUE(itk::ImageIOInformationCache::CreateImageIO(fileName).IsNull());
+
+  itk::ImageIOInformationCache::SetEnabled(true);
+  ITK_TEST_EXPECT_TRUE(itk::ImageIOInformationCache::GetEnabled());
+  const auto expectedReader = ReadInformation(fileName);
+  ITK_TEST_EXPECT_EQUAL(itk::ImageIOInformationCache::GetNumberOfEntries(), 1);
+
+  // The information of the file comes from the cache
+  const auto reader = ReadInformation(fileName);
+  ITK_TEST_EXPECT_EQUAL(itk::ImageIOInformationCache::GetNumberOfEntries(), 1);
+  ITK_TEST_EXPECT_TRUE(reader->GetImageIO() != expectedReader->GetImageIO());
+  ITK_TEST_EXPECT_EQUAL(std::string(reader->GetImageIO()->GetNameOfClass()),
+                        std::string(expectedReader->GetImageIO()->GetNameOfClass()));
+  const ImageType * output = reader->GetOutput();
+  const ImageType * expectedOutput = expectedReader->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(output->GetLargestPossibleRegion(), expectedOutput->GetLargestPossibleRegion());
+  ITK_TEST_EXPECT_EQUAL(output->GetSpacing(), expectedOutput->GetSpacing());
+  ITK_TEST_EXPECT_EQUAL(output->GetOrigin(), expectedOutput->GetOrigin());
+  std::string value;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData<std::string>(output->GetMetaDataDictionary(), "ITKCacheTestKey", value));
+  ITK_TEST_EXPECT_EQUAL(value, "cached");
+
+  // and the pixels from the file
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  ITK_TEST_EXPECT_EQUAL(output->GetPixel({ { 4, 3, 2 } }), 4 + 7 * 3 - 11 * 2);
+
+  // A file which has changed is read again
+  const ImageType::SizeType newSize = { { 17, 9, 5 } };
+  WriteImage(fileName, newSize, 0.25);
+  const auto changedReader = ReadInformation(fileName);
+  ITK_TEST_EXPECT_EQUAL(changedReader->GetOutput()->GetLargestPossibleRegion().GetSize(), newSize);
+  ITK_TEST_EXPECT_EQUAL(changedReader->GetOutput()->GetSpacing()[0], 0.25);
+  ITK_TEST_EXPECT_EQUAL(itk::ImageIOInformationCache::GetNumberOfEntries(), 1);
+
+#if defined(ITK_HAS_STAT_ST_MTIM) || defined(ITK_HAS_STAT_ST_MTIMESPEC)
+  // even when its size does not change within the same second
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  WriteImage(fileName, newSize, 0.75);
+  ITK_TEST_EXPECT_EQUAL(ReadInformation(fileName)->GetOutput()->GetSpacing()[0], 0.75);
+#endif
+
+  // The ImageIO given by the user is not cached
+  auto userReader = itk::ImageFileReader<ImageType>::New();
+  userReader->SetFileName(otherFileName);
+  userReader->SetImageIO(changedReader->GetImageIO());
+  userReader->UpdateOutputInformation();
+  ITK_TEST_EXPECT_EQUAL(itk::ImageIOInformationCache::GetNumberOfEntries(), 1);
+
+  // The least recently used files are evicted
+  ReadInformation(otherFileName);
+  ITK_TEST_EXPECT_EQUAL(itk::ImageIOInformationCache::GetNumberOfEntries(), 2);
+  itk::ImageIOInformationCache::SetMaximumNumberOfEntries(1);
+  ITK_TEST_EXPECT_EQUAL(itk::ImageIOInformationCache::GetMaximumNumberOfEntries(), 1);
+  ITK_TEST_EXPECT_EQUAL(itk::ImageIOInformationCache::GetNumberOfEntries(), 1);
+  ITK_TEST_EXPECT_TRUE(itk::ImageIOInformationCache::CreateImageIO(fileName).IsNull());
+  ITK_TEST_EXPECT_TRUE(itk::ImageIOInformationCache::CreateImageIO(otherFileName).IsNotNull());
+
+  itk::ImageIOInformationCache::Clear();
+  ITK_TEST_EXPECT_EQUAL(itk::ImageIOInformationCache::GetNumberOfEntries(), 0);
+  ReadInformation(fileName);
+  ITK_TEST_EXPECT_EQUAL(itk::ImageIOInformationCache::GetNumberOfEntries(), 1);
+  itk::ImageIOInformationCache::SetEnabled(false);
+  ITK_TEST_EXPECT_EQUAL(itk::ImageIOInformationCache::GetNumberOfEntries(), 0);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,166 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageSeriesReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaDataObject.h"
+#include "itkMetaImageIO.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+using ImageType = itk::Image<short, 3>;
+using ReaderType = itk::ImageSeriesReader<ImageType>;
+
+// Writes a slice of the series, at z = sliceNumber, with its number in its dictionary
+void
+WriteSlice(const std::string & fileName, int sliceNumber)
+{
+  auto                      slice = ImageType::New();
+  const ImageType::SizeType size = { { 17, 13, 1 } };
+  slice->SetRegions(size);
+  slice->Allocate();
+  ImageType::PointType origin{};
+  origin[2] = 2.5 * sliceNumber;
+  slice->SetOrigin(origin);
+  itk::ImageRegionIteratorWithIndex<ImageType> it(slice, slice->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<short>(100 * sliceNumber + 3 * it.GetIndex()[1] + it.GetIndex()[0]));
+  }
+  itk::EncapsulateMetaData<std::string>(slice->GetMetaDataDictionary(), "SliceNumber", std::to_string(sliceNumber));
+  itk::WriteImage(slice, fileName);
+}
+
+ImageType::Pointer
+ReadSeries(ReaderType * reader, bool useStreaming)
+{
+  if (!useStreaming)
+  {
+    reader->Update();
+    return reader->GetOutput();
+  }
+  auto streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+  streamer->SetInput(reader->GetOutput());
+  streamer->SetNumberOfStreamDivisions(3);
+  streamer->Update();
+  return streamer->GetOutput();
+}
+
+// Slice numbers and sampling deviations of the dictionaries of the slices
+std::vector<std::string>
+GetSliceDescriptions(const ReaderType * reader)
+{
+  std::vector<std::string> descriptions;
+  for (const itk::MetaDataDictionary * dictionary : *reader->GetMetaDataDictionaryArray())
+  {
+    std::string sliceNumber;
+    double      samplingDeviation = 0.0;
+    itk::ExposeMetaData<std::string>(*dictionary, "SliceNumber", sliceNumber);
+    itk::ExposeMetaData<double>(*dictionary, "ITK_non_uniform_sampling_deviation", samplingDeviation);
+    descriptions.push_back(sliceNumber + ' ' + std::to_string(samplingDeviation));
+  }
+  return descriptions;
+}
+} // namespace
+
+int
+itkImageSeriesReaderParallelTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  // Slice 7 is missing, to check the non uniform sampling of the series
+  ReaderType::FileNamesContainer fileNames;
+  for (int i = 0; i < 12; ++i)
+  {
+    if (i != 7)
+    {
+      fileNames.push_back(outputDirectory + "/itkImageSeriesReaderParallelTest" + std::to_string(i) + ".mha");
+      WriteSlice(fileNames.back(), i);
+    }
+  }
+
+  // Several slices are read concurrently, even on a single core
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(4);
+
+  auto serialReader = ReaderType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(serialReader, ImageSeriesReader, ImageSource);
+  ITK_TEST_SET_GET_BOOLEAN(serialReader, UseParallelReading, false);
+  serialReader->SetFileNames(fileNames);
+  ImageType::Pointer expectedImage;
+  ITK_TRY_EXPECT_NO_EXCEPTION(expectedImage = ReadSeries(serialReader, false));
+  const std::vector<std::string> expectedDescriptions = GetSliceDescriptions(serialReader);
+  ITK_TEST_EXPECT_EQUAL(expectedDescriptions.size(), fileNames.size());
+  ITK_TEST_EXPECT_EQUAL(expectedDescriptions[7], "8 2.250000");
+
+  for (const bool reverseOrder : { false, true })
+  {
+    for (const bool useImageIO : { false, true })
+    {
+      for (const bool useStreaming : { false, true })
+      {
+        std::cout << "ReverseOrder " << reverseOrder << ", ImageIO " << useImageIO << ", streaming " << useStreaming
+                  << std::endl;
+        serialReader = ReaderType::New();
+        auto parallelReader = ReaderType::New();
+        for (ReaderType * reader : { serialReader.GetPointer(), parallelReader.GetPointer() })
+        {
+          reader->SetFileNames(fileNames);
+          reader->SetReverseOrder(reverseOrder);
+          if (useImageIO)
+          {
+            reader->SetImageIO(itk::MetaImageIO::New());
+          }
+        }
+        parallelReader->UseParallelReadingOn();
+
+        ITK_TRY_EXPECT_NO_EXCEPTION(expectedImage = ReadSeries(serialReader, useStreaming));
+        ImageType::Pointer image;
+        ITK_TRY_EXPECT_NO_EXCEPTION(image = ReadSeries(parallelReader, useStreaming));
+
+        ITK_TEST_EXPECT_EQUAL(image->GetBufferedRegion(), expectedImage->GetBufferedRegion());
+        ITK_TEST_EXPECT_TRUE(std::equal(image->GetBufferPointer(),
+                                        image->GetBufferPointer() + image->GetBufferedRegion().GetNumberOfPixels(),
+                                        expectedImage->GetBufferPointer()));
+        ITK_TEST_EXPECT_TRUE(GetSliceDescriptions(parallelReader) == GetSliceDescriptions(serialReader));
+        double                          maxSamplingDeviation = 0.0;
+        const itk::MetaDataDictionary & dictionary = parallelReader->GetOutput()->GetMetaDataDictionary();
+        ITK_TEST_EXPECT_TRUE(
+          itk::ExposeMetaData<double>(dictionary, "ITK_non_uniform_sampling_deviation", maxSamplingDeviation));
+      }
+    }
+  }
+
+  // The error of a slice is reported after the others are read
+  fileNames[4] = outputDirectory + "/itkImageSeriesReaderParallelTestMissingSlice.mha";
+  auto parallelReader = ReaderType::New();
+  parallelReader->SetFileNames(fileNames);
+  parallelReader->UseParallelReadingOn();
+  ITK_TRY_EXPECT_EXCEPTION(parallelReader->Update());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,177 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkParallelDeflateCodec.h"
+#include "itkMultiThreaderBase.h"
+#include "itkTestingMacros.h"
+#include "itk_zlib.h"
+
+#include <algorithm>
+
+namespace
+{
+using ByteVector = std::vector<unsigned char>;
+
+// Compressible data: slowly varying values with some noise
+ByteVector
+CreateData(itk::SizeValueType numberOfBytes)
+{
+  ByteVector   data(numberOfBytes);
+  unsigned int state = 12345;
+  for (itk::SizeValueType i = 0; i < numberOfBytes; ++i)
+  {
+    state = 1103515245 * state + 12345;
+    data[i] = static_cast<unsigned char>(i / 1000 + ((state >> 16) & 0x03));
+  }
+  return data;
+}
+
+// Decompresses with zlib itself, as any reader of the streams would
+ByteVector
+InflateWithZlib(const ByteVector & compressedData, itk::SizeValueType numberOfBytes, int windowBits)
+{
+  ByteVector data(numberOfBytes);
+  z_stream   stream{};
+  inflateInit2(&stream, windowBits);
+  stream.next_in = const_cast<Bytef *>(compressedData.data());
+  stream.avail_in = static_cast<uInt>(compressedData.size());
+  stream.next_out = data.data();
+  stream.avail_out = static_cast<uInt>(data.size());
+  const int status = inflate(&stream, Z_FINISH);
+  inflateEnd(&stream);
+  if (status != Z_STREAM_END || stream.avail_out != 0)
+  {
+    data.clear();
+  }
+  return data;
+}
+
+ByteVector
+Decompress(const ByteVector & compressedData, itk::SizeValueType numberOfBytes)
+{
+  ByteVector data(numberOfBytes);
+  itk::ParallelDeflateCodec::Decompress(compressedData.data(), compressedData.size(), data.data(), numberOfBytes);
+  return data;
+}
+} // namespace
+
+int
+itkParallelDeflateCodecTest(int, char *[])
+{
+  using FormatEnum = itk::ParallelDeflateCodec::FormatEnum;
+
+  for (const auto format : { FormatEnum::Zlib, FormatEnum::Gzip })
+  {
+    std::cout << "STREAMED ENUM VALUE ParallelDeflateCodecEnums::Format: " << format << std::endl;
+  }
+
+  // Several parts are inflated concurrently, even on a single core
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(8);
+
+  const ByteVector         data = CreateData(itk::SizeValueType{ 5 } << 20);
+  const itk::SizeValueType smallBlockSize = 100000;
+  ByteVector               compressedData;
+  ByteVector               decompressedData;
+
+  for (const auto format : { FormatEnum::Zlib, FormatEnum::Gzip })
+  {
+    const int windowBits = format == FormatEnum::Gzip ? MAX_WBITS + 16 : MAX_WBITS;
+    for (const int compressionLevel : { Z_DEFAULT_COMPRESSION, 0, 1, 9 })
+    {
+      for (const itk::SizeValueType blockSize : { itk::ParallelDeflateCodec::DefaultBlockSize, smallBlockSize })
+      {
+        std::cout << format << ", level " << compressionLevel << ", blocks of " << blockSize << " bytes" << std::endl;
+        ITK_TRY_EXPECT_NO_EXCEPTION(
+          compressedData =
+            itk::ParallelDeflateCodec::Compress(data.data(), data.size(), compressionLevel, format, blockSize));
+        if (compressionLevel != 0)
+        {
+          ITK_TEST_EXPECT_TRUE(compressedData.size() < data.size() / 2 || compressionLevel == 1);
+        }
+
+        // A single standard stream
+        ITK_TEST_EXPECT_TRUE(InflateWithZlib(compressedData, data.size(), windowBits) == data);
+
+        ITK_TRY_EXPECT_NO_EXCEPTION(decompressedData = Decompress(compressedData, data.size()));
+        ITK_TEST_EXPECT_TRUE(decompressedData == data);
+      }
+    }
+  }
+
+  // A stream compressed serially by zlib
+  uLongf serialSize = compressBound(static_cast<uLong>(data.size()));
+  compressedData.resize(serialSize);
+  compress2(compressedData.data(), &serialSize, data.data(), static_cast<uLong>(data.size()), Z_DEFAULT_COMPRESSION);
+  compressedData.resize(serialSize);
+  ITK_TRY_EXPECT_NO_EXCEPTION(decompressedData = Decompress(compressedData, data.size()));
+  ITK_TEST_EXPECT_TRUE(decompressedData == data);
+
+  // Blocks decompressed independently of each other
+  std::vector<itk::SizeValueType> blockOffsets;
+  compressedData = itk::ParallelDeflateCodec::Compress(
+    data.data(), data.size(), Z_DEFAULT_COMPRESSION, FormatEnum::Zlib, smallBlockSize, blockOffsets);
+  const itk::SizeValueType numberOfBlocks = (data.size() + smallBlockSize - 1) / smallBlockSize;
+  ITK_TEST_EXPECT_EQUAL(blockOffsets.size(), numberOfBlocks);
+  ITK_TEST_EXPECT_EQUAL(blockOffsets.front(), 2);
+  blockOffsets.push_back(compressedData.size() - 4);
+  for (const itk::SizeValueType block : { itk::SizeValueType{ 0 }, numberOfBlocks / 2, numberOfBlocks - 1 })
+  {
+    const itk::SizeValueType    begin = block * smallBlockSize;
+    const itk::SizeValueType    size = std::min(smallBlockSize, data.size() - begin);
+    const unsigned char * const compressedBlock = compressedData.data() + blockOffsets[block];
+    const itk::SizeValueType    compressedBlockSize = blockOffsets[block + 1] - blockOffsets[block];
+    ByteVector                  blockData(size);
+    ITK_TRY_EXPECT_NO_EXCEPTION(
+      itk::ParallelDeflateCodec::DecompressBlock(compressedBlock, compressedBlockSize, blockData.data(), size));
+    ITK_TEST_EXPECT_TRUE(std::equal(blockData.cbegin(), blockData.cend(), data.cbegin() + begin));
+    // Including a part of the next block, or decompressed into another size
+    ITK_TRY_EXPECT_EXCEPTION(
+      itk::ParallelDeflateCodec::DecompressBlock(compressedBlock, compressedBlockSize + 1, blockData.data(), size));
+    ITK_TRY_EXPECT_EXCEPTION(
+      itk::ParallelDeflateCodec::DecompressBlock(compressedBlock, compressedBlockSize, blockData.data(), size - 1));
+  }
+
+  // Empty data
+  for (const auto format : { FormatEnum::Zlib, FormatEnum::Gzip })
+  {
+    ITK_TRY_EXPECT_NO_EXCEPTION(compressedData = itk::ParallelDeflateCodec::Compress(nullptr, 0, 6, format));
+    ITK_TRY_EXPECT_NO_EXCEPTION(Decompress(compressedData, 0));
+  }
+
+  ITK_TRY_EXPECT_EXCEPTION(itk::ParallelDeflateCodec::Compress(data.data(), data.size(), 10, FormatEnum::Zlib));
+
+  compressedData = itk::ParallelDeflateCodec::Compress(data.data(), data.size(), 6, FormatEnum::Gzip, smallBlockSize);
+  // Data of another size
+  ITK_TRY_EXPECT_EXCEPTION(Decompress(compressedData, data.size() - 1));
+  ITK_TRY_EXPECT_EXCEPTION(Decompress(compressedData, data.size() + 1));
+  // Truncated stream
+  ITK_TRY_EXPECT_EXCEPTION(
+    Decompress(ByteVector(compressedData.cbegin(), compressedData.cbegin() + compressedData.size() / 2), data.size()));
+  // Corrupted stream and checksum
+  ByteVector corruptedData = compressedData;
+  corruptedData[corruptedData.size() / 2] ^= 0x01;
+  ITK_TRY_EXPECT_EXCEPTION(Decompress(corruptedData, data.size()));
+  corruptedData = compressedData;
+  corruptedData[corruptedData.size() - 6] ^= 0x01;
+  ITK_TRY_EXPECT_EXCEPTION(Decompress(corruptedData, data.size()));
+  // No zlib nor gzip header
+  ITK_TRY_EXPECT_EXCEPTION(Decompress(ByteVector(data.cbegin(), data.cbegin() + 1000), data.size()));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -312,6 +312,7 @@ JPEGImageIO::JPEGImageIO()
     this->AddSupportedWriteExtension(ext);
     this->AddSupportedReadExtension(ext);
   }
+  this->AddSupportedReadSignature("\xFF\xD8\xFF");
 }
 
 JPEGImageIO::~JPEGImageIO() = default;
@@ -31,6 +31,7 @@
 #include "itkQuadraticTriangleCell.h"
 #include "itkTetrahedronCell.h"
 #include "itkTriangleCell.h"
+#include "itkVectorContainer.h"
 #include "itkVertexCell.h"
 
 #include "itkDefaultConvertPixelTraits.h"
@@ -143,6 +144,16 @@ public:
   itkGetModifiableObjectMacro(MeshIO, MeshIOBase);
   /** @ITKEndGrouping */
 
+  /** Set/Get whether the cells are stored compactly in the output mesh, as
+   * flat arrays of cell types and point identifiers (see
+   * Mesh::SetCompactCells()), instead of one cell object per cell. This
+   * makes reading large meshes much faster and lighter. Off by default. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseCompactCells, bool);
+  itkGetConstMacro(UseCompactCells, bool);
+  itkBooleanMacro(UseCompactCells);
+  /** @ITKEndGrouping */
+
   /** Prepare the allocation of the output mesh during the first back
    * propagation of the pipeline. */
   void
@@ -193,6 +204,7 @@ protected:
   bool                m_UserSpecifiedMeshIO{}; // keep track whether the MeshIO is
                                                // user specified
   std::string m_FileName{};                    // The file to be read
+  bool        m_UseCompactCells{ false };
 
 private:
   template <typename T>
@@ -203,6 +215,31 @@ private:
   void
   ReadCellsUsingMeshIO();
 
+  /** Checks that a cell of the buffer has a valid number of points for its
+   * type, and returns the type of the output cell, which is a triangle for a
+   * polygon of three points. */
+  CellGeometryEnum
+  CheckCellType(CellGeometryEnum type, unsigned int numberOfPoints) const;
+
+  /** Appends the cells of the buffer to a compact cells container. */
+  template <typename T>
+  void
+  ReadCompactCells(T * buffer);
+
+  /** Whether the points and the point and cell data of the output mesh are
+   * stored contiguously, so that the MeshIO reads them in place. */
+  static constexpr bool PointsAreContiguous =
+    std::is_same_v<typename OutputMeshType::PointsContainer, VectorContainer<OutputPointIdentifier, OutputPointType>> &&
+    sizeof(OutputPointType) == OutputPointDimension * sizeof(OutputCoordinateType);
+  static constexpr bool PointDataAreContiguous =
+    std::is_same_v<typename OutputMeshType::PointDataContainer,
+                   VectorContainer<OutputPointIdentifier, OutputPointPixelType>> &&
+    std::is_trivially_copyable_v<OutputPointPixelType>;
+  static constexpr bool CellDataAreContiguous =
+    std::is_same_v<typename OutputMeshType::CellDataContainer,
+                   VectorContainer<OutputCellIdentifier, OutputCellPixelType>> &&
+    std::is_trivially_copyable_v<OutputCellPixelType>;
+
   std::string m_ExceptionMessage{};
 };
 
@@ -50,6 +50,7 @@ MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::Pr
 
   os << indent << "UserSpecifiedMeshIO flag: " << m_UserSpecifiedMeshIO << '\n';
   os << indent << "FileName: " << m_FileName << '\n';
+  os << indent << "UseCompactCells: " << (m_UseCompactCells ? "On" : "Off") << '\n';
 }
 
 template <typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits>
@@ -100,18 +101,17 @@ template <typename T>
 void
 MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::ReadPoints(T * buffer)
 {
-  const typename TOutputMesh::Pointer output = this->GetOutput();
-  output->GetPoints()->Reserve(m_MeshIO->GetNumberOfPoints());
-  OutputPointType point;
+  // The points are allocated at once, and converted in place
+  typename OutputMeshType::PointsContainer * points = this->GetOutput()->GetPoints();
+  points->Reserve(m_MeshIO->GetNumberOfPoints());
 
-  for (OutputPointIdentifier id = 0; id < output->GetNumberOfPoints(); ++id)
+  for (OutputPointIdentifier id = 0; id < points->Size(); ++id)
   {
+    OutputPointType & point = points->ElementAt(id);
     for (OutputPointIdentifier ii = 0; ii < OutputPointDimension; ++ii)
     {
       point[ii] = static_cast<typename OutputPointType::ValueType>(buffer[id * OutputPointDimension + ii]);
     }
-
-    output->SetPoint(id, point);
   }
 }
 
@@ -121,213 +121,131 @@ void
 MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::ReadCells(T * buffer)
 {
   const typename TOutputMesh::Pointer output = this->GetOutput();
+  if constexpr (std::is_same_v<typename OutputMeshType::CellsContainer,
+                               VectorContainer<OutputCellIdentifier, OutputCellType *>>)
+  {
+    if (!output->GetCells())
+    {
+      output->SetCells(OutputMeshType::CellsContainer::New());
+    }
+    output->GetCells()->reserve(m_MeshIO->GetNumberOfCells());
+  }
 
   SizeValueType        index{};
   OutputCellIdentifier id{};
   while (index < m_MeshIO->GetCellBufferSize())
   {
-    auto type = static_cast<CellGeometryEnum>(static_cast<int>(buffer[index++]));
+    auto       type = static_cast<CellGeometryEnum>(static_cast<int>(buffer[index++]));
+    const auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
+    type = this->CheckCellType(type, numberOfPoints);
+
+    OutputCellAutoPointer cell;
     switch (type)
     {
       case CellGeometryEnum::VERTEX_CELL:
       {
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints != OutputVertexCellType::NumberOfPoints)
-        {
-          itkExceptionMacro("Invalid Vertex Cell with number of points = " << numberOfPoints);
-        }
-        OutputCellAutoPointer cell;
-        auto *                vertexCell = new OutputVertexCellType;
+        auto * vertexCell = new OutputVertexCellType;
         for (unsigned int jj = 0; jj < OutputVertexCellType::NumberOfPoints; ++jj)
         {
           vertexCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
         }
-
         cell.TakeOwnership(vertexCell);
-        output->SetCell(id++, cell);
         break;
       }
       case CellGeometryEnum::LINE_CELL:
       {
         // for polylines will be loaded as individual edges.
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints < 2)
-        {
-          itkExceptionMacro("Invalid Line Cell with number of points = " << numberOfPoints);
-        }
         auto pointIDBuffer = static_cast<OutputPointIdentifier>(buffer[index++]);
         for (unsigned int jj = 1; jj < numberOfPoints; ++jj)
         {
-          OutputCellAutoPointer cell;
+          OutputCellAutoPointer lineCellPointer;
           auto *                lineCell = new OutputLineCellType;
           lineCell->SetPointId(0, pointIDBuffer);
           pointIDBuffer = static_cast<OutputPointIdentifier>(buffer[index++]);
           lineCell->SetPointId(1, pointIDBuffer);
-          cell.TakeOwnership(lineCell);
-          output->SetCell(id++, cell);
+          lineCellPointer.TakeOwnership(lineCell);
+          output->SetCell(id++, lineCellPointer);
         }
-        break;
+        continue;
       }
       case CellGeometryEnum::POLYLINE_CELL:
       {
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints < 2)
-        {
-          itkExceptionMacro("Invalid Line Cell with number of points = " << numberOfPoints);
-        }
-        auto *                polyLineCell = new OutputPolyLineCellType;
-        OutputCellAutoPointer cell;
-
+        auto * polyLineCell = new OutputPolyLineCellType;
         for (unsigned int jj = 0; jj < numberOfPoints; ++jj)
         {
-          auto pointIDBuffer = static_cast<OutputPointIdentifier>(buffer[index++]);
-          polyLineCell->SetPointId(jj, pointIDBuffer);
+          polyLineCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
         }
-
         cell.TakeOwnership(polyLineCell);
-        output->SetCell(id++, cell);
         break;
       }
       case CellGeometryEnum::TRIANGLE_CELL:
       {
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints != OutputTriangleCellType::NumberOfPoints)
-        {
-          itkExceptionMacro("Invalid Triangle Cell with number of points = " << numberOfPoints);
-        }
-
-        OutputCellAutoPointer cell;
-        auto *                triangleCell = new OutputTriangleCellType;
+        auto * triangleCell = new OutputTriangleCellType;
         for (unsigned int jj = 0; jj < OutputTriangleCellType::NumberOfPoints; ++jj)
         {
           triangleCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
         }
-
         cell.TakeOwnership(triangleCell);
-        output->SetCell(id++, cell);
         break;
       }
       case CellGeometryEnum::QUADRILATERAL_CELL:
       {
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints != OutputQuadrilateralCellType::NumberOfPoints)
-        {
-          itkExceptionMacro("Invalid Quadrilateral Cell with number of points = " << numberOfPoints);
-        }
-
-        OutputCellAutoPointer cell;
-        auto *                quadrilateralCell = new OutputQuadrilateralCellType;
+        auto * quadrilateralCell = new OutputQuadrilateralCellType;
         for (unsigned int jj = 0; jj < OutputQuadrilateralCellType::NumberOfPoints; ++jj)
         {
           quadrilateralCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
         }
-
         cell.TakeOwnership(quadrilateralCell);
-        output->SetCell(id++, cell);
         break;
       }
       case CellGeometryEnum::POLYGON_CELL:
       {
-        // For polyhedron, if the number of points is 3, then we treat it as
-        // triangle cell
-        OutputCellAutoPointer cell;
-        auto                  numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints == OutputTriangleCellType::NumberOfPoints)
-        {
-          auto * triangleCell = new OutputTriangleCellType;
-          for (unsigned int jj = 0; jj < OutputTriangleCellType::NumberOfPoints; ++jj)
-          {
-            triangleCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
-          }
-          cell.TakeOwnership(triangleCell);
-        }
-        else
+        auto * polygonCell = new OutputPolygonCellType;
+        for (unsigned int jj = 0; jj < numberOfPoints; ++jj)
         {
-          auto * polygonCell = new OutputPolygonCellType;
-          for (unsigned int jj = 0; jj < numberOfPoints; ++jj)
-          {
-            polygonCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
-          }
-          cell.TakeOwnership(polygonCell);
+          polygonCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
         }
-
-        output->SetCell(id++, cell);
+        cell.TakeOwnership(polygonCell);
         break;
       }
       case CellGeometryEnum::TETRAHEDRON_CELL:
       {
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints != OutputTetrahedronCellType::NumberOfPoints)
-        {
-          itkExceptionMacro("Invalid Tetrahedron Cell with number of points = " << numberOfPoints);
-        }
-
-        OutputCellAutoPointer cell;
-        auto *                tetrahedronCell = new OutputTetrahedronCellType;
+        auto * tetrahedronCell = new OutputTetrahedronCellType;
         for (unsigned int jj = 0; jj < OutputTetrahedronCellType::NumberOfPoints; ++jj)
         {
           tetrahedronCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
         }
-
         cell.TakeOwnership(tetrahedronCell);
-        output->SetCell(id++, cell);
         break;
       }
       case CellGeometryEnum::HEXAHEDRON_CELL:
       {
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints != OutputHexahedronCellType::NumberOfPoints)
-        {
-          itkExceptionMacro("Invalid Hexahedron Cell with number of points = " << numberOfPoints);
-        }
-
-        OutputCellAutoPointer cell;
-        auto *                hexahedronCell = new OutputHexahedronCellType;
+        auto * hexahedronCell = new OutputHexahedronCellType;
         for (unsigned int jj = 0; jj < OutputHexahedronCellType::NumberOfPoints; ++jj)
         {
           hexahedronCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
         }
-
         cell.TakeOwnership(hexahedronCell);
-        output->SetCell(id++, cell);
         break;
       }
       case CellGeometryEnum::QUADRATIC_EDGE_CELL:
       {
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints != OutputQuadraticEdgeCellType::NumberOfPoints)
-        {
-          itkExceptionMacro("Invalid Quadratic edge Cell with number of points = " << numberOfPoints);
-        }
-
-        OutputCellAutoPointer cell;
-        auto *                quadraticEdgeCell = new OutputQuadraticEdgeCellType;
+        auto * quadraticEdgeCell = new OutputQuadraticEdgeCellType;
         for (unsigned int jj = 0; jj < OutputQuadraticEdgeCellType::NumberOfPoints; ++jj)
         {
           quadraticEdgeCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
         }
-
         cell.TakeOwnership(quadraticEdgeCell);
-        output->SetCell(id++, cell);
         break;
       }
       case CellGeometryEnum::QUADRATIC_TRIANGLE_CELL:
       {
-        auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
-        if (numberOfPoints != OutputQuadraticTriangleCellType::NumberOfPoints)
-        {
-          itkExceptionMacro("Invalid Quadratic triangle Cell with number of points = " << numberOfPoints);
-        }
-
-        OutputCellAutoPointer cell;
-        auto *                quadraticTriangleCell = new OutputQuadraticTriangleCellType;
+        auto * quadraticTriangleCell = new OutputQuadraticTriangleCellType;
         for (unsigned int jj = 0; jj < OutputQuadraticTriangleCellType::NumberOfPoints; ++jj)
         {
           quadraticTriangleCell->SetPointId(jj, static_cast<OutputPointIdentifier>(buffer[index++]));
         }
-
         cell.TakeOwnership(quadraticTriangleCell);
-        output->SetCell(id++, cell);
         break;
       }
       default:
@@ -335,7 +253,71 @@ MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::Re
         itkExceptionStringMacro("Unknown cell type");
       }
     }
+    output->SetCell(id++, cell);
+  }
+}
+
+template <typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits>
+CellGeometryEnum
+MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::CheckCellType(
+  CellGeometryEnum type,
+  unsigned int     numberOfPoints) const
+{
+  unsigned int expectedNumberOfPoints = numberOfPoints;
+  const char * cellName = "";
+  switch (type)
+  {
+    case CellGeometryEnum::VERTEX_CELL:
+      expectedNumberOfPoints = OutputVertexCellType::NumberOfPoints;
+      cellName = "Vertex";
+      break;
+    case CellGeometryEnum::LINE_CELL:
+    case CellGeometryEnum::POLYLINE_CELL:
+      if (numberOfPoints < 2)
+      {
+        itkExceptionMacro("Invalid Line Cell with number of points = " << numberOfPoints);
+      }
+      break;
+    case CellGeometryEnum::TRIANGLE_CELL:
+      expectedNumberOfPoints = OutputTriangleCellType::NumberOfPoints;
+      cellName = "Triangle";
+      break;
+    case CellGeometryEnum::QUADRILATERAL_CELL:
+      expectedNumberOfPoints = OutputQuadrilateralCellType::NumberOfPoints;
+      cellName = "Quadrilateral";
+      break;
+    case CellGeometryEnum::POLYGON_CELL:
+      // For polyhedron, if the number of points is 3, then we treat it as
+      // triangle cell
+      if (numberOfPoints == OutputTriangleCellType::NumberOfPoints)
+      {
+        return CellGeometryEnum::TRIANGLE_CELL;
+      }
+      break;
+    case CellGeometryEnum::TETRAHEDRON_CELL:
+      expectedNumberOfPoints = OutputTetrahedronCellType::NumberOfPoints;
+      cellName = "Tetrahedron";
+      break;
+    case CellGeometryEnum::HEXAHEDRON_CELL:
+      expectedNumberOfPoints = OutputHexahedronCellType::NumberOfPoints;
+      cellName = "Hexahedron";
+      break;
+    case CellGeometryEnum::QUADRATIC_EDGE_CELL:
+      expectedNumberOfPoints = OutputQuadraticEdgeCellType::NumberOfPoints;
+      cellName = "Quadratic edge";
+      break;
+    case CellGeometryEnum::QUADRATIC_TRIANGLE_CELL:
+      expectedNumberOfPoints = OutputQuadraticTriangleCellType::NumberOfPoints;
+      cellName = "Quadratic triangle";
+      break;
+    default:
+      itkExceptionStringMacro("Unknown cell type");
   }
+  if (numberOfPoints != expectedNumberOfPoints)
+  {
+    itkExceptionMacro("Invalid " << cellName << " Cell with number of points = " << numberOfPoints);
+  }
+  return type;
 }
 
 template <typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits>
@@ -344,12 +326,28 @@ MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::Re
 {
   const typename TOutputMesh::Pointer output = this->GetOutput();
 
+  const bool requiresConversion =
+    (m_MeshIO->GetPointPixelComponentType() !=
+     MeshIOBase::MapComponentType<typename ConvertPointPixelTraits::ComponentType>::CType) ||
+    (m_MeshIO->GetNumberOfPointPixelComponents() != ConvertPointPixelTraits::GetNumberOfComponents());
+
+  if constexpr (PointDataAreContiguous)
+  {
+    if (!requiresConversion)
+    {
+      // The MeshIO reads the point data straight into the point data container
+      itkDebugMacro("No buffer conversion required.");
+      auto & pointData = output->GetPointData()->CastToSTLContainer();
+      pointData.resize(m_MeshIO->GetNumberOfPointPixels());
+      m_MeshIO->ReadPointData(static_cast<void *>(pointData.data()));
+      return;
+    }
+  }
+
   const auto outputPointDataBuffer =
     make_unique_for_overwrite<OutputPointPixelType[]>(m_MeshIO->GetNumberOfPointPixels());
 
-  if ((m_MeshIO->GetPointPixelComponentType() !=
-       MeshIOBase::MapComponentType<typename ConvertPointPixelTraits::ComponentType>::CType) ||
-      (m_MeshIO->GetNumberOfPointPixelComponents() != ConvertPointPixelTraits::GetNumberOfComponents()))
+  if (requiresConversion)
   {
     // the point pixel types don't match a type conversion needs to be
     // performed
@@ -386,11 +384,27 @@ MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::Re
 {
   const typename TOutputMesh::Pointer output = this->GetOutput();
 
+  const bool requiresConversion =
+    (m_MeshIO->GetCellPixelComponentType() !=
+     MeshIOBase::MapComponentType<typename ConvertCellPixelTraits::ComponentType>::CType) ||
+    (m_MeshIO->GetNumberOfCellPixelComponents() != ConvertCellPixelTraits::GetNumberOfComponents());
+
+  if constexpr (CellDataAreContiguous)
+  {
+    if (!requiresConversion)
+    {
+      // The MeshIO reads the cell data straight into the cell data container
+      itkDebugMacro("No buffer conversion required.");
+      auto & cellData = output->GetCellData()->CastToSTLContainer();
+      cellData.resize(m_MeshIO->GetNumberOfCellPixels());
+      m_MeshIO->ReadCellData(static_cast<void *>(cellData.data()));
+      return;
+    }
+  }
+
   const auto outputCellDataBuffer = make_unique_for_overwrite<OutputCellPixelType[]>(m_MeshIO->GetNumberOfCellPixels());
 
-  if ((m_MeshIO->GetCellPixelComponentType() !=
-       MeshIOBase::MapComponentType<typename ConvertCellPixelTraits::ComponentType>::CType) ||
-      (m_MeshIO->GetNumberOfCellPixelComponents() != ConvertCellPixelTraits::GetNumberOfComponents()))
+  if (requiresConversion)
   {
     // the cell pixel types don't match a type conversion needs to be
     // performed
@@ -829,9 +843,19 @@ template <typename T>
 void
 MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::ReadPointsUsingMeshIO()
 {
-  const auto buffer = make_unique_for_overwrite<T[]>(m_MeshIO->GetNumberOfPoints() * OutputPointDimension);
-  m_MeshIO->ReadPoints(buffer.get());
-  Self::ReadPoints(buffer.get());
+  if constexpr (PointsAreContiguous && std::is_same_v<T, OutputCoordinateType>)
+  {
+    // The MeshIO reads the coordinates straight into the points container
+    auto & points = this->GetOutput()->GetPoints()->CastToSTLContainer();
+    points.resize(m_MeshIO->GetNumberOfPoints());
+    m_MeshIO->ReadPoints(static_cast<void *>(points.data()));
+  }
+  else
+  {
+    const auto buffer = make_unique_for_overwrite<T[]>(m_MeshIO->GetNumberOfPoints() * OutputPointDimension);
+    m_MeshIO->ReadPoints(buffer.get());
+    Self::ReadPoints(buffer.get());
+  }
 }
 
 
@@ -842,7 +866,69 @@ MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::Re
 {
   const auto buffer = make_unique_for_overwrite<T[]>(m_MeshIO->GetCellBufferSize());
   m_MeshIO->ReadCells(buffer.get());
-  Self::ReadCells(buffer.get());
+  if (m_UseCompactCells)
+  {
+    Self::ReadCompactCells(buffer.get());
+  }
+  else
+  {
+    Self::ReadCells(buffer.get());
+  }
+}
+
+template <typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits>
+template <typename T>
+void
+MeshFileReader<TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits>::ReadCompactCells(T * buffer)
+{
+  const SizeValueType numberOfCells = m_MeshIO->GetNumberOfCells();
+  const SizeValueType cellBufferSize = m_MeshIO->GetCellBufferSize();
+
+  // Each cell takes its type, its number of points and its point identifiers
+  if (cellBufferSize / 2 < numberOfCells)
+  {
+    itkExceptionMacro("Invalid cell buffer size = " << cellBufferSize << " for number of cells = " << numberOfCells);
+  }
+  auto cells = OutputMeshType::CompactCellsContainer::New();
+  cells->Reserve(numberOfCells, cellBufferSize - 2 * numberOfCells);
+
+  std::vector<OutputPointIdentifier> pointIds;
+  SizeValueType                      index{};
+  while (index < cellBufferSize)
+  {
+    if (cellBufferSize - index < 2)
+    {
+      itkExceptionMacro("Truncated cell at index = " << index << " of the cell buffer");
+    }
+    auto       type = static_cast<CellGeometryEnum>(static_cast<int>(buffer[index++]));
+    const auto numberOfPoints = static_cast<unsigned int>(buffer[index++]);
+    if (numberOfPoints > cellBufferSize - index)
+    {
+      itkExceptionMacro("Invalid number of points = " << numberOfPoints << " at index = " << index - 1
+                                                      << " of the cell buffer");
+    }
+    type = this->CheckCellType(type, numberOfPoints);
+    pointIds.resize(numberOfPoints);
+    for (unsigned int jj = 0; jj < numberOfPoints; ++jj)
+    {
+      pointIds[jj] = static_cast<OutputPointIdentifier>(buffer[index++]);
+    }
+
+    if (type == CellGeometryEnum::LINE_CELL)
+    {
+      // for polylines will be loaded as individual edges.
+      for (unsigned int jj = 1; jj < numberOfPoints; ++jj)
+      {
+        cells->InsertCell(type, &pointIds[jj - 1], OutputLineCellType::NumberOfPoints);
+      }
+    }
+    else
+    {
+      cells->InsertCell(type, pointIds.data(), numberOfPoints);
+    }
+  }
+
+  this->GetOutput()->SetCompactCells(cells);
 }
 
 
@@ -21,6 +21,7 @@
 #include "itkMeshFileWriterException.h"
 #include "itkProcessObject.h"
 #include "itkMeshIOBase.h"
+#include "itkVectorContainer.h"
 
 namespace itk
 {
@@ -179,6 +180,13 @@ protected:
   WriteCellData();
 
 private:
+  /** Returns the storage of the container, when its elements are stored
+   * contiguously as numberOfComponents values of type TValue, so that the
+   * MeshIO writes them in place, and nullptr otherwise. */
+  template <typename TValue, typename TContainer>
+  static void *
+  GetContiguousBuffer(const TContainer * container, unsigned int numberOfComponents);
+
   std::string         m_FileName{};
   MeshIOBase::Pointer m_MeshIO{ nullptr };
   bool                m_UserSpecifiedMeshIO{ false };    // track whether the MeshIO is user specified
@@ -158,14 +158,21 @@ MeshFileWriter<TInputMesh>::Write()
   }
 
   // Whether write cells
-  if (input->GetCells() && input->GetNumberOfCells())
+  if (input->GetNumberOfCells())
   {
     SizeValueType cellsBufferSize = 2 * input->GetNumberOfCells();
-    for (typename TInputMesh::CellsContainerConstIterator ct = input->GetCells()->Begin();
-         ct != input->GetCells()->End();
-         ++ct)
+    if (const auto * compactCells = input->GetCompactCells())
     {
-      cellsBufferSize += ct->Value()->GetNumberOfPoints();
+      cellsBufferSize += compactCells->GetConnectivity().size();
+    }
+    else
+    {
+      for (typename TInputMesh::CellsContainerConstIterator ct = input->GetCells()->Begin();
+           ct != input->GetCells()->End();
+           ++ct)
+      {
+        cellsBufferSize += ct->Value()->GetNumberOfPoints();
+      }
     }
     m_MeshIO->SetCellBufferSize(cellsBufferSize);
     m_MeshIO->SetUpdateCells(true);
@@ -205,7 +212,7 @@ MeshFileWriter<TInputMesh>::Write()
   }
 
   // Write cells
-  if (input->GetCells() && input->GetNumberOfCells())
+  if (input->GetNumberOfCells())
   {
     WriteCells();
   }
@@ -239,9 +246,14 @@ MeshFileWriter<TInputMesh>::WritePoints()
   const InputMeshType * input = this->GetInput();
 
   itkDebugMacro("Writing points: " << m_FileName);
-  const SizeValueType pointsBufferSize = input->GetNumberOfPoints() * TInputMesh::PointDimension;
   using ValueType = typename TInputMesh::PointType::ValueType;
-  const auto buffer = make_unique_for_overwrite<ValueType[]>(pointsBufferSize);
+  if (void * const points = GetContiguousBuffer<ValueType>(input->GetPoints(), TInputMesh::PointDimension))
+  {
+    m_MeshIO->WritePoints(points);
+    return;
+  }
+  const SizeValueType pointsBufferSize = input->GetNumberOfPoints() * TInputMesh::PointDimension;
+  const auto          buffer = make_unique_for_overwrite<ValueType[]>(pointsBufferSize);
   CopyPointsToBuffer(buffer.get());
   m_MeshIO->WritePoints(buffer.get());
 }
@@ -269,11 +281,17 @@ MeshFileWriter<TInputMesh>::WritePointData()
 
   if (input->GetPointData()->Size())
   {
-    const SizeValueType numberOfComponents =
-      input->GetPointData()->Size() * MeshConvertPixelTraits<typename TInputMesh::PixelType>::GetNumberOfComponents(
-                                        input->GetPointData()->Begin().Value());
+    const unsigned int numberOfPixelComponents =
+      MeshConvertPixelTraits<typename TInputMesh::PixelType>::GetNumberOfComponents(
+        input->GetPointData()->Begin().Value());
+    const SizeValueType numberOfComponents = input->GetPointData()->Size() * numberOfPixelComponents;
 
     using ValueType = typename itk::NumericTraits<typename TInputMesh::PixelType>::ValueType;
+    if (void * const pointData = GetContiguousBuffer<ValueType>(input->GetPointData(), numberOfPixelComponents))
+    {
+      m_MeshIO->WritePointData(pointData);
+      return;
+    }
     const auto buffer = make_unique_for_overwrite<ValueType[]>(numberOfComponents);
     CopyPointDataToBuffer(buffer.get());
     m_MeshIO->WritePointData(buffer.get());
@@ -290,17 +308,41 @@ MeshFileWriter<TInputMesh>::WriteCellData()
 
   if (input->GetCellData()->Size())
   {
-    const SizeValueType numberOfComponents =
-      input->GetCellData()->Size() * MeshConvertPixelTraits<typename TInputMesh::CellPixelType>::GetNumberOfComponents(
-                                       input->GetCellData()->Begin().Value());
+    const unsigned int numberOfPixelComponents =
+      MeshConvertPixelTraits<typename TInputMesh::CellPixelType>::GetNumberOfComponents(
+        input->GetCellData()->Begin().Value());
+    const SizeValueType numberOfComponents = input->GetCellData()->Size() * numberOfPixelComponents;
 
     using ValueType = typename itk::NumericTraits<typename TInputMesh::CellPixelType>::ValueType;
+    if (void * const cellData = GetContiguousBuffer<ValueType>(input->GetCellData(), numberOfPixelComponents))
+    {
+      m_MeshIO->WriteCellData(cellData);
+      return;
+    }
     const auto buffer = make_unique_for_overwrite<ValueType[]>(numberOfComponents);
     CopyCellDataToBuffer(buffer.get());
     m_MeshIO->WriteCellData(buffer.get());
   }
 }
 
+template <typename TInputMesh>
+template <typename TValue, typename TContainer>
+void *
+MeshFileWriter<TInputMesh>::GetContiguousBuffer(const TContainer * container, unsigned int numberOfComponents)
+{
+  using ElementType = typename TContainer::Element;
+  if constexpr (std::is_same_v<TContainer, VectorContainer<typename TContainer::ElementIdentifier, ElementType>> &&
+                std::is_trivially_copyable_v<ElementType>)
+  {
+    if (sizeof(ElementType) == numberOfComponents * sizeof(TValue))
+    {
+      // the MeshIO only reads the buffer
+      return const_cast<ElementType *>(container->CastToSTLConstContainer().data());
+    }
+  }
+  return nullptr;
+}
+
 template <typename TInputMesh>
 template <typename Output>
 void
@@ -327,67 +369,37 @@ template <typename Output>
 void
 MeshFileWriter<TInputMesh>::CopyCellsToBuffer(Output * data)
 {
-  // Get input mesh pointer
-  const typename InputMeshType::CellsContainer * cells = this->GetInput()->GetCells();
-
-  // Define required variables
-
-  // For each cell
-  SizeValueType                                    index{};
-  typename TInputMesh::CellsContainerConstIterator cter = cells->Begin();
-  while (cter != cells->End())
-  {
-    typename TInputMesh::CellType * cellPtr = cter.Value();
-
-    // Write the cell type
-    switch (cellPtr->GetType())
-    {
-      case CellGeometryEnum::VERTEX_CELL:
-        data[index++] = static_cast<Output>(CellGeometryEnum::VERTEX_CELL);
-        break;
-      case CellGeometryEnum::LINE_CELL:
-        data[index++] = static_cast<Output>(CellGeometryEnum::LINE_CELL);
-        break;
-      case CellGeometryEnum::POLYLINE_CELL:
-        data[index++] = static_cast<Output>(CellGeometryEnum::POLYLINE_CELL);
-        break;
-      case CellGeometryEnum::TRIANGLE_CELL:
-        data[index++] = static_cast<Output>(CellGeometryEnum::TRIANGLE_CELL);
-        break;
-      case CellGeometryEnum::QUADRILATERAL_CELL:
-        data[index++] = static_cast<Output>(CellGeometryEnum::QUADRILATERAL_CELL);
-        break;
-      case CellGeometryEnum::POLYGON_CELL:
-        data[index++] = static_cast<Output>(CellGeometryEnum::POLYGON_CELL);
-        break;
-      case CellGeometryEnum::TETRAHEDRON_CELL:
-        data[index++] = static_cast<Output>(CellGeometryEnum::TETRAHEDRON_CELL);
-        break;
-      case CellGeometryEnum::HEXAHEDRON_CELL:
-        data[index++] = static_cast<Output>(CellGeometryEnum::HEXAHEDRON_CELL);
-        break;
-      case CellGeometryEnum::QUADRATIC_EDGE_CELL:
-        data[index++] = static_cast<Output>(CellGeometryEnum::QUADRATIC_EDGE_CELL);
-        break;
-      case CellGeometryEnum::QUADRATIC_TRIANGLE_CELL:
-        data[index++] = static_cast<Output>(CellGeometryEnum::QUADRATIC_TRIANGLE_CELL);
-        break;
-      default:
-        itkExceptionStringMacro("Unknown mesh cell");
-    }
-
-    // The second element is number of points for each cell
-    data[index++] = cellPtr->GetNumberOfPoints();
-    // Others are point identifiers in the cell
-    const typename TInputMesh::PointIdentifier * ptIds = cellPtr->GetPointIds();
-    const unsigned int                           numberOfPoints = cellPtr->GetNumberOfPoints();
-    for (unsigned int ii = 0; ii < numberOfPoints; ++ii)
-    {
-      data[index++] = static_cast<Output>(ptIds[ii]);
-    }
+  // For each cell, whether stored as a cell object or compactly
+  SizeValueType index{};
+  this->GetInput()->ForEachCell(
+    [this, data, &index](auto, CellGeometryEnum cellType, auto pointIdsBegin, auto pointIdsEnd) {
+      // Write the cell type
+      switch (cellType)
+      {
+        case CellGeometryEnum::VERTEX_CELL:
+        case CellGeometryEnum::LINE_CELL:
+        case CellGeometryEnum::POLYLINE_CELL:
+        case CellGeometryEnum::TRIANGLE_CELL:
+        case CellGeometryEnum::QUADRILATERAL_CELL:
+        case CellGeometryEnum::POLYGON_CELL:
+        case CellGeometryEnum::TETRAHEDRON_CELL:
+        case CellGeometryEnum::HEXAHEDRON_CELL:
+        case CellGeometryEnum::QUADRATIC_EDGE_CELL:
+        case CellGeometryEnum::QUADRATIC_TRIANGLE_CELL:
+          data[index++] = static_cast<Output>(cellType);
+          break;
+        default:
+          itkExceptionStringMacro("Unknown mesh cell");
+      }
 
-    ++cter;
-  }
+      // The second element is number of points for each cell
+      data[index++] = static_cast<Output>(pointIdsEnd - pointIdsBegin);
+      // Others are point identifiers in the cell
+      for (auto pointId = pointIdsBegin; pointId != pointIdsEnd; ++pointId)
+      {
+        data[index++] = static_cast<Output>(*pointId);
+      }
+    });
 }
 
 template <typename TInputMesh>
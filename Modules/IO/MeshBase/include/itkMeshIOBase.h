@@ -589,7 +589,8 @@ public:
   /*-------- This part of the interfaces deals with writing data ----- */
 
   /** Writes the data to disk from the memory buffer provided. Make sure
-   * that the IORegions has been set properly. */
+   * that the IORegions has been set properly. The buffer may be the
+   * storage of the mesh itself, so it must not be modified. */
   virtual bool
   CanWriteFile(const char *) = 0;
 
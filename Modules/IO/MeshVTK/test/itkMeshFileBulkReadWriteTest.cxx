@@ -0,0 +1,199 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkDefaultDynamicMeshTraits.h"
+#include "itkMesh.h"
+#include "itkMeshFileReader.h"
+#include "itkMeshFileWriter.h"
+#include "itkTestingMacros.h"
+#include "itkTriangleCell.h"
+
+#include <array>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+constexpr unsigned int GridSize = 20;
+
+using MeshType = itk::Mesh<float, Dimension>;
+
+// A grid of triangles, with data on its points and its cells
+MeshType::Pointer
+CreateMesh()
+{
+  auto mesh = MeshType::New();
+  for (unsigned int j = 0; j < GridSize; ++j)
+  {
+    for (unsigned int i = 0; i < GridSize; ++i)
+    {
+      const MeshType::PointIdentifier id = j * GridSize + i;
+      mesh->SetPoint(id, MeshType::PointType({ 0.5f * i, 0.25f * j, 0.125f * (i + j) }));
+      mesh->SetPointData(id, 2.0f * id);
+    }
+  }
+  MeshType::CellIdentifier cellId = 0;
+  for (unsigned int j = 0; j + 1 < GridSize; ++j)
+  {
+    for (unsigned int i = 0; i + 1 < GridSize; ++i)
+    {
+      const MeshType::PointIdentifier corner = j * GridSize + i;
+      for (const auto & pointIds : { std::array<MeshType::PointIdentifier, 3>{ corner, corner + 1, corner + GridSize },
+                                     std::array<MeshType::PointIdentifier, 3>{
+                                       corner + 1, corner + GridSize + 1, corner + GridSize } })
+      {
+        MeshType::CellAutoPointer cell;
+        cell.TakeOwnership(new itk::TriangleCell<MeshType::CellType>);
+        cell->SetPointIds(pointIds.data());
+        mesh->SetCell(cellId, cell);
+        mesh->SetCellData(cellId, -1.0f * cellId);
+        ++cellId;
+      }
+    }
+  }
+  return mesh;
+}
+
+// Reads the file as a mesh of type TMesh, and compares it with the written mesh
+template <typename TMesh>
+bool
+TestReading(const std::string & fileName, const MeshType * expectedMesh, bool useCompactCells = false)
+{
+  auto reader = itk::MeshFileReader<TMesh>::New();
+  reader->SetFileName(fileName);
+  reader->SetUseCompactCells(useCompactCells);
+  reader->Update();
+  const typename TMesh::Pointer mesh = reader->GetOutput();
+  if ((mesh->GetCompactCells() != nullptr) != useCompactCells)
+  {
+    std::cerr << "Wrong storage of the cells of " << fileName << std::endl;
+    return false;
+  }
+  if (mesh->GetNumberOfPoints() != expectedMesh->GetNumberOfPoints() ||
+      mesh->GetNumberOfCells() != expectedMesh->GetNumberOfCells() ||
+      mesh->GetPointData()->Size() != expectedMesh->GetPointData()->Size() ||
+      mesh->GetCellData()->Size() != expectedMesh->GetCellData()->Size())
+  {
+    std::cerr << "Wrong number of points, cells or data in " << fileName << std::endl;
+    return false;
+  }
+  for (MeshType::PointIdentifier id = 0; id < expectedMesh->GetNumberOfPoints(); ++id)
+  {
+    const auto point = mesh->GetPoint(id);
+    const auto expectedPoint = expectedMesh->GetPoint(id);
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      if (point[d] != static_cast<typename TMesh::CoordinateType>(expectedPoint[d]))
+      {
+        std::cerr << "Point " << id << " is " << point << " instead of " << expectedPoint << std::endl;
+        return false;
+      }
+    }
+    if (mesh->GetPointData()->GetElement(id) != expectedMesh->GetPointData()->GetElement(id))
+    {
+      std::cerr << "Wrong data of point " << id << std::endl;
+      return false;
+    }
+  }
+  for (MeshType::CellIdentifier id = 0; id < expectedMesh->GetNumberOfCells(); ++id)
+  {
+    typename TMesh::CellAutoPointer cell;
+    MeshType::CellAutoPointer       expectedCell;
+    mesh->GetCell(id, cell);
+    expectedMesh->GetCell(id, expectedCell);
+    if (cell->GetType() != expectedCell->GetType() ||
+        !std::equal(expectedCell->PointIdsBegin(), expectedCell->PointIdsEnd(), cell->PointIdsBegin()))
+    {
+      std::cerr << "Wrong cell " << id << std::endl;
+      return false;
+    }
+    if (mesh->GetCellData()->GetElement(id) != expectedMesh->GetCellData()->GetElement(id))
+    {
+      std::cerr << "Wrong data of cell " << id << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkMeshFileBulkReadWriteTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const MeshType::Pointer mesh = CreateMesh();
+
+  bool succeeded = true;
+  for (const bool isBinary : { false, true })
+  {
+    const std::string fileName =
+      std::string(argv[1]) + "/itkMeshFileBulkReadWriteTest" + (isBinary ? "Binary" : "ASCII") + ".vtk";
+    std::cout << fileName << std::endl;
+
+    // The points and the data are written from the storage of the mesh
+    auto writer = itk::MeshFileWriter<MeshType>::New();
+    writer->SetInput(mesh);
+    writer->SetFileName(fileName);
+    if (isBinary)
+    {
+      writer->SetFileTypeAsBINARY();
+    }
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+    // and read into it, when the types match
+    succeeded &= TestReading<MeshType>(fileName, mesh);
+    // or converted
+    succeeded &= TestReading<itk::Mesh<double, Dimension>>(fileName, mesh);
+    // into containers which do not store them contiguously
+    succeeded &=
+      TestReading<itk::Mesh<float, Dimension, itk::DefaultDynamicMeshTraits<float, Dimension, Dimension>>>(fileName,
+                                                                                                          mesh);
+    // The cells are read into a compact cells container
+    succeeded &= TestReading<MeshType>(fileName, mesh, true);
+
+    // and written from it
+    const auto compactReader = itk::MeshFileReader<MeshType>::New();
+    compactReader->SetFileName(fileName);
+    compactReader->UseCompactCellsOn();
+    const std::string compactFileName =
+      std::string(argv[1]) + "/itkMeshFileBulkReadWriteTestCompact" + (isBinary ? "Binary" : "ASCII") + ".vtk";
+    auto compactWriter = itk::MeshFileWriter<MeshType>::New();
+    compactWriter->SetInput(compactReader->GetOutput());
+    compactWriter->SetFileName(compactFileName);
+    if (isBinary)
+    {
+      compactWriter->SetFileTypeAsBINARY();
+    }
+    ITK_TRY_EXPECT_NO_EXCEPTION(compactWriter->Update());
+    succeeded &= TestReading<MeshType>(compactFileName, mesh);
+  }
+
+  if (!succeeded)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
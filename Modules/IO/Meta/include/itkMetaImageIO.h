@@ -82,6 +82,12 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Uncompressed binary data, stored in the header file or in a single
+   * data file, can be mapped when in the byte order of the system and not
+   * subsampled. */
+  bool
+  CanMapPixelData(std::string & dataFileName, SizeValueType & dataOffset) override;
+
   MetaImage *
   GetMetaImagePointer();
 
@@ -134,12 +140,14 @@ public:
                            const ImageIORegion & largestPossibleRegion) override;
 
   /** Determine if the ImageIO can stream reading from this
-   *  file. Only time cannot stream read/write is if compression is used.
+   *  file. Compressed data can only be streamed when it is followed by the
+   *  index of its chunks, as written by this class: only the chunks covering
+   *  the requested region are then decompressed.
    *  CanRead must be called prior to this function. */
   bool
   CanStreamRead() override
   {
-    if (m_MetaImage.CompressedData())
+    if (m_MetaImage.CompressedData() && m_CompressedChunkOffsets.empty())
     {
       return false;
     }
@@ -161,6 +169,27 @@ public:
     return true;
   }
 
+  /** Set/Get whether compressed pixel data stored in the header file or in
+   * a single data file is compressed and uncompressed by this class on
+   * multiple threads, see ParallelDeflateCodec, rather than serially by
+   * MetaIO. The files are standard zlib streams either way. The default is false. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseParallelCompression, bool);
+  itkGetConstMacro(UseParallelCompression, bool);
+  itkBooleanMacro(UseParallelCompression);
+  /** @ITKEndGrouping */
+
+  /** Set/Get whether compressed pixel data written on multiple threads, see
+   * SetUseParallelCompression(), is followed by the index of its chunks, so
+   * that it can be stream read by this class. The index is an ITK-specific footer appended to the data in
+   * the .mha file or in the data file named by the header, which other
+   * MetaImage readers do not expect. The default is false. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseCompressedChunkIndex, bool);
+  itkGetConstMacro(UseCompressedChunkIndex, bool);
+  itkBooleanMacro(UseCompressedChunkIndex);
+  /** @ITKEndGrouping */
+
   /** Determining the subsampling factor in case
    *  we want a coarse version of the image/
    * \warning this is only used when streaming is on. */
@@ -197,13 +226,74 @@ protected:
                         const std::string &        metaString) const;
 
 private:
+  /** MetaImage whose pixel data may be compressed and uncompressed by
+   * MetaImageIO, giving access to the compressed data size of the header. */
+  class InternalMetaImage : public MetaImage
+  {
+  public:
+    /** Size of the compressed data as read from the header, or 0 if unknown. */
+    std::streamoff
+    GetCompressedDataSize() const
+    {
+      return m_CompressedDataSize;
+    }
+
+    /** Writes the header of an image whose compressedDataSize bytes of
+     * compressed data are written by the caller. */
+    bool
+    WriteHeader(METAIO_STREAM::ofstream & stream, std::streamoff compressedDataSize);
+  };
+
   /** Only used to synchronize the global variable across static libraries.*/
   itkGetGlobalDeclarationMacro(unsigned int, DefaultDoublePrecision);
 
-  MetaImage m_MetaImage{};
+  /** Finds the file and the offset of binary data stored in the header file
+   * or in a single data file. */
+  bool
+  GetPixelDataLocation(std::string & dataFileName, SizeValueType & dataOffset);
+
+  /** Reads the index of the chunks of compressed data, if any. An index that
+   * does not describe the chunks of the image is ignored, so that the data is
+   * read as a whole. */
+  void
+  ReadCompressedChunkIndex();
+
+  /** Decompresses the chunks of compressed data covering m_IORegion. */
+  void
+  ReadCompressedChunks(void * buffer);
+
+  /** Uncompresses the pixel data of the whole image on multiple threads.
+   * Returns false if it is not stored in the header file or in a single data
+   * file, to be read by MetaIO instead. */
+  bool
+  ReadCompressedPixelData(void * buffer);
+
+  /** Compresses the pixel data of the whole image on multiple threads, and
+   * writes it along with the header. Returns false if it is not to be stored
+   * in the header file or in a single data file, to be written by MetaIO instead. */
+  bool
+  WriteCompressedPixelData(const void * buffer);
+
+  /** Appends the index of the chunks of the compressed data, starting at
+   * the given offsets, to the data file, so that it can be stream read. */
+  void
+  WriteCompressedChunkIndex(const std::string & dataFileName, const std::vector<SizeValueType> & chunkOffsets);
+
+  InternalMetaImage m_MetaImage{};
 
   unsigned int m_SubSamplingFactor{};
 
+  bool m_UseParallelCompression{ false };
+
+  bool m_UseCompressedChunkIndex{ false };
+
+  /** Offsets of the chunks of compressed data, followed by the end of the
+   * last one, relative to the beginning of the data; empty without index. */
+  std::vector<SizeValueType> m_CompressedChunkOffsets{};
+  SizeValueType              m_CompressedChunkSize{};
+  std::string                m_CompressedDataFileName{};
+  SizeValueType              m_CompressedDataOffset{};
+
   static unsigned int * m_DefaultDoublePrecision;
 };
 
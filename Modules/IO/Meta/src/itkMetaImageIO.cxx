@@ -23,8 +23,15 @@
 #include "itkMath.h"
 #include "itkSingleton.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkMultiThreaderBase.h"
+#include "itkParallelDeflateCodec.h"
 #include "metaImageUtils.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <set>
 
 // Function to join strings with a delimiter similar to python's ' '.join([1, 2, 3 ])
@@ -50,6 +57,39 @@ itkGetGlobalValueMacro(MetaImageIO, unsigned int, DefaultDoublePrecision, 17);
 
 unsigned int * MetaImageIO::m_DefaultDoublePrecision;
 
+namespace
+{
+// Number of uncompressed bytes of the chunks of compressed data
+constexpr SizeValueType compressedChunkSize = ParallelDeflateCodec::DefaultBlockSize;
+
+// End of the index of the chunks, which follows the compressed data. The index
+// holds the offsets of the chunks, their uncompressed size, their number and
+// this signature, as 64-bit little-endian integers. MetaIO only reads the
+// CompressedDataSize bytes of the zlib stream, and ignores the index.
+constexpr unsigned char chunkIndexSignature[] = { 'I', 'T', 'K', 'C', 'H', 'U', 'N', 'K' };
+constexpr SizeValueType chunkIndexFooterSize = 2 * sizeof(std::uint64_t) + sizeof(chunkIndexSignature);
+
+void
+AppendUInt64(std::vector<unsigned char> & bytes, std::uint64_t value)
+{
+  for (unsigned int byte = 0; byte < sizeof(value); ++byte)
+  {
+    bytes.push_back(static_cast<unsigned char>((value >> (8 * byte)) & 0xFF));
+  }
+}
+
+std::uint64_t
+ParseUInt64(const unsigned char * bytes)
+{
+  std::uint64_t value = 0;
+  for (unsigned int byte = 0; byte < sizeof(value); ++byte)
+  {
+    value |= std::uint64_t{ bytes[byte] } << (8 * byte);
+  }
+  return value;
+}
+} // namespace
+
 MetaImageIO::MetaImageIO()
   : m_SubSamplingFactor(1)
 {
@@ -85,6 +125,10 @@ MetaImageIO::PrintSelf(std::ostream & os, Indent indent) const
   Superclass::PrintSelf(os, indent);
   m_MetaImage.PrintInfo();
   os << indent << "SubSamplingFactor: " << m_SubSamplingFactor << '\n';
+  itkPrintSelfBooleanMacro(UseParallelCompression);
+  itkPrintSelfBooleanMacro(UseCompressedChunkIndex);
+  os << indent << "NumberOfCompressedChunks: "
+     << (m_CompressedChunkOffsets.empty() ? 0 : m_CompressedChunkOffsets.size() - 1) << '\n';
 }
 
 void
@@ -314,6 +358,217 @@ MetaImageIO::ReadImageInformation()
   {
     EncapsulateMetaData<std::string>(metaDict, ITK_ExperimentDate, std::string(m_MetaImage.AcquisitionDate()));
   }
+
+  this->ReadCompressedChunkIndex();
+}
+
+void
+MetaImageIO::ReadCompressedChunkIndex()
+{
+  m_CompressedChunkOffsets.clear();
+  std::string   dataFileName;
+  SizeValueType dataOffset = 0;
+  if (!m_MetaImage.BinaryData() || !m_MetaImage.CompressedData() || m_MetaImage.HeaderSize() == -1 ||
+      !this->GetPixelDataLocation(dataFileName, dataOffset))
+  {
+    return;
+  }
+
+  std::ifstream       stream(dataFileName.c_str(), std::ios::in | std::ios::binary);
+  const SizeValueType fileLength = itksys::SystemTools::FileLength(dataFileName);
+  if (!stream.is_open() || fileLength < dataOffset + chunkIndexFooterSize)
+  {
+    return;
+  }
+  unsigned char footer[chunkIndexFooterSize];
+  stream.seekg(static_cast<std::streamoff>(fileLength - chunkIndexFooterSize), std::ios::beg);
+  if (!stream.read(reinterpret_cast<char *>(footer), sizeof(footer)) ||
+      std::memcmp(footer + 2 * sizeof(std::uint64_t), chunkIndexSignature, sizeof(chunkIndexSignature)) != 0)
+  {
+    return;
+  }
+
+  // The index must describe the chunks of the whole image
+  const SizeValueType chunkSize = ParseUInt64(footer);
+  const SizeValueType numberOfChunks = ParseUInt64(footer + sizeof(std::uint64_t));
+  const SizeValueType numberOfBytes = this->GetImageSizeInBytes();
+  const SizeValueType availableSize = fileLength - dataOffset - chunkIndexFooterSize;
+  if (chunkSize == 0 || chunkSize > std::max<SizeValueType>(numberOfBytes, 1) ||
+      numberOfChunks != std::max<SizeValueType>(numberOfBytes / chunkSize + (numberOfBytes % chunkSize != 0), 1) ||
+      numberOfChunks > availableSize / sizeof(std::uint64_t))
+  {
+    return;
+  }
+  std::vector<unsigned char> index(numberOfChunks * sizeof(std::uint64_t));
+  stream.seekg(static_cast<std::streamoff>(fileLength - chunkIndexFooterSize - index.size()), std::ios::beg);
+  if (!stream.read(reinterpret_cast<char *>(index.data()), static_cast<std::streamsize>(index.size())))
+  {
+    return;
+  }
+
+  // The chunks follow the zlib header, and the last one is followed by the
+  // checksum of the stream
+  const SizeValueType compressedSize = availableSize - index.size();
+  std::vector<SizeValueType> offsets;
+  for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+  {
+    offsets.push_back(ParseUInt64(index.data() + chunk * sizeof(std::uint64_t)));
+  }
+  offsets.push_back(compressedSize >= 4 ? compressedSize - 4 : 0);
+  const bool isIncreasing =
+    std::adjacent_find(offsets.cbegin(), offsets.cend(), std::greater_equal<>()) == offsets.cend();
+  if (offsets.front() < 2 || !isIncreasing)
+  {
+    return;
+  }
+  m_CompressedChunkOffsets = std::move(offsets);
+  m_CompressedChunkSize = chunkSize;
+  m_CompressedDataFileName = dataFileName;
+  m_CompressedDataOffset = dataOffset;
+}
+
+void
+MetaImageIO::ReadCompressedChunks(void * buffer)
+{
+  const unsigned int  nDims = this->GetNumberOfDimensions();
+  const SizeValueType pixelSize = this->GetPixelSize();
+  const SizeValueType numberOfBytes = this->GetImageSizeInBytes();
+
+  // Offsets of the rows of the region in the uncompressed data
+  std::vector<SizeValueType> index(nDims, 0);
+  std::vector<SizeValueType> size(nDims, 1);
+  std::vector<SizeValueType> strides(nDims);
+  SizeValueType              stride = pixelSize;
+  for (unsigned int i = 0; i < nDims; ++i)
+  {
+    if (i < m_IORegion.GetImageDimension())
+    {
+      index[i] = m_IORegion.GetIndex(i);
+      size[i] = m_IORegion.GetSize(i);
+    }
+    strides[i] = stride;
+    stride *= this->GetDimensions(i);
+  }
+  const SizeValueType rowSize = size[0] * pixelSize;
+  SizeValueType       numberOfRows = 1;
+  for (unsigned int i = 1; i < nDims; ++i)
+  {
+    numberOfRows *= size[i];
+  }
+  if (rowSize == 0 || numberOfRows == 0)
+  {
+    return;
+  }
+  std::vector<SizeValueType> rowOffsets;
+  rowOffsets.reserve(numberOfRows);
+  std::vector<SizeValueType> position = index;
+  for (SizeValueType row = 0; row < numberOfRows; ++row)
+  {
+    SizeValueType offset = 0;
+    for (unsigned int i = 0; i < nDims; ++i)
+    {
+      offset += position[i] * strides[i];
+    }
+    rowOffsets.push_back(offset);
+    for (unsigned int i = 1; i < nDims && ++position[i] == index[i] + size[i]; ++i)
+    {
+      position[i] = index[i];
+    }
+  }
+
+  // Only the chunks covering a row are read, and decompressed concurrently
+  const SizeValueType        numberOfChunks = m_CompressedChunkOffsets.size() - 1;
+  constexpr SizeValueType    notRead = NumericTraits<SizeValueType>::max();
+  std::vector<SizeValueType> slots(numberOfChunks, notRead);
+  for (const SizeValueType rowOffset : rowOffsets)
+  {
+    const SizeValueType lastChunk = (rowOffset + rowSize - 1) / m_CompressedChunkSize;
+    for (SizeValueType chunk = rowOffset / m_CompressedChunkSize; chunk <= lastChunk; ++chunk)
+    {
+      slots[chunk] = 0;
+    }
+  }
+  std::vector<SizeValueType> chunks;
+  for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+  {
+    if (slots[chunk] != notRead)
+    {
+      slots[chunk] = chunks.size();
+      chunks.push_back(chunk);
+    }
+  }
+
+  std::ifstream stream(m_CompressedDataFileName.c_str(), std::ios::in | std::ios::binary);
+  if (!stream.is_open())
+  {
+    itkExceptionMacro("File cannot be read: " << m_CompressedDataFileName << " for reading." << std::endl
+                                              << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+  std::vector<unsigned char> compressedData;
+  std::vector<SizeValueType> compressedOffsets;
+  for (const SizeValueType chunk : chunks)
+  {
+    const SizeValueType begin = m_CompressedChunkOffsets[chunk];
+    const SizeValueType chunkCompressedSize = m_CompressedChunkOffsets[chunk + 1] - begin;
+    compressedOffsets.push_back(compressedData.size());
+    compressedData.resize(compressedData.size() + chunkCompressedSize);
+    stream.seekg(static_cast<std::streamoff>(m_CompressedDataOffset + begin), std::ios::beg);
+    if (!stream.read(reinterpret_cast<char *>(compressedData.data() + compressedOffsets.back()),
+                     static_cast<std::streamsize>(chunkCompressedSize)))
+    {
+      itkExceptionMacro("File cannot be read: " << m_CompressedDataFileName << " for reading." << std::endl
+                                                << "Reason: the compressed data is truncated.");
+    }
+  }
+  compressedOffsets.push_back(compressedData.size());
+
+  if (chunks.size() > std::numeric_limits<SizeValueType>::max() / m_CompressedChunkSize)
+  {
+    itkExceptionMacro("File cannot be read: " << m_CompressedDataFileName << " for reading." << std::endl
+                                              << "Reason: the chunks of compressed data are too large.");
+  }
+  std::vector<unsigned char> data(chunks.size() * m_CompressedChunkSize);
+  std::vector<std::string>   errors(chunks.size());
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    chunks.size(),
+    [&](SizeValueType slot) {
+      const SizeValueType begin = chunks[slot] * m_CompressedChunkSize;
+      try
+      {
+        ParallelDeflateCodec::DecompressBlock(compressedData.data() + compressedOffsets[slot],
+                                              compressedOffsets[slot + 1] - compressedOffsets[slot],
+                                              data.data() + slot * m_CompressedChunkSize,
+                                              std::min(m_CompressedChunkSize, numberOfBytes - begin));
+      }
+      catch (const ExceptionObject & exception)
+      {
+        errors[slot] = exception.GetDescription();
+      }
+    },
+    nullptr);
+  for (const std::string & error : errors)
+  {
+    if (!error.empty())
+    {
+      itkExceptionMacro("File cannot be read: " << m_CompressedDataFileName << " for reading." << std::endl
+                                                << "Reason: " << error);
+    }
+  }
+
+  auto * output = static_cast<unsigned char *>(buffer);
+  for (const SizeValueType rowOffset : rowOffsets)
+  {
+    for (SizeValueType offset = rowOffset; offset < rowOffset + rowSize;)
+    {
+      const SizeValueType chunk = offset / m_CompressedChunkSize;
+      const SizeValueType chunkOffset = offset - chunk * m_CompressedChunkSize;
+      const SizeValueType copySize = std::min(m_CompressedChunkSize - chunkOffset, rowOffset + rowSize - offset);
+      std::memcpy(output, data.data() + slots[chunk] * m_CompressedChunkSize + chunkOffset, copySize);
+      output += copySize;
+      offset += copySize;
+    }
+  }
 }
 
 void
@@ -352,7 +607,13 @@ MetaImageIO::Read(void * buffer)
       }
     }
 
-    if (!m_MetaImage.ReadROI(indexMin.get(), indexMax.get(), m_FileName.c_str(), true, buffer, m_SubSamplingFactor))
+    if (!m_CompressedChunkOffsets.empty() && m_SubSamplingFactor == 1)
+    {
+      this->ReadCompressedChunks(buffer);
+      m_MetaImage.ElementData(buffer, false);
+    }
+    else if (!m_MetaImage.ReadROI(
+               indexMin.get(), indexMax.get(), m_FileName.c_str(), true, buffer, m_SubSamplingFactor))
     {
       itkExceptionMacro("File cannot be read: " << this->GetFileName() << " for reading." << std::endl
                                                 << "Reason: " << itksys::SystemTools::GetLastSystemError());
@@ -360,6 +621,11 @@ MetaImageIO::Read(void * buffer)
 
     m_MetaImage.ElementByteOrderFix(m_IORegion.GetNumberOfPixels());
   }
+  else if (m_UseParallelCompression && this->ReadCompressedPixelData(buffer))
+  {
+    m_MetaImage.ElementData(buffer, false);
+    m_MetaImage.ElementByteOrderFix(this->GetImageSizeInPixels());
+  }
   else
   {
     if (!m_MetaImage.Read(m_FileName.c_str(), true, buffer))
@@ -373,6 +639,131 @@ MetaImageIO::Read(void * buffer)
   }
 }
 
+bool
+MetaImageIO::ReadCompressedPixelData(void * buffer)
+{
+  std::string   dataFileName;
+  SizeValueType dataOffset = 0;
+  if (!m_MetaImage.BinaryData() || !m_MetaImage.CompressedData() || m_MetaImage.HeaderSize() == -1 ||
+      !this->GetPixelDataLocation(dataFileName, dataOffset))
+  {
+    return false;
+  }
+
+  // Without a size in the header, the data extends to the end of the file,
+  // or to its chunk index
+  const SizeValueType fileLength = itksys::SystemTools::FileLength(dataFileName);
+  SizeValueType       compressedSize = static_cast<SizeValueType>(m_MetaImage.GetCompressedDataSize());
+  if (compressedSize == 0)
+  {
+    compressedSize = m_CompressedChunkOffsets.empty() ? fileLength - std::min(dataOffset, fileLength)
+                                                      : m_CompressedChunkOffsets.back() + 4;
+  }
+  std::ifstream stream(dataFileName.c_str(), std::ios::in | std::ios::binary);
+  if (!stream.is_open())
+  {
+    itkExceptionMacro("File cannot be read: " << dataFileName << " for reading." << std::endl
+                                              << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+  if (dataOffset > fileLength || compressedSize > fileLength - dataOffset)
+  {
+    itkExceptionMacro("File cannot be read: " << dataFileName << " for reading." << std::endl
+                                              << "Reason: the compressed data is truncated.");
+  }
+  std::vector<unsigned char> compressedData(compressedSize);
+  stream.seekg(static_cast<std::streamoff>(dataOffset), std::ios::beg);
+  if (!stream.read(reinterpret_cast<char *>(compressedData.data()), static_cast<std::streamsize>(compressedSize)))
+  {
+    itkExceptionMacro("File cannot be read: " << dataFileName << " for reading." << std::endl
+                                              << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+
+  try
+  {
+    ParallelDeflateCodec::Decompress(compressedData.data(), compressedSize, buffer, this->GetImageSizeInBytes());
+  }
+  catch (const ExceptionObject & exception)
+  {
+    itkExceptionMacro("File cannot be read: " << dataFileName << " for reading." << std::endl
+                                              << "Reason: " << exception.GetDescription());
+  }
+  return true;
+}
+
+bool
+MetaImageIO::CanMapPixelData(std::string & dataFileName, SizeValueType & dataOffset)
+{
+  if (!m_MetaImage.BinaryData() || m_MetaImage.CompressedData() || m_SubSamplingFactor != 1 ||
+      (this->GetComponentSize() > 1 && m_MetaImage.BinaryDataByteOrderMSB() != MET_SystemByteOrderMSB()))
+  {
+    return false;
+  }
+  return this->GetPixelDataLocation(dataFileName, dataOffset);
+}
+
+bool
+MetaImageIO::GetPixelDataLocation(std::string & dataFileName, SizeValueType & dataOffset)
+{
+  const std::string elementDataFileName = m_MetaImage.ElementDataFileName();
+  const bool        isLocal = itksys::SystemTools::Strucmp(elementDataFileName.c_str(), "LOCAL") == 0;
+  if (isLocal)
+  {
+    dataFileName = m_FileName;
+  }
+  else if (elementDataFileName.empty() || elementDataFileName.compare(0, 4, "LIST") == 0 ||
+           elementDataFileName.find('%') != std::string::npos)
+  {
+    return false;
+  }
+  else if (itksys::SystemTools::FileIsFullPath(elementDataFileName))
+  {
+    dataFileName = elementDataFileName;
+  }
+  else
+  {
+    dataFileName = itksys::SystemTools::CollapseFullPath(elementDataFileName,
+                                                         itksys::SystemTools::GetFilenamePath(m_FileName));
+  }
+
+  const int headerSize = m_MetaImage.HeaderSize();
+  if (headerSize > 0)
+  {
+    dataOffset = static_cast<SizeValueType>(headerSize);
+  }
+  else if (headerSize == -1)
+  {
+    // The data is at the end of the file
+    const SizeValueType fileLength = itksys::SystemTools::FileLength(dataFileName);
+    const SizeValueType dataSize = this->GetImageSizeInBytes();
+    if (fileLength < dataSize)
+    {
+      return false;
+    }
+    dataOffset = fileLength - dataSize;
+  }
+  else if (isLocal)
+  {
+    // The data follows the header, parse it again to find where it ends
+    std::ifstream stream(m_FileName.c_str(), std::ios::in | std::ios::binary);
+    MetaImage     header;
+    if (!stream.is_open() || !header.ReadStream(0, &stream, false))
+    {
+      return false;
+    }
+    const std::streamoff position = stream.tellg();
+    if (position < 0)
+    {
+      return false;
+    }
+    dataOffset = static_cast<SizeValueType>(position);
+  }
+  else
+  {
+    dataOffset = 0;
+  }
+  return true;
+}
+
 MetaImage *
 MetaImageIO::GetMetaImagePointer()
 {
@@ -755,7 +1146,7 @@ MetaImageIO::Write(const void * buffer)
                                                        << "Reason: " << itksys::SystemTools::GetLastSystemError());
     }
   }
-  else
+  else if (!(m_UseCompression && m_UseParallelCompression && binaryData && this->WriteCompressedPixelData(buffer)))
   {
     if (!m_MetaImage.Write(m_FileName.c_str()))
     {
@@ -765,6 +1156,122 @@ MetaImageIO::Write(const void * buffer)
   }
 }
 
+bool
+MetaImageIO::InternalMetaImage::WriteHeader(METAIO_STREAM::ofstream & stream, std::streamoff compressedDataSize)
+{
+  // As MetaImage::WriteStream() does, without compressing the data
+  m_CompressedDataSize = compressedDataSize;
+  m_WriteStream = &stream;
+  M_SetupWriteFields();
+  const bool result = M_Write();
+  m_WriteStream = nullptr;
+  m_CompressedDataSize = 0;
+  return result;
+}
+
+bool
+MetaImageIO::WriteCompressedPixelData(const void * buffer)
+{
+  // The files are named as MetaImage::Write() does: the data is stored in a
+  // .mha header file, or else in a .zraw file named after the .mhd header
+  // file, unless set explicitly. MetaIO writes the other cases.
+  const std::string previousElementDataFileName = m_MetaImage.ElementDataFileName();
+  std::string       elementDataFileName = previousElementDataFileName;
+  const std::string extension = itksys::SystemTools::GetFilenameLastExtension(m_FileName);
+  if (elementDataFileName.empty())
+  {
+    elementDataFileName =
+      extension == ".mha" ? "LOCAL" : itksys::SystemTools::GetFilenameWithoutLastExtension(m_FileName) + ".zraw";
+  }
+  const bool isLocal = elementDataFileName == "LOCAL";
+  if (extension != (isLocal ? ".mha" : ".mhd") || elementDataFileName.compare(0, 4, "LIST") == 0 ||
+      elementDataFileName.find('%') != std::string::npos)
+  {
+    return false;
+  }
+  std::string dataFileName = m_FileName;
+  if (!isLocal)
+  {
+    const std::string headerPath = itksys::SystemTools::GetFilenamePath(m_FileName);
+    if (!itksys::SystemTools::FileIsFullPath(elementDataFileName))
+    {
+      dataFileName = itksys::SystemTools::CollapseFullPath(elementDataFileName, headerPath);
+    }
+    else
+    {
+      dataFileName = elementDataFileName;
+      if (itksys::SystemTools::GetFilenamePath(elementDataFileName) == headerPath)
+      {
+        elementDataFileName = itksys::SystemTools::GetFilenameName(elementDataFileName);
+      }
+    }
+  }
+
+  std::vector<SizeValueType>       chunkOffsets;
+  const std::vector<unsigned char> compressedData =
+    ParallelDeflateCodec::Compress(buffer,
+                                   this->GetImageSizeInBytes(),
+                                   this->GetCompressionLevel(),
+                                   ParallelDeflateCodecEnums::Format::Zlib,
+                                   compressedChunkSize,
+                                   chunkOffsets);
+
+  METAIO_STREAM::ofstream headerStream(m_FileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  m_MetaImage.ElementDataFileName(elementDataFileName.c_str());
+  const bool headerWritten =
+    headerStream.is_open() &&
+    m_MetaImage.WriteHeader(headerStream, static_cast<std::streamoff>(compressedData.size()));
+  m_MetaImage.ElementDataFileName(previousElementDataFileName.c_str());
+  if (!headerWritten)
+  {
+    itkExceptionMacro("File cannot be written: " << this->GetFileName() << std::endl
+                                                 << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+
+  METAIO_STREAM::ofstream dataFileStream;
+  if (!isLocal)
+  {
+    headerStream.close();
+    dataFileStream.open(dataFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  }
+  METAIO_STREAM::ofstream & dataStream = isLocal ? headerStream : dataFileStream;
+  if (!dataStream.is_open() || !dataStream.write(reinterpret_cast<const char *>(compressedData.data()),
+                                                 static_cast<std::streamsize>(compressedData.size())))
+  {
+    itkExceptionMacro("File cannot be written: " << dataFileName << std::endl
+                                                 << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+  dataStream.close();
+
+  if (m_UseCompressedChunkIndex)
+  {
+    this->WriteCompressedChunkIndex(dataFileName, chunkOffsets);
+  }
+  return true;
+}
+
+void
+MetaImageIO::WriteCompressedChunkIndex(const std::string &                dataFileName,
+                                       const std::vector<SizeValueType> & chunkOffsets)
+{
+  std::vector<unsigned char> index;
+  for (const SizeValueType offset : chunkOffsets)
+  {
+    AppendUInt64(index, offset);
+  }
+  AppendUInt64(index, compressedChunkSize);
+  AppendUInt64(index, chunkOffsets.size());
+  index.insert(index.end(), std::begin(chunkIndexSignature), std::end(chunkIndexSignature));
+
+  std::ofstream stream(dataFileName.c_str(), std::ios::out | std::ios::binary | std::ios::app);
+  if (!stream.is_open() ||
+      !stream.write(reinterpret_cast<const char *>(index.data()), static_cast<std::streamsize>(index.size())))
+  {
+    itkExceptionMacro("File cannot be written: " << dataFileName << std::endl
+                                                 << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+}
+
 /** Given a requested region, determine what could be the region that we can
  * read from the file. This is called the streamable region, which will be
  * smaller than the LargestPossibleRegion and greater or equal to the
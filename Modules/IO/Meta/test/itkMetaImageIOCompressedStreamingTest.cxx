@@ -0,0 +1,167 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileWriter.h"
+#include "itkMetaImageIO.h"
+#include "itkTestingImageIOStreamingHelpers.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+
+namespace
+{
+using ImageType = itk::Image<short, 3>;
+
+bool
+CanStreamRead(const std::string & fileName)
+{
+  auto metaImageIO = itk::MetaImageIO::New();
+  metaImageIO->SetFileName(fileName);
+  metaImageIO->ReadImageInformation();
+  return metaImageIO->CanStreamRead();
+}
+
+void
+WriteCompressed(const ImageType * image, const std::string & fileName, itk::MetaImageIO * metaImageIO)
+{
+  auto writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(metaImageIO);
+  writer->UseCompressionOn();
+  writer->Update();
+}
+
+// Overwrites the 8 bytes at the given offset from the end of a file
+void
+OverwriteFromEnd(const std::string & fileName, std::streamoff offsetFromEnd, std::uint64_t value)
+{
+  std::fstream stream(fileName.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+  stream.seekp(-offsetFromEnd, std::ios::end);
+  for (unsigned int i = 0; i < 8; ++i)
+  {
+    stream.put(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+} // namespace
+
+int
+itkMetaImageIOCompressedStreamingTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  // Several chunks of 1 MiB of compressed data, of about 16 slices each
+  auto                      image = ImageType::New();
+  const ImageType::SizeType size = { { 211, 157, 43 } };
+  image->SetRegions(size);
+  image->Allocate();
+  itk::Testing::FillWithIndexPattern(image.GetPointer());
+
+  // The chunk index is only written on request, with the data compressed on
+  // multiple threads
+  auto metaImageIO = itk::MetaImageIO::New();
+  ITK_TEST_EXPECT_TRUE(!metaImageIO->GetUseParallelCompression());
+  metaImageIO->UseParallelCompressionOn();
+  ITK_TEST_EXPECT_TRUE(!metaImageIO->GetUseCompressedChunkIndex());
+  ITK_TEST_SET_GET_BOOLEAN(metaImageIO, UseCompressedChunkIndex, false);
+  const std::string noIndexFileName = outputDirectory + "/itkMetaImageIOCompressedStreamingTestNoIndex.mha";
+  ITK_TRY_EXPECT_NO_EXCEPTION(WriteCompressed(image, noIndexFileName, metaImageIO));
+  ITK_TEST_EXPECT_TRUE(!CanStreamRead(noIndexFileName));
+
+  const std::string attachedFileName = outputDirectory + "/itkMetaImageIOCompressedStreamingTest.mha";
+  const std::string detachedFileName = outputDirectory + "/itkMetaImageIOCompressedStreamingTest.mhd";
+  metaImageIO->UseCompressedChunkIndexOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(WriteCompressed(image, attachedFileName, metaImageIO));
+  ITK_TRY_EXPECT_NO_EXCEPTION(WriteCompressed(image, detachedFileName, metaImageIO));
+
+  // Only the chunks covering a region are decompressed: a region spanning the
+  // boundary of the first two chunks in the middle of slice 15, and a slab
+  // within the second chunk
+  const ImageType::RegionType region({ { 17, 100, 14 } }, { { 60, 50, 3 } });
+  const ImageType::RegionType slab({ { 0, 0, 21 } }, { { 211, 157, 2 } });
+  ImageType::Pointer          readImage;
+  for (const std::string & fileName : { attachedFileName, detachedFileName })
+  {
+    ITK_TEST_EXPECT_TRUE(CanStreamRead(fileName));
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(readImage = itk::ReadImage<ImageType>(fileName));
+    ITK_TEST_EXPECT_EQUAL(readImage->GetBufferedRegion(), image->GetLargestPossibleRegion());
+    ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(readImage.GetPointer(), image.GetPointer()));
+
+    for (const ImageType::RegionType & requestedRegion : { region, slab })
+    {
+      ITK_TRY_EXPECT_NO_EXCEPTION(
+        readImage = itk::Testing::ReadImageRegion<ImageType>(fileName, requestedRegion, itk::MetaImageIO::New()));
+      ITK_TEST_EXPECT_EQUAL(readImage->GetBufferedRegion(), requestedRegion);
+      ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(readImage.GetPointer(), image.GetPointer()));
+    }
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(readImage = itk::Testing::ReadImageStreamed<ImageType>(fileName, 7));
+    ITK_TEST_EXPECT_EQUAL(readImage->GetBufferedRegion(), image->GetLargestPossibleRegion());
+    ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(readImage.GetPointer(), image.GetPointer()));
+  }
+
+  // MetaIO only reads the zlib stream, and ignores the index
+  MetaImage metaImage;
+  ITK_TEST_EXPECT_TRUE(metaImage.Read(detachedFileName.c_str()));
+  ITK_TEST_EXPECT_TRUE(std::equal(image->GetBufferPointer(),
+                                  image->GetBufferPointer() + image->GetPixelContainer()->Size(),
+                                  static_cast<const short *>(metaImage.ElementData())));
+
+  // Without a valid chunk index, the file is still read as compressed data.
+  // The footer holds the chunk size, the number of chunks and the signature.
+  const std::uint64_t numberOfBytes = image->GetPixelContainer()->Size() * sizeof(short);
+  for (const std::uint64_t chunkSize : { std::uint64_t{ 0 }, numberOfBytes + 1, ~std::uint64_t{ 0 } })
+  {
+    ITK_TRY_EXPECT_NO_EXCEPTION(WriteCompressed(image, attachedFileName, metaImageIO));
+    OverwriteFromEnd(attachedFileName, 24, chunkSize);
+    ITK_TEST_EXPECT_TRUE(!CanStreamRead(attachedFileName));
+    ITK_TRY_EXPECT_NO_EXCEPTION(readImage = itk::ReadImage<ImageType>(attachedFileName));
+    ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(readImage.GetPointer(), image.GetPointer()));
+  }
+  {
+    std::fstream stream(attachedFileName.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    stream.seekp(-1, std::ios::end);
+    stream.put('X');
+  }
+  ITK_TEST_EXPECT_TRUE(!CanStreamRead(attachedFileName));
+  ITK_TRY_EXPECT_NO_EXCEPTION(
+    readImage = itk::Testing::ReadImageRegion<ImageType>(attachedFileName, region, itk::MetaImageIO::New()));
+  ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(readImage.GetPointer(), image.GetPointer()));
+
+  // Data compressed serially by MetaIO, without chunk index
+  const std::string serialFileName = outputDirectory + "/itkMetaImageIOCompressedStreamingTestSerial.mha";
+  auto              serialImageIO = itk::MetaImageIO::New();
+  ITK_TEST_SET_GET_BOOLEAN(serialImageIO, UseParallelCompression, false);
+  serialImageIO->UseCompressedChunkIndexOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(WriteCompressed(image, serialFileName, serialImageIO));
+  ITK_TEST_EXPECT_TRUE(!CanStreamRead(serialFileName));
+  ITK_TRY_EXPECT_NO_EXCEPTION(readImage = itk::ReadImage<ImageType>(serialFileName));
+  ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(readImage.GetPointer(), image.GetPointer()));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
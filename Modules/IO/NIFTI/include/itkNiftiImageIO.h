@@ -159,6 +159,11 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Uncompressed data can be mapped when in the byte order of the system,
+   * not rescaled, and of scalar, complex, RGB or RGBA pixels. */
+  bool
+  CanMapPixelData(std::string & dataFileName, SizeValueType & dataOffset) override;
+
   //-------- This part of the interfaces deals with writing data. -----
 
   /** Determine if the file can be written with this ImageIO implementation.
@@ -435,6 +435,11 @@ NiftiImageIO::NiftiImageIO()
     this->AddSupportedWriteExtension(ext);
     this->AddSupportedReadExtension(ext);
   }
+  // NIfTI-1 and NIfTI-2 single files and headers
+  this->AddSupportedReadSignature(std::string("n+1\0", 4), 344);
+  this->AddSupportedReadSignature(std::string("ni1\0", 4), 344);
+  this->AddSupportedReadSignature(std::string("n+2\0", 4), 4);
+  this->AddSupportedReadSignature(std::string("ni2\0", 4), 4);
   std::string envVar;
   if (itksys::SystemTools::GetEnv("ITK_NIFTI_SFORM_PERMISSIVE", envVar))
   {
@@ -836,6 +841,29 @@ NiftiImageIO::Read(void * buffer)
   }
 }
 
+bool
+NiftiImageIO::CanMapPixelData(std::string & dataFileName, SizeValueType & dataOffset)
+{
+  // Only these pixels have the same layout in NIfTI and ITK
+  const unsigned int numComponents = this->GetNumberOfComponents();
+  if (this->MustRescale() || this->m_ComponentType != this->m_OnDiskComponentType ||
+      (numComponents > 1 && this->GetPixelType() != IOPixelEnum::COMPLEX && this->GetPixelType() != IOPixelEnum::RGB &&
+       this->GetPixelType() != IOPixelEnum::RGBA))
+  {
+    return false;
+  }
+
+  const std::unique_ptr<nifti_image, NiftiImageDeleter> header(nifti_image_read(this->GetFileName(), false));
+  if (!header || header->iname == nullptr || header->iname_offset < 0 || nifti_is_gzfile(header->iname) ||
+      (header->nbyper > 1 && header->byteorder != nifti_short_order()))
+  {
+    return false;
+  }
+  dataFileName = header->iname;
+  dataOffset = static_cast<SizeValueType>(header->iname_offset);
+  return true;
+}
+
 NiftiImageIOEnums::NiftiFileEnum
 NiftiImageIO::DetermineFileType(const char * FileNameToRead)
 {
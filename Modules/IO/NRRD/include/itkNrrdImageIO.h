@@ -118,6 +118,12 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Raw data, attached or in a single detached data file, can be mapped
+   * when in the byte order of the system and with the pixel components on
+   * the fastest axis. */
+  bool
+  CanMapPixelData(std::string & dataFileName, SizeValueType & dataOffset) override;
+
   /** Determine the file type. Returns true if this ImageIO can write the
    * file specified. */
   bool
@@ -199,6 +205,17 @@ public:
     this->SetAxesReorder(AxesReorderEnum::UseScalarPixel);
   }
 
+  /** Set/Get whether gzip encoded data is compressed and uncompressed by this
+   * class on multiple threads, see ParallelDeflateCodec, rather than serially
+   * by NrrdIO. The files are standard gzip streams either way. Only data held
+   * in a single file, attached or detached, is uncompressed on multiple
+   * threads. The default is false. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseParallelCompression, bool);
+  itkGetConstMacro(UseParallelCompression, bool);
+  itkBooleanMacro(UseParallelCompression);
+  /** @ITKEndGrouping */
+
 protected:
   NrrdImageIO();
   ~NrrdImageIO() override;
@@ -219,6 +236,8 @@ protected:
   const NrrdEncoding_t * m_NrrdCompressionEncoding{ nullptr };
 
   AxesReorderEnum m_AxesReorder{ AxesReorderEnum::UseAnyRangeAxisAsPixel };
+
+  bool m_UseParallelCompression{ false };
 };
 } // end namespace itk
 
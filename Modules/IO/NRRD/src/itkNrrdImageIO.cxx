@@ -22,7 +22,9 @@
 #include "itkMetaDataObject.h"
 #include "itkIOCommon.h"
 #include "itkFloatingPointExceptions.h"
+#include "itkParallelDeflateCodec.h"
 
+#include <fstream>
 #include <sstream>
 
 namespace
@@ -123,6 +125,129 @@ GetAxisOrderForFileReading(Nrrd *                             nrrd,
 
 const std::string NRRD_KEY_PREFIX{ "NRRD_" };
 
+
+// Reads the header of a NRRD file again, leaving its data file open where the
+// data starts. Returns false if the header cannot be read.
+bool
+LoadHeaderKeepingDataFileOpen(Nrrd * nrrd, NrrdIoState * nio, const char * fileName)
+{
+  // nrrd causes exceptions on purpose, so mask them
+  bool saveFPEState(false);
+  if (itk::FloatingPointExceptions::HasFloatingPointExceptionsSupport())
+  {
+    saveFPEState = itk::FloatingPointExceptions::GetEnabled();
+    itk::FloatingPointExceptions::Disable();
+  }
+
+  nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+  nrrdIoStateSet(nio, nrrdIoStateKeepNrrdDataFileOpen, 1);
+  const bool loaded = nrrdLoad(nrrd, fileName, nio) == 0;
+  if (!loaded)
+  {
+    free(biffGetDone(NRRD));
+  }
+
+  if (itk::FloatingPointExceptions::HasFloatingPointExceptionsSupport())
+  {
+    itk::FloatingPointExceptions::SetEnabled(saveFPEState);
+  }
+  return loaded;
+}
+
+// Whether the data of a loaded header is in a single file, attached or
+// detached, with the components of the pixels on the fastest axis, as read
+// into the buffer of ITK without rearranging them
+bool
+HasContiguousPixelData(Nrrd * nrrd, const NrrdIoState * nio, itk::NrrdImageIOEnums::AxesReorder axesReorder)
+{
+  int                       pixelAxisIndex{ -1 };
+  std::vector<unsigned int> imageAxes_nrrd;
+  unsigned int              numberOfDomainAxes{ 0 };
+  bool                      needPermutation{ false };
+  GetAxisOrderForFileReading(nrrd, imageAxes_nrrd, pixelAxisIndex, numberOfDomainAxes, needPermutation, axesReorder);
+
+  return nio->format == nrrdFormatNRRD && nio->dataFile != nullptr && nio->dataFile != stdin &&
+         nio->dataFNFormat == nullptr && !needPermutation && nrrd->axis[0].kind != nrrdKind3DMaskedSymMatrix;
+}
+
+// Name of the file of the data: the header file itself for attached data, or
+// the detached data file, resolved relative to the header as NrrdIO does
+std::string
+GetDataFileName(const NrrdIoState * nio, const std::string & headerFileName)
+{
+  if (nio->dataFNArr->len == 0)
+  {
+    return headerFileName;
+  }
+  const std::string name = nio->dataFN[0];
+  const bool        needPath = name.size() < 2 || (name[1] != ':' && name[0] != '/');
+  return needPath ? std::string(nio->path) + '/' + name : name;
+}
+
+// Reads gzip encoded data, attached or in a single detached data file, with a
+// multi-threaded inflate rather than the serial one of NrrdIO. Returns false if
+// the data cannot be read this way.
+bool
+ReadGzipEncodedData(const char *                       fileName,
+                    itk::NrrdImageIOEnums::AxesReorder axesReorder,
+                    void *                             buffer,
+                    itk::SizeValueType                 numberOfBytes)
+{
+  Nrrd *        nrrd = nrrdNew();
+  NrrdIoState * nio = nrrdIoStateNew();
+
+  bool canRead = LoadHeaderKeepingDataFileOpen(nrrd, nio, fileName) && nio->encoding == nrrdEncodingGzip &&
+                 nio->byteSkip == 0 && HasContiguousPixelData(nrrd, nio, axesReorder) &&
+                 nrrdElementNumber(nrrd) * nrrdElementSize(nrrd) == numberOfBytes;
+
+  // The compressed data extends to the end of the data file
+  std::vector<unsigned char> compressedData;
+  if (canRead)
+  {
+    const long begin = ftell(nio->dataFile);
+    canRead = begin >= 0 && fseek(nio->dataFile, 0, SEEK_END) == 0;
+    const long end = canRead ? ftell(nio->dataFile) : -1;
+    canRead = end >= begin && fseek(nio->dataFile, begin, SEEK_SET) == 0;
+    if (canRead)
+    {
+      compressedData.resize(static_cast<size_t>(end - begin));
+      canRead = fread(compressedData.data(), 1, compressedData.size(), nio->dataFile) == compressedData.size();
+    }
+  }
+  if (nio->dataFile != nullptr)
+  {
+    nio->dataFile = airFclose(nio->dataFile);
+  }
+
+  try
+  {
+    if (canRead)
+    {
+      itk::ParallelDeflateCodec::Decompress(compressedData.data(), compressedData.size(), buffer, numberOfBytes);
+
+      // Swapped as by NrrdIO
+      if (nio->endian != airEndianUnknown && nio->encoding->endianMatters && nio->endian != airMyEndian())
+      {
+        nrrd->data = buffer;
+        nrrdSwapEndian(nrrd);
+      }
+    }
+  }
+  catch (...)
+  {
+    // clean up from an exception
+    nrrdNix(nrrd);
+    nrrdIoStateNix(nio);
+
+    // rethrow exception
+    throw;
+  }
+
+  // Free the nrrd struct but don't touch nrrd->data
+  nrrdNix(nrrd);
+  nrrdIoStateNix(nio);
+  return canRead;
+}
 } // namespace
 
 namespace itk
@@ -158,6 +283,7 @@ NrrdImageIO::NrrdImageIO()
     this->AddSupportedWriteExtension(ext);
     this->AddSupportedReadExtension(ext);
   }
+  this->AddSupportedReadSignature("NRRD");
 
   this->Self::SetCompressor("");
   this->Self::SetMaximumCompressionLevel(9);
@@ -183,6 +309,7 @@ NrrdImageIO::PrintSelf(std::ostream & os, Indent indent) const
   Superclass::PrintSelf(os, indent);
 
   os << indent << "NrrdCompressionEncoding: " << m_NrrdCompressionEncoding << std::endl;
+  itkPrintSelfBooleanMacro(UseParallelCompression);
 }
 
 void
@@ -874,6 +1001,13 @@ NrrdImageIO::ReadImageInformation()
 void
 NrrdImageIO::Read(void * buffer)
 {
+  // Gzip encoded data is decompressed on multiple threads on request, when possible
+  if (m_UseParallelCompression && this->GetPixelType() != IOPixelEnum::SYMMETRICSECONDRANKTENSOR &&
+      ReadGzipEncodedData(this->GetFileName(), this->GetAxesReorder(), buffer, this->GetImageSizeInBytes()))
+  {
+    return;
+  }
+
   Nrrd * nrrd = nrrdNew();
   bool   nrrdAllocated;
 
@@ -1013,6 +1147,32 @@ NrrdImageIO::Read(void * buffer)
   }
 }
 
+bool
+NrrdImageIO::CanMapPixelData(std::string & dataFileName, SizeValueType & dataOffset)
+{
+  Nrrd *        nrrd = nrrdNew();
+  NrrdIoState * nio = nrrdIoStateNew();
+
+  bool canMap = LoadHeaderKeepingDataFileOpen(nrrd, nio, this->GetFileName()) && nio->encoding == nrrdEncodingRaw &&
+                (nrrdElementSize(nrrd) == 1 || nio->endian == airMyEndian()) &&
+                HasContiguousPixelData(nrrd, nio, this->GetAxesReorder());
+  if (canMap)
+  {
+    const long position = ftell(nio->dataFile);
+    canMap = position >= 0;
+    dataOffset = static_cast<SizeValueType>(position);
+    dataFileName = GetDataFileName(nio, this->GetFileName());
+  }
+
+  if (nio->dataFile != nullptr)
+  {
+    airFclose(nio->dataFile);
+  }
+  nrrdNix(nrrd);
+  nrrdIoStateNix(nio);
+  return canMap;
+}
+
 bool
 NrrdImageIO::CanWriteFile(const char * name)
 {
@@ -1338,6 +1498,14 @@ NrrdImageIO::Write(const void * buffer)
       break;
   }
 
+  // On request, NrrdIO only writes the header of gzip encoded data, which is
+  // compressed on multiple threads instead
+  const bool compressInParallel = m_UseParallelCompression && nio->encoding == nrrdEncodingGzip;
+  if (compressInParallel)
+  {
+    nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+  }
+
   // Write the nrrd to file.
   if (nrrdSave(this->GetFileName(), nrrd, nio))
   {
@@ -1345,6 +1513,26 @@ NrrdImageIO::Write(const void * buffer)
     itkExceptionMacro("Write: Error writing " << this->GetFileName() << ":\n" << err);
   }
 
+  if (compressInParallel)
+  {
+    const std::vector<unsigned char> compressedData =
+      ParallelDeflateCodec::Compress(buffer,
+                                     nrrdElementNumber(nrrd) * nrrdElementSize(nrrd),
+                                     nio->zlibLevel,
+                                     ParallelDeflateCodecEnums::Format::Gzip);
+
+    // Attached data follows the header
+    const std::string dataFileName = GetDataFileName(nio, this->GetFileName());
+    const bool        attached = nio->dataFNArr->len == 0;
+    std::ofstream     dataFile(dataFileName, std::ios::binary | (attached ? std::ios::app : std::ios::trunc));
+    dataFile.write(reinterpret_cast<const char *>(compressedData.data()),
+                   static_cast<std::streamsize>(compressedData.size()));
+    if (!dataFile)
+    {
+      itkExceptionMacro("Write: Error writing " << dataFileName << '.');
+    }
+  }
+
   // Free the nrrd struct but don't touch nrrd->data
   nrrdNix(nrrd);
   nrrdIoStateNix(nio);
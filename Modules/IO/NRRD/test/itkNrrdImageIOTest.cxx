@@ -99,6 +99,12 @@ itkNrrdImageIOTest(int argc, char * argv[])
   ret += itkNrrdImageIOTestReadWriteTest<float, 4>(std::string(argv[1]), sz, inputFile, true);
   ret += itkNrrdImageIOTestReadWriteTest<double, 4>(std::string(argv[1]), sz, inputFile, true);
 
+  // Test with compression on multiple threads
+  ret += itkNrrdImageIOTestReadWriteTest<unsigned char, 4>(std::string(argv[1]), sz, inputFile, true, true);
+  ret += itkNrrdImageIOTestReadWriteTest<short, 4>(std::string(argv[1]), sz, inputFile, true, true);
+  ret += itkNrrdImageIOTestReadWriteTest<float, 4>(std::string(argv[1]), sz, inputFile, true, true);
+  ret += itkNrrdImageIOTestReadWriteTest<double, 4>(std::string(argv[1]), sz, inputFile, true, true);
+
   // Now we try to read a file which doesn't exist
   ret += !(itkNrrdImageIOTestReadWriteTest<double, 4>(std::string(argv[1]), sz, "IDontExist.nrrd"));
 
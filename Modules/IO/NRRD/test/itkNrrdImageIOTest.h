@@ -60,7 +60,8 @@ int
 itkNrrdImageIOTestReadWriteTest(const std::string & fn,
                                 unsigned int        size,
                                 const std::string & inputFile,
-                                bool                compression = false)
+                                bool                compression = false,
+                                bool                parallelCompression = false)
 {
   using ImageType = itk::Image<TPixelType, VImageDimension>;
 
@@ -71,6 +72,9 @@ itkNrrdImageIOTestReadWriteTest(const std::string & fn,
 
   ITK_EXERCISE_BASIC_OBJECT_METHODS(io, NrrdImageIO, ImageIOBase);
 
+  ITK_TEST_EXPECT_TRUE(!io->GetUseParallelCompression());
+  io->SetUseParallelCompression(parallelCompression);
+
 
   ITK_TEST_EXPECT_TRUE(io->SupportsDimension(VImageDimension));
 
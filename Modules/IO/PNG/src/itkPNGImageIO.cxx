@@ -285,6 +285,7 @@ PNGImageIO::PNGImageIO()
     this->AddSupportedWriteExtension(ext);
     this->AddSupportedReadExtension(ext);
   }
+  this->AddSupportedReadSignature("\x89PNG\r\n\x1a\n");
 }
 
 PNGImageIO::~PNGImageIO() = default;
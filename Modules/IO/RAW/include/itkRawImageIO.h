@@ -124,6 +124,10 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Binary data can be mapped when in the byte order of the system. */
+  bool
+  CanMapPixelData(std::string & dataFileName, SizeValueType & dataOffset) override;
+
   /** Set/Get the Data mask. */
   /** @ITKStartGrouping */
   itkGetConstReferenceMacro(ImageMask, unsigned short);
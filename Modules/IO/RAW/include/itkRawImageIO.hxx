@@ -161,6 +161,21 @@ RawImageIO<TPixel, VImageDimension>::Read(void * buffer)
   ReadRawBytesAfterSwapping(componentType, buffer, m_ByteOrder, numberOfComponents);
 }
 
+template <typename TPixel, unsigned int VImageDimension>
+bool
+RawImageIO<TPixel, VImageDimension>::CanMapPixelData(std::string & dataFileName, SizeValueType & dataOffset)
+{
+  const IOByteOrderEnum systemByteOrder =
+    ByteSwapper<int>::SystemIsBigEndian() ? IOByteOrderEnum::BigEndian : IOByteOrderEnum::LittleEndian;
+  if (m_FileType != IOFileEnum::Binary || (this->GetComponentSize() > 1 && m_ByteOrder != systemByteOrder))
+  {
+    return false;
+  }
+  dataFileName = m_FileName;
+  dataOffset = this->GetHeaderSize();
+  return true;
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 bool
 RawImageIO<TPixel, VImageDimension>::CanWriteFile(const char * fname)
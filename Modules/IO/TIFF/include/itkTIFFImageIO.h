@@ -38,6 +38,15 @@ class TIFFReaderInternal;
  * supports the compression level for JPEG quality parameter in the
  * range 0-100.
  *
+ * Strips and tiles are decoded directly into the output buffer, concurrently
+ * when they are compressed. Only the strips or tiles which intersect the
+ * requested region are decoded when streaming, so that a small region of a
+ * large tiled image, e.g. a whole-slide image, is read quickly.
+ *
+ * Images are written in strips of about 1 MB, or in tiles when a tile size is
+ * set. The strips or tiles of the "Deflate" and "AdobeDeflate" compressors are
+ * compressed concurrently.
+ *
  * \ingroup IOFilters
  * \ingroup ITKIOTIFF
  *
@@ -83,6 +92,20 @@ public:
   virtual void
   ReadVolume(void * buffer);
 
+  /** Returns true when the file is read through its strips or tiles, which
+   * is the case of all images but those read as RGBA by libtiff. Must be
+   * called after ReadImageInformation(). */
+  bool
+  CanStreamRead() override
+  {
+    return m_CanStreamRead;
+  }
+
+  /** Returns the requested region when streaming is enabled and supported,
+   * and the largest possible region otherwise. */
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const override;
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -180,6 +203,18 @@ public:
   }
   /** @ITKEndGrouping */
 
+  /** Set/Get the width and the height of the tiles of the written images, in
+   * pixels. They are rounded up to multiples of 16, as required by the TIFF
+   * format. Images are written in strips when either of them is zero, which is
+   * the default. ReadImageInformation() sets them to the tile size of the file,
+   * or to zero if it is made of strips. */
+  /** @ITKStartGrouping */
+  itkSetMacro(TileWidth, unsigned int);
+  itkGetConstMacro(TileWidth, unsigned int);
+  itkSetMacro(TileHeight, unsigned int);
+  itkGetConstMacro(TileHeight, unsigned int);
+  /** @ITKEndGrouping */
+
   /** Get a const ref to the palette of the image. In the case of non palette
    * image or ExpandRGBPalette set to true, a vector of size
    * 0 is returned.
@@ -317,6 +352,9 @@ private:
   uint16_t *   m_ColorBlue{};
   uint64_t     m_TotalColors{ 0 };
   unsigned int m_ImageFormat{ TIFFImageIO::NOFORMAT };
+  unsigned int m_TileWidth{ 0 };
+  unsigned int m_TileHeight{ 0 };
+  bool         m_CanStreamRead{ false };
 };
 } // end namespace itk
 
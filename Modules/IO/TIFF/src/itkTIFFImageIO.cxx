@@ -21,11 +21,34 @@
 #include "itksys/SystemTools.hxx"
 #include "itkMetaDataObject.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkMultiThreaderBase.h"
+#include "itkParallelDeflateCodec.h"
 
 #include "itk_tiff.h"
 
+#include <algorithm>
+#include <exception>
+
 namespace itk
 {
+namespace
+{
+// Returns the part of a page in the IO region, which is the whole page when
+// the region has fewer than two dimensions, e.g. when it is not set
+ImageIORegion
+GetPageRegion(const ImageIORegion & ioRegion, uint32_t width, uint32_t height)
+{
+  ImageIORegion pageRegion(2);
+  pageRegion.SetSize(0, width);
+  pageRegion.SetSize(1, height);
+  for (unsigned int i = 0; i < 2 && i < ioRegion.GetImageDimension(); ++i)
+  {
+    pageRegion.SetIndex(i, ioRegion.GetIndex(i));
+    pageRegion.SetSize(i, ioRegion.GetSize(i));
+  }
+  return pageRegion;
+}
+} // namespace
 
 bool
 TIFFImageIO::CanReadFile(const char * file)
@@ -147,10 +170,20 @@ TIFFImageIO::GetFormat()
 void
 TIFFImageIO::ReadVolume(void * buffer)
 {
-  const size_t width{ m_InternalImage->m_Width };
-  const size_t height{ m_InternalImage->m_Height };
+  // Only the pages of the IO region are read when streaming
+  const ImageIORegion & ioRegion = this->GetIORegion();
+  const ImageIORegion   pageRegion = GetPageRegion(ioRegion, m_InternalImage->m_Width, m_InternalImage->m_Height);
+  const size_t          pageSize = pageRegion.GetNumberOfPixels() * this->GetNumberOfComponents();
+  SizeValueType         firstSlice = 0;
+  SizeValueType         endSlice = m_InternalImage->m_NumberOfPages;
+  if (ioRegion.GetImageDimension() > 2)
+  {
+    firstSlice = static_cast<SizeValueType>(ioRegion.GetIndex(2));
+    endSlice = firstSlice + ioRegion.GetSize(2);
+  }
 
-  for (uint16_t page = 0; page < m_InternalImage->m_NumberOfPages; ++page)
+  SizeValueType slice = 0;
+  for (uint16_t page = 0; page < m_InternalImage->m_NumberOfPages && slice < endSlice; ++page)
   {
     if (m_InternalImage->m_IgnoredSubFiles > 0)
     {
@@ -167,9 +200,11 @@ TIFFImageIO::ReadVolume(void * buffer)
     }
 
 
-    const size_t pixelOffset = width * height * this->GetNumberOfComponents() * page;
-
-    ReadCurrentPage(buffer, pixelOffset);
+    if (slice >= firstSlice)
+    {
+      ReadCurrentPage(buffer, pageSize * (slice - firstSlice));
+    }
+    ++slice;
 
     TIFFReadDirectory(m_InternalImage->m_Image);
   }
@@ -203,6 +238,16 @@ TIFFImageIO::Read(void * buffer)
   m_InternalImage->Clean();
 }
 
+ImageIORegion
+TIFFImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const
+{
+  if (!m_UseStreamedReading || !m_CanStreamRead)
+  {
+    return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requestedRegion);
+  }
+  return requestedRegion;
+}
+
 TIFFImageIO::TIFFImageIO()
   : m_InternalImage(new TIFFReaderInternal)
   , m_ColorPalette(0)
@@ -229,6 +274,11 @@ TIFFImageIO::TIFFImageIO()
     this->AddSupportedWriteExtension(ext);
     this->AddSupportedReadExtension(ext);
   }
+  // little and big endian, classic and BigTIFF files
+  this->AddSupportedReadSignature(std::string("II*\0", 4));
+  this->AddSupportedReadSignature(std::string("MM\0*", 4));
+  this->AddSupportedReadSignature(std::string("II+\0", 4));
+  this->AddSupportedReadSignature(std::string("MM\0+", 4));
 }
 
 TIFFImageIO::~TIFFImageIO()
@@ -244,6 +294,9 @@ TIFFImageIO::PrintSelf(std::ostream & os, Indent indent) const
 
   os << indent << "Compression: " << m_Compression << std::endl;
   os << indent << "JPEGQuality: " << this->GetJPEGQuality() << std::endl;
+  os << indent << "TileWidth: " << m_TileWidth << std::endl;
+  os << indent << "TileHeight: " << m_TileHeight << std::endl;
+  os << indent << "CanStreamRead: " << (m_CanStreamRead ? "On" : "Off") << std::endl;
   if (!m_ColorPalette.empty())
   {
     os << indent << "Image RGB palette:" << '\n';
@@ -392,6 +445,9 @@ TIFFImageIO::ReadImageInformation()
   m_Dimensions[0] = m_InternalImage->m_Width;
   m_Dimensions[1] = m_InternalImage->m_Height;
 
+  m_TileWidth = m_InternalImage->m_TileWidth;
+  m_TileHeight = m_InternalImage->m_TileHeight;
+
   if (m_InternalImage->m_BitsPerSample <= 8)
   {
     if (m_InternalImage->m_SampleFormat == 2)
@@ -491,6 +547,8 @@ TIFFImageIO::ReadImageInformation()
   }
 
 
+  // The strips or tiles are decoded by this class, unless the image is read as RGBA by libtiff
+  m_CanStreamRead = m_InternalImage->CanRead();
   if (!m_InternalImage->CanRead())
   {
     //  exception if compression is not supported
@@ -569,6 +627,108 @@ TIFFImageIO::Write(const void * buffer)
   }
 }
 
+namespace
+{
+// Writes a page in strips of blockHeight rows, or in tiles of blockWidth x
+// blockHeight pixels. The strips or tiles are either deflated concurrently and
+// then written as raw data, or encoded one after the other by libtiff.
+void
+WritePageBlocks(TIFF *       tif,
+                const char * page,
+                uint32_t     width,
+                uint32_t     height,
+                size_t       pixelSize,
+                bool         isTiled,
+                uint32_t     blockWidth,
+                uint32_t     blockHeight,
+                bool         deflateConcurrently)
+{
+  const size_t   rowSize = size_t{ width } * pixelSize;
+  const uint32_t blocksPerRow = isTiled ? (width + blockWidth - 1) / blockWidth : 1;
+  const uint32_t numberOfBlocks = blocksPerRow * ((height + blockHeight - 1) / blockHeight);
+
+  // The rows of a strip are contiguous in the page, while the ones of a tile
+  // are copied into the tile buffer, padded with zeros at the image border
+  const auto getBlock = [=](uint32_t block, std::vector<char> & tile) -> std::pair<const char *, size_t> {
+    const uint32_t blockY = block / blocksPerRow * blockHeight;
+    const uint32_t rows = std::min(blockHeight, height - blockY);
+    if (!isTiled)
+    {
+      return { page + blockY * rowSize, rows * rowSize };
+    }
+    const uint32_t blockX = block % blocksPerRow * blockWidth;
+    const size_t   blockRowSize = size_t{ blockWidth } * pixelSize;
+    const size_t   columnsSize = std::min(blockWidth, width - blockX) * pixelSize;
+    tile.assign(blockRowSize * blockHeight, 0);
+    for (uint32_t row = 0; row < rows; ++row)
+    {
+      std::copy_n(page + (blockY + row) * rowSize + blockX * pixelSize, columnsSize, tile.data() + row * blockRowSize);
+    }
+    return { tile.data(), tile.size() };
+  };
+
+  const auto writeBlock = [tif, isTiled](uint32_t block, const void * data, size_t size, bool isRaw) {
+    void * const   blockData = const_cast<void *>(data);
+    const auto     blockSize = static_cast<tmsize_t>(size);
+    const tmsize_t written = isRaw ? (isTiled ? TIFFWriteRawTile(tif, block, blockData, blockSize)
+                                              : TIFFWriteRawStrip(tif, block, blockData, blockSize))
+                                   : (isTiled ? TIFFWriteEncodedTile(tif, block, blockData, blockSize)
+                                              : TIFFWriteEncodedStrip(tif, block, blockData, blockSize));
+    if (written < 0)
+    {
+      itkGenericExceptionMacro("TIFFImageIO: error out of disk space");
+    }
+  };
+
+  if (!deflateConcurrently)
+  {
+    std::vector<char> tile;
+    for (uint32_t block = 0; block < numberOfBlocks; ++block)
+    {
+      const std::pair<const char *, size_t> blockData = getBlock(block, tile);
+      writeBlock(block, blockData.first, blockData.second, false);
+    }
+    return;
+  }
+
+  // Batches of blocks are deflated concurrently, and then written in order
+  const uint32_t batchSize = 4 * MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  std::vector<std::vector<char>>          tiles(batchSize);
+  std::vector<std::vector<unsigned char>> deflatedBlocks(batchSize);
+  std::vector<std::exception_ptr>         exceptions(batchSize);
+  for (uint32_t batchBegin = 0; batchBegin < numberOfBlocks; batchBegin += batchSize)
+  {
+    const uint32_t batchEnd = std::min(numberOfBlocks, batchBegin + batchSize);
+    MultiThreaderBase::New()->ParallelizeArray(
+      batchBegin,
+      batchEnd,
+      [&](SizeValueType block) {
+        const SizeValueType i = block - batchBegin;
+        try
+        {
+          const std::pair<const char *, size_t> blockData = getBlock(static_cast<uint32_t>(block), tiles[i]);
+          deflatedBlocks[i] = ParallelDeflateCodec::Compress(
+            blockData.first, blockData.second, -1, ParallelDeflateCodec::FormatEnum::Zlib, blockData.second);
+        }
+        catch (...)
+        {
+          exceptions[i] = std::current_exception();
+        }
+      },
+      nullptr);
+    for (uint32_t block = batchBegin; block < batchEnd; ++block)
+    {
+      const uint32_t i = block - batchBegin;
+      if (exceptions[i])
+      {
+        std::rethrow_exception(exceptions[i]);
+      }
+      writeBlock(block, deflatedBlocks[i].data(), deflatedBlocks[i].size(), true);
+    }
+  }
+}
+} // namespace
+
 void
 TIFFImageIO::InternalWrite(const void * buffer)
 {
@@ -756,38 +916,53 @@ TIFFImageIO::InternalWrite(const void * buffer)
     }
 
 
-    // Previously, rowsperstrip was set to a default value so that it would be calculated using
-    // the STRIP_SIZE_DEFAULT defined to be 8 kB in tiffiop.h.
-    // However, this a very conservative small number, and it leads to very small strips resulting
-    // in many io operations, which can be slow when written over networks that require
-    // encryption/decryption of each packet (such as sshfs).
-    // Conversely, if the value is too high, a lot of extra memory is required to store the strips
-    // before they are written out.
-    // Experiments writing TIFF images to drives mapped by sshfs showed that a good tradeoff is
-    // achieved when the STRIP_SIZE_DEFAULT is increased to 1 MB.
-    // This results in an increase in memory usage but no increase in writing time when writing
-    // locally and significant writing time improvement when writing over sshfs.
-    // For example, writing a 2048x2048 uint16_t image with 8 kB per strip leads to 2 rows per strip
-    // and takes about 120 seconds writing over sshfs.
-    // Using 1 MB per strip leads to 256 rows per strip, which takes only 4 seconds to write over sshfs.
-    // Rather than change that value in the third party libtiff library, we instead compute the
-    // rowsperstrip here to lead to this same value.
-#ifdef TIFF_INT64_T // detect if libtiff4
-    uint64_t const scanlinesize = TIFFScanlineSize64(tif);
-#else
-    tsize_t scanlinesize = TIFFScanlineSize(tif);
-#endif
-    if (scanlinesize == 0)
+    // Tiles are multiples of 16 x 16 pixels, as required by the TIFF format
+    const bool isTiled = m_TileWidth > 0 && m_TileHeight > 0;
+    uint32_t   blockWidth = w;
+    uint32_t   blockHeight = 0;
+    if (isTiled)
     {
-      itkExceptionStringMacro("TIFFScanlineSize returned 0");
+      blockWidth = (m_TileWidth + 15) / 16 * 16;
+      blockHeight = (m_TileHeight + 15) / 16 * 16;
+      TIFFSetField(tif, TIFFTAG_TILEWIDTH, blockWidth);
+      TIFFSetField(tif, TIFFTAG_TILELENGTH, blockHeight);
     }
-    rowsperstrip = static_cast<uint32_t>(1024 * 1024 / scanlinesize);
-    if (rowsperstrip < 1)
+    else
     {
-      rowsperstrip = 1;
-    }
+      // Previously, rowsperstrip was set to a default value so that it would be calculated using
+      // the STRIP_SIZE_DEFAULT defined to be 8 kB in tiffiop.h.
+      // However, this a very conservative small number, and it leads to very small strips resulting
+      // in many io operations, which can be slow when written over networks that require
+      // encryption/decryption of each packet (such as sshfs).
+      // Conversely, if the value is too high, a lot of extra memory is required to store the strips
+      // before they are written out.
+      // Experiments writing TIFF images to drives mapped by sshfs showed that a good tradeoff is
+      // achieved when the STRIP_SIZE_DEFAULT is increased to 1 MB.
+      // This results in an increase in memory usage but no increase in writing time when writing
+      // locally and significant writing time improvement when writing over sshfs.
+      // For example, writing a 2048x2048 uint16_t image with 8 kB per strip leads to 2 rows per strip
+      // and takes about 120 seconds writing over sshfs.
+      // Using 1 MB per strip leads to 256 rows per strip, which takes only 4 seconds to write over sshfs.
+      // Rather than change that value in the third party libtiff library, we instead compute the
+      // rowsperstrip here to lead to this same value.
+#ifdef TIFF_INT64_T // detect if libtiff4
+      uint64_t const scanlinesize = TIFFScanlineSize64(tif);
+#else
+      tsize_t scanlinesize = TIFFScanlineSize(tif);
+#endif
+      if (scanlinesize == 0)
+      {
+        itkExceptionStringMacro("TIFFScanlineSize returned 0");
+      }
+      rowsperstrip = static_cast<uint32_t>(1024 * 1024 / scanlinesize);
+      if (rowsperstrip < 1)
+      {
+        rowsperstrip = 1;
+      }
 
-    TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, TIFFDefaultStripSize(tif, rowsperstrip));
+      blockHeight = TIFFDefaultStripSize(tif, rowsperstrip);
+      TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, blockHeight);
+    }
 
     if (resolution_x > 0 && resolution_y > 0)
     {
@@ -827,18 +1002,13 @@ TIFFImageIO::InternalWrite(const void * buffer)
     }
 
     rowLength *= this->GetNumberOfComponents();
+    const size_t pixelSize = rowLength;
     rowLength *= width;
 
-    uint32_t row = 0;
-    for (unsigned int idx2 = 0; idx2 < height; ++idx2)
-    {
-      if (TIFFWriteScanline(tif, const_cast<char *>(outPtr), row, 0) < 0)
-      {
-        itkExceptionStringMacro("TIFFImageIO: error out of disk space");
-      }
-      outPtr += rowLength;
-      ++row;
-    }
+    // Only deflate is done concurrently, libtiff encodes the others on its own
+    const bool deflateConcurrently = (compression == COMPRESSION_DEFLATE || compression == COMPRESSION_ADOBE_DEFLATE);
+    WritePageBlocks(tif, outPtr, w, h, pixelSize, isTiled, blockWidth, blockHeight, deflateConcurrently);
+    outPtr += rowLength * height;
 
     if (m_NumberOfDimensions == 3)
     {
@@ -1325,18 +1495,6 @@ TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int heig
 {
   using ComponentType = TComponent;
 
-#ifdef TIFF_INT64_T // detect if libtiff4
-  uint64_t isize = TIFFScanlineSize64(m_InternalImage->m_Image);
-#else
-  tsize_t isize = TIFFScanlineSize(m_InternalImage->m_Image);
-#endif
-
-  size_t  inc = 0;
-  tdata_t buf = _TIFFmalloc(static_cast<tmsize_t>(isize));
-  isize /= sizeof(ComponentType);
-
-  auto * out = static_cast<ComponentType *>(_out);
-
   if (m_InternalImage->m_PlanarConfig != PLANARCONFIG_CONTIG && m_InternalImage->m_SamplesPerPixel != 1)
   {
     itkExceptionStringMacro("This reader can only do PLANARCONFIG_CONTIG or single-component PLANARCONFIG_SEPARATE");
@@ -1347,7 +1505,7 @@ TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int heig
     itkExceptionStringMacro("This reader can only do ORIENTATION_TOPLEFT and  ORIENTATION_BOTLEFT.");
   }
 
-
+  size_t inc = 0;
   switch (this->GetFormat())
   {
     case TIFFImageIO::GRAYSCALE:
@@ -1374,41 +1532,28 @@ TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int heig
       break;
   }
 
-  for (uint32_t row = 0; row < height; ++row)
-  {
-    if (TIFFReadScanline(m_InternalImage->m_Image, buf, row, 0) <= 0)
-    {
-      itkExceptionMacro("Problem reading the row: " << row);
-    }
-    ComponentType * image = nullptr;
-    if (m_InternalImage->m_Orientation == ORIENTATION_TOPLEFT)
-    {
-      image = out + inc * row * width;
-    }
-    else // bottom left
-    {
-      image = out + inc * width * (height - (row + 1));
-    }
-
+  // Converts a row of width pixels of the file into the output
+  const auto putRow = [this](ComponentType * image, void * buf, unsigned int rowWidth) {
     switch (this->GetFormat())
     {
       case TIFFImageIO::GRAYSCALE:
         // check inverted
-        PutGrayscale<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
+        PutGrayscale<ComponentType>(image, static_cast<ComponentType *>(buf), rowWidth, 1, 0, 0);
         break;
       case TIFFImageIO::RGB_:
-        PutRGB_<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
+        PutRGB_<ComponentType>(image, static_cast<ComponentType *>(buf), rowWidth, 1, 0, 0);
         break;
 
       case TIFFImageIO::PALETTE_GRAYSCALE:
         switch (m_InternalImage->m_BitsPerSample)
         {
           case 8:
-            PutPaletteGrayscale<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
+            PutPaletteGrayscale<ComponentType, unsigned char>(
+              image, static_cast<unsigned char *>(buf), rowWidth, 1, 0, 0);
             break;
           case 16:
             PutPaletteGrayscale<ComponentType, unsigned short>(
-              image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
+              image, static_cast<unsigned short *>(buf), rowWidth, 1, 0, 0);
             break;
           default:
             itkExceptionMacro("Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
@@ -1421,10 +1566,11 @@ TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int heig
           switch (m_InternalImage->m_BitsPerSample)
           {
             case 8:
-              PutPaletteRGB<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
+              PutPaletteRGB<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), rowWidth, 1, 0, 0);
               break;
             case 16:
-              PutPaletteRGB<ComponentType, unsigned short>(image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
+              PutPaletteRGB<ComponentType, unsigned short>(
+                image, static_cast<unsigned short *>(buf), rowWidth, 1, 0, 0);
               break;
             default:
               itkExceptionMacro("Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
@@ -1436,11 +1582,12 @@ TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int heig
           switch (m_InternalImage->m_BitsPerSample)
           {
             case 8:
-              PutPaletteScalar<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
+              PutPaletteScalar<ComponentType, unsigned char>(
+                image, static_cast<unsigned char *>(buf), rowWidth, 1, 0, 0);
               break;
             case 16:
               PutPaletteScalar<ComponentType, unsigned short>(
-                image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
+                image, static_cast<unsigned short *>(buf), rowWidth, 1, 0, 0);
               break;
             default:
               itkExceptionMacro("Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
@@ -1452,9 +1599,136 @@ TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int heig
       default:
         itkExceptionStringMacro("Logic Error: Unexpected format!");
     }
+  };
+
+  // The part of the page to read, which is the whole page unless streaming
+  const ImageIORegion pageRegion = GetPageRegion(this->GetIORegion(), width, height);
+  if (pageRegion.GetIndex(0) < 0 || pageRegion.GetIndex(1) < 0 ||
+      pageRegion.GetIndex(0) + pageRegion.GetSize(0) > width || pageRegion.GetIndex(1) + pageRegion.GetSize(1) > height)
+  {
+    itkExceptionMacro("The region to read " << pageRegion << " is outside of the page of size " << width << 'x'
+                                            << height);
   }
+  const auto regionX = static_cast<uint32_t>(pageRegion.GetIndex(0));
+  const auto regionY = static_cast<uint32_t>(pageRegion.GetIndex(1));
+  const auto regionWidth = static_cast<uint32_t>(pageRegion.GetSize(0));
+  const auto regionHeight = static_cast<uint32_t>(pageRegion.GetSize(1));
 
-  _TIFFfree(buf);
+  // The rows of the region in the file, in which the rows of a ORIENTATION_BOTLEFT image are upside down
+  const bool     isBottomUp = (m_InternalImage->m_Orientation == ORIENTATION_BOTLEFT);
+  const uint32_t beginRow = isBottomUp ? height - regionY - regionHeight : regionY;
+  const uint32_t endRow = beginRow + regionHeight;
+
+  TIFF * const image = m_InternalImage->m_Image;
+  const bool   isTiled = (TIFFIsTiled(image) != 0);
+  uint32_t     blockWidth = width;
+  uint32_t     blockHeight = height;
+  if (isTiled)
+  {
+    if (!TIFFGetField(image, TIFFTAG_TILEWIDTH, &blockWidth) || !TIFFGetField(image, TIFFTAG_TILELENGTH, &blockHeight))
+    {
+      itkExceptionStringMacro("Cannot read tile width and tile length from file");
+    }
+  }
+  else
+  {
+    TIFFGetFieldDefaulted(image, TIFFTAG_ROWSPERSTRIP, &blockHeight);
+    blockHeight = std::min(blockHeight, height);
+  }
+  if (blockWidth == 0 || blockHeight == 0)
+  {
+    itkExceptionStringMacro("Invalid size of the strips or tiles of the file");
+  }
+
+  // The strips or tiles which intersect the region, given by their upper left corner
+  std::vector<std::pair<uint32_t, uint32_t>> blocks;
+  for (uint64_t y = beginRow - beginRow % blockHeight; y < endRow; y += blockHeight)
+  {
+    for (uint64_t x = regionX - regionX % blockWidth; x < uint64_t{ regionX } + regionWidth; x += blockWidth)
+    {
+      blocks.emplace_back(static_cast<uint32_t>(x), static_cast<uint32_t>(y));
+    }
+  }
+
+  const tmsize_t blockSize = isTiled ? TIFFTileSize(image) : TIFFStripSize(image);
+  const size_t   pixelSize = size_t{ m_InternalImage->m_SamplesPerPixel } * (m_InternalImage->m_BitsPerSample / 8);
+  const size_t   blockRowSize = size_t{ blockWidth } * pixelSize;
+  auto *         out = static_cast<ComponentType *>(_out);
+
+  // Decodes the blocks from begin to end with the given handle, and puts the
+  // part of their rows in the region into the output
+  const auto readBlocks = [&, this](TIFF * blockImage, size_t begin, size_t end) {
+    const auto buf = make_unique_for_overwrite<unsigned char[]>(static_cast<size_t>(blockSize));
+    for (size_t i = begin; i < end; ++i)
+    {
+      const uint32_t blockX = blocks[i].first;
+      const uint32_t blockY = blocks[i].second;
+      const tmsize_t readSize =
+        isTiled
+          ? TIFFReadEncodedTile(blockImage, TIFFComputeTile(blockImage, blockX, blockY, 0, 0), buf.get(), blockSize)
+          : TIFFReadEncodedStrip(blockImage, TIFFComputeStrip(blockImage, blockY, 0), buf.get(), blockSize);
+      if (readSize < 0)
+      {
+        itkExceptionMacro("Problem reading the " << (isTiled ? "tile" : "strip") << " at row " << blockY
+                                                 << " and column " << blockX);
+      }
+
+      const uint32_t beginColumn = std::max(blockX, regionX);
+      const uint32_t endColumn =
+        static_cast<uint32_t>(std::min(uint64_t{ blockX } + blockWidth, uint64_t{ regionX } + regionWidth));
+      const uint32_t endBlockRow =
+        static_cast<uint32_t>(std::min(uint64_t{ blockY } + blockHeight, uint64_t{ endRow }));
+      for (uint32_t row = std::max(blockY, beginRow); row < endBlockRow; ++row)
+      {
+        const size_t outRow = (isBottomUp ? height - (row + 1) : row) - regionY;
+        putRow(out + inc * (outRow * regionWidth + (beginColumn - regionX)),
+               buf.get() + (row - blockY) * blockRowSize + (beginColumn - blockX) * pixelSize,
+               endColumn - beginColumn);
+      }
+    }
+  };
+
+  // Compressed blocks are decoded concurrently, by work units which each
+  // have their own handle on the file
+  uint16_t compression = COMPRESSION_NONE;
+  TIFFGetFieldDefaulted(image, TIFFTAG_COMPRESSION, &compression);
+  size_t numberOfWorkUnits = 1;
+  if (compression != COMPRESSION_NONE)
+  {
+    numberOfWorkUnits = std::min(blocks.size(), size_t{ MultiThreaderBase::GetGlobalDefaultNumberOfThreads() });
+  }
+  if (numberOfWorkUnits <= 1)
+  {
+    readBlocks(image, 0, blocks.size());
+    return;
+  }
+
+  const std::vector<TIFF *> images =
+    m_InternalImage->GetWorkUnitImages(static_cast<unsigned int>(numberOfWorkUnits));
+  std::vector<std::exception_ptr> exceptions(numberOfWorkUnits);
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    static_cast<SizeValueType>(numberOfWorkUnits),
+    [&](SizeValueType workUnit) {
+      try
+      {
+        readBlocks(images[workUnit],
+                   blocks.size() * workUnit / numberOfWorkUnits,
+                   blocks.size() * (workUnit + 1) / numberOfWorkUnits);
+      }
+      catch (...)
+      {
+        exceptions[workUnit] = std::current_exception();
+      }
+    },
+    nullptr);
+  for (const std::exception_ptr & exception : exceptions)
+  {
+    if (exception)
+    {
+      std::rethrow_exception(exception);
+    }
+  }
 }
 
 // iso component scalar
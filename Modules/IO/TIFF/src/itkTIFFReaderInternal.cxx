@@ -103,6 +103,27 @@ TIFFReaderInternal::Open(const char * filename, bool silent)
     return 0;
 #endif
   }
+  this->m_Image = this->OpenImage(filename, silent);
+  if (!this->m_Image)
+  {
+    this->Clean();
+    return 0;
+  }
+  if (!this->Initialize())
+  {
+    this->Clean();
+    return 0;
+  }
+
+  this->m_WarningSilence = false;
+  this->m_ErrorSilence = false;
+  this->m_IsOpen = true;
+  return 1;
+}
+
+TIFF *
+TIFFReaderInternal::OpenImage(const char * filename, bool silent)
+{
 // Macro added in libtiff 4.5.0
 #if defined(TIFFLIB_AT_LEAST)
 
@@ -113,7 +134,7 @@ TIFFReaderInternal::Open(const char * filename, bool silent)
   {
     this->m_ErrorSilence = true;
   }
-  this->m_Image = TIFFOpenExt(filename, "r", options.get());
+  return TIFFOpenExt(filename, "r", options.get());
 
 #else
   if (silent)
@@ -122,30 +143,40 @@ TIFFReaderInternal::Open(const char * filename, bool silent)
     // Now check if this is a valid TIFF image
     TIFFErrorHandler error_save = TIFFSetErrorHandler(nullptr);
 
-    this->m_Image = TIFFOpen(filename, "r");
+    TIFF * const image = TIFFOpen(filename, "r");
     TIFFSetErrorHandler(error_save);
+    return image;
   }
-  else
-  {
-    this->m_Image = TIFFOpen(filename, "r");
-  }
+  return TIFFOpen(filename, "r");
 
 #endif
-  if (!this->m_Image)
-  {
-    this->Clean();
-    return 0;
-  }
-  if (!this->Initialize())
+}
+
+std::vector<TIFF *>
+TIFFReaderInternal::GetWorkUnitImages(unsigned int numberOfWorkUnits)
+{
+  const tdir_t        directory = TIFFCurrentDirectory(this->m_Image);
+  std::vector<TIFF *> images{ this->m_Image };
+  for (unsigned int workUnit = 1; workUnit < numberOfWorkUnits; ++workUnit)
   {
-    this->Clean();
-    return 0;
+    if (workUnit > this->m_WorkUnitImages.size())
+    {
+      TIFF * const image = this->OpenImage(TIFFFileName(this->m_Image), false);
+      if (!image)
+      {
+        itkGenericExceptionMacro("Cannot open file " << TIFFFileName(this->m_Image)
+                                                     << " again to read it concurrently");
+      }
+      this->m_WorkUnitImages.push_back(image);
+    }
+    TIFF * const image = this->m_WorkUnitImages[workUnit - 1];
+    if (TIFFCurrentDirectory(image) != directory && !TIFFSetDirectory(image, directory))
+    {
+      itkGenericExceptionMacro("Cannot read directory " << directory << " of file " << TIFFFileName(image));
+    }
+    images.push_back(image);
   }
-
-  this->m_WarningSilence = false;
-  this->m_ErrorSilence = false;
-  this->m_IsOpen = true;
-  return 1;
+  return images;
 }
 
 void
@@ -156,6 +187,11 @@ TIFFReaderInternal::Clean()
     TIFFClose(this->m_Image);
   }
   this->m_Image = nullptr;
+  for (TIFF * const image : this->m_WorkUnitImages)
+  {
+    TIFFClose(image);
+  }
+  this->m_WorkUnitImages.clear();
   this->m_Width = 0;
   this->m_Height = 0;
   this->m_SamplesPerPixel = 0;
@@ -284,9 +320,7 @@ TIFFReaderInternal::CanRead()
 {
   const bool compressionSupported = (TIFFIsCODECConfigured(this->m_Compression) == 1);
   return (this->m_Image && (this->m_Width > 0) && (this->m_Height > 0) && (this->m_SamplesPerPixel > 0) &&
-          compressionSupported && (m_NumberOfTiles == 0) // just use TIFFReadRGBAImage, an
-                                                         // native optimized version would be nice
-          && (this->m_HasValidPhotometricInterpretation) &&
+          compressionSupported && (this->m_HasValidPhotometricInterpretation) &&
           (this->m_Photometrics == PHOTOMETRIC_RGB || this->m_Photometrics == PHOTOMETRIC_MINISWHITE ||
            this->m_Photometrics == PHOTOMETRIC_MINISBLACK ||
            (this->m_Photometrics == PHOTOMETRIC_PALETTE && this->m_BitsPerSample != 32)) &&
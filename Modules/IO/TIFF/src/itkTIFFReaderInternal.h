@@ -22,6 +22,8 @@
 #include "itkIntTypes.h"
 #include "itk_tiff.h"
 
+#include <vector>
+
 
 namespace itk
 {
@@ -42,6 +44,13 @@ public:
   int
   Open(const char * filename, bool silent = false);
 
+  /** Returns a handle on the current directory of the file for each of
+   * numberOfWorkUnits work units, the first one being m_Image. As a libtiff
+   * handle may not be used by several threads at once, the others are opened
+   * on the same file, and kept open until Clean() to read the next pages. */
+  std::vector<TIFF *>
+  GetWorkUnitImages(unsigned int numberOfWorkUnits);
+
   TIFF *   m_Image{ nullptr };
   bool     m_IsOpen;
   uint32_t m_Width;
@@ -69,6 +78,12 @@ public:
 
   bool m_WarningSilence{ false };
   bool m_ErrorSilence{ false };
+
+private:
+  TIFF *
+  OpenImage(const char * filename, bool silent);
+
+  std::vector<TIFF *> m_WorkUnitImages{};
 };
 
 } // namespace itk
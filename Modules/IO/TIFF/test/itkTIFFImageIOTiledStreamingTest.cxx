@@ -0,0 +1,190 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkTIFFImageIO.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkRGBPixel.h"
+#include "itkTestingImageIOStreamingHelpers.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+// Fills an image with values which differ between neighboring tiles and strips
+template <typename TImage>
+typename TImage::Pointer
+CreateImage(const typename TImage::SizeType & size)
+{
+  using PixelTraits = itk::DefaultConvertPixelTraits<typename TImage::PixelType>;
+  using ValueType = typename PixelTraits::ComponentType;
+
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const typename TImage::IndexType index = it.GetIndex();
+    typename TImage::PixelType       pixel;
+    for (unsigned int c = 0; c < PixelTraits::GetNumberOfComponents(); ++c)
+    {
+      PixelTraits::SetNthComponent(
+        c, pixel, static_cast<ValueType>(index[0] + 7 * index[1] + 1000 * index[TImage::ImageDimension - 1] + 11 * c));
+    }
+    it.Set(pixel);
+  }
+  return image;
+}
+
+template <typename TImage>
+void
+Write(const TImage * image, const std::string & fileName, itk::TIFFImageIO * tiffImageIO)
+{
+  auto writer = itk::ImageFileWriter<TImage>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(tiffImageIO);
+  writer->UseCompressionOn();
+  writer->Update();
+}
+
+// Writes the image in strips or tiles, and reads it back whole, in regions and streamed
+template <typename TImage>
+bool
+TestWriteRead(const TImage *                      image,
+              const std::string &                 fileName,
+              const typename TImage::RegionType & region,
+              unsigned int                        tileSize)
+{
+  for (const char * compressor : { "NoCompression", "PackBits", "AdobeDeflate", "LZW" })
+  {
+    std::cout << "Compressor " << compressor << ", tile size " << tileSize << std::endl;
+    auto tiffImageIO = itk::TIFFImageIO::New();
+    tiffImageIO->SetCompressor(compressor);
+    tiffImageIO->SetTileWidth(tileSize);
+    tiffImageIO->SetTileHeight(tileSize);
+    Write(image, fileName, tiffImageIO.GetPointer());
+
+    auto readImageIO = itk::TIFFImageIO::New();
+    readImageIO->SetFileName(fileName);
+    readImageIO->ReadImageInformation();
+    // tiles are rounded up to multiples of 16
+    const unsigned int expectedTileSize = (tileSize + 15) / 16 * 16;
+    if (readImageIO->GetTileWidth() != expectedTileSize || readImageIO->GetTileHeight() != expectedTileSize ||
+        !readImageIO->CanStreamRead())
+    {
+      std::cerr << "Unexpected tile size " << readImageIO->GetTileWidth() << 'x' << readImageIO->GetTileHeight()
+                << " or streaming support " << readImageIO->CanStreamRead() << std::endl;
+      return false;
+    }
+
+    const typename TImage::Pointer readImage = itk::ReadImage<TImage>(fileName);
+    if (readImage->GetBufferedRegion() != image->GetLargestPossibleRegion() ||
+        !itk::Testing::HasExpectedPixels(readImage.get(), image))
+    {
+      std::cerr << "Failed to read the whole image" << std::endl;
+      return false;
+    }
+
+    const typename TImage::Pointer regionImage =
+      itk::Testing::ReadImageRegion<TImage>(fileName, region, itk::TIFFImageIO::New());
+    if (regionImage->GetBufferedRegion() != region || !itk::Testing::HasExpectedPixels(regionImage.get(), image))
+    {
+      std::cerr << "Failed to read the region " << region << std::endl;
+      return false;
+    }
+
+    const typename TImage::Pointer streamedImage =
+      itk::Testing::ReadImageStreamed<TImage>(fileName, 7, itk::TIFFImageIO::New());
+    if (!itk::Testing::HasExpectedPixels(streamedImage.get(), image))
+    {
+      std::cerr << "Failed to read the image streamed" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkTIFFImageIOTiledStreamingTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  // Strips and tiles are decoded and deflated concurrently, even on a single core
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(4);
+
+  auto tiffImageIO = itk::TIFFImageIO::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(tiffImageIO, TIFFImageIO, ImageIOBase);
+  ITK_TEST_SET_GET_VALUE(0, tiffImageIO->GetTileWidth());
+  ITK_TEST_SET_GET_VALUE(0, tiffImageIO->GetTileHeight());
+  tiffImageIO->SetTileWidth(64);
+  ITK_TEST_SET_GET_VALUE(64, tiffImageIO->GetTileWidth());
+  tiffImageIO->SetTileHeight(40);
+  ITK_TEST_SET_GET_VALUE(40, tiffImageIO->GetTileHeight());
+
+  // 16-bit images keep their precision when tiled, with strips of about 1 MB
+  // so that the image has several ones
+  using ShortImageType = itk::Image<unsigned short, 2>;
+  const ShortImageType::Pointer    shortImage = CreateImage<ShortImageType>({ { 1031, 563 } });
+  const ShortImageType::RegionType shortRegion({ { 100, 37 } }, { { 250, 500 } });
+  const std::string                shortFileName = outputDirectory + "/itkTIFFImageIOTiledStreamingTest.tif";
+  for (const unsigned int tileSize : { 0, 64, 100 })
+  {
+    if (!TestWriteRead(shortImage.get(), shortFileName, shortRegion, tileSize))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Multipage RGB images are read page by page
+  using RGBImageType = itk::Image<itk::RGBPixel<unsigned char>, 3>;
+  const RGBImageType::Pointer    rgbImage = CreateImage<RGBImageType>({ { 90, 70, 5 } });
+  const RGBImageType::RegionType rgbRegion({ { 17, 31, 1 } }, { { 50, 33, 3 } });
+  const std::string              rgbFileName = outputDirectory + "/itkTIFFImageIOTiledStreamingTestRGB.tif";
+  for (const unsigned int tileSize : { 0, 32 })
+  {
+    if (!TestWriteRead(rgbImage.get(), rgbFileName, rgbRegion, tileSize))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Without streaming, the whole image is read
+  auto reader = itk::ImageFileReader<RGBImageType>::New();
+  reader->SetFileName(rgbFileName);
+  reader->SetUseStreaming(false);
+  reader->UpdateOutputInformation();
+  reader->GetOutput()->SetRequestedRegion(rgbRegion);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetBufferedRegion(), rgbImage->GetLargestPossibleRegion());
+  ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(reader->GetOutput(), rgbImage.get()));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
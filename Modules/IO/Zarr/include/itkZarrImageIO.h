@@ -0,0 +1,267 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkZarrImageIO_h
+#define itkZarrImageIO_h
+#include "ITKIOZarrExport.h"
+
+#include "itkImageIOBase.h"
+
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class ZarrImageIO
+ *
+ * \brief ImageIO for chunked, multiscale images stored in a Zarr directory.
+ *
+ * The image is stored in a local directory (with the ".zarr" extension) as a
+ * Zarr version 2 group, whose OME-NGFF 0.4 "multiscales" attributes list a
+ * pyramid of arrays: "0" holds the image at full resolution, and each
+ * following level is downsampled by 2 from the previous one by averaging the
+ * pixels along the first three (spatial) dimensions. Each array is split into
+ * chunks of ChunkSize pixels, each one stored in its own file, either
+ * zlib-compressed or raw. The chunks of a region are compressed and
+ * decompressed in parallel on the ITK thread pool.
+ *
+ * The axes of the arrays are the dimensions of the image in reverse order,
+ * followed by a "c" channel axis for multi-component pixels, so that the
+ * chunks have the same memory layout as an ITK image buffer. The direction
+ * cosines and the pixel type are stored in an additional "itk" attribute.
+ *
+ * Any region can be read or written: ImageFileReader only decompresses the
+ * chunks overlapping the requested region, and ImageFileWriter splits the
+ * image into pieces aligned with the chunks, updating the pyramid as the
+ * pieces are written. When reading, either the Level or the RequestedSpacing
+ * selects the array of the pyramid from which the image is read.
+ *
+ * Chunks compressed with Blosc, and channel axes stored in another position
+ * than the last one, are not supported.
+ *
+ * \sa ImageFileWriter ImageFileReader ImageIOBase
+ * \ingroup IOFilters
+ * \ingroup ITKIOZarr
+ */
+class ITKIOZarr_EXPORT ZarrImageIO : public ImageIOBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ZarrImageIO);
+
+  /** Standard class type aliases. */
+  using Self = ZarrImageIO;
+  using Superclass = ImageIOBase;
+  using Pointer = SmartPointer<Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ZarrImageIO);
+
+  /** Number of levels of the pyramid written, including the full resolution
+   * image. After ReadImageInformation(), the number of levels of the store. */
+  /** @ITKStartGrouping */
+  itkSetClampMacro(NumberOfLevels, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfLevels, unsigned int);
+  /** @ITKEndGrouping */
+
+  /** Level of the pyramid read, 0 being the full resolution image. */
+  /** @ITKStartGrouping */
+  itkSetMacro(Level, unsigned int);
+  itkGetConstMacro(Level, unsigned int);
+  /** @ITKEndGrouping */
+
+  /** When not empty, ReadImageInformation() sets the Level to the coarsest
+   * one whose spacing does not exceed the requested spacing along any
+   * dimension, or to 0 if there is none. */
+  /** @ITKStartGrouping */
+  void
+  SetRequestedSpacing(const std::vector<double> & spacing);
+  const std::vector<double> &
+  GetRequestedSpacing() const
+  {
+    return m_RequestedSpacing;
+  }
+  /** @ITKEndGrouping */
+
+  /** Number of pixels of the chunks along each dimension of the image. A
+   * missing or zero entry selects a default size, so that a chunk holds about
+   * one MiB. After ReadImageInformation(), the chunk size of the level read. */
+  /** @ITKStartGrouping */
+  void
+  SetChunkSize(const std::vector<SizeValueType> & chunkSize);
+  const std::vector<SizeValueType> &
+  GetChunkSize() const
+  {
+    return m_ChunkSize;
+  }
+  /** @ITKEndGrouping */
+
+  /** The different types of ImageIO's can support data of varying
+   * dimensionality. For example, some file formats are strictly 2D
+   * while others can support 2D, 3D, or even n-D. This method returns
+   * true/false as to whether the ImageIO can support the dimension
+   * indicated. */
+  bool
+  SupportsDimension(unsigned long) override
+  {
+    return true;
+  }
+
+  /*-------- This part of the interfaces deals with reading data. ----- */
+
+  /** Determine the file type. Returns true if the file is a directory
+   * holding a Zarr array, or a group with multiscales attributes. */
+  bool
+  CanReadFile(const char *) override;
+
+  /** Set the spacing and dimension information for the set filename. */
+  void
+  ReadImageInformation() override;
+
+  /** Reads the data from disk into the memory buffer provided. */
+  void
+  Read(void * buffer) override;
+
+  /** Any region can be read, from the chunks overlapping it. */
+  bool
+  CanStreamRead() override
+  {
+    return true;
+  }
+
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const override;
+
+  /*-------- This part of the interfaces deals with writing data. ----- */
+
+  /** Determine the file type. Returns true if this ImageIO can write the
+   * file specified. */
+  bool
+  CanWriteFile(const char *) override;
+
+  /** Creates the store, replacing an existing one, with the metadata of all
+   * the levels of the pyramid and no chunks. */
+  void
+  WriteImageInformation() override;
+
+  /** Writes the chunks overlapping the IORegion, and updates the ones of
+   * the coarser levels of the pyramid depending on them. */
+  void
+  Write(const void * buffer) override;
+
+  /** Any region can be written, chunks partially covered by it being read
+   * back from the store. */
+  bool
+  CanStreamWrite() override
+  {
+    return true;
+  }
+
+  /** Splits the region along its slowest dimension at chunk boundaries, so
+   * that no chunk is written twice. */
+  unsigned int
+  GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion) override;
+
+  ImageIORegion
+  GetSplitRegionForWriting(unsigned int          ithPiece,
+                           unsigned int          numberOfActualSplits,
+                           const ImageIORegion & pasteRegion,
+                           const ImageIORegion & largestPossibleRegion) override;
+
+protected:
+  ZarrImageIO();
+  ~ZarrImageIO() override;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Layout of one array of the store, i.e. of one level of the pyramid,
+   * with its dimensions in the order of the image. */
+  struct ArrayLayout
+  {
+    std::string                Path{};
+    std::vector<SizeValueType> Dimensions{};
+    std::vector<SizeValueType> ChunkSize{};
+    std::vector<double>        Scale{};
+    std::vector<double>        Translation{};
+    char                       DimensionSeparator{ '/' };
+    bool                       Compressed{ false };
+    bool                       SwapBytes{ false };
+    std::vector<char>          FillValue{};
+  };
+
+  /** Reads the metadata of the store into m_Arrays, and sets the number of
+   * dimensions, the pixel type and the direction. */
+  void
+  ReadStoreLayout();
+
+  /** Chunk size of the full resolution array of the image to write. */
+  std::vector<SizeValueType>
+  GetChunkSizeForWriting() const;
+
+  /** File name of the chunk at the given position in the grid of chunks. */
+  std::string
+  GetChunkFileName(const ArrayLayout & array, const std::vector<SizeValueType> & chunkPosition) const;
+
+  /** Reads and decompresses a chunk, or sets it to the fill value if it has
+   * not been written. */
+  void
+  ReadChunk(const ArrayLayout &                array,
+            const std::vector<SizeValueType> & chunkPosition,
+            std::vector<char> &                chunk) const;
+
+  void
+  WriteChunk(const ArrayLayout &                array,
+             const std::vector<SizeValueType> & chunkPosition,
+             const std::vector<char> &          chunk) const;
+
+  /** Reads the region of the given index and size of an array into buffer,
+   * the chunks being decompressed in parallel or serially. */
+  void
+  ReadRegion(const ArrayLayout &                array,
+             const std::vector<SizeValueType> & index,
+             const std::vector<SizeValueType> & size,
+             void *                             buffer,
+             bool                               inParallel) const;
+
+  void
+  WriteRegion(const ArrayLayout &                array,
+              const std::vector<SizeValueType> & index,
+              const std::vector<SizeValueType> & size,
+              const void *                       buffer) const;
+
+  /** Recomputes the chunks of the given level overlapping the region, from
+   * the previous level. */
+  void
+  DownsampleRegion(unsigned int                       level,
+                   const std::vector<SizeValueType> & index,
+                   const std::vector<SizeValueType> & size) const;
+
+  unsigned int               m_NumberOfLevels{ 1 };
+  unsigned int               m_Level{ 0 };
+  std::vector<double>        m_RequestedSpacing{};
+  std::vector<SizeValueType> m_ChunkSize{};
+  std::vector<ArrayLayout>   m_Arrays{};
+};
+} // end namespace itk
+
+#endif // itkZarrImageIO_h
@@ -0,0 +1,20 @@
+set(
+  DOCUMENTATION
+  "This module contains an ImageIO class for reading and writing
+images as chunked arrays in a Zarr (version 2) directory store, with
+an OME-NGFF multiscale pyramid. https://zarr.dev https://ngff.openmicroscopy.org"
+)
+
+itk_module(
+  ITKIOZarr
+  ENABLE_SHARED
+  DEPENDS
+    ITKIOImageBase
+  PRIVATE_DEPENDS
+    ITKZLIB
+  TEST_DEPENDS
+    ITKTestKernel
+  FACTORY_NAMES
+    ImageIO::Zarr
+  DESCRIPTION "${DOCUMENTATION}"
+)
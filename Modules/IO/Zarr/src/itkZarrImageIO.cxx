@@ -0,0 +1,1796 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkZarrImageIO.h"
+#include "itkByteSwapper.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNumberToString.h"
+#include "itkPrintHelper.h"
+#include "itk_zlib.h"
+#include "itksys/Directory.hxx"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <locale>
+#include <set>
+#include <sstream>
+#include <type_traits>
+
+namespace itk
+{
+
+namespace
+{
+// Minimal document model of JSON, enough for the metadata of Zarr stores.
+// The members of an object are its elements, with their name.
+struct JSONValue
+{
+  enum class Type : uint8_t
+  {
+    Null,
+    Boolean,
+    Number,
+    String,
+    Array,
+    Object
+  };
+
+  Type                   type{ Type::Null };
+  bool                   boolean{ false };
+  double                 number{ 0.0 };
+  std::string            string{};
+  std::string            name{};
+  std::vector<JSONValue> elements{};
+
+  const JSONValue *
+  Find(const std::string & memberName) const
+  {
+    if (type == Type::Object)
+    {
+      for (const JSONValue & element : elements)
+      {
+        if (element.name == memberName)
+        {
+          return &element;
+        }
+      }
+    }
+    return nullptr;
+  }
+};
+
+class JSONParser
+{
+public:
+  JSONParser(const std::string & text, const std::string & fileName)
+    : m_Text(text)
+    , m_FileName(fileName)
+  {}
+
+  JSONValue
+  Parse()
+  {
+    JSONValue value = this->ParseValue();
+    this->SkipWhitespace();
+    if (m_Position != m_Text.size())
+    {
+      this->Fail("unexpected characters after the value");
+    }
+    return value;
+  }
+
+private:
+  [[noreturn]] void
+  Fail(const char * what) const
+  {
+    itkGenericExceptionMacro("Invalid JSON in " << m_FileName << " at offset " << m_Position << ": " << what << '.');
+  }
+
+  void
+  SkipWhitespace()
+  {
+    while (m_Position < m_Text.size() && std::isspace(static_cast<unsigned char>(m_Text[m_Position])))
+    {
+      ++m_Position;
+    }
+  }
+
+  bool
+  Consume(const char * literal)
+  {
+    const size_t length = std::strlen(literal);
+    if (m_Text.compare(m_Position, length, literal) == 0)
+    {
+      m_Position += length;
+      return true;
+    }
+    return false;
+  }
+
+  JSONValue
+  ParseValue()
+  {
+    this->SkipWhitespace();
+    if (m_Position >= m_Text.size())
+    {
+      this->Fail("unexpected end of the text");
+    }
+    JSONValue value;
+    if (this->Consume("{"))
+    {
+      value.type = JSONValue::Type::Object;
+      this->SkipWhitespace();
+      if (!this->Consume("}"))
+      {
+        do
+        {
+          this->SkipWhitespace();
+          std::string name = this->ParseString();
+          this->SkipWhitespace();
+          if (!this->Consume(":"))
+          {
+            this->Fail("expected ':'");
+          }
+          value.elements.push_back(this->ParseValue());
+          value.elements.back().name = std::move(name);
+          this->SkipWhitespace();
+        } while (this->Consume(","));
+        if (!this->Consume("}"))
+        {
+          this->Fail("expected ',' or '}'");
+        }
+      }
+    }
+    else if (this->Consume("["))
+    {
+      value.type = JSONValue::Type::Array;
+      this->SkipWhitespace();
+      if (!this->Consume("]"))
+      {
+        do
+        {
+          value.elements.push_back(this->ParseValue());
+          this->SkipWhitespace();
+        } while (this->Consume(","));
+        if (!this->Consume("]"))
+        {
+          this->Fail("expected ',' or ']'");
+        }
+      }
+    }
+    else if (m_Text[m_Position] == '"')
+    {
+      value.type = JSONValue::Type::String;
+      value.string = this->ParseString();
+    }
+    else if (this->Consume("true"))
+    {
+      value.type = JSONValue::Type::Boolean;
+      value.boolean = true;
+    }
+    else if (this->Consume("false"))
+    {
+      value.type = JSONValue::Type::Boolean;
+    }
+    else if (this->Consume("null"))
+    {
+      value.type = JSONValue::Type::Null;
+    }
+    else
+    {
+      value.type = JSONValue::Type::Number;
+      value.number = this->ParseNumber();
+    }
+    return value;
+  }
+
+  std::string
+  ParseString()
+  {
+    if (!this->Consume("\""))
+    {
+      this->Fail("expected a string");
+    }
+    std::string result;
+    while (m_Position < m_Text.size() && m_Text[m_Position] != '"')
+    {
+      const char character = m_Text[m_Position++];
+      if (static_cast<unsigned char>(character) < 0x20)
+      {
+        this->Fail("control character in a string");
+      }
+      if (character != '\\')
+      {
+        result += character;
+        continue;
+      }
+      if (m_Position >= m_Text.size())
+      {
+        break;
+      }
+      const char escaped = m_Text[m_Position++];
+      switch (escaped)
+      {
+        case '"':
+        case '\\':
+        case '/':
+          result += escaped;
+          break;
+        case 'b':
+          result += '\b';
+          break;
+        case 'f':
+          result += '\f';
+          break;
+        case 'n':
+          result += '\n';
+          break;
+        case 'r':
+          result += '\r';
+          break;
+        case 't':
+          result += '\t';
+          break;
+        case 'u':
+          this->AppendCodePoint(result);
+          break;
+        default:
+          this->Fail("invalid escape sequence");
+      }
+    }
+    if (!this->Consume("\""))
+    {
+      this->Fail("unterminated string");
+    }
+    return result;
+  }
+
+  // Appends the UTF-8 encoding of the code point of a \u escape sequence
+  void
+  AppendCodePoint(std::string & result)
+  {
+    if (m_Position + 4 > m_Text.size() ||
+        !std::all_of(m_Text.cbegin() + m_Position, m_Text.cbegin() + m_Position + 4, [](const char character) {
+          return std::isxdigit(static_cast<unsigned char>(character)) != 0;
+        }))
+    {
+      this->Fail("invalid unicode escape sequence");
+    }
+    const auto codePoint = static_cast<unsigned int>(std::stoul(m_Text.substr(m_Position, 4), nullptr, 16));
+    m_Position += 4;
+    if (codePoint < 0x80)
+    {
+      result += static_cast<char>(codePoint);
+    }
+    else if (codePoint < 0x800)
+    {
+      result += static_cast<char>(0xC0 | (codePoint >> 6));
+      result += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    else
+    {
+      result += static_cast<char>(0xE0 | (codePoint >> 12));
+      result += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      result += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+  }
+
+  double
+  ParseNumber()
+  {
+    const size_t begin = m_Position;
+    while (m_Position < m_Text.size() && std::strchr("+-0123456789.eE", m_Text[m_Position]) != nullptr &&
+           m_Text[m_Position] != '\0')
+    {
+      ++m_Position;
+    }
+    std::istringstream stream(m_Text.substr(begin, m_Position - begin));
+    stream.imbue(std::locale::classic());
+    double number = 0.0;
+    if (m_Position == begin || !(stream >> number) || stream.peek() != std::char_traits<char>::eof())
+    {
+      m_Position = begin;
+      this->Fail("invalid value");
+    }
+    return number;
+  }
+
+  const std::string & m_Text;
+  const std::string & m_FileName;
+  size_t              m_Position{ 0 };
+};
+
+JSONValue
+ReadJSONFile(const std::string & fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  if (!file)
+  {
+    itkGenericExceptionMacro("Cannot open " << fileName << " for reading.");
+  }
+  std::ostringstream text;
+  text << file.rdbuf();
+  return JSONParser(text.str(), fileName).Parse();
+}
+
+const JSONValue &
+GetMember(const JSONValue & object, const char * name, JSONValue::Type type, const std::string & fileName)
+{
+  const JSONValue * member = object.Find(name);
+  if (member == nullptr || member->type != type)
+  {
+    itkGenericExceptionMacro("Missing or invalid \"" << name << "\" in " << fileName << '.');
+  }
+  return *member;
+}
+
+std::vector<double>
+GetNumbers(const JSONValue & array, const char * name, const std::string & fileName)
+{
+  std::vector<double> numbers;
+  if (array.type == JSONValue::Type::Array)
+  {
+    for (const JSONValue & element : array.elements)
+    {
+      if (element.type != JSONValue::Type::Number)
+      {
+        break;
+      }
+      numbers.push_back(element.number);
+    }
+  }
+  if (array.type != JSONValue::Type::Array || numbers.size() != array.elements.size())
+  {
+    itkGenericExceptionMacro("Invalid \"" << name << "\" in " << fileName << ": expected an array of numbers.");
+  }
+  return numbers;
+}
+
+// Sizes of the dimensions of an array, which must be positive integers
+std::vector<SizeValueType>
+GetSizes(const JSONValue & array, const char * name, const std::string & fileName)
+{
+  std::vector<SizeValueType> sizes;
+  for (const double number : GetNumbers(array, name, fileName))
+  {
+    if (!(number >= 1.0) || number != std::floor(number))
+    {
+      itkGenericExceptionMacro("Invalid \"" << name << "\" in " << fileName << ": " << number
+                                            << " is not a positive integer.");
+    }
+    sizes.push_back(static_cast<SizeValueType>(number));
+  }
+  return sizes;
+}
+
+std::string
+ToJSON(const std::string & text)
+{
+  std::string quotedText = "\"";
+  for (const char character : text)
+  {
+    if (character == '"' || character == '\\')
+    {
+      quotedText += '\\';
+    }
+    quotedText += character;
+  }
+  return quotedText + '"';
+}
+
+template <typename TValue>
+std::string
+ToJSON(const std::vector<TValue> & values)
+{
+  std::string text = "[";
+  for (const TValue & value : values)
+  {
+    if (text.size() > 1)
+    {
+      text += ", ";
+    }
+    if constexpr (std::is_floating_point_v<TValue>)
+    {
+      text += ConvertNumberToString(value);
+    }
+    else
+    {
+      text += std::to_string(value);
+    }
+  }
+  return text + ']';
+}
+
+void
+WriteTextFile(const std::string & fileName, const std::string & text)
+{
+  std::ofstream file(fileName.c_str(), std::ios::binary);
+  if (!file || !file.write(text.data(), static_cast<std::streamsize>(text.size())))
+  {
+    itkGenericExceptionMacro("Cannot write " << fileName << '.');
+  }
+}
+
+std::vector<char>
+ReadBinaryFile(const std::string & fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  std::vector<char> data(file ? itksys::SystemTools::FileLength(fileName) : 0);
+  if (!file || !file.read(data.data(), static_cast<std::streamsize>(data.size())))
+  {
+    itkGenericExceptionMacro("Cannot read " << fileName << '.');
+  }
+  return data;
+}
+
+void
+WriteBinaryFile(const std::string & fileName, const char * data, SizeValueType numberOfBytes)
+{
+  std::ofstream file(fileName.c_str(), std::ios::binary);
+  if (!file || !file.write(data, static_cast<std::streamsize>(numberOfBytes)))
+  {
+    itkGenericExceptionMacro("Cannot write " << fileName << '.');
+  }
+}
+
+// Zarr data type of the components, without its byte order character
+std::string
+GetDataType(IOComponentEnum componentType)
+{
+  switch (componentType)
+  {
+    case IOComponentEnum::UCHAR:
+      return "u1";
+    case IOComponentEnum::CHAR:
+      return "i1";
+    case IOComponentEnum::USHORT:
+      return "u2";
+    case IOComponentEnum::SHORT:
+      return "i2";
+    case IOComponentEnum::UINT:
+      return "u4";
+    case IOComponentEnum::INT:
+      return "i4";
+    case IOComponentEnum::ULONG:
+      return sizeof(unsigned long) == 8 ? "u8" : "u4";
+    case IOComponentEnum::LONG:
+      return sizeof(long) == 8 ? "i8" : "i4";
+    case IOComponentEnum::ULONGLONG:
+      return "u8";
+    case IOComponentEnum::LONGLONG:
+      return "i8";
+    case IOComponentEnum::FLOAT:
+      return "f4";
+    case IOComponentEnum::DOUBLE:
+      return "f8";
+    default:
+      return "";
+  }
+}
+
+IOComponentEnum
+GetComponentTypeOfDataType(const std::string & dataType)
+{
+  const std::pair<const char *, IOComponentEnum> componentTypes[] = {
+    { "u1", IOComponentEnum::UCHAR },      { "i1", IOComponentEnum::CHAR },      { "u2", IOComponentEnum::USHORT },
+    { "i2", IOComponentEnum::SHORT },      { "u4", IOComponentEnum::UINT },      { "i4", IOComponentEnum::INT },
+    { "u8", IOComponentEnum::ULONGLONG }, { "i8", IOComponentEnum::LONGLONG }, { "f4", IOComponentEnum::FLOAT },
+    { "f8", IOComponentEnum::DOUBLE }
+  };
+  for (const auto & componentType : componentTypes)
+  {
+    if (dataType == componentType.first)
+    {
+      return componentType.second;
+    }
+  }
+  return IOComponentEnum::UNKNOWNCOMPONENTTYPE;
+}
+
+// Calls function with a zero of the type of the components
+template <typename TFunction>
+void
+CallWithComponentType(IOComponentEnum componentType, TFunction && function)
+{
+  switch (componentType)
+  {
+    case IOComponentEnum::UCHAR:
+      function(static_cast<unsigned char>(0));
+      break;
+    case IOComponentEnum::CHAR:
+      function(static_cast<char>(0));
+      break;
+    case IOComponentEnum::USHORT:
+      function(static_cast<unsigned short>(0));
+      break;
+    case IOComponentEnum::SHORT:
+      function(static_cast<short>(0));
+      break;
+    case IOComponentEnum::UINT:
+      function(static_cast<unsigned int>(0));
+      break;
+    case IOComponentEnum::INT:
+      function(static_cast<int>(0));
+      break;
+    case IOComponentEnum::ULONG:
+      function(static_cast<unsigned long>(0));
+      break;
+    case IOComponentEnum::LONG:
+      function(static_cast<long>(0));
+      break;
+    case IOComponentEnum::ULONGLONG:
+      function(static_cast<unsigned long long>(0));
+      break;
+    case IOComponentEnum::LONGLONG:
+      function(static_cast<long long>(0));
+      break;
+    case IOComponentEnum::FLOAT:
+      function(0.0f);
+      break;
+    case IOComponentEnum::DOUBLE:
+      function(0.0);
+      break;
+    default:
+      itkGenericExceptionMacro("Unsupported component type: " << componentType);
+  }
+}
+
+// Bytes of a pixel whose components all have the fill value of an array
+std::vector<char>
+GetFillValue(const JSONValue * fillValue,
+             IOComponentEnum   componentType,
+             unsigned int      numberOfComponents,
+             const std::string & fileName)
+{
+  double value = 0.0;
+  if (fillValue != nullptr && fillValue->type == JSONValue::Type::Number)
+  {
+    value = fillValue->number;
+  }
+  else if (fillValue != nullptr && fillValue->type == JSONValue::Type::String && fillValue->string == "NaN")
+  {
+    value = std::numeric_limits<double>::quiet_NaN();
+  }
+  else if (fillValue != nullptr && fillValue->type == JSONValue::Type::String &&
+           (fillValue->string == "Infinity" || fillValue->string == "-Infinity"))
+  {
+    value = fillValue->string[0] == '-' ? -std::numeric_limits<double>::infinity()
+                                        : std::numeric_limits<double>::infinity();
+  }
+  else if (fillValue != nullptr && fillValue->type != JSONValue::Type::Null)
+  {
+    itkGenericExceptionMacro("Invalid \"fill_value\" in " << fileName << '.');
+  }
+
+  std::vector<char> pixel;
+  CallWithComponentType(componentType, [&](auto zero) {
+    using ComponentType = decltype(zero);
+    const ComponentType component =
+      std::is_integral_v<ComponentType> && !std::isfinite(value) ? zero : static_cast<ComponentType>(value);
+    pixel.resize(sizeof(ComponentType) * numberOfComponents);
+    for (unsigned int i = 0; i < numberOfComponents; ++i)
+    {
+      std::memcpy(pixel.data() + i * sizeof(ComponentType), &component, sizeof(ComponentType));
+    }
+  });
+  return pixel;
+}
+
+SizeValueType
+GetNumberOfPixels(const std::vector<SizeValueType> & size)
+{
+  SizeValueType numberOfPixels = 1;
+  for (const SizeValueType s : size)
+  {
+    numberOfPixels *= s;
+  }
+  return numberOfPixels;
+}
+
+// A chunk whose pixels all have the fill value
+void
+FillChunk(const std::vector<char> & fillValue, SizeValueType numberOfPixels, std::vector<char> & chunk)
+{
+  chunk.resize(numberOfPixels * fillValue.size());
+  if (std::all_of(fillValue.cbegin(), fillValue.cend(), [](const char byte) { return byte == 0; }))
+  {
+    std::fill(chunk.begin(), chunk.end(), 0);
+    return;
+  }
+  for (SizeValueType i = 0; i < numberOfPixels; ++i)
+  {
+    std::copy(fillValue.cbegin(), fillValue.cend(), chunk.begin() + i * fillValue.size());
+  }
+}
+
+void
+SwapComponentBytes(std::vector<char> & data, unsigned int componentSize)
+{
+  for (SizeValueType i = 0; i + componentSize <= data.size(); i += componentSize)
+  {
+    std::reverse(data.begin() + i, data.begin() + i + componentSize);
+  }
+}
+
+void
+Inflate(const std::vector<char> & compressedData, std::vector<char> & data, const std::string & fileName)
+{
+  if (compressedData.size() > std::numeric_limits<uInt>::max() || data.size() > std::numeric_limits<uInt>::max())
+  {
+    itkGenericExceptionMacro("The chunk " << fileName << " is too large to be decompressed.");
+  }
+  z_stream stream{};
+  if (inflateInit2(&stream, MAX_WBITS + 32) != Z_OK)
+  {
+    itkGenericExceptionMacro("Cannot initialize the decompression of " << fileName << '.');
+  }
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(compressedData.data()));
+  stream.avail_in = static_cast<uInt>(compressedData.size());
+  stream.next_out = reinterpret_cast<Bytef *>(data.data());
+  stream.avail_out = static_cast<uInt>(data.size());
+  const bool decompressed = inflate(&stream, Z_FINISH) == Z_STREAM_END && stream.avail_out == 0;
+  inflateEnd(&stream);
+  if (!decompressed)
+  {
+    itkGenericExceptionMacro("The chunk " << fileName << " is corrupted, or does not hold " << data.size()
+                                          << " bytes.");
+  }
+}
+
+std::vector<char>
+Deflate(const std::vector<char> & data, int compressionLevel, const std::string & fileName)
+{
+  if (data.size() > std::numeric_limits<uLong>::max() / 2)
+  {
+    itkGenericExceptionMacro("The chunk " << fileName << " is too large to be compressed.");
+  }
+  uLongf            compressedSize = compressBound(static_cast<uLong>(data.size()));
+  std::vector<char> compressedData(compressedSize);
+  if (compress2(reinterpret_cast<Bytef *>(compressedData.data()),
+                &compressedSize,
+                reinterpret_cast<const Bytef *>(data.data()),
+                static_cast<uLong>(data.size()),
+                compressionLevel) != Z_OK)
+  {
+    itkGenericExceptionMacro("Cannot compress the chunk " << fileName << '.');
+  }
+  compressedData.resize(compressedSize);
+  return compressedData;
+}
+
+// A region of an array, by the index and the size of its dimensions
+struct Box
+{
+  std::vector<SizeValueType> Index;
+  std::vector<SizeValueType> Size;
+};
+
+Box
+Intersect(const Box & box1, const Box & box2)
+{
+  Box intersection{ box1.Index, box1.Size };
+  for (size_t i = 0; i < box1.Index.size(); ++i)
+  {
+    const SizeValueType begin = std::max(box1.Index[i], box2.Index[i]);
+    const SizeValueType end = std::min(box1.Index[i] + box1.Size[i], box2.Index[i] + box2.Size[i]);
+    intersection.Index[i] = begin;
+    intersection.Size[i] = end > begin ? end - begin : 0;
+  }
+  return intersection;
+}
+
+Box
+GetChunkBox(const std::vector<SizeValueType> & chunkPosition, const std::vector<SizeValueType> & chunkSize)
+{
+  Box chunkBox{ chunkPosition, chunkSize };
+  for (size_t i = 0; i < chunkPosition.size(); ++i)
+  {
+    chunkBox.Index[i] *= chunkSize[i];
+  }
+  return chunkBox;
+}
+
+// Positions in the grid of chunks of the ones overlapping a non-empty region
+std::vector<std::vector<SizeValueType>>
+GetChunkPositions(const Box & region, const std::vector<SizeValueType> & chunkSize)
+{
+  std::vector<std::vector<SizeValueType>> chunkPositions;
+  if (GetNumberOfPixels(region.Size) == 0)
+  {
+    return chunkPositions;
+  }
+  const size_t               numberOfDimensions = region.Index.size();
+  std::vector<SizeValueType> first(numberOfDimensions);
+  std::vector<SizeValueType> last(numberOfDimensions);
+  for (size_t i = 0; i < numberOfDimensions; ++i)
+  {
+    first[i] = region.Index[i] / chunkSize[i];
+    last[i] = (region.Index[i] + region.Size[i] - 1) / chunkSize[i];
+  }
+  std::vector<SizeValueType> position = first;
+  while (true)
+  {
+    chunkPositions.push_back(position);
+    size_t i = 0;
+    for (; i < numberOfDimensions; ++i)
+    {
+      if (++position[i] <= last[i])
+      {
+        break;
+      }
+      position[i] = first[i];
+    }
+    if (i == numberOfDimensions)
+    {
+      return chunkPositions;
+    }
+  }
+}
+
+// Copies the pixels of a region, row by row, from the buffer of a region
+// containing it to the buffer of another one
+void
+CopyRegion(const char *  source,
+           const Box &   sourceBox,
+           char *        destination,
+           const Box &   destinationBox,
+           const Box &   region,
+           SizeValueType pixelSize)
+{
+  if (GetNumberOfPixels(region.Size) == 0)
+  {
+    return;
+  }
+  const size_t               numberOfDimensions = region.Index.size();
+  const SizeValueType        rowSize = region.Size[0] * pixelSize;
+  std::vector<SizeValueType> position = region.Index;
+  while (true)
+  {
+    SizeValueType sourceOffset = 0;
+    SizeValueType destinationOffset = 0;
+    for (size_t i = numberOfDimensions; i-- > 0;)
+    {
+      sourceOffset = sourceOffset * sourceBox.Size[i] + position[i] - sourceBox.Index[i];
+      destinationOffset = destinationOffset * destinationBox.Size[i] + position[i] - destinationBox.Index[i];
+    }
+    std::memcpy(destination + destinationOffset * pixelSize, source + sourceOffset * pixelSize, rowSize);
+    size_t i = 1;
+    for (; i < numberOfDimensions; ++i)
+    {
+      if (++position[i] < region.Index[i] + region.Size[i])
+      {
+        break;
+      }
+      position[i] = region.Index[i];
+    }
+    if (i >= numberOfDimensions)
+    {
+      return;
+    }
+  }
+}
+
+// Averages the pixels of the source by blocks of 2 pixels along the first
+// numberOfSpatialDimensions dimensions, into the first size pixels of each
+// dimension of the destination
+template <typename TComponent>
+void
+DownsamplePixels(const TComponent *                 source,
+                 const std::vector<SizeValueType> & sourceSize,
+                 TComponent *                       destination,
+                 const std::vector<SizeValueType> & destinationSize,
+                 const std::vector<SizeValueType> & size,
+                 unsigned int                       numberOfComponents,
+                 unsigned int                       numberOfSpatialDimensions)
+{
+  const size_t               numberOfDimensions = size.size();
+  const SizeValueType        numberOfPixels = GetNumberOfPixels(size);
+  const unsigned int         numberOfNeighbors = 1u << numberOfSpatialDimensions;
+  std::vector<SizeValueType> position(numberOfDimensions, 0);
+  std::vector<double>        sums(numberOfComponents);
+  for (SizeValueType pixel = 0; pixel < numberOfPixels; ++pixel)
+  {
+    std::fill(sums.begin(), sums.end(), 0.0);
+    unsigned int count = 0;
+    for (unsigned int neighbor = 0; neighbor < numberOfNeighbors; ++neighbor)
+    {
+      SizeValueType sourceOffset = 0;
+      bool          isInside = true;
+      for (size_t i = numberOfDimensions; i-- > 0 && isInside;)
+      {
+        const SizeValueType coordinate =
+          i < numberOfSpatialDimensions ? 2 * position[i] + ((neighbor >> i) & 1u) : position[i];
+        isInside = coordinate < sourceSize[i];
+        sourceOffset = sourceOffset * sourceSize[i] + coordinate;
+      }
+      if (isInside)
+      {
+        for (unsigned int c = 0; c < numberOfComponents; ++c)
+        {
+          sums[c] += static_cast<double>(source[sourceOffset * numberOfComponents + c]);
+        }
+        ++count;
+      }
+    }
+
+    SizeValueType destinationOffset = 0;
+    for (size_t i = numberOfDimensions; i-- > 0;)
+    {
+      destinationOffset = destinationOffset * destinationSize[i] + position[i];
+    }
+    for (unsigned int c = 0; c < numberOfComponents; ++c)
+    {
+      const double mean = sums[c] / count;
+      if constexpr (std::is_integral_v<TComponent>)
+      {
+        destination[destinationOffset * numberOfComponents + c] = static_cast<TComponent>(std::floor(mean + 0.5));
+      }
+      else
+      {
+        destination[destinationOffset * numberOfComponents + c] = static_cast<TComponent>(mean);
+      }
+    }
+
+    for (size_t i = 0; i < numberOfDimensions; ++i)
+    {
+      if (++position[i] < size[i])
+      {
+        break;
+      }
+      position[i] = 0;
+    }
+  }
+}
+
+// Runs function for each index, on the ITK thread pool or serially, and then
+// throws the first error reported by one of them
+void
+ForEachChunk(SizeValueType                               numberOfChunks,
+             bool                                        inParallel,
+             const std::function<void(SizeValueType)> & function)
+{
+  std::vector<std::string> errors(numberOfChunks);
+  const auto               callFunction = [&function, &errors](SizeValueType i) {
+    try
+    {
+      function(i);
+    }
+    catch (const std::exception & exception)
+    {
+      errors[i] = exception.what();
+    }
+  };
+  if (inParallel)
+  {
+    MultiThreaderBase::New()->ParallelizeArray(0, numberOfChunks, callFunction, nullptr);
+  }
+  else
+  {
+    for (SizeValueType i = 0; i < numberOfChunks; ++i)
+    {
+      callFunction(i);
+    }
+  }
+  for (const std::string & error : errors)
+  {
+    if (!error.empty())
+    {
+      itkGenericExceptionMacro(<< error);
+    }
+  }
+}
+
+// Dimension along which a region is split at chunk boundaries: the slowest
+// one overlapping several chunks, with the number of slabs of chunks overlapped
+unsigned int
+GetSplitDimension(const ImageIORegion &              region,
+                  const std::vector<SizeValueType> & chunkSize,
+                  SizeValueType &                    numberOfSlabs)
+{
+  for (unsigned int i = std::min<unsigned int>(region.GetImageDimension(), chunkSize.size()); i-- > 0;)
+  {
+    if (region.GetSize(i) == 0)
+    {
+      break;
+    }
+    const auto          begin = static_cast<SizeValueType>(region.GetIndex(i));
+    const SizeValueType first = begin / chunkSize[i];
+    const SizeValueType last = (begin + region.GetSize(i) - 1) / chunkSize[i];
+    if (last > first)
+    {
+      numberOfSlabs = last - first + 1;
+      return i;
+    }
+  }
+  numberOfSlabs = 1;
+  return 0;
+}
+
+// Index and size of all the dimensions of the IORegion, padded with the first
+// pixel of the dimensions it does not have
+Box
+GetBox(const ImageIORegion & region, unsigned int numberOfDimensions)
+{
+  Box box{ std::vector<SizeValueType>(numberOfDimensions, 0), std::vector<SizeValueType>(numberOfDimensions, 1) };
+  for (unsigned int i = 0; i < std::min(numberOfDimensions, region.GetImageDimension()); ++i)
+  {
+    box.Index[i] = static_cast<SizeValueType>(region.GetIndex(i));
+    box.Size[i] = region.GetSize(i);
+  }
+  return box;
+}
+
+constexpr unsigned int maximumNumberOfSpatialDimensions = 3;
+constexpr const char * axisNames[] = { "x", "y", "z", "t" };
+} // namespace
+
+ZarrImageIO::ZarrImageIO()
+{
+  this->AddSupportedReadExtension(".zarr");
+  this->AddSupportedWriteExtension(".zarr");
+
+  this->Self::SetCompressor("");
+  this->Self::SetMaximumCompressionLevel(9);
+  this->Self::SetCompressionLevel(1);
+}
+
+ZarrImageIO::~ZarrImageIO() = default;
+
+void
+ZarrImageIO::PrintSelf(std::ostream & os, Indent indent) const
+{
+  using namespace print_helper;
+
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfLevels: " << m_NumberOfLevels << std::endl;
+  os << indent << "Level: " << m_Level << std::endl;
+  os << indent << "RequestedSpacing: " << m_RequestedSpacing << std::endl;
+  os << indent << "ChunkSize: " << m_ChunkSize << std::endl;
+}
+
+void
+ZarrImageIO::SetRequestedSpacing(const std::vector<double> & spacing)
+{
+  if (m_RequestedSpacing != spacing)
+  {
+    m_RequestedSpacing = spacing;
+    this->Modified();
+  }
+}
+
+void
+ZarrImageIO::SetChunkSize(const std::vector<SizeValueType> & chunkSize)
+{
+  if (m_ChunkSize != chunkSize)
+  {
+    m_ChunkSize = chunkSize;
+    this->Modified();
+  }
+}
+
+bool
+ZarrImageIO::CanReadFile(const char * filename)
+{
+  const std::string store = filename;
+  if (store.empty() || !itksys::SystemTools::FileIsDirectory(store))
+  {
+    return false;
+  }
+  if (itksys::SystemTools::FileExists(store + "/.zarray", true))
+  {
+    return true;
+  }
+  std::ifstream attributes((store + "/.zattrs").c_str(), std::ios::binary);
+  std::ostringstream text;
+  text << attributes.rdbuf();
+  return text.str().find("\"multiscales\"") != std::string::npos;
+}
+
+bool
+ZarrImageIO::CanWriteFile(const char * filename)
+{
+  const std::string store = filename;
+  return !store.empty() && this->HasSupportedWriteExtension(filename);
+}
+
+void
+ZarrImageIO::ReadStoreLayout()
+{
+  const std::string & store = m_FileName;
+  m_Arrays.clear();
+
+  std::vector<std::string>         paths;
+  std::vector<std::vector<double>> scales;
+  std::vector<std::vector<double>> translations;
+  bool                             hasChannelAxis = false;
+  const JSONValue *                itkAttributes = nullptr;
+  JSONValue                        attributes;
+  const std::string                attributesFileName = store + "/.zattrs";
+  if (itksys::SystemTools::FileExists(store + "/.zarray", true))
+  {
+    // A single array, without multiscales attributes
+    paths.emplace_back();
+  }
+  else
+  {
+    attributes = ReadJSONFile(attributesFileName);
+    const JSONValue & multiscales = GetMember(attributes, "multiscales", JSONValue::Type::Array, attributesFileName);
+    if (multiscales.elements.empty() || multiscales.elements[0].type != JSONValue::Type::Object)
+    {
+      itkExceptionMacro("No multiscale image in " << attributesFileName << '.');
+    }
+    const JSONValue & multiscale = multiscales.elements[0];
+
+    if (const JSONValue * axes = multiscale.Find("axes"); axes != nullptr && axes->type == JSONValue::Type::Array)
+    {
+      for (size_t i = 0; i < axes->elements.size(); ++i)
+      {
+        const JSONValue & axis = axes->elements[i];
+        const JSONValue * type = axis.Find("type");
+        const JSONValue * name = axis.Find("name");
+        const bool        isNamedC = (name != nullptr && name->string == "c") || axis.string == "c";
+        const bool        isChannelAxis = type != nullptr ? type->string == "channel" : isNamedC;
+        if (isChannelAxis && i + 1 != axes->elements.size())
+        {
+          itkExceptionMacro("Unsupported channel axis in " << attributesFileName
+                                                           << ": only a last channel axis is supported.");
+        }
+        hasChannelAxis = hasChannelAxis || isChannelAxis;
+      }
+    }
+
+    const JSONValue & datasets = GetMember(multiscale, "datasets", JSONValue::Type::Array, attributesFileName);
+    for (const JSONValue & dataset : datasets.elements)
+    {
+      paths.push_back(GetMember(dataset, "path", JSONValue::Type::String, attributesFileName).string);
+      scales.emplace_back();
+      translations.emplace_back();
+      if (const JSONValue * transformations = dataset.Find("coordinateTransformations"); transformations != nullptr)
+      {
+        for (const JSONValue & transformation : transformations->elements)
+        {
+          const JSONValue * type = transformation.Find("type");
+          if (type != nullptr && (type->string == "scale" || type->string == "translation"))
+          {
+            const char * name = type->string.c_str();
+            const auto & values = GetMember(transformation, name, JSONValue::Type::Array, attributesFileName);
+            (type->string == "scale" ? scales : translations).back() = GetNumbers(values, name, attributesFileName);
+          }
+        }
+      }
+    }
+    if (paths.empty())
+    {
+      itkExceptionMacro("No dataset in " << attributesFileName << '.');
+    }
+    itkAttributes = attributes.Find("itk");
+  }
+
+  unsigned int numberOfComponents = 1;
+  for (size_t level = 0; level < paths.size(); ++level)
+  {
+    ArrayLayout       array;
+    const std::string arrayFileName = store + (paths[level].empty() ? "" : "/" + paths[level]) + "/.zarray";
+    array.Path = itksys::SystemTools::GetFilenamePath(arrayFileName);
+    const JSONValue metadata = ReadJSONFile(arrayFileName);
+
+    if (GetMember(metadata, "zarr_format", JSONValue::Type::Number, arrayFileName).number != 2.0)
+    {
+      itkExceptionMacro("Unsupported Zarr format in " << arrayFileName << ": only version 2 is supported.");
+    }
+    std::vector<SizeValueType> shape =
+      GetSizes(GetMember(metadata, "shape", JSONValue::Type::Array, arrayFileName), "shape", arrayFileName);
+    std::vector<SizeValueType> chunks =
+      GetSizes(GetMember(metadata, "chunks", JSONValue::Type::Array, arrayFileName), "chunks", arrayFileName);
+    if (shape.empty() || chunks.size() != shape.size() || (hasChannelAxis && shape.size() < 2))
+    {
+      itkExceptionMacro("Invalid shape or chunks in " << arrayFileName << '.');
+    }
+
+    const std::string & dataType = GetMember(metadata, "dtype", JSONValue::Type::String, arrayFileName).string;
+    const IOComponentEnum componentType =
+      dataType.size() == 3 ? GetComponentTypeOfDataType(dataType.substr(1)) : IOComponentEnum::UNKNOWNCOMPONENTTYPE;
+    if (componentType == IOComponentEnum::UNKNOWNCOMPONENTTYPE || std::strchr("<>|", dataType[0]) == nullptr)
+    {
+      itkExceptionMacro("Unsupported data type " << dataType << " in " << arrayFileName << '.');
+    }
+    const bool isBigEndian = ByteSwapper<int>::SystemIsBigEndian();
+    array.SwapBytes = (dataType[0] == '<' && isBigEndian) || (dataType[0] == '>' && !isBigEndian);
+
+    if (const JSONValue * order = metadata.Find("order"); order == nullptr || order->string != "C")
+    {
+      itkExceptionMacro("Unsupported order in " << arrayFileName << ": only the C order is supported.");
+    }
+    if (const JSONValue * filters = metadata.Find("filters");
+        filters != nullptr && filters->type != JSONValue::Type::Null && !filters->elements.empty())
+    {
+      itkExceptionMacro("Unsupported filters in " << arrayFileName << '.');
+    }
+    if (const JSONValue * compressor = metadata.Find("compressor");
+        compressor != nullptr && compressor->type != JSONValue::Type::Null)
+    {
+      const JSONValue * id = compressor->Find("id");
+      if (id == nullptr || (id->string != "zlib" && id->string != "gzip"))
+      {
+        itkExceptionMacro("Unsupported compressor " << (id != nullptr ? id->string : std::string("?")) << " in "
+                                                    << arrayFileName << ": only zlib and gzip are supported.");
+      }
+      array.Compressed = true;
+    }
+    array.DimensionSeparator = '.';
+    if (const JSONValue * separator = metadata.Find("dimension_separator"); separator != nullptr)
+    {
+      if (separator->string != "/" && separator->string != ".")
+      {
+        itkExceptionMacro("Invalid dimension separator in " << arrayFileName << '.');
+      }
+      array.DimensionSeparator = separator->string[0];
+    }
+
+    std::vector<double> scale = level < scales.size() ? scales[level] : std::vector<double>{};
+    std::vector<double> translation = level < translations.size() ? translations[level] : std::vector<double>{};
+    scale.resize(shape.size(), 1.0);
+    translation.resize(shape.size(), 0.0);
+    if (hasChannelAxis)
+    {
+      if (chunks.back() != shape.back())
+      {
+        itkExceptionMacro("Unsupported chunks in " << arrayFileName << ": the channels must not be split.");
+      }
+      numberOfComponents = static_cast<unsigned int>(shape.back());
+      shape.pop_back();
+      chunks.pop_back();
+      scale.pop_back();
+      translation.pop_back();
+    }
+
+    if (level == 0)
+    {
+      this->SetComponentType(componentType);
+      this->SetNumberOfComponents(numberOfComponents);
+    }
+    else if (componentType != m_ComponentType || shape.size() != m_Arrays[0].Dimensions.size())
+    {
+      itkExceptionMacro("The data type or the number of dimensions of "
+                        << arrayFileName << " differs from the ones of the first level.");
+    }
+    array.FillValue = GetFillValue(metadata.Find("fill_value"), componentType, numberOfComponents, arrayFileName);
+    array.Dimensions.assign(shape.crbegin(), shape.crend());
+    array.ChunkSize.assign(chunks.crbegin(), chunks.crend());
+    array.Scale.assign(scale.crbegin(), scale.crend());
+    array.Translation.assign(translation.crbegin(), translation.crend());
+    m_Arrays.push_back(std::move(array));
+  }
+
+  const auto numberOfDimensions = static_cast<unsigned int>(m_Arrays[0].Dimensions.size());
+  this->SetNumberOfDimensions(numberOfDimensions);
+  this->SetPixelType(numberOfComponents > 1 ? IOPixelEnum::VECTOR : IOPixelEnum::SCALAR);
+  if (itkAttributes == nullptr)
+  {
+    return;
+  }
+  if (const JSONValue * pixelType = itkAttributes->Find("pixelType"); pixelType != nullptr)
+  {
+    const IOPixelEnum pixelTypeEnum = Self::GetPixelTypeFromString(pixelType->string);
+    if (pixelTypeEnum != IOPixelEnum::UNKNOWNPIXELTYPE)
+    {
+      this->SetPixelType(pixelTypeEnum);
+    }
+  }
+  if (const JSONValue * direction = itkAttributes->Find("direction"); direction != nullptr)
+  {
+    if (direction->elements.size() != numberOfDimensions)
+    {
+      itkExceptionMacro("Invalid direction in " << attributesFileName << '.');
+    }
+    for (unsigned int i = 0; i < numberOfDimensions; ++i)
+    {
+      const std::vector<double> axis = GetNumbers(direction->elements[i], "direction", attributesFileName);
+      if (axis.size() != numberOfDimensions)
+      {
+        itkExceptionMacro("Invalid direction in " << attributesFileName << '.');
+      }
+      this->SetDirection(i, axis);
+    }
+  }
+}
+
+void
+ZarrImageIO::ReadImageInformation()
+{
+  this->ReadStoreLayout();
+  const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+
+  if (!m_RequestedSpacing.empty())
+  {
+    m_Level = 0;
+    for (unsigned int level = 1; level < m_Arrays.size(); ++level)
+    {
+      bool isFineEnough = true;
+      for (unsigned int i = 0; i < std::min<size_t>(numberOfDimensions, m_RequestedSpacing.size()); ++i)
+      {
+        // Tolerate the rounding errors of the spacing written by other libraries
+        isFineEnough = isFineEnough && m_Arrays[level].Scale[i] <= m_RequestedSpacing[i] * (1.0 + 1e-6);
+      }
+      if (isFineEnough)
+      {
+        m_Level = level;
+      }
+    }
+  }
+  if (m_Level >= m_Arrays.size())
+  {
+    itkExceptionMacro("Cannot read level " << m_Level << " of " << m_FileName << ", which has " << m_Arrays.size()
+                                           << " levels.");
+  }
+
+  // The translations are along the axes of the image: the origin of a level
+  // is the one of the first level, offset along the direction cosines.
+  const ArrayLayout & array = m_Arrays[m_Level];
+  const ArrayLayout & firstArray = m_Arrays.front();
+  for (unsigned int i = 0; i < numberOfDimensions; ++i)
+  {
+    this->SetDimensions(i, array.Dimensions[i]);
+    this->SetSpacing(i, array.Scale[i]);
+    double origin = firstArray.Translation[i];
+    for (unsigned int j = 0; j < numberOfDimensions; ++j)
+    {
+      origin += m_Direction[j][i] * (array.Translation[j] - firstArray.Translation[j]);
+    }
+    this->SetOrigin(i, origin);
+  }
+  m_NumberOfLevels = static_cast<unsigned int>(m_Arrays.size());
+  m_ChunkSize = array.ChunkSize;
+}
+
+ImageIORegion
+ZarrImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const
+{
+  if (!m_UseStreamedReading)
+  {
+    return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requestedRegion);
+  }
+  return requestedRegion;
+}
+
+void
+ZarrImageIO::Read(void * buffer)
+{
+  if (m_Level >= m_Arrays.size())
+  {
+    itkExceptionMacro("ReadImageInformation() must be called before Read().");
+  }
+  const Box region = GetBox(m_IORegion, this->GetNumberOfDimensions());
+  this->ReadRegion(m_Arrays[m_Level], region.Index, region.Size, buffer, true);
+}
+
+std::string
+ZarrImageIO::GetChunkFileName(const ArrayLayout & array, const std::vector<SizeValueType> & chunkPosition) const
+{
+  std::string fileName = array.Path;
+  char        separator = '/';
+  for (size_t i = chunkPosition.size(); i-- > 0;)
+  {
+    fileName += separator + std::to_string(chunkPosition[i]);
+    separator = array.DimensionSeparator;
+  }
+  if (this->GetNumberOfComponents() > 1)
+  {
+    // The single chunk along the channel axis
+    fileName += separator;
+    fileName += '0';
+  }
+  return fileName;
+}
+
+void
+ZarrImageIO::ReadChunk(const ArrayLayout &                array,
+                       const std::vector<SizeValueType> & chunkPosition,
+                       std::vector<char> &                chunk) const
+{
+  const SizeValueType numberOfPixels = GetNumberOfPixels(array.ChunkSize);
+  const std::string   fileName = this->GetChunkFileName(array, chunkPosition);
+  if (!itksys::SystemTools::FileExists(fileName, true))
+  {
+    FillChunk(array.FillValue, numberOfPixels, chunk);
+    return;
+  }
+
+  std::vector<char> data = ReadBinaryFile(fileName);
+  chunk.resize(numberOfPixels * this->GetPixelSize());
+  if (array.Compressed)
+  {
+    Inflate(data, chunk, fileName);
+  }
+  else if (data.size() == chunk.size())
+  {
+    chunk.swap(data);
+  }
+  else
+  {
+    itkExceptionMacro("The chunk " << fileName << " does not hold " << chunk.size() << " bytes.");
+  }
+  if (array.SwapBytes)
+  {
+    SwapComponentBytes(chunk, this->GetComponentSize());
+  }
+}
+
+void
+ZarrImageIO::WriteChunk(const ArrayLayout &                array,
+                        const std::vector<SizeValueType> & chunkPosition,
+                        const std::vector<char> &          chunk) const
+{
+  const std::string fileName = this->GetChunkFileName(array, chunkPosition);
+  const auto *      data = &chunk;
+  std::vector<char> swappedChunk;
+  if (array.SwapBytes)
+  {
+    swappedChunk = chunk;
+    SwapComponentBytes(swappedChunk, this->GetComponentSize());
+    data = &swappedChunk;
+  }
+  if (array.Compressed)
+  {
+    const std::vector<char> compressedData = Deflate(*data, this->GetCompressionLevel(), fileName);
+    WriteBinaryFile(fileName, compressedData.data(), compressedData.size());
+  }
+  else
+  {
+    WriteBinaryFile(fileName, data->data(), data->size());
+  }
+}
+
+void
+ZarrImageIO::ReadRegion(const ArrayLayout &                array,
+                        const std::vector<SizeValueType> & index,
+                        const std::vector<SizeValueType> & size,
+                        void *                             buffer,
+                        bool                               inParallel) const
+{
+  const Box           region{ index, size };
+  const auto          chunkPositions = GetChunkPositions(region, array.ChunkSize);
+  const SizeValueType pixelSize = this->GetPixelSize();
+  ForEachChunk(chunkPositions.size(), inParallel, [&](SizeValueType i) {
+    std::vector<char> chunk;
+    this->ReadChunk(array, chunkPositions[i], chunk);
+    const Box chunkBox = GetChunkBox(chunkPositions[i], array.ChunkSize);
+    CopyRegion(
+      chunk.data(), chunkBox, static_cast<char *>(buffer), region, Intersect(chunkBox, region), pixelSize);
+  });
+}
+
+void
+ZarrImageIO::WriteRegion(const ArrayLayout &                array,
+                         const std::vector<SizeValueType> & index,
+                         const std::vector<SizeValueType> & size,
+                         const void *                       buffer) const
+{
+  const Box           region{ index, size };
+  const Box           arrayBox{ std::vector<SizeValueType>(index.size(), 0), array.Dimensions };
+  const auto          chunkPositions = GetChunkPositions(region, array.ChunkSize);
+  const SizeValueType pixelSize = this->GetPixelSize();
+
+  // The directories of the chunks are created serially
+  std::set<std::string> directories;
+  for (const auto & chunkPosition : chunkPositions)
+  {
+    directories.insert(itksys::SystemTools::GetFilenamePath(this->GetChunkFileName(array, chunkPosition)));
+  }
+  for (const std::string & directory : directories)
+  {
+    if (!itksys::SystemTools::MakeDirectory(directory))
+    {
+      itkExceptionMacro("Cannot create the directory " << directory << '.');
+    }
+  }
+
+  ForEachChunk(chunkPositions.size(), true, [&](SizeValueType i) {
+    const Box         chunkBox = GetChunkBox(chunkPositions[i], array.ChunkSize);
+    const Box         chunkRegion = Intersect(chunkBox, region);
+    std::vector<char> chunk;
+    if (chunkRegion.Size == Intersect(chunkBox, arrayBox).Size)
+    {
+      // Fully overwritten, except for the padding beyond the array
+      FillChunk(array.FillValue, GetNumberOfPixels(array.ChunkSize), chunk);
+    }
+    else
+    {
+      this->ReadChunk(array, chunkPositions[i], chunk);
+    }
+    CopyRegion(static_cast<const char *>(buffer), region, chunk.data(), chunkBox, chunkRegion, pixelSize);
+    this->WriteChunk(array, chunkPositions[i], chunk);
+  });
+}
+
+void
+ZarrImageIO::DownsampleRegion(unsigned int                       level,
+                              const std::vector<SizeValueType> & index,
+                              const std::vector<SizeValueType> & size) const
+{
+  const ArrayLayout & source = m_Arrays[level - 1];
+  const ArrayLayout & target = m_Arrays[level];
+  const size_t        numberOfDimensions = index.size();
+  const auto          numberOfSpatialDimensions =
+    static_cast<unsigned int>(std::min<size_t>(numberOfDimensions, maximumNumberOfSpatialDimensions));
+  const Box  targetBox{ std::vector<SizeValueType>(numberOfDimensions, 0), target.Dimensions };
+  const auto chunkPositions = GetChunkPositions(Box{ index, size }, target.ChunkSize);
+
+  std::set<std::string> directories;
+  for (const auto & chunkPosition : chunkPositions)
+  {
+    directories.insert(itksys::SystemTools::GetFilenamePath(this->GetChunkFileName(target, chunkPosition)));
+  }
+  for (const std::string & directory : directories)
+  {
+    if (!itksys::SystemTools::MakeDirectory(directory))
+    {
+      itkExceptionMacro("Cannot create the directory " << directory << '.');
+    }
+  }
+
+  // Each chunk is recomputed from the pixels of the previous level it covers,
+  // which are read serially as the chunks are processed in parallel.
+  ForEachChunk(chunkPositions.size(), true, [&](SizeValueType i) {
+    const Box chunkRegion = Intersect(GetChunkBox(chunkPositions[i], target.ChunkSize), targetBox);
+    Box       sourceRegion = chunkRegion;
+    for (unsigned int d = 0; d < numberOfSpatialDimensions; ++d)
+    {
+      sourceRegion.Index[d] = 2 * chunkRegion.Index[d];
+      sourceRegion.Size[d] =
+        std::min(2 * (chunkRegion.Index[d] + chunkRegion.Size[d]), source.Dimensions[d]) - sourceRegion.Index[d];
+    }
+    std::vector<char> sourcePixels(GetNumberOfPixels(sourceRegion.Size) * this->GetPixelSize());
+    this->ReadRegion(source, sourceRegion.Index, sourceRegion.Size, sourcePixels.data(), false);
+
+    std::vector<char> chunk;
+    FillChunk(target.FillValue, GetNumberOfPixels(target.ChunkSize), chunk);
+    CallWithComponentType(m_ComponentType, [&](auto zero) {
+      using ComponentType = decltype(zero);
+      DownsamplePixels(reinterpret_cast<const ComponentType *>(sourcePixels.data()),
+                       sourceRegion.Size,
+                       reinterpret_cast<ComponentType *>(chunk.data()),
+                       target.ChunkSize,
+                       chunkRegion.Size,
+                       this->GetNumberOfComponents(),
+                       numberOfSpatialDimensions);
+    });
+    this->WriteChunk(target, chunkPositions[i], chunk);
+  });
+}
+
+std::vector<SizeValueType>
+ZarrImageIO::GetChunkSizeForWriting() const
+{
+  // Chunks of about one MiB by default, with the same size along each dimension
+  const unsigned int  numberOfDimensions = this->GetNumberOfDimensions();
+  const SizeValueType maximumChunkBytes = SizeValueType{ 1 } << 20;
+  SizeValueType       defaultSize = 1;
+  while (true)
+  {
+    SizeValueType chunkBytes = this->GetPixelSize();
+    for (unsigned int i = 0; i < numberOfDimensions && chunkBytes <= maximumChunkBytes; ++i)
+    {
+      chunkBytes *= 2 * defaultSize;
+    }
+    if (chunkBytes > maximumChunkBytes)
+    {
+      break;
+    }
+    defaultSize *= 2;
+  }
+
+  std::vector<SizeValueType> chunkSize(numberOfDimensions);
+  for (unsigned int i = 0; i < numberOfDimensions; ++i)
+  {
+    const SizeValueType size = i < m_ChunkSize.size() && m_ChunkSize[i] > 0 ? m_ChunkSize[i] : defaultSize;
+    chunkSize[i] = std::max<SizeValueType>(std::min<SizeValueType>(size, this->GetDimensions(i)), 1);
+  }
+  return chunkSize;
+}
+
+void
+ZarrImageIO::WriteImageInformation()
+{
+  const std::string & store = m_FileName;
+  const std::string   dataType = GetDataType(m_ComponentType);
+  if (dataType.empty())
+  {
+    itkExceptionMacro("Unsupported component type: " << m_ComponentType);
+  }
+
+  // An existing store is replaced, but not any other file
+  if (itksys::SystemTools::FileExists(store))
+  {
+    itksys::Directory directory;
+    const bool isEmptyDirectory = directory.Load(store) && directory.GetNumberOfFiles() <= 2;
+    if (!isEmptyDirectory && !this->CanReadFile(store.c_str()))
+    {
+      itkExceptionMacro("Cannot write " << store << ": the file exists and is not a Zarr store.");
+    }
+    if (!isEmptyDirectory && !itksys::SystemTools::RemoveADirectory(store))
+    {
+      itkExceptionMacro("Cannot remove the existing store " << store << '.');
+    }
+  }
+  if (!itksys::SystemTools::MakeDirectory(store))
+  {
+    itkExceptionMacro("Cannot create the directory " << store << '.');
+  }
+
+  const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+  const unsigned int numberOfComponents = this->GetNumberOfComponents();
+  const unsigned int numberOfSpatialDimensions = std::min(numberOfDimensions, maximumNumberOfSpatialDimensions);
+  const char         byteOrder =
+    this->GetComponentSize() == 1 ? '|' : (ByteSwapper<int>::SystemIsBigEndian() ? '>' : '<');
+  const std::vector<SizeValueType> chunkSize = this->GetChunkSizeForWriting();
+
+  std::vector<ArrayLayout> arrays(m_NumberOfLevels);
+  std::string              datasets;
+  for (unsigned int level = 0; level < m_NumberOfLevels; ++level)
+  {
+    ArrayLayout & array = arrays[level];
+    array.Path = store + '/' + std::to_string(level);
+    array.Compressed = m_UseCompression;
+    array.FillValue.assign(this->GetPixelSize(), 0);
+    const double factor = std::ldexp(1.0, static_cast<int>(level));
+    for (unsigned int i = 0; i < numberOfDimensions; ++i)
+    {
+      const bool isSpatial = i < numberOfSpatialDimensions;
+      array.Dimensions.push_back(level == 0 || !isSpatial ? this->GetDimensions(i)
+                                                          : (arrays[level - 1].Dimensions[i] + 1) / 2);
+      array.ChunkSize.push_back(std::min(chunkSize[i], array.Dimensions[i]));
+      // Each pixel is centered on the pixels of the full resolution it averages
+      array.Scale.push_back(isSpatial ? factor * this->GetSpacing(i) : this->GetSpacing(i));
+      array.Translation.push_back(this->GetOrigin(i) + (isSpatial ? (factor - 1.0) / 2.0 * this->GetSpacing(i) : 0.0));
+    }
+
+    // The Zarr axes are the dimensions of the image in reverse order
+    std::vector<SizeValueType> shape(array.Dimensions.crbegin(), array.Dimensions.crend());
+    std::vector<SizeValueType> chunks(array.ChunkSize.crbegin(), array.ChunkSize.crend());
+    std::vector<double>        scale(array.Scale.crbegin(), array.Scale.crend());
+    std::vector<double>        translation(array.Translation.crbegin(), array.Translation.crend());
+    if (numberOfComponents > 1)
+    {
+      shape.push_back(numberOfComponents);
+      chunks.push_back(numberOfComponents);
+      scale.push_back(1.0);
+      translation.push_back(0.0);
+    }
+
+    if (!itksys::SystemTools::MakeDirectory(array.Path))
+    {
+      itkExceptionMacro("Cannot create the directory " << array.Path << '.');
+    }
+    const std::string compressor =
+      array.Compressed ? "{\"id\": \"zlib\", \"level\": " + std::to_string(this->GetCompressionLevel()) + '}' : "null";
+    WriteTextFile(array.Path + "/.zarray",
+                  "{\n"
+                  "  \"chunks\": " +
+                    ToJSON(chunks) +
+                    ",\n"
+                    "  \"compressor\": " +
+                    compressor +
+                    ",\n"
+                    "  \"dimension_separator\": \"/\",\n"
+                    "  \"dtype\": \"" +
+                    byteOrder + dataType +
+                    "\",\n"
+                    "  \"fill_value\": 0,\n"
+                    "  \"filters\": null,\n"
+                    "  \"order\": \"C\",\n"
+                    "  \"shape\": " +
+                    ToJSON(shape) +
+                    ",\n"
+                    "  \"zarr_format\": 2\n"
+                    "}\n");
+
+    datasets += std::string(level == 0 ? "" : ",\n") +
+                "        {\n"
+                "          \"path\": \"" +
+                std::to_string(level) +
+                "\",\n"
+                "          \"coordinateTransformations\": [\n"
+                "            {\"type\": \"scale\", \"scale\": " +
+                ToJSON(scale) +
+                "},\n"
+                "            {\"type\": \"translation\", \"translation\": " +
+                ToJSON(translation) +
+                "}\n"
+                "          ]\n"
+                "        }";
+  }
+
+  std::string axes;
+  std::string direction;
+  for (unsigned int i = numberOfDimensions; i-- > 0;)
+  {
+    const std::string name = i < std::size(axisNames) ? axisNames[i] : 'd' + std::to_string(i);
+    const std::string type = i < numberOfSpatialDimensions ? "space" : (i == 3 ? "time" : "");
+    axes += "        {\"name\": \"" + name + '"' + (type.empty() ? "" : ", \"type\": \"" + type + '"') + "},\n";
+  }
+  if (numberOfComponents > 1)
+  {
+    axes += "        {\"name\": \"c\", \"type\": \"channel\"},\n";
+  }
+  axes.erase(axes.size() - 2);
+  for (unsigned int i = 0; i < numberOfDimensions; ++i)
+  {
+    direction += std::string(i == 0 ? "" : ", ") + ToJSON(this->GetDirection(i));
+  }
+
+  WriteTextFile(store + "/.zgroup", "{\n  \"zarr_format\": 2\n}\n");
+  WriteTextFile(store + "/.zattrs",
+                "{\n"
+                "  \"multiscales\": [\n"
+                "    {\n"
+                "      \"version\": \"0.4\",\n"
+                "      \"name\": " +
+                  ToJSON(itksys::SystemTools::GetFilenameWithoutLastExtension(store)) +
+                  ",\n"
+                  "      \"axes\": [\n" +
+                  axes +
+                  "\n"
+                  "      ],\n"
+                  "      \"datasets\": [\n" +
+                  datasets +
+                  "\n"
+                  "      ],\n"
+                  "      \"type\": \"mean\"\n"
+                  "    }\n"
+                  "  ],\n"
+                  "  \"itk\": {\n"
+                  "    \"direction\": [" +
+                  direction +
+                  "],\n"
+                  "    \"pixelType\": \"" +
+                  Self::GetPixelTypeAsString(m_PixelType) +
+                  "\"\n"
+                  "  }\n"
+                  "}\n");
+
+  m_Arrays = std::move(arrays);
+}
+
+void
+ZarrImageIO::Write(const void * buffer)
+{
+  // A streamed write creates the store with its first piece
+  if (!m_UseStreamedWriting || m_Arrays.empty())
+  {
+    this->WriteImageInformation();
+  }
+
+  const unsigned int numberOfDimensions = this->GetNumberOfDimensions();
+  Box                region = GetBox(m_IORegion, numberOfDimensions);
+  this->WriteRegion(m_Arrays[0], region.Index, region.Size, buffer);
+
+  // The pixels of each level depending on the region written
+  for (unsigned int level = 1; level < m_Arrays.size(); ++level)
+  {
+    for (unsigned int i = 0; i < std::min(numberOfDimensions, maximumNumberOfSpatialDimensions); ++i)
+    {
+      const SizeValueType end = std::min((region.Index[i] + region.Size[i] + 1) / 2, m_Arrays[level].Dimensions[i]);
+      region.Index[i] /= 2;
+      region.Size[i] = end - region.Index[i];
+    }
+    this->DownsampleRegion(level, region.Index, region.Size);
+  }
+}
+
+unsigned int
+ZarrImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                               const ImageIORegion & pasteRegion,
+                                               const ImageIORegion & largestPossibleRegion)
+{
+  // Pasting into an existing store keeps its layout
+  m_Arrays.clear();
+  if (pasteRegion != largestPossibleRegion && itksys::SystemTools::FileExists(m_FileName))
+  {
+    std::string errorMessage;
+    const auto  storeReader = Self::New();
+    try
+    {
+      storeReader->SetFileName(m_FileName);
+      storeReader->ReadImageInformation();
+    }
+    catch (...)
+    {
+      errorMessage = "Unable to read information from file: " + m_FileName;
+    }
+
+    if (!errorMessage.empty())
+    {
+      // Can't read the store
+    }
+    else if (storeReader->GetNumberOfComponents() != this->GetNumberOfComponents() ||
+             storeReader->GetComponentType() != this->GetComponentType())
+    {
+      errorMessage = "Component type does not match in file: " + m_FileName;
+    }
+    else if (storeReader->GetNumberOfDimensions() != this->GetNumberOfDimensions())
+    {
+      errorMessage = "Dimensions does not match in file: " + m_FileName;
+    }
+    else
+    {
+      for (unsigned int i = 0; i < this->GetNumberOfDimensions(); ++i)
+      {
+        if (storeReader->GetDimensions(i) != this->GetDimensions(i) ||
+            Math::NotExactlyEquals(storeReader->GetSpacing(i), this->GetSpacing(i)) ||
+            Math::NotExactlyEquals(storeReader->GetOrigin(i), this->GetOrigin(i)) ||
+            storeReader->GetDirection(i) != this->GetDirection(i))
+        {
+          errorMessage = "Size, spacing, origin or direction cosines does not match in file: " + m_FileName;
+          break;
+        }
+      }
+    }
+    if (!errorMessage.empty())
+    {
+      itkExceptionMacro("Unable to paste because pasting file exists and is different. " << errorMessage);
+    }
+    m_Arrays = storeReader->m_Arrays;
+  }
+
+  const std::vector<SizeValueType> chunkSize =
+    m_Arrays.empty() ? this->GetChunkSizeForWriting() : m_Arrays[0].ChunkSize;
+  SizeValueType numberOfSlabs = 1;
+  GetSplitDimension(pasteRegion, chunkSize, numberOfSlabs);
+  const SizeValueType numberOfSplits = std::min<SizeValueType>(numberOfRequestedSplits, numberOfSlabs);
+  return static_cast<unsigned int>(std::max<SizeValueType>(numberOfSplits, 1));
+}
+
+ImageIORegion
+ZarrImageIO::GetSplitRegionForWriting(unsigned int          ithPiece,
+                                      const unsigned int    numberOfActualSplits,
+                                      const ImageIORegion & pasteRegion,
+                                      const ImageIORegion & itkNotUsed(largestPossibleRegion))
+{
+  const std::vector<SizeValueType> chunkSize =
+    m_Arrays.empty() ? this->GetChunkSizeForWriting() : m_Arrays[0].ChunkSize;
+  SizeValueType      numberOfSlabs = 1;
+  const unsigned int dimension = GetSplitDimension(pasteRegion, chunkSize, numberOfSlabs);
+  if (numberOfActualSplits <= 1 || numberOfSlabs <= 1)
+  {
+    return pasteRegion;
+  }
+
+  // Each piece is made of whole slabs of chunks, clipped to the paste region
+  const auto          pasteBegin = static_cast<SizeValueType>(pasteRegion.GetIndex(dimension));
+  const SizeValueType pasteEnd = pasteBegin + pasteRegion.GetSize(dimension);
+  const SizeValueType firstSlab = pasteBegin / chunkSize[dimension];
+  const SizeValueType begin =
+    std::max(pasteBegin, (firstSlab + numberOfSlabs * ithPiece / numberOfActualSplits) * chunkSize[dimension]);
+  const SizeValueType end =
+    std::min(pasteEnd, (firstSlab + numberOfSlabs * (ithPiece + 1) / numberOfActualSplits) * chunkSize[dimension]);
+
+  ImageIORegion splitRegion = pasteRegion;
+  splitRegion.SetIndex(dimension, static_cast<IndexValueType>(begin));
+  splitRegion.SetSize(dimension, end - begin);
+  return splitRegion;
+}
+
+} // end namespace itk
@@ -0,0 +1,246 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingImageIOStreamingHelpers.h"
+#include "itkTestingMacros.h"
+#include "itkVectorImage.h"
+#include "itkZarrImageIO.h"
+#include "itkZarrImageIOFactory.h"
+#include "itksys/SystemTools.hxx"
+
+#include <cmath>
+#include <fstream>
+
+namespace
+{
+using ImageType = itk::Image<short, 3>;
+
+// Mean of the blocks of 2x2x2 pixels, as the levels of the pyramid
+ImageType::Pointer
+Downsample(const ImageType * image)
+{
+  const ImageType::SizeType size = image->GetLargestPossibleRegion().GetSize();
+  auto                      downsampledImage = ImageType::New();
+  downsampledImage->SetRegions(ImageType::SizeType{ { (size[0] + 1) / 2, (size[1] + 1) / 2, (size[2] + 1) / 2 } });
+  downsampledImage->Allocate();
+  itk::ImageRegionIteratorWithIndex<ImageType> it(downsampledImage, downsampledImage->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    double       sum = 0.0;
+    unsigned int count = 0;
+    for (unsigned int neighbor = 0; neighbor < 8; ++neighbor)
+    {
+      ImageType::IndexType index;
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        index[i] = 2 * it.GetIndex()[i] + ((neighbor >> i) & 1);
+      }
+      if (image->GetLargestPossibleRegion().IsInside(index))
+      {
+        sum += image->GetPixel(index);
+        ++count;
+      }
+    }
+    it.Set(static_cast<short>(std::floor(sum / count + 0.5)));
+  }
+  return downsampledImage;
+}
+
+ImageType::Pointer
+ReadLevel(const std::string & fileName, unsigned int level, const ImageType::RegionType & region = {})
+{
+  auto zarrImageIO = itk::ZarrImageIO::New();
+  zarrImageIO->SetLevel(level);
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(fileName);
+  reader->SetImageIO(zarrImageIO);
+  reader->UpdateOutputInformation();
+  if (region.GetNumberOfPixels() > 0)
+  {
+    reader->GetOutput()->SetRequestedRegion(region);
+  }
+  reader->Update();
+  return reader->GetOutput();
+}
+
+unsigned int
+GetLevelForSpacing(const std::string & fileName, const std::vector<double> & spacing)
+{
+  auto zarrImageIO = itk::ZarrImageIO::New();
+  zarrImageIO->SetFileName(fileName);
+  zarrImageIO->SetRequestedSpacing(spacing);
+  zarrImageIO->ReadImageInformation();
+  return zarrImageIO->GetLevel();
+}
+} // namespace
+
+int
+itkZarrImageIOTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  itk::ZarrImageIOFactory::RegisterOneFactory();
+
+  auto zarrImageIO = itk::ZarrImageIO::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(zarrImageIO, ZarrImageIO, ImageIOBase);
+  ITK_TEST_EXPECT_EQUAL(zarrImageIO->GetNumberOfLevels(), 1u);
+  zarrImageIO->SetNumberOfLevels(3);
+  ITK_TEST_SET_GET_VALUE(3u, zarrImageIO->GetNumberOfLevels());
+  zarrImageIO->SetLevel(1);
+  ITK_TEST_SET_GET_VALUE(1u, zarrImageIO->GetLevel());
+  zarrImageIO->SetLevel(0);
+  const std::vector<itk::SizeValueType> chunkSize{ 32, 24, 16 };
+  zarrImageIO->SetChunkSize(chunkSize);
+  ITK_TEST_EXPECT_TRUE(zarrImageIO->GetChunkSize() == chunkSize);
+  ITK_TEST_EXPECT_TRUE(zarrImageIO->CanWriteFile("image.zarr"));
+  ITK_TEST_EXPECT_TRUE(!zarrImageIO->CanWriteFile("image.mha"));
+  ITK_TEST_EXPECT_TRUE(!zarrImageIO->CanReadFile(outputDirectory.c_str()));
+
+  // Several chunks, partially covering the image along each dimension
+  auto                      image = ImageType::New();
+  const ImageType::SizeType size = { { 150, 97, 37 } };
+  image->SetRegions(size);
+  image->SetSpacing(itk::MakeVector(0.5, 0.25, 2.0));
+  image->SetOrigin(itk::MakePoint(-10.0, 3.0, 7.5));
+  image->Allocate();
+  itk::Testing::FillWithIndexPattern(image.GetPointer());
+
+  // Written in pieces aligned with the chunks, as a compressed pyramid
+  const std::string fileName = outputDirectory + "/itkZarrImageIOTest.zarr";
+  auto              writer = itk::ImageFileWriter<ImageType>::New();
+  writer->SetInput(image);
+  writer->SetFileName(fileName);
+  writer->SetImageIO(zarrImageIO);
+  writer->SetUseCompression(true);
+  writer->SetNumberOfStreamDivisions(4);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(fileName + "/0/2/4/4", true));
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(fileName + "/2/0/1/1", true));
+  ITK_TEST_EXPECT_TRUE(zarrImageIO->CanReadFile(fileName.c_str()));
+
+  ImageType::Pointer readImage;
+  ITK_TRY_EXPECT_NO_EXCEPTION(readImage = itk::ReadImage<ImageType>(fileName));
+  ITK_TEST_EXPECT_EQUAL(readImage->GetBufferedRegion(), image->GetLargestPossibleRegion());
+  ITK_TEST_EXPECT_EQUAL(readImage->GetSpacing(), image->GetSpacing());
+  ITK_TEST_EXPECT_EQUAL(readImage->GetOrigin(), image->GetOrigin());
+  ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(readImage.GetPointer(), image.GetPointer()));
+
+  // Only the chunks covering a region are read: a region across a corner of
+  // eight chunks, and one in the chunks partially covering the image
+  const ImageType::RegionType region({ { 30, 20, 14 } }, { { 40, 30, 6 } });
+  const ImageType::RegionType edgeRegion({ { 130, 90, 33 } }, { { 20, 7, 4 } });
+  for (const ImageType::RegionType & requestedRegion : { region, edgeRegion })
+  {
+    ITK_TRY_EXPECT_NO_EXCEPTION(readImage = ReadLevel(fileName, 0, requestedRegion));
+    ITK_TEST_EXPECT_EQUAL(readImage->GetBufferedRegion(), requestedRegion);
+    ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(readImage.GetPointer(), image.GetPointer()));
+  }
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(readImage = itk::Testing::ReadImageStreamed<ImageType>(fileName, 7));
+  ITK_TEST_EXPECT_EQUAL(readImage->GetBufferedRegion(), image->GetLargestPossibleRegion());
+  ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(readImage.GetPointer(), image.GetPointer()));
+
+  // The coarser levels are centered on the pixels they average
+  ImageType::Pointer expectedImage = image;
+  for (unsigned int level = 1; level < 3; ++level)
+  {
+    expectedImage = Downsample(expectedImage);
+    ITK_TRY_EXPECT_NO_EXCEPTION(readImage = ReadLevel(fileName, level));
+    ITK_TEST_EXPECT_EQUAL(readImage->GetLargestPossibleRegion(), expectedImage->GetLargestPossibleRegion());
+    ITK_TEST_EXPECT_EQUAL(readImage->GetSpacing(), image->GetSpacing() * double(1u << level));
+    itk::ContinuousIndex<double, 3> centerIndex;
+    centerIndex.Fill(((1u << level) - 1) / 2.0);
+    ITK_TEST_EXPECT_EQUAL(readImage->GetOrigin(), image->TransformContinuousIndexToPhysicalPoint<double>(centerIndex));
+    ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(readImage.GetPointer(), expectedImage.GetPointer()));
+  }
+  ITK_TRY_EXPECT_EXCEPTION(ReadLevel(fileName, 3));
+
+  ITK_TEST_EXPECT_EQUAL(GetLevelForSpacing(fileName, { 0.1 }), 0u);
+  ITK_TEST_EXPECT_EQUAL(GetLevelForSpacing(fileName, { 1.0, 0.5, 4.0 }), 1u);
+  ITK_TEST_EXPECT_EQUAL(GetLevelForSpacing(fileName, { 1.5, 1.0, 100.0 }), 1u);
+  ITK_TEST_EXPECT_EQUAL(GetLevelForSpacing(fileName, { 2.0 }), 2u);
+
+  // Pasting a region into the store updates its pyramid
+  const ImageType::RegionType pasteRegion({ { 40, 30, 10 } }, { { 50, 20, 17 } });
+  itk::ImageRegionIterator<ImageType> it(image, pasteRegion);
+  for (; !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<short>(-it.Get()));
+  }
+  image->Modified();
+  itk::ImageIORegion pasteIORegion(3);
+  itk::ImageIORegionAdaptor<3>::Convert(pasteRegion, pasteIORegion, image->GetLargestPossibleRegion().GetIndex());
+  writer->SetIORegion(pasteIORegion);
+  writer->SetNumberOfStreamDivisions(2);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+  ITK_TRY_EXPECT_NO_EXCEPTION(readImage = itk::ReadImage<ImageType>(fileName));
+  ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(readImage.GetPointer(), image.GetPointer()));
+  ITK_TRY_EXPECT_NO_EXCEPTION(readImage = ReadLevel(fileName, 2));
+  ITK_TEST_EXPECT_TRUE(
+    itk::Testing::HasExpectedPixels(readImage.GetPointer(), Downsample(Downsample(image)).GetPointer()));
+
+  // Multi-component pixels, along the last axis of raw chunks
+  using VectorImageType = itk::VectorImage<float, 2>;
+  auto vectorImage = VectorImageType::New();
+  vectorImage->SetRegions(VectorImageType::SizeType{ { 300, 200 } });
+  vectorImage->SetNumberOfComponentsPerPixel(3);
+  vectorImage->Allocate();
+  itk::ImageRegionIteratorWithIndex<VectorImageType> vectorIt(vectorImage, vectorImage->GetLargestPossibleRegion());
+  for (; !vectorIt.IsAtEnd(); ++vectorIt)
+  {
+    VectorImageType::PixelType pixel(3);
+    pixel[0] = vectorIt.GetIndex()[0];
+    pixel[1] = vectorIt.GetIndex()[1] * 0.5f;
+    pixel[2] = -1.0f;
+    vectorIt.Set(pixel);
+  }
+  const std::string vectorFileName = outputDirectory + "/itkZarrImageIOTestVector.zarr";
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(vectorImage, vectorFileName));
+  ITK_TEST_EXPECT_TRUE(itksys::SystemTools::FileExists(vectorFileName + "/0/0/0/0", true));
+  VectorImageType::Pointer readVectorImage;
+  ITK_TRY_EXPECT_NO_EXCEPTION(readVectorImage = itk::ReadImage<VectorImageType>(vectorFileName));
+  ITK_TEST_EXPECT_EQUAL(readVectorImage->GetNumberOfComponentsPerPixel(), 3u);
+  ITK_TEST_EXPECT_TRUE(itk::Testing::HasExpectedPixels(readVectorImage.GetPointer(), vectorImage.GetPointer()));
+
+  // Only a store is replaced when writing
+  const std::string fileNotAStore = outputDirectory + "/itkZarrImageIOTestNotAStore.zarr";
+  std::ofstream(fileNotAStore.c_str()) << "Not a store";
+  ITK_TRY_EXPECT_EXCEPTION(itk::WriteImage(image, fileNotAStore));
+
+  // Unsupported compressor
+  const std::string arrayFileName = vectorFileName + "/0/.zarray";
+  std::ifstream     arrayFile(arrayFileName.c_str());
+  std::string       arrayMetadata((std::istreambuf_iterator<char>(arrayFile)), std::istreambuf_iterator<char>());
+  arrayFile.close();
+  arrayMetadata.replace(arrayMetadata.find("null"), 4, "{\"id\": \"blosc\"}");
+  std::ofstream(arrayFileName.c_str()) << arrayMetadata;
+  ITK_TRY_EXPECT_EXCEPTION(itk::ReadImage<VectorImageType>(vectorFileName));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
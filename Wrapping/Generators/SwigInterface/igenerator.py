@@ -520,7 +520,10 @@ class SwigInputGenerator:
         "itk::SmartPointer< const itk::Mesh.+ >",
         "itk::ObjectFactoryBasePrivate",
         "itk::ThreadPoolGlobals",
+        "itk::WorkStealingThreadPoolGlobals",
         "itk::MultiThreaderBaseGlobals",
+        "itk::ImportImageContainerCommonGlobals",
+        "itk::ImageBufferAllocatorGlobals",
         ".+[(][*][)][(].+",  # functor functions
     ]
 